@@ -44,6 +44,10 @@ function progressHandler(current, total) {
 function beforeSuiteRun(suite) {
     suite.on("start", function () {
         output.innerHTML += suite.name + "...<br/>";
+
+        const metrics = result.metrics[suite.name] = suite.metrics;
+        output.innerHTML += `&nbsp;&nbsp;startup emcc ${metrics.emcc.startupTime.toFixed(2)} ms, wasm ${metrics.wasm.startupTime.toFixed(2)} ms ` +
+            `(compile ${metrics.wasm.compileTime.toFixed(2)} ms, instantiate ${metrics.wasm.instantiateTime.toFixed(2)} ms)<br/>`;
     });
 
     suite.on("cycle", function (event) {
@@ -75,7 +79,7 @@ function beforeSuiteRun(suite) {
 function startBenchmark (numRuns=1) {
     buttons.forEach(button => button.disabled = "disabled");
     output.textContent = json.textContent = "";
-    result = { platform: platform, suites: {} };
+    result = { platform: platform, suites: {}, metrics: {} };
     progress.style.width = "0%";
     progress.parentNode.attributes.removeNamedItem("hidden");
 
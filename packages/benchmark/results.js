@@ -113,6 +113,7 @@ function changeBrowserSelection(event, data) {
 function renderChart(data) {
     document.querySelector("#json").innerText = JSON.stringify(toMathematicaData(data), undefined, "  ");
     renderTable(data);
+    renderMetricsTable(data);
     chart.render(data);
 }
 
@@ -296,6 +297,62 @@ function renderTable(chartData) {
     table.appendChild(footer);
 }
 
+function formatMetric(value, digits=2) {
+    return typeof(value) === "number" ? value.toFixed(digits) : "-";
+}
+
+/**
+ * Renders the startup time, call time per input size, peak memory, marshalling and gc time of each variant.
+ * Only the result files that have been recorded with the metrics pass contain these values.
+ */
+function renderMetricsTable(chartData) {
+    const visibleBrowsers = chartData.browsers.filter(isVisible);
+    const visibleTestCases = chartData.testCases.filter(isVisible);
+
+    const table = document.querySelector("#metrics-table");
+    removeChildNodes(table);
+
+    const header = document.createElement("thead");
+    const headerRow = document.createElement("tr");
+    const titles = ["Test Case", "Browser", "Arguments", "Variant", "Startup ms", "Call ms", "Compute ms", "Marshalling ms", "GC ms", "Memory KB", "Heap KB"];
+    for (const title of titles) {
+        appendCell(headerRow, title, "th");
+    }
+    header.appendChild(headerRow);
+    table.appendChild(header);
+
+    const body = document.createElement("tbody");
+
+    for (const testCase of visibleTestCases) {
+        for (const browser of visibleBrowsers) {
+            const metrics = testCase.metrics[browser.id];
+            if (!metrics) {
+                continue;
+            }
+
+            for (const variant of ["js", "emcc", "wasm"]) {
+                for (const run of metrics[variant].runs) {
+                    const row = document.createElement("tr");
+                    appendCell(row, testCase.name);
+                    appendCell(row, browser.name + " " + browser.version);
+                    appendCell(row, run.args.join(", "));
+                    appendCell(row, variant);
+                    appendNumberCell(row, formatMetric(metrics[variant].startupTime));
+                    appendNumberCell(row, formatMetric(run.time));
+                    appendNumberCell(row, formatMetric(run.computeTime));
+                    appendNumberCell(row, formatMetric(run.marshallingTime));
+                    appendNumberCell(row, formatMetric(run.gcTime));
+                    appendNumberCell(row, formatMetric(run.memorySize / 1024, 0));
+                    appendNumberCell(row, formatMetric(run.heapSize / 1024, 0));
+                    body.appendChild(row);
+                }
+            }
+        }
+    }
+
+    table.appendChild(body);
+}
+
 function createFooterRow(caption, value, visibleBrowsers) {
     const row = document.createElement("tr");
     appendCell(row, caption);
@@ -310,11 +367,12 @@ function createFooterRow(caption, value, visibleBrowsers) {
 function transformResultToChartData(browserResults) {
     const browsers = browserResults.map(result => { return { name: result.platform.name, version: result.platform.version, id: result.platform.description } });
     // all test cases
-    const testCases = _.chain(browserResults).flatMap(result => Object.keys(result.suites)).uniq().map(testSuite => { return { name: testSuite, results: {} }; }).value();
+    const testCases = _.chain(browserResults).flatMap(result => Object.keys(result.suites)).uniq().map(testSuite => { return { name: testSuite, results: {}, metrics: {} }; }).value();
 
     for (let i = 0; i < browserResults.length; ++i) {
         const browserId = browserResults[i].platform.description;
         const suites = browserResults[i].suites;
+        const metrics = browserResults[i].metrics || {};
 
         for (const testCase of testCases) {
             const browserResults = suites[testCase.name] || {};
@@ -329,6 +387,7 @@ function transformResultToChartData(browserResults) {
             const emccAvg = emccResultNames.reduce((memo, current) => memo + browserResults[current].hz, 0) / emccResultNames.length;
 
             testCase.results[browserId] = { js: jsAvg, jsRme: jsRme, wasm: wasmAvg, wasmRme: wasmRme, emcc: emccAvg };
+            testCase.metrics[browserId] = metrics[testCase.name];
         }
     }
 
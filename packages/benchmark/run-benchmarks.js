@@ -9,10 +9,12 @@ const Benchmark = window.Benchmark = benchmarkImport.runInContext( { _: _, platf
 const TEST_CASES = {
     "nbody": {
         args: [10000000],
+        sizes: [[100000], [1000000], [10000000]],
         result: -0.16907784165413997
     },
     "factorize": {
         args: [183626381],
+        sizes: [[1046527], [16769023], [183626381]],
         result: 183626381
     },
     "tspInt": {
@@ -21,6 +23,7 @@ const TEST_CASES = {
     },
     "simjs": {
         args: [10, 1000],
+        sizes: [[10, 100], [10, 1000], [10, 5000]],
         result: 969.1866817441974
     },
     "tspArrayInt": {
@@ -46,6 +49,7 @@ const TEST_CASES = {
     "fib": {
         fnName: "fib",
         args: [40],
+        sizes: [[30], [35], [40]],
         result: 102334155
     },
     "isPrime": {
@@ -54,6 +58,7 @@ const TEST_CASES = {
     },
     "nsieve": {
         args: [40000],
+        sizes: [[10000], [40000], [160000]],
         result: 4203
     },
     // "createPoints": {
@@ -70,6 +75,7 @@ const TEST_CASES = {
     },
     "intCompare": {
         args: [2548965],
+        sizes: [[254896], [2548965], [25489650]],
         result: 2548965
     },
     "arrayReverse": {
@@ -80,13 +86,12 @@ const TEST_CASES = {
 
 const jsModules = require.context("ts-loader!./cases", false, /.*^(?:(?!-spdy\.ts$).)*\.ts$/);
 
-function getJsFunctionForTestCase(caseName) {
-    const testCase = TEST_CASES[caseName];
+function getJsFunctionForTestCase(caseName, args = TEST_CASES[caseName].args) {
     const fnName = TEST_CASES[caseName].fnName || caseName;
     const fn = jsModules("./" + caseName + ".ts")[fnName];
 
     function jsFunctionWrapper() {
-        return Promise.resolve(fn.apply(undefined, testCase.args));
+        return Promise.resolve(fn.apply(undefined, args));
     }
 
     return jsFunctionWrapper;
@@ -108,8 +113,11 @@ function getWasmFunctionForTestCase(caseName) {
     return { fn: wasmFunctionWrapper, gc: gc };
 }
 
+// Same modules but linked against the instrumented runtime, only used to collect the metrics (startup, memory, marshalling and gc time)
+const instrumentedWasmModules = require.context("!speedyjs-loader?{speedyJS:{unsafe: true, exportGc: true, instrumentRuntime: true, disableHeapNukeOnExit: true, optimizationLevel: 3, binaryenOpt: true}}!./cases", false, /.*-spdy\.ts/);
+
 const emccModules = require.context("exports-loader?Module!./cases", false, /.*-emcc\.js$/);
-async function getEmccFunctionForTestCase(caseName) {
+async function getEmccFunctionForTestCase(caseName, args = TEST_CASES[caseName].args) {
     const testCase = TEST_CASES[caseName];
     const fnName = testCase.fnName || caseName;
 
@@ -119,7 +127,7 @@ async function getEmccFunctionForTestCase(caseName) {
     const fn = emccModule["_" + fnName];
 
     function emccFunctionWrapper() {
-        let result = fn.apply(undefined, testCase.args);
+        let result = fn.apply(undefined, args);
         if (typeof(testCase.result) === "boolean") {
             result = result !== 0;
         }
@@ -188,6 +196,94 @@ async function addBenchmark(suite, testCase, run) {
     return suite;
 }
 
+function now() {
+    return typeof(performance) !== "undefined" ? performance.now() : Date.now();
+}
+
+function usedJsHeapSize() {
+    return typeof(performance) !== "undefined" && performance.memory ? performance.memory.usedJSHeapSize : undefined;
+}
+
+/**
+ * Calls the function once and returns the result and the elapsed time in milliseconds
+ */
+async function timeCall(fn) {
+    const start = now();
+    const result = await fn();
+    return { result: result, time: now() - start };
+}
+
+function assertResult(variant, caseName, args, result, expected) {
+    if (result !== expected) {
+        throw new Error(`${variant} Result for Test Case ${caseName}(${args.join(", ")}) returned ${result} instead of ${expected}`);
+    }
+}
+
+/**
+ * Measures the startup time, the time of a single call and the memory usage of each variant for every input size of the test case.
+ * The modules are loaded for the first time by this function, the metrics are therefore only measured once per page
+ * (see measuredMetrics). The expected results of the other input sizes are the results of the JS implementation.
+ * The speedy.js metrics are collected with the instrumented runtime (instrumentRuntime, not used by the benchmarks).
+ */
+async function measureMetrics(caseName) {
+    const testCase = TEST_CASES[caseName];
+    const fnName = testCase.fnName || caseName;
+    const sizes = testCase.sizes || [testCase.args];
+
+    const emccStart = now();
+    const emccModule = emccModules("./" + caseName + "-emcc.js");
+    await emccModule.initialized;
+    const emccStartupTime = now() - emccStart;
+
+    const speedyModule = instrumentedWasmModules("./" + caseName + "-spdy.ts");
+    const metrics = {
+        js: { runs: [] },
+        emcc: { startupTime: emccStartupTime, runs: [] },
+        wasm: { runs: [] }
+    };
+
+    for (const args of sizes) {
+        const js = await timeCall(getJsFunctionForTestCase(caseName, args));
+        const expected = args === testCase.args ? testCase.result : js.result;
+        assertResult("JS", caseName, args, js.result, expected);
+        metrics.js.runs.push({ args: args, time: js.time, usedJsHeapSize: usedJsHeapSize() });
+
+        const emcc = await timeCall(await getEmccFunctionForTestCase(caseName, args));
+        assertResult("EMCC", caseName, args, emcc.result, expected);
+        metrics.emcc.runs.push({ args: args, time: emcc.time, memorySize: emccModule.HEAPU8 ? emccModule.HEAPU8.buffer.byteLength : undefined });
+
+        speedyModule.speedyJsResetRuntimeStatistics();
+        const wasm = await timeCall(() => speedyModule[fnName].apply(undefined, args));
+        assertResult("WASM", caseName, args, wasm.result, expected);
+
+        // read the heap size before the gc releases the allocations of the call
+        const beforeGc = speedyModule.speedyJsRuntimeStatistics();
+        speedyModule.speedyJsGc();
+        const statistics = speedyModule.speedyJsRuntimeStatistics();
+
+        if (!metrics.wasm.startupTime) {
+            metrics.wasm.compileTime = statistics.compileTime;
+            metrics.wasm.instantiateTime = statistics.instantiateTime;
+            metrics.wasm.startupTime = statistics.compileTime + statistics.instantiateTime;
+        }
+
+        metrics.wasm.runs.push({
+            args: args,
+            time: wasm.time,
+            marshallingTime: statistics.marshallingTime,
+            computeTime: wasm.time - statistics.marshallingTime,
+            gcTime: statistics.gcTime,
+            memorySize: statistics.memorySize,
+            heapSize: beforeGc.heapSize,
+            elementAllocations: statistics.elementAllocations,
+            arrayGrowths: statistics.arrayGrowths,
+            allocatedElementBytes: statistics.allocatedElementBytes
+        });
+    }
+
+    return metrics;
+}
+
 async function createSuite(caseName, numRuns = 1) {
     const suite = new Benchmark.Suite(caseName, { async: true });
     if (numRuns === 1) {
@@ -201,6 +297,8 @@ async function createSuite(caseName, numRuns = 1) {
     return suite;
 }
 
+const measuredMetrics = {};
+
 function runSuites(numRuns = 1, beforeRun, progress) {
     const pendingNames = Object.keys(TEST_CASES).reverse();
     const totalCases = pendingNames.length;
@@ -213,8 +311,17 @@ function runSuites(numRuns = 1, beforeRun, progress) {
         progress(totalCases - pendingNames.length, totalCases);
 
         const next = pendingNames.pop();
-        return createSuite(next, numRuns)
+        let metrics;
+
+        measuredMetrics[next] = measuredMetrics[next] || measureMetrics(next);
+
+        return measuredMetrics[next]
+            .then(measured => {
+                metrics = measured;
+                return createSuite(next, numRuns);
+            })
             .then(suite => {
+                suite.metrics = metrics;
                 return new Promise((resolve, reject) => {
                     beforeRun(suite);
 
@@ -111,6 +111,19 @@ async function arrayFillInBetween(array: number[], value: number, start: int, en
     return array;
 }
 
+async function arrayReverse(array: int[]) {
+    "use speedyjs";
+
+    array.reverse();
+    return array;
+}
+
+async function arrayReverseNumbers(array: number[]) {
+    "use speedyjs";
+
+    return array.reverse();
+}
+
 async function arrayPush(array: boolean[], value: boolean) {
     "use speedyjs";
 
@@ -125,6 +138,16 @@ async function arrayPushMultiple(array: boolean[], a: boolean, b: boolean, c: bo
     return array;
 }
 
+async function arrayPushInLoop(array: int[], n: int) {
+    "use speedyjs";
+
+    for (let i = 1; i <= n; ++i) {
+        array.push(i);
+    }
+
+    return array;
+}
+
 async function arrayUnshift(array: int[], value: int) {
     "use speedyjs";
 
@@ -217,6 +240,18 @@ async function numberArraySort(array: number[]) {
     return array.sort();
 }
 
+async function intArraySortWithAscendingComparator(array: int[]) {
+    "use speedyjs";
+
+    return array.sort((a, b) => a - b as number);
+}
+
+async function numberArraySortWithDescendingComparator(array: number[]) {
+    "use speedyjs";
+
+    return array.sort((a, b) => b - a);
+}
+
 function sortByXCoordinate(a: Point, b: Point) {
     "use speedyjs";
 
@@ -254,6 +289,18 @@ describe("Array", () => {
             cb();
         });
 
+        it("throws a RangeError if the size is negative", async (cb) => {
+            try {
+                await newArrayOfSize(-1);
+                cb.fail("Expected creating an array with a negative size to throw an error");
+            } catch (ex) {
+                expect(ex).toEqual(jasmine.any(RangeError));
+                expect((ex as Error).message).toBe("Invalid array length");
+            }
+
+            cb();
+        });
+
         it("creates an array containing the specified elements", async (cb) => {
             expect(await newArrayWithElements(10, 20, 30)).toEqual([10, 20, 30]);
             cb();
@@ -282,6 +329,20 @@ describe("Array", () => {
             cb();
         });
 
+        it("throws a RangeError if the value is set at an index out of bound", async (cb) => {
+            try {
+                await arraySet([1, 2, 3, 4], 10, 10);
+                cb.fail("Expected setting an element out of bound to throw an error");
+            } catch (ex) {
+                expect(ex).toEqual(jasmine.any(RangeError));
+                expect((ex as Error).message).toBe("Invalid array index");
+            }
+
+            // the module remains usable after the trap
+            expect(await arraySet([1, 2, 3, 4], 0, 10)).toEqual([10, 2, 3, 4]);
+            cb();
+        });
+
         it("returns the object at the given address", async (cb) => {
             expect(await objectArrayElementAccess(10)).toBe(10);
             cb();
@@ -322,6 +383,18 @@ describe("Array", () => {
         });
     });
 
+    describe("reverse", () => {
+        it("reverses the elements in place", async (cb) => {
+            expect(await arrayReverse([1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11])).toEqual([11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1]);
+            cb();
+        });
+
+        it("returns the reversed array", async (cb) => {
+            expect(await arrayReverseNumbers([1.5, 2.5, 3.5])).toEqual([3.5, 2.5, 1.5]);
+            cb();
+        });
+    });
+
     describe("push", () => {
         it("inserts the new element at the end of the array", async (cb) => {
             const pushed = await arrayPush([true, false], true);
@@ -334,6 +407,14 @@ describe("Array", () => {
             expect(pushed).toEqual([true, false, true, false, true]);
             cb();
         });
+
+        it("inserts the elements pushed in a for loop", async (cb) => {
+            const pushed = await arrayPushInLoop([0], 100);
+            expect(pushed.length).toBe(101);
+            expect(pushed[0]).toBe(0);
+            expect(pushed[100]).toBe(100);
+            cb();
+        });
     });
 
     describe("unshift", () => {
@@ -372,6 +453,16 @@ describe("Array", () => {
             cb();
         });
 
+        it("sorts boolean arrays that exceed the inline storage", async (cb) => {
+            const flags = Array.from({ length: 300 }, (value, index) => index % 3 === 0);
+            const sorted = await boolArraySort(flags);
+
+            expect(sorted.length).toBe(300);
+            expect(sorted.indexOf(true)).toBe(200);
+            expect(sorted.lastIndexOf(false)).toBe(199);
+            cb();
+        });
+
         it("sorts the int array ascending", async (cb) => {
             expect(await intArraySort([2, 5, 1, 13, 8])).toEqual([1, 2, 5, 8, 13]);
             cb();
@@ -381,6 +472,17 @@ describe("Array", () => {
             expect(await numberArraySort([12.3, 83.3, 213.2, 11.2, 93.2])).toEqual([11.2, 12.3, 83.3, 93.2, 213.2]);
             cb();
         });
+
+        it("sorts the int array ascending if the comparator is a - b", async (cb) => {
+            const array: int[] = Array.from({ length: 1000 }, (value, index) => ((index * 7919) % 1000 - 500) as int);
+            expect(await intArraySortWithAscendingComparator(array)).toEqual(array.slice().sort((a, b) => a - b));
+            cb();
+        });
+
+        it("sorts the number array descending if the comparator is b - a", async (cb) => {
+            expect(await numberArraySortWithDescendingComparator([12.3, -83.3, 213.2, 11.2, 93.2])).toEqual([213.2, 93.2, 12.3, 11.2, -83.3]);
+            cb();
+        });
     });
 
     describe("splice", () => {
@@ -16,6 +16,18 @@ async function pow(base: number, exp: number) {
     return Math.pow(base, exp);
 }
 
+async function square(base: number) {
+    "use speedyjs";
+
+    return Math.pow(base, 2);
+}
+
+async function exp(value: number) {
+    "use speedyjs";
+
+    return Math.exp(value);
+}
+
 async function log(value: number) {
     "use speedyjs";
 
@@ -46,6 +58,18 @@ async function maxInt(a: int, b: int, c: int) {
     return Math.max(a, b, c);
 }
 
+async function minNumber(a: number, b: number, c: number) {
+    "use speedyjs";
+
+    return Math.min(a, b, c);
+}
+
+async function minInt(a: int, b: int, c: int) {
+    "use speedyjs";
+
+    return Math.min(a, b, c);
+}
+
 describe("Math", () => {
     describe("PI", () => {
         it("returns the value PI", async (cb) => {
@@ -66,6 +90,24 @@ describe("Math", () => {
             expect(await pow(2.34, 34.2)).toBe(Math.pow(2.34, 34.2));
             cb();
         });
+
+        it("computes the power for a constant integer exponent", async (cb) => {
+            expect(await square(1.7)).toBe(Math.pow(1.7, 2));
+            expect(await square(1e200)).toBe(Infinity);
+            cb();
+        });
+
+        it("returns NaN if the base is one and the exponent is infinite", async (cb) => {
+            expect(await pow(1, Infinity)).toBeNaN();
+            cb();
+        });
+    });
+
+    describe("exp", () => {
+        it("computes the exponential function", async (cb) => {
+            expect(await exp(2.33)).toBeCloseTo(Math.exp(2.33), 12);
+            cb();
+        });
     });
 
     describe("log", () => {
@@ -99,5 +141,27 @@ describe("Math", () => {
             expect(await maxInt(11, 22, 100)).toBe(100);
             cb();
         });
+
+        it("returns NaN if any number is NaN", async (cb) => {
+            expect(await maxNumber(10, NaN, 100)).toBeNaN();
+            cb();
+        });
+    });
+
+    describe("min", () => {
+        it("returns the min of the passed numbers", async (cb) => {
+            expect(await minNumber(10, -22, 100)).toBe(-22);
+            cb();
+        });
+
+        it("returns the min of the passed integers", async (cb) => {
+            expect(await minInt(11, 22, -100)).toBe(-100);
+            cb();
+        });
+
+        it("returns NaN if any number is NaN", async (cb) => {
+            expect(await minNumber(10, NaN, 100)).toBeNaN();
+            cb();
+        });
     });
 });
@@ -0,0 +1,67 @@
+import * as fs from "fs";
+import * as path from "path";
+import * as tmp from "tmp";
+import {BuildCache} from "../src/code-generation/build-cache";
+import {getLinkTimeOptimizationArguments, getOptimizationArguments} from "../src/external-tools/llvm-opt";
+
+describe("BuildCache", () => {
+    let directory: { name: string, removeCallback: () => void };
+    let inputFileName: string;
+
+    beforeEach(() => {
+        directory = tmp.dirSync({ unsafeCleanup: true });
+        inputFileName = path.join(directory.name, "input.bc");
+        fs.writeFileSync(inputFileName, "input");
+    });
+
+    afterEach(() => {
+        directory.removeCallback();
+    });
+
+    it("computes the same key for the same step, input and parameters", () => {
+        const cache = new BuildCache(path.join(directory.name, "cache"), "1.0.0");
+
+        expect(cache.computeKey("opt", inputFileName, getOptimizationArguments("3")))
+            .toBe(cache.computeKey("opt", inputFileName, getOptimizationArguments("3")));
+    });
+
+    it("computes a different key if the parameters change", () => {
+        const cache = new BuildCache(path.join(directory.name, "cache"), "1.0.0");
+
+        expect(cache.computeKey("opt", inputFileName, getOptimizationArguments("3")))
+            .not.toBe(cache.computeKey("opt", inputFileName, getOptimizationArguments("2")));
+    });
+
+    it("computes a different key for another compiler version", () => {
+        const cache = new BuildCache(path.join(directory.name, "cache"), "1.0.0");
+        const updatedCache = new BuildCache(path.join(directory.name, "cache"), "1.0.1");
+
+        expect(cache.computeKey("lto", inputFileName, [])).not.toBe(updatedCache.computeKey("lto", inputFileName, []));
+    });
+
+    it("restores a stored entry", () => {
+        const cache = new BuildCache(path.join(directory.name, "cache"), "1.0.0");
+        const key = cache.computeKey("opt", inputFileName, []);
+        const outputFileName = path.join(directory.name, "output.bc");
+
+        expect(cache.restore(key, outputFileName)).toBe(false);
+
+        cache.store(key, inputFileName);
+
+        expect(cache.restore(key, outputFileName)).toBe(true);
+        expect(fs.readFileSync(outputFileName, "utf-8")).toBe("input");
+    });
+
+    it("includes the fixed optimization passes in the parameters of the optimization step", () => {
+        expect(getOptimizationArguments("3")).toEqual(["-O3", "-loop-unswitch", "-loop-unswitch", "-licm", "-irce"]);
+    });
+
+    it("includes the default public functions in the parameters of the link time optimization step", () => {
+        const args = getLinkTimeOptimizationArguments(["_fib"], "3");
+
+        expect(args[0]).toMatch(/^-internalize-public-api-list=_fib,speedyJsGc,.*,speedyJsFreezeHeap,/);
+        expect(args).toContain("-std-link-opts");
+        expect(args).toContain("-strip-debug");
+        expect(getLinkTimeOptimizationArguments(["_fib"], "0")).not.toContain("-std-link-opts");
+    });
+});
@@ -0,0 +1,11 @@
+async function elementAccessInCountingLoop(array: int[]) {
+    "use speedyjs";
+
+    let sum = 0;
+    for (let i = 0; i < array.length; ++i) {
+        array[i] = array[i] * 2;
+        sum += array[i];
+    }
+
+    return sum;
+}
@@ -0,0 +1,8 @@
+async function elementAccessInLoopShrinkingLength(array: int[]) {
+    "use speedyjs";
+
+    for (let i = 0; i < array.length; ++i) {
+        array.length--;
+        array[i] = 1;
+    }
+}
@@ -0,0 +1,14 @@
+async function elementAccessInLoopWithComparator(array: int[]) {
+    "use speedyjs";
+
+    for (let i = 0; i < array.length; ++i) {
+        array.sort(descending);
+        array[i] = 1;
+    }
+}
+
+function descending(a: int, b: int) {
+    "use speedyjs";
+
+    return b - a as number;
+}
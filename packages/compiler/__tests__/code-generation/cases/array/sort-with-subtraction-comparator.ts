@@ -0,0 +1,10 @@
+async function arraySortWithSubtractionComparator() {
+    "use speedyjs";
+
+    const array = [1.5, 2.5];
+
+    const ascending = array.sort((a, b) => a - b);
+    const descending = array.sort((a, b) => {
+        return b - a;
+    });
+}
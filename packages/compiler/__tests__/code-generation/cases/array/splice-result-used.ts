@@ -0,0 +1,7 @@
+async function arraySpliceResultUsed() {
+    "use speedyjs";
+
+    const array = [1, 2, 3, 4, 5, 6, 7, 8, 9, 10];
+    const deleted = array.splice(2, 3);
+    array.splice(0, 1);
+}
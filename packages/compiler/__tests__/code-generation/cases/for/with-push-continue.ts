@@ -0,0 +1,13 @@
+async function forWithPushContinue(n: int) {
+    "use speedyjs";
+
+    const result: int[] = [];
+    for (let i = 0; i < n; ++i) {
+        if (i % 2 === 1) {
+            continue;
+        }
+        result.push(i);
+    }
+
+    return result.length;
+}
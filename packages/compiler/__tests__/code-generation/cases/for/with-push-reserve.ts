@@ -0,0 +1,10 @@
+async function forWithPushReserve(n: int) {
+    "use speedyjs";
+
+    const result: int[] = [];
+    for (let i = 0; i < n; ++i) {
+        result.push(i * 2);
+    }
+
+    return result.length;
+}
@@ -0,0 +1,12 @@
+async function map() {
+    "use speedyjs";
+
+    const squares = new Map<int, number>();
+    squares.set(2, 4.0).set(3, 9.0);
+
+    const hasTwo = squares.has(2);
+    const three = squares.get(3);
+    const deleted = squares.delete(2);
+    const size = squares.size;
+    squares.clear();
+}
@@ -0,0 +1,11 @@
+async function set() {
+    "use speedyjs";
+
+    const seen = new Set<number>();
+    seen.add(1.5).add(2.5);
+
+    const hasOne = seen.has(1.5);
+    const deleted = seen.delete(2.5);
+    const size = seen.size;
+    seen.clear();
+}
@@ -0,0 +1,5 @@
+async function mapUnsupportedKeyType() {
+    "use speedyjs";
+
+    const flags = new Map<boolean, int>();
+}
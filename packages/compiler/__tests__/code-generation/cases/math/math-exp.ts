@@ -0,0 +1,5 @@
+async function mathExp() {
+    "use speedyjs";
+
+    Math.exp(1.3);
+}
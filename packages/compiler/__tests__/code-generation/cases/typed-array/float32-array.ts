@@ -0,0 +1,13 @@
+async function float32Array(): Promise<number> {
+    "use speedyjs";
+
+    const array = new Float32Array(10);
+    array.fill(1.5);
+    array[2] = 0.1;
+    array.sort();
+    array.reverse();
+
+    const length = array.length;
+    const copy = array.slice(1.0, 5.0);
+    return copy[0];
+}
@@ -0,0 +1,9 @@
+async function int16Array(): Promise<number> {
+    "use speedyjs";
+
+    const array = new Int16Array(8);
+    array.fill(-2.0, 1.0, 4.0);
+    array.reverse();
+
+    return array[6];
+}
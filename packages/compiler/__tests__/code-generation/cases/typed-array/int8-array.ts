@@ -0,0 +1,9 @@
+async function int8Array(): Promise<number> {
+    "use speedyjs";
+
+    const array = new Int8Array(4);
+    array[0] = 200.0;
+    array[1] = -3.0;
+
+    return array[0] + array[1];
+}
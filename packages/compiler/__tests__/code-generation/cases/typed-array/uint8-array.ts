@@ -0,0 +1,10 @@
+async function uint8Array(): Promise<number> {
+    "use speedyjs";
+
+    const array = new Uint8Array(16);
+    for (let i = 0; i < array.length; ++i) {
+        array[i] = (i * 17) as number;
+    }
+
+    return array.slice(15.0)[0];
+}
@@ -0,0 +1,6 @@
+async function typedArrayUnsupportedMethod() {
+    "use speedyjs";
+
+    const array = new Int8Array(4);
+    return array.indexOf(3.0);
+}
@@ -0,0 +1,3 @@
+import {runCases} from "./code-generation-test-case-runner";
+
+runCases("Map", "map");
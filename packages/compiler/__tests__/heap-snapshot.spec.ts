@@ -0,0 +1,128 @@
+import {addHeapSnapshotToWast, changedRanges, escapeWastString} from "../src/code-generation/per-file/heap-snapshot";
+
+describe("HeapSnapshot", () => {
+    const WASM_PAGE_SIZE = 64 * 1024;
+
+    describe("changedRanges", () => {
+        it("returns no ranges if the memory is unchanged", () => {
+            const initial = new Uint8Array([1, 2, 3, 4]);
+
+            expect(changedRanges(initial.slice(), initial, 0, 4)).toEqual([]);
+        });
+
+        it("returns the changed bytes as a single range", () => {
+            const initial = new Uint8Array(16);
+            const memory = initial.slice();
+            memory[4] = 1;
+            memory[5] = 2;
+
+            expect(changedRanges(memory, initial, 0, 16)).toEqual([{ offset: 4, data: new Uint8Array([1, 2]) }]);
+        });
+
+        it("includes small gaps of unchanged bytes in the range", () => {
+            const memory = new Uint8Array(64);
+            memory[2] = 1;
+            memory[10] = 2;
+
+            expect(changedRanges(memory, undefined, 0, 64)).toEqual([{ offset: 2, data: memory.slice(2, 11) }]);
+        });
+
+        it("starts a new range if the gap of unchanged bytes is too large", () => {
+            const memory = new Uint8Array(128);
+            memory[2] = 1;
+            memory[100] = 2;
+
+            expect(changedRanges(memory, undefined, 0, 128)).toEqual([
+                { offset: 2, data: new Uint8Array([1]) },
+                { offset: 100, data: new Uint8Array([2]) }
+            ]);
+        });
+
+        it("compares the memory with zero if no initial memory is given", () => {
+            const memory = new Uint8Array([0, 0, 7, 0]);
+
+            expect(changedRanges(memory, undefined, 0, 4)).toEqual([{ offset: 2, data: new Uint8Array([7]) }]);
+        });
+
+        it("only compares the bytes in between start and end", () => {
+            const memory = new Uint8Array([1, 0, 0, 0, 1]);
+
+            expect(changedRanges(memory, undefined, 1, 4)).toEqual([]);
+        });
+    });
+
+    describe("escapeWastString", () => {
+        it("writes printable ascii characters as is", () => {
+            expect(escapeWastString(new Uint8Array([0x61, 0x42, 0x20, 0x7e]))).toBe("aB ~");
+        });
+
+        it("escapes quotes and backslashes", () => {
+            expect(escapeWastString(new Uint8Array([0x22, 0x5c]))).toBe("\\22\\5c");
+        });
+
+        it("escapes non printable characters as two digit hex sequence", () => {
+            expect(escapeWastString(new Uint8Array([0x00, 0x0a, 0x7f, 0xff]))).toBe("\\00\\0a\\7f\\ff");
+        });
+    });
+
+    describe("addHeapSnapshotToWast", () => {
+        const wast = [
+            "(module",
+            ` (import "env" "memory" (memory $0 256))`,
+            ` (data (i32.const 1024) "abc")`,
+            ` (export "f" (func $f))`,
+            ")",
+            `;; METADATA: { "asmConsts": {},"staticBump": 1040, "initializers": [] }`,
+            ""
+        ].join("\n");
+
+        it("adds the segments after the data segments of the module", () => {
+            const segments = [
+                { offset: 1024, data: new Uint8Array([0x78]) },
+                { offset: 2048, data: new Uint8Array([0x00, 0x22]) }
+            ];
+
+            const result = addHeapSnapshotToWast(wast, { memorySize: 256 * WASM_PAGE_SIZE, results: {} }, segments);
+
+            expect(result).toBe([
+                "(module",
+                ` (import "env" "memory" (memory $0 256))`,
+                ` (data (i32.const 1024) "abc")`,
+                ` (export "f" (func $f))`,
+                ` (data (i32.const 1024) "x")`,
+                ` (data (i32.const 2048) "\\00\\22")`,
+                ")",
+                `;; METADATA: { "asmConsts": {},"staticBump": 1040, "initializers": [] }`,
+                ""
+            ].join("\n"));
+        });
+
+        it("adds the segments at the end of the module if the wast file has no meta data", () => {
+            const result = addHeapSnapshotToWast("(module\n)\n", { memorySize: WASM_PAGE_SIZE, results: {} }, [
+                { offset: 16, data: new Uint8Array([0x61]) }
+            ]);
+
+            expect(result).toBe(`(module\n (data (i32.const 16) "a")\n)\n`);
+        });
+
+        it("grows the initial size of the imported memory to the size of the snapshot", () => {
+            const result = addHeapSnapshotToWast(wast, { memorySize: 512 * WASM_PAGE_SIZE, results: {} }, []);
+
+            expect(result).toContain(`(import "env" "memory" (memory $0 512))`);
+        });
+
+        it("does not shrink the initial size of the imported memory", () => {
+            const result = addHeapSnapshotToWast(wast, { memorySize: 16 * WASM_PAGE_SIZE, results: {} }, []);
+
+            expect(result).toContain(`(import "env" "memory" (memory $0 256))`);
+        });
+
+        it("only changes the size of the memory imported from env", () => {
+            const otherImport = wast.replace(`(import "env" "memory"`, `(import "other" "memory"`);
+
+            const result = addHeapSnapshotToWast(otherImport, { memorySize: 512 * WASM_PAGE_SIZE, results: {} }, []);
+
+            expect(result).toContain(`(import "other" "memory" (memory $0 256))`);
+        });
+    });
+});
@@ -0,0 +1,583 @@
+import * as fs from "fs";
+import * as path from "path";
+import * as tmp from "tmp";
+import * as ts from "typescript";
+import {Compiler} from "../src/compiler";
+import {initializeCompilerOptions, UninitializedSpeedyJSCompilerOptions} from "../src/speedyjs-compiler-options";
+import {formatDiagnostics} from "../src/util/diagnostics";
+
+describe("ModuleLoader", () => {
+    let directory: { name: string, removeCallback: () => void };
+
+    beforeEach(() => {
+        directory = tmp.dirSync({ unsafeCleanup: true });
+    });
+
+    afterEach(() => {
+        directory.removeCallback();
+    });
+
+    describe("snapshotResult", () => {
+        const snapshotSource = `
+        export async function createSquares(): Promise<int[]> {
+            "use speedyjs";
+
+            const squares = new Array<int>();
+            for (let i = 0; i < 10; ++i) {
+                squares.push(i * i);
+            }
+            return squares;
+        }
+
+        export async function answer(): Promise<int> {
+            "use speedyjs";
+
+            return 42;
+        }`;
+
+        it("returns the result of the snapshot function computed at build time", () => {
+            const compiled = compileModule(snapshotSource, { snapshotFunctions: ["module.ts:createSquares", "module.ts:answer"] });
+
+            return Promise.all([compiled.createSquares(), compiled.answer()]).then(([squares, answer]) => {
+                expect(squares).toEqual([0, 1, 4, 9, 16, 25, 36, 49, 64, 81]);
+                expect(answer).toBe(42);
+            });
+        });
+
+        it("returns the same object for every call of the snapshot function", () => {
+            const compiled = compileModule(snapshotSource, { snapshotFunctions: ["module.ts:createSquares"] });
+
+            return Promise.all([compiled.createSquares(), compiled.createSquares()]).then(([first, second]) => {
+                expect(first).toBe(second);
+            });
+        });
+    });
+
+    describe("Map and Set", () => {
+        const mapSource = `
+        export async function squareValues(values: Map<int, number>): Promise<Map<int, number>> {
+            "use speedyjs";
+
+            const squares = new Map<int, number>();
+            for (let i = 0; i < 10; ++i) {
+                if (values.has(i)) {
+                    squares.set(i, values.get(i) * values.get(i));
+                }
+            }
+            return squares;
+        }
+
+        export async function identity(values: Map<int, number>): Promise<Map<int, number>> {
+            "use speedyjs";
+
+            return values;
+        }
+
+        export async function addHalf(values: Set<number>): Promise<Set<number>> {
+            "use speedyjs";
+
+            values.add(0.5);
+            values.delete(2.5);
+            return values;
+        }`;
+
+        let compiled: any;
+
+        beforeEach(() => {
+            compiled = compileModule(mapSource);
+        });
+
+        it("passes a Map<int, number> to WASM and returns it to JS", () => {
+            return compiled.identity(new Map([[3, 1.5], [1, -2.25], [7, 8]])).then((result: Map<number, number>) => {
+                expect(result instanceof Map).toBe(true);
+                expect(Array.from(result.entries())).toEqual([[3, 1.5], [1, -2.25], [7, 8]]);
+            });
+        });
+
+        it("looks up the entries of a Map passed from JS in WASM", () => {
+            return compiled.squareValues(new Map([[2, 1.5], [5, 3]])).then((result: Map<number, number>) => {
+                expect(Array.from(result.entries())).toEqual([[2, 2.25], [5, 9]]);
+            });
+        });
+
+        it("passes a Set<number> to WASM and returns it to JS", () => {
+            return compiled.addHalf(new Set([1.5, 2.5, -0, NaN])).then((result: Set<number>) => {
+                expect(result instanceof Set).toBe(true);
+                expect(result.size).toBe(4);
+                expect(result.has(1.5)).toBe(true);
+                expect(result.has(2.5)).toBe(false);
+                expect(result.has(0)).toBe(true);
+                expect(result.has(NaN)).toBe(true);
+                expect(result.has(0.5)).toBe(true);
+            });
+        });
+    });
+
+    describe("typed arrays", () => {
+        const typedArraySource = `
+        export async function scaleFloat32(values: Float32Array, factor: number): Promise<Float32Array> {
+            "use speedyjs";
+
+            for (let i = 0; i < values.length; ++i) {
+                values[i] = values[i] * factor;
+            }
+            return values;
+        }
+
+        export async function reverseInt8(values: Int8Array): Promise<Int8Array> {
+            "use speedyjs";
+
+            return values.reverse();
+        }
+
+        export async function sortInt16(values: Int16Array): Promise<Int16Array> {
+            "use speedyjs";
+
+            return values.sort();
+        }
+
+        export async function incrementUint8(values: Uint8Array): Promise<Uint8Array> {
+            "use speedyjs";
+
+            for (let i = 0; i < values.length; ++i) {
+                values[i] = values[i] + 1.0;
+            }
+            return values;
+        }`;
+
+        let compiled: any;
+
+        beforeEach(() => {
+            compiled = compileModule(typedArraySource);
+        });
+
+        it("passes a Float32Array to WASM and returns a copy of the elements", () => {
+            const values = new Float32Array([1.5, -2, 0.1]);
+
+            return compiled.scaleFloat32(values, 2).then((result: Float32Array) => {
+                expect(result instanceof Float32Array).toBe(true);
+                expect(Array.from(result)).toEqual(Array.from(new Float32Array([3, -4, 0.2])));
+                // the passed array is copied to WASM
+                expect(values[0]).toBe(1.5);
+            });
+        });
+
+        it("passes an Int8Array to WASM and returns it to JS", () => {
+            return compiled.reverseInt8(new Int8Array([-128, 0, 127])).then((result: Int8Array) => {
+                expect(result instanceof Int8Array).toBe(true);
+                expect(Array.from(result)).toEqual([127, 0, -128]);
+            });
+        });
+
+        it("passes an Int16Array to WASM and returns it to JS", () => {
+            return compiled.sortInt16(new Int16Array([300, -32768, 7, 32767])).then((result: Int16Array) => {
+                expect(result instanceof Int16Array).toBe(true);
+                expect(Array.from(result)).toEqual([-32768, 7, 300, 32767]);
+            });
+        });
+
+        it("wraps the elements of an Uint8Array around like JS", () => {
+            return compiled.incrementUint8(new Uint8Array([0, 254, 255])).then((result: Uint8Array) => {
+                expect(result instanceof Uint8Array).toBe(true);
+                expect(Array.from(result)).toEqual([1, 255, 0]);
+            });
+        });
+
+        it("rejects the call if the argument is not a typed array of the declared type", () => {
+            return compiled.reverseInt8(new Uint8Array([1, 2])).then(() => fail("Expected the call to fail"), (error: Error) => {
+                expect(error.message).toMatch(/Expected argument of type/);
+            });
+        });
+    });
+
+    describe("lazyResults", () => {
+        const lazySource = `
+        export async function range(size: int): Promise<int[]> {
+            "use speedyjs";
+
+            const result = new Array<int>();
+            for (let i = 0; i < size; ++i) {
+                result.push(i);
+            }
+            return result;
+        }`;
+
+        let compiled: any;
+
+        beforeEach(() => {
+            compiled = compileModule(lazySource, { lazyResults: true });
+        });
+
+        it("returns an array view that can be used like an array", () => {
+            return compiled.range(3).then((view: number[]) => {
+                expect(Array.isArray(view)).toBe(true);
+                expect(view.length).toBe(3);
+                expect(view[1]).toBe(1);
+                expect(Array.from(view)).toEqual([0, 1, 2]);
+                expect(JSON.stringify(view)).toBe("[0,1,2]");
+            });
+        });
+
+        it("lists the elements of the array view as own properties", () => {
+            return compiled.range(3).then((view: number[]) => {
+                expect(Object.keys(view)).toEqual(["0", "1", "2"]);
+                expect(Object.getOwnPropertyNames(view)).toEqual(["0", "1", "2", "length"]);
+                expect(view.hasOwnProperty(2)).toBe(true);
+                expect(view.hasOwnProperty(3)).toBe(false);
+                expect(Object.getOwnPropertyDescriptor(view, "1")).toEqual({ value: 1, writable: false, enumerable: true, configurable: true });
+                expect(Object.assign({}, view)).toEqual({ 0: 0, 1: 1, 2: 2 });
+            });
+        });
+
+        it("does not allow to change the array view", () => {
+            return compiled.range(3).then((view: number[]) => {
+                expect(() => view[0] = 10).toThrowError("Lazy results are read only");
+            });
+        });
+
+        it("throws if the array view is used after the heap has been released", () => {
+            return compiled.range(3).then((view: number[]) => {
+                // the next call releases the heap of the previous call
+                return compiled.range(2).then((current: number[]) => {
+                    expect(current.length).toBe(2);
+                    expect(() => view.length).toThrowError(/The lazy result is no longer valid/);
+                    expect(() => view[0]).toThrowError(/The lazy result is no longer valid/);
+                    expect(() => Object.keys(view)).toThrowError(/The lazy result is no longer valid/);
+                });
+            });
+        });
+    });
+
+    describe("retain", () => {
+        const retainSource = `
+        export class Point {
+            x: number;
+            y: number;
+        }
+
+        export async function moveX(point: Point): Promise<void> {
+            "use speedyjs";
+
+            point.x += 1.0;
+        }
+
+        export async function moveAllX(points: Point[]): Promise<void> {
+            "use speedyjs";
+
+            for (let i = 0; i < points.length; ++i) {
+                points[i].x += 1.0;
+            }
+        }
+
+        export async function sumX(points: Point[]): Promise<number> {
+            "use speedyjs";
+
+            let sum = 0.0;
+            for (let i = 0; i < points.length; ++i) {
+                sum += points[i].x;
+            }
+            return sum;
+        }`;
+
+        let compiled: any;
+
+        beforeEach(() => {
+            compiled = compileModule(retainSource, { exportRetain: true });
+        });
+
+        function createPoints() {
+            return [1, 2].map(x => {
+                const point = new compiled.Point();
+                point.x = x;
+                point.y = 0;
+                return point;
+            });
+        }
+
+        it("passes the retained WASM object to later calls without converting the value again", () => {
+            const points = compiled.speedyJsRetain(createPoints());
+
+            return compiled.moveAllX(points)
+                .then(() => compiled.moveAllX(points))
+                .then(() => compiled.sumX(points))
+                .then((sum: number) => {
+                    expect(sum).toBe(7);
+                    // changes of the WASM code are not visible to the JS value
+                    expect(points[0].x).toBe(1);
+                });
+        });
+
+        it("converts the value again if it is passed after it has been released", () => {
+            const points = compiled.speedyJsRetain(createPoints());
+
+            return compiled.moveAllX(points)
+                .then(() => compiled.speedyJsRelease(points))
+                .then(() => compiled.sumX(points))
+                .then((sum: number) => expect(sum).toBe(3));
+        });
+
+        it("shares a nested retained value with the retained value that references it", () => {
+            const points = compiled.speedyJsRetain(createPoints());
+            const first = compiled.speedyJsRetain(points[0]);
+
+            return compiled.sumX(points)
+                .then(() => compiled.moveX(first))
+                .then(() => compiled.sumX(points))
+                .then((sum: number) => expect(sum).toBe(4));
+        });
+
+        it("keeps a released nested value alive while a retained value references it", () => {
+            const points = compiled.speedyJsRetain(createPoints());
+            const first = compiled.speedyJsRetain(points[0]);
+
+            return compiled.sumX(points)
+                .then(() => compiled.moveX(first))
+                .then(() => compiled.speedyJsRelease(first))
+                .then(() => compiled.sumX(points))
+                .then((sum: number) => expect(sum).toBe(4))
+                .then(() => compiled.speedyJsRelease(points))
+                .then(() => compiled.sumX(points))
+                .then((sum: number) => expect(sum).toBe(3));
+        });
+    });
+
+    describe("value arrays", () => {
+        const valueArraySource = `
+        class Point {
+            x: number;
+            y: number;
+
+            constructor(x: number, y: number) {
+                this.x = x;
+                this.y = y;
+            }
+        }
+
+        export async function createPoints(count: int): Promise<Point[]> {
+            "use speedyjs";
+
+            const points = new Array<Point>();
+            for (let i = 0; i < count; ++i) {
+                points.push(new Point(i, 2.0 * i));
+            }
+            return points;
+        }
+
+        export async function shift(points: Point[], dx: number): Promise<Point[]> {
+            "use speedyjs";
+
+            for (let i = 0; i < points.length; ++i) {
+                points[i].x += dx;
+            }
+            points.push(new Point(10, 20));
+            return points;
+        }
+
+        export async function shiftAll(xs: number[], dx: number): Promise<number[]> {
+            const points = await shift(xs.map(x => new Point(x, 2 * x)), dx);
+            const sums: number[] = [];
+
+            for (let i = 0; i < points.length; ++i) {
+                sums.push(points[i].x + points[i].y);
+            }
+            return sums;
+        }`;
+
+        let compiled: any;
+
+        beforeEach(() => {
+            compiled = compileModule(valueArraySource, { valueArrays: true });
+        });
+
+        it("returns the objects stored inline in an array of a value class", () => {
+            return compiled.createPoints(3).then((points: any[]) => {
+                expect(points.length).toBe(3);
+                expect(points.every(point => point.constructor.name === "Point")).toBe(true);
+                expect(points.map(point => [point.x, point.y])).toEqual([[0, 0], [1, 2], [2, 4]]);
+            });
+        });
+
+        it("copies the objects of an array of a value class to WASM and back", () => {
+            return compiled.shiftAll([1, 2], 0.5).then((sums: number[]) => {
+                expect(sums).toEqual([3.5, 6.5, 30]);
+            });
+        });
+
+        it("returns an empty array of a value class", () => {
+            return compiled.createPoints(0).then((points: any[]) => {
+                expect(points).toEqual([]);
+            });
+        });
+    });
+
+    describe("compiled module", () => {
+        const fibSource = `
+        export async function fib(value: int): Promise<int> {
+            "use speedyjs";
+
+            return value <= 2 ? 1 : await fib(value - 2) + await fib(value - 1);
+        }`;
+
+        it("shares the compiled module between the loaders of the same wasm file", () => {
+            const first = compileModule(fibSource);
+            const second = requireCompiledModule(path.join(directory.name, "module.js"));
+
+            return Promise.all([first.fib(10), second.fib(11)]).then(([firstResult, secondResult]) => {
+                expect(firstResult).toBe(55);
+                expect(secondResult).toBe(89);
+            });
+        });
+    });
+
+    describe("workers", () => {
+        const threads = require("worker_threads");
+        const OriginalWorker = threads.Worker;
+
+        const fibSource = `
+        export async function fib(value: int): Promise<int> {
+            "use speedyjs";
+
+            return value <= 2 ? 1 : await fib(value - 2) + await fib(value - 1);
+        }`;
+
+        afterEach(() => {
+            threads.Worker = OriginalWorker;
+        });
+
+        /**
+         * Replaces the node worker with a worker that terminates instead of executing the n-th task
+         */
+        function terminateWorkersOnTask(n: number) {
+            threads.Worker = function(code: string, workerOptions: any) {
+                const worker = new OriginalWorker(code, workerOptions);
+                const postMessage = worker.postMessage;
+                let tasks = 0;
+
+                worker.postMessage = function(message: any) {
+                    if (++tasks === n) {
+                        worker.terminate();
+                    } else {
+                        postMessage.call(worker, message);
+                    }
+                };
+
+                return worker;
+            };
+        }
+
+        it("executes the calls in node worker threads", () => {
+            const compiled = compileModule(fibSource, { workers: 2 });
+
+            return Promise.all([compiled.fib(10), compiled.fib(11), compiled.fib(12)]).then(results => {
+                expect(results).toEqual([55, 89, 144]);
+            });
+        });
+
+        it("passes maps to the workers and returns maps from the workers", () => {
+            const compiled = compileModule(`
+            export async function squareValues(values: Map<int, number>): Promise<Map<int, number>> {
+                "use speedyjs";
+
+                const squares = new Map<int, number>();
+                for (let i = 0; i < 10; ++i) {
+                    if (values.has(i)) {
+                        squares.set(i, values.get(i) * values.get(i));
+                    }
+                }
+                return squares;
+            }`, { workers: 2 });
+
+            return Promise.all([
+                compiled.squareValues(new Map([[1, 1.5], [3, 2]])),
+                compiled.squareValues(new Map([[2, -3]]))
+            ]).then(([first, second]: Array<Map<number, number>>) => {
+                expect(first instanceof Map).toBe(true);
+                expect(Array.from(first.entries())).toEqual([[1, 2.25], [3, 4]]);
+                expect(Array.from(second.entries())).toEqual([[2, 9]]);
+            });
+        });
+
+        it("rejects the call with the type of the error thrown in the worker", () => {
+            const compiled = compileModule(`
+            export async function arraySet(array: int[], index: int, value: int): Promise<int[]> {
+                "use speedyjs";
+
+                array[index] = value;
+                return array;
+            }`, { workers: 1, unsafe: false });
+
+            return compiled.arraySet([1, 2], 10, 3).then(() => fail("Expected the call to fail"), (error: Error) => {
+                expect(error).toEqual(jasmine.any(RangeError));
+                expect(error.message).toBe("Invalid array index");
+            });
+        });
+
+        it("rejects the task of a worker that stopped", () => {
+            terminateWorkersOnTask(2);
+            const compiled = compileModule(fibSource, { workers: 1 });
+
+            return compiled.fib(10).then((result: number) => {
+                expect(result).toBe(55);
+                return compiled.fib(11).then(() => fail("Expected the call to fail"), (error: Error) => {
+                    expect(error.message).toMatch(/The worker stopped with exit code/);
+                });
+            });
+        });
+
+        it("replaces a worker that stopped after it completed tasks", () => {
+            terminateWorkersOnTask(2);
+            const compiled = compileModule(fibSource, { workers: 1 });
+
+            return compiled.fib(10)
+                .then(() => Promise.all([compiled.fib(11).catch((error: Error) => error), compiled.fib(12)]))
+                .then(([error, result]) => {
+                    expect(error).toEqual(jasmine.any(Error));
+                    // the queued call is executed by the replacement worker
+                    expect(result).toBe(144);
+                });
+        });
+
+        it("executes the calls on the calling thread if a worker stops before it completed a task", () => {
+            terminateWorkersOnTask(1);
+            const compiled = compileModule(fibSource, { workers: 1 });
+
+            return compiled.fib(10)
+                .then(() => fail("Expected the call to fail"), (error: Error) => expect(error.message).toMatch(/The worker stopped/))
+                .then(() => compiled.fib(11))
+                .then((result: number) => expect(result).toBe(89));
+        });
+    });
+
+    /**
+     * Compiles the source code to a module in the temporary directory and loads the compiled module
+     */
+    function compileModule(sourceCode: string, options: UninitializedSpeedyJSCompilerOptions = {}): any {
+        const fileName = path.join(directory.name, "module.ts");
+        fs.writeFileSync(fileName, sourceCode);
+
+        const compilerOptions = initializeCompilerOptions(Object.assign({
+            target: ts.ScriptTarget.ES2015,
+            module: ts.ModuleKind.CommonJS,
+            types: []
+        }, options));
+        const compilerHost = ts.createCompilerHost(compilerOptions);
+        const { diagnostics } = new Compiler(compilerOptions, compilerHost).compile([fileName]);
+
+        expect(formatDiagnostics(diagnostics)).toBe("");
+        return requireCompiledModule(path.join(directory.name, "module.js"));
+    }
+
+    /**
+     * Loads the module with the node module system (instead of jest) as the module loader requires node modules
+     * using module.require
+     */
+    function requireCompiledModule(fileName: string) {
+        const NodeModule = require("module");
+        const compiledModule = new NodeModule(fileName, module);
+        compiledModule.filename = fileName;
+        compiledModule.paths = NodeModule._nodeModulePaths(path.dirname(fileName));
+        compiledModule._compile(fs.readFileSync(fileName, "utf-8"), fileName);
+
+        return compiledModule.exports;
+    }
+});
@@ -57,6 +57,62 @@ describe("Transformation", () => {
         expectCompiledJSOutputMatchesSnapshot(fibSourceCode, "transform/fib.ts", { exportGc: true });
     });
 
+    it("includes the module loader in the emitted JavaScript", () => {
+        const result = compileSourceCode(fibSourceCode, "transform/fib.ts", createCompilerOptions());
+
+        expect(formatDiagnostics(result.diagnostics)).toBe("");
+        expect(result.js).toContain("function __moduleLoader(wasmUri, options) {");
+        expect(result.js).toMatch(/\nvar loadWasmModule_\d+ = __moduleLoader\("\.\/fib\.wasm", {/);
+    });
+
+    it("calls the gc before the function and returns lazy results if lazyResults is set", () => {
+        const compilerOptions = createCompilerOptions({ lazyResults: true });
+        const result = compileSourceCode(`
+        async function squares(count: int): Promise<int[]> {
+            "use speedyjs";
+
+            const result: int[] = [];
+            for (let i = 0; i < count; ++i) {
+                result.push(i * i);
+            }
+            return result;
+        }`, "transform/lazy-results.ts", compilerOptions);
+
+        expect(formatDiagnostics(result.diagnostics)).toBe("");
+        expect(result.exitStatus).toBe(ts.ExitStatus.Success);
+        expect(withoutModuleLoader(result.js)).toMatchSnapshot();
+        expect(result.js).toMatch(/\.gc\(\); var result_\d+ = loadWasmModule_\d+\.toLazyJSObject\(/);
+    });
+
+    it("calls the entry function in a worker if workers is set", () => {
+        const result = compileSourceCode(fibSourceCode, "transform/fib.ts", createCompilerOptions({ workers: 2 }));
+
+        expect(formatDiagnostics(result.diagnostics)).toBe("");
+        expect(withoutModuleLoader(result.js)).toMatchSnapshot();
+        expect(result.js).toContain(`"workers": 2`);
+        expect(result.js).toMatch(/return loadWasmModule_\d+\.callInWorker\("_fib", \[value\], \["i32"\], "i32", types_\d+\);/);
+    });
+
+    it("returns the result of the execution at build time for the snapshot functions", () => {
+        const compilerOptions = createCompilerOptions({ snapshotFunctions: ["snapshot.ts:createSquares"] });
+        const result = compileSourceCode(`
+        export async function createSquares(): Promise<int[]> {
+            "use speedyjs";
+
+            const squares: int[] = [];
+            for (let i = 0; i < 10; ++i) {
+                squares.push(i * i);
+            }
+            return squares;
+        }`, "transform/snapshot.ts", compilerOptions);
+
+        expect(formatDiagnostics(result.diagnostics)).toBe("");
+        expect(result.exitStatus).toBe(ts.ExitStatus.Success);
+        expect(withoutModuleLoader(result.js)).toMatchSnapshot();
+        expect(result.js).toMatch(/return loadWasmModule_\d+\.snapshotResult\("_createSquares", "Array<i32>", types_\d+\);/);
+        expect(result.js).toContain(`"snapshotResults": { "_createSquares": `);
+    });
+
     it("casts the return value for boolean functions to a bool value", () => {
         expectCompiledJSOutputMatchesSnapshot(`
         async function isTruthy(value: int) {
@@ -119,6 +175,83 @@ describe("Transformation", () => {
         `, "transform/converts-arrays-and-object.ts");
     });
 
+    it("imports the module loader from the program loader module if wholeProgram is set", () => {
+        const compilerOptions = createCompilerOptions({ wholeProgram: true });
+        const result = compileSourceCode(`
+        export async function fib(value: int): Promise<int> {
+            "use speedyjs";
+
+            if (value <= 2) {
+                return 1;
+            }
+
+            return await fib(value - 2) + await fib(value - 1);
+        }`, "transform/whole-program.ts", compilerOptions);
+
+        expect(formatDiagnostics(result.diagnostics)).toBe("");
+        expect(result.exitStatus).toBe(ts.ExitStatus.Success);
+        expect(withoutModuleLoader(result.js)).toMatchSnapshot();
+        expect(result.programLoader).toContain("function __moduleLoader(wasmUri, options) {");
+        expect(result.programLoader).toMatch(/\nexport var loadWasmModule = __moduleLoader\(/);
+    });
+
+    it("exports a batch function for an exported entry function if batchEntryFunctions is set", () => {
+        const compilerOptions = createCompilerOptions({ batchEntryFunctions: true, declaration: true });
+        const result = compileSourceCode(`
+        export default async function isPrime(value: int): Promise<boolean> {
+            "use speedyjs";
+
+            for (let i = 2; i <= (Math.sqrt(value)|0); ++i) {
+                if (value % i === 0) {
+                    return false;
+                }
+            }
+            return value > 1;
+        }`, "transform/batch.ts", compilerOptions);
+
+        expect(formatDiagnostics(result.diagnostics)).toBe("");
+        expect(result.exitStatus).toBe(ts.ExitStatus.Success);
+        expect(withoutModuleLoader(result.js)).toMatchSnapshot();
+        expect(result.js).toMatch(/\nexport function isPrimeBatch\(argumentTuples\) {/);
+        expect(result.declaration).toContain("export declare function isPrimeBatch(argumentTuples: Array<[int]>): Promise<boolean[]>;");
+    });
+
+    it("does not create a batch function for an entry function that is not exported", () => {
+        const compilerOptions = createCompilerOptions({ batchEntryFunctions: true });
+        const result = compileSourceCode(`
+        export const answer = 42;
+
+        async function fib(value: int): Promise<int> {
+            "use speedyjs";
+
+            return value <= 2 ? 1 : await fib(value - 2) + await fib(value - 1);
+        }`, "transform/batch-not-exported.ts", compilerOptions);
+
+        expect(formatDiagnostics(result.diagnostics)).toBe("");
+        expect(result.exitStatus).toBe(ts.ExitStatus.Success);
+        expect(result.js).not.toContain("fibBatch");
+    });
+
+    it("emits a diagnostic if the name of the batch function is already declared in the source file", () => {
+        const compilerOptions = createCompilerOptions({ batchEntryFunctions: true });
+        const source = `
+        export async function fib(value: int): Promise<int> {
+            "use speedyjs";
+
+            return value <= 2 ? 1 : await fib(value - 2) + await fib(value - 1);
+        }
+
+        export function fibBatch(values: int[]) {
+            return Promise.all(values.map(fib));
+        }
+        `;
+
+        const {exitStatus, diagnostics } = compileSourceCode(source, "test.ts", compilerOptions);
+
+        expect(exitStatus).toBe(ts.ExitStatus.DiagnosticsPresent_OutputsSkipped);
+        expect(formatDiagnostics(diagnostics)).toMatchSnapshot();
+    });
+
     it("emits a diagnostic if a non entry speedyjs function is referenced from normal JavaScriptCode", () => {
         const compilerOptions = createCompilerOptions();
         const source = `
@@ -258,6 +391,38 @@ describe("Transformation", () => {
         expect(formatDiagnostics(diagnostics)).toMatchSnapshot();
     });
 
+    it("emits a diagnostic if wholeProgram is set and an entry function is declared outside of a module", () => {
+        const compilerOptions = createCompilerOptions({ wholeProgram: true });
+        const source = `
+        async function fib(value: int): Promise<int> {
+            "use speedyjs";
+
+            return value <= 2 ? 1 : await fib(value - 2) + await fib(value - 1);
+        }
+        `;
+
+        const {exitStatus, diagnostics } = compileSourceCode(source, "test.ts", compilerOptions);
+
+        expect(exitStatus).toBe(ts.ExitStatus.DiagnosticsPresent_OutputsSkipped);
+        expect(formatDiagnostics(diagnostics)).toMatchSnapshot();
+    });
+
+    it("emits a diagnostic if a snapshot function is not qualified by the name of its source file", () => {
+        const compilerOptions = createCompilerOptions({ snapshotFunctions: ["createTable"] });
+        const source = `
+        export async function createTable(): Promise<int[]> {
+            "use speedyjs";
+
+            return [1, 2, 3];
+        }
+        `;
+
+        const {exitStatus, diagnostics } = compileSourceCode(source, "test.ts", compilerOptions);
+
+        expect(exitStatus).toBe(ts.ExitStatus.DiagnosticsPresent_OutputsSkipped);
+        expect(formatDiagnostics(diagnostics)).toMatchSnapshot();
+    });
+
     function expectCompiledJSOutputMatchesSnapshot(sourceCode: string, fileName: string, compilerOptions?: UninitializedSpeedyJSCompilerOptions) {
         compilerOptions = createCompilerOptions(compilerOptions);
         const result = compileSourceCode(sourceCode, fileName, compilerOptions);
@@ -268,7 +433,15 @@ describe("Transformation", () => {
         }
 
         expect(result.exitStatus).toBe(ts.ExitStatus.Success);
-        expect(result.js).toMatchSnapshot();
+        expect(withoutModuleLoader(result.js)).toMatchSnapshot();
+    }
+
+    /**
+     * Removes the emitted __moduleLoader function from the output. The snapshots would otherwise include the whole
+     * loader source and are outdated by every change to the loader
+     */
+    function withoutModuleLoader(js: string | undefined) {
+        return js!.replace(/\/\*\*\n \* This file includes a single statement[\s\S]*?\/\/# sourceMappingURL=get-wasm-module-function\.js\.map\n/, "");
     }
 
     function createCompilerOptions(options?: ts.CompilerOptions) {
@@ -24,7 +24,19 @@ interface CommandLineArguments {
     disableHeapNukeOnExit?: boolean;
     exposeGc?: boolean;
     exportGc?: boolean;
+    exportArrayAllocator?: boolean;
+    exportRetain?: boolean;
+    lazyResults?: boolean;
+    workers?: number;
+    arenaAllocator?: boolean;
+    simd?: boolean;
+    instrumentRuntime?: boolean;
+    batchEntryFunctions?: boolean;
+    valueArrays?: boolean;
+    snapshotFunctions?: string[];
     optimizationLevel?: "0" | "1" | "2" | "3" | "z" | "s";
+    wholeProgram?: boolean;
+    buildCache?: string;
     settings: {
         INITIAL_MEMORY?: number;
         TOTAL_STACK?: number;
@@ -53,8 +65,20 @@ function parseCommandLine(): CommandLineArguments {
         .option("--binaryen-opt", "Optimize using Binaryen opt")
         .option("--expose-gc", "Exposes the speedy js garbage collector in the module as speedyJsGc")
         .option("--export-gc", "Exposes and exports the speedy js garbage collector as the symbol speedyJsGc")
+        .option("--export-array-allocator", "Exports speedyJsAllocateArray and speedyJsReleaseArray to allocate arrays in the WASM memory that are passed without copying")
+        .option("--export-retain", "Exports speedyJsRetain and speedyJsRelease to keep objects and arrays in the WASM memory across calls")
+        .option("--workers <count>", "Executes the calls of entry functions with primitive, array, map and set arguments in a pool of the given number of workers", (value: string) => parseInt(value, 10))
+        .option("--lazy-results", "Returns lazy views of the returned objects and arrays that decode the fields on access (the views are valid until the next call)")
         .option("--disable-heap-nuke-on-exit", "Disables nuking of the heap before to the exit of the entry function (it's your responsible for calling the GC in this case!)")
+        .option("--arena-allocator", "Use the runtime variant that allocates from an arena (bump allocator) that is reset by the gc")
+        .option("--simd", "Use the runtime variant that uses WebAssembly SIMD (simd128) for bulk array operations and enable simd128 code generation")
+        .option("--instrument-runtime", "Use the runtime variant that counts the array allocations and gc calls, read by the runtimeStatistics function of the loader")
+        .option("--batch-entry-functions", "Generates a fnBatch(argumentTuples) function for each entry function with primitive parameters that performs all calls in a single WASM call")
+        .option("--value-arrays", "Stores the elements of arrays of value classes (classes with primitive fields whose array elements are never used by identity) inline")
+        .option("--snapshot-functions <names>", "Executes the given comma separated parameterless entry functions (file:name, the file relative to the root directory) at build time and stores the initialized heap in the WASM file", (value: string) => value.split(","))
         .option("--optimization-level [value]", "The optimization level to use. One of the following values: '0, 1, 2, 3, s or z'")
+        .option("--whole-program", "Compiles the speedy js functions of all source files into a single WASM module loaded by speedyjs-program.js")
+        .option("--build-cache <directory>", "Caches the outputs of the external tools in the given directory and reuses them for unchanged source files")
         .option("-s --settings [value]", "additional settings", parseSettings, {})
         .parse(process.argv);
     // tslint:enable:max-line-length
@@ -102,8 +126,20 @@ function getCompilerOptions(commandLine: CommandLineArguments, tsConfigFileName:
     compilerOptions.totalStack = commandLine.settings.TOTAL_STACK;
     compilerOptions.exposeGc = commandLine.exposeGc;
     compilerOptions.exportGc = commandLine.exportGc;
+    compilerOptions.exportArrayAllocator = commandLine.exportArrayAllocator;
+    compilerOptions.exportRetain = commandLine.exportRetain;
     compilerOptions.disableHeapNukeOnExit = commandLine.disableHeapNukeOnExit;
+    compilerOptions.lazyResults = commandLine.lazyResults;
+    compilerOptions.workers = commandLine.workers;
+    compilerOptions.arenaAllocator = commandLine.arenaAllocator;
+    compilerOptions.simd = commandLine.simd;
+    compilerOptions.instrumentRuntime = commandLine.instrumentRuntime;
+    compilerOptions.batchEntryFunctions = commandLine.batchEntryFunctions;
+    compilerOptions.valueArrays = commandLine.valueArrays;
+    compilerOptions.snapshotFunctions = commandLine.snapshotFunctions;
     compilerOptions.optimizationLevel = commandLine.optimizationLevel;
+    compilerOptions.wholeProgram = commandLine.wholeProgram;
+    compilerOptions.buildCache = commandLine.buildCache;
 
     return { rootFileNames, compilerOptions: initializeCompilerOptions(compilerOptions) };
 }
@@ -252,6 +252,29 @@ export class CodeGenerationDiagnostics {
     static entryFunctionWithCallbackNotSupported(parameter: ts.ParameterDeclaration) {
         return CodeGenerationDiagnostics.createException(parameter, diagnostics.UnsupportedEntryFunctionWithCallback);
     }
+
+    static unsupportedKeyType(newExpression: ts.NewExpression, className: string, keyType: string) {
+        return CodeGenerationDiagnostics.createException(newExpression, diagnostics.UnsupportedKeyType, keyType, className);
+    }
+
+    static snapshotFunctionWithParameters(functionDeclaration: ts.FunctionDeclaration) {
+        return CodeGenerationDiagnostics.createException(functionDeclaration, diagnostics.SnapshotFunctionWithParameters, functionDeclaration.name!.text);
+    }
+
+    static wholeProgramEntryFunctionOutsideOfModule(functionDeclaration: ts.FunctionDeclaration) {
+        const functionName = functionDeclaration.name!.text;
+        return CodeGenerationDiagnostics.createException(functionDeclaration, diagnostics.WholeProgramEntryFunctionOutsideOfModule, functionName);
+    }
+
+    static unqualifiedSnapshotFunction(functionDeclaration: ts.FunctionDeclaration, qualifiedName: string) {
+        const functionName = functionDeclaration.name!.text;
+        return CodeGenerationDiagnostics.createException(functionDeclaration, diagnostics.UnqualifiedSnapshotFunction, functionName, qualifiedName);
+    }
+
+    static batchFunctionNameCollision(functionDeclaration: ts.FunctionDeclaration, batchFunctionName: string) {
+        const functionName = functionDeclaration.name!.text;
+        return CodeGenerationDiagnostics.createException(functionDeclaration, diagnostics.BatchFunctionNameCollision, batchFunctionName, functionName);
+    }
 }
 
 /* tslint:disable:max-line-length */
@@ -395,5 +418,25 @@ const diagnostics = {
     UnsupportedEntryFunctionWithCallback: {
         message: "Passing callbacks to speedy.js entry functions is not yet supported",
         code: 1000034
+    },
+    UnsupportedKeyType: {
+        message: "The key type '%s' of '%s' is not supported. Only int and number keys are supported.",
+        code: 1000035
+    },
+    SnapshotFunctionWithParameters: {
+        message: "The snapshot function '%s' is executed at build time and therefore cannot have parameters.",
+        code: 1000036
+    },
+    WholeProgramEntryFunctionOutsideOfModule: {
+        message: "The entry function '%s' imports the wasm module of the whole program and therefore needs to be declared in a module (a file with at least one import or export).",
+        code: 1000037
+    },
+    BatchFunctionNameCollision: {
+        message: "The batch function '%s' of the entry function '%s' cannot be created because the source file already declares a value with this name. Either rename the declaration or disable the batchEntryFunctions option.",
+        code: 1000038
+    },
+    UnqualifiedSnapshotFunction: {
+        message: "The snapshot function '%s' needs to be qualified by the path of its source file relative to the root directory ('%s') as entry functions of different source files can have the same name.",
+        code: 1000039
     }
 };
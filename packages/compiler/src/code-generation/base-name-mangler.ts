@@ -47,8 +47,8 @@ export abstract class BaseNameMangler implements NameMangler {
         return this.mangleAccessor(this.encodeName(property.name.text), property, setter);
     }
 
-    mangleIndexer(element: ts.ElementAccessExpression, setter: boolean): string {
-        return this.mangleAccessor(setter ? "set" : "get", element, setter);
+    mangleIndexer(element: ts.ElementAccessExpression, setter: boolean, unchecked = false): string {
+        return this.mangleAccessor((setter ? "set" : "get") + (unchecked ? "Unchecked" : ""), element, setter);
     }
 
     /**
@@ -0,0 +1,122 @@
+import * as crypto from "crypto";
+import * as debug from "debug";
+import * as fs from "fs";
+import * as path from "path";
+import {CompilationContext} from "../compilation-context";
+import {getConfiguration} from "../external-tools/tools";
+
+const LOG = debug("code-generation/build-cache");
+
+// The outputs also depend on the compiler itself (e.g. the default public functions or the passes passed to the tools)
+const COMPILER_VERSION: string = require("../../package.json").version;
+
+/**
+ * Content addressed cache for the files produced by the external tools (llvm-link, opt, llc, s2wasm, wasm-opt, wasm-as).
+ * An entry is keyed by the hash of the input file, the name of the step, the parameters of the step, the version of the
+ * compiler and the used tool chain. The steps of an unchanged source file therefore hit the cache one after the other
+ * and the final wasm file is reused without executing any of the tools.
+ */
+export class BuildCache {
+    private toolchain: string;
+    private fileHashes = new Map<string, string>();
+
+    /**
+     * @param directory the directory where the cached files are stored, created if it does not exist
+     * @param compilerVersion the version of the compiler that produces the entries
+     */
+    constructor(private directory: string, compilerVersion = COMPILER_VERSION) {
+        createDirectory(directory);
+        this.toolchain = JSON.stringify({ compilerVersion, tools: getConfiguration() });
+    }
+
+    /**
+     * Creates the build cache for the compilation
+     * @param compilationContext the compilation context
+     * @return the build cache or undefined if the buildCache option is not set
+     */
+    static create(compilationContext: CompilationContext): BuildCache | undefined {
+        const buildCacheDirectory = compilationContext.compilerOptions.buildCache;
+
+        if (!buildCacheDirectory) {
+            return undefined;
+        }
+
+        return new BuildCache(path.resolve(compilationContext.rootDir, buildCacheDirectory));
+    }
+
+    /**
+     * Computes the key of the output of a step
+     * @param step the name of the step
+     * @param inputFileName the input file of the step
+     * @param parameters the values besides the input file that affect the output (e.g. the optimization level or the
+     * hash of other linked files)
+     * @return the key of the entry
+     */
+    computeKey(step: string, inputFileName: string, parameters: any[]): string {
+        return crypto.createHash("sha256")
+            .update(this.toolchain)
+            .update(step)
+            .update(JSON.stringify(parameters))
+            .update(fs.readFileSync(inputFileName))
+            .digest("hex");
+    }
+
+    /**
+     * Copies the cached file with the given key to the output file
+     * @param key the key of the entry
+     * @param outputFileName the file where the cached content is to be written to
+     * @return true if the cache contains the entry, false otherwise
+     */
+    restore(key: string, outputFileName: string): boolean {
+        const cachedFileName = path.join(this.directory, key);
+
+        if (!fs.existsSync(cachedFileName)) {
+            return false;
+        }
+
+        LOG(`Restore ${outputFileName} from cache entry ${key}`);
+        fs.writeFileSync(outputFileName, fs.readFileSync(cachedFileName));
+        return true;
+    }
+
+    /**
+     * Computes the hash of the content of a file that is not produced by the build (e.g. the runtime). The hash is
+     * computed once per file and modification time.
+     * @param fileName the name of the file
+     * @return the hash of the content
+     */
+    hashFile(fileName: string): string {
+        const hashKey = `${fileName}:${fs.statSync(fileName).mtime.getTime()}`;
+        let hash = this.fileHashes.get(hashKey);
+
+        if (!hash) {
+            hash = crypto.createHash("sha256").update(fs.readFileSync(fileName)).digest("hex");
+            this.fileHashes.set(hashKey, hash);
+        }
+
+        return hash;
+    }
+
+    /**
+     * Stores a copy of the given file in the cache. The entry is written to a temporary file first and then renamed
+     * so that concurrent builds never read a partially written entry.
+     * @param key the key of the entry
+     * @param fileName the file to store
+     */
+    store(key: string, fileName: string): void {
+        const cachedFileName = path.join(this.directory, key);
+        const tempFileName = `${cachedFileName}.${process.pid}.tmp`;
+
+        fs.writeFileSync(tempFileName, fs.readFileSync(fileName));
+        fs.renameSync(tempFileName, cachedFileName);
+    }
+}
+
+function createDirectory(directory: string) {
+    if (fs.existsSync(directory)) {
+        return;
+    }
+
+    createDirectory(path.dirname(directory));
+    fs.mkdirSync(directory);
+}
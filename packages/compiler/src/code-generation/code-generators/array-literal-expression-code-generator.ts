@@ -4,15 +4,15 @@ import {CodeGenerationContext} from "../code-generation-context";
 import {SyntaxCodeGenerator} from "../syntax-code-generator";
 import {getArrayElementType} from "../util/types";
 import {ArrayClassReference} from "../value/array-class-reference";
-import {ArrayReference} from "../value/array-reference";
+import {ObjectReference} from "../value/object-reference";
 
 /**
  * Code Generator for [1, 2, ...] array expressions
  */
-class ArrayLiteralExpressionCodeGenerator implements SyntaxCodeGenerator<ts.ArrayLiteralExpression, ArrayReference> {
+class ArrayLiteralExpressionCodeGenerator implements SyntaxCodeGenerator<ts.ArrayLiteralExpression, ObjectReference> {
     syntaxKind = ts.SyntaxKind.ArrayLiteralExpression;
 
-    generate(arrayLiteral: ts.ArrayLiteralExpression, context: CodeGenerationContext): ArrayReference {
+    generate(arrayLiteral: ts.ArrayLiteralExpression, context: CodeGenerationContext): ObjectReference {
         const type = context.typeChecker.getTypeAtLocation(arrayLiteral);
         const elementType = getArrayElementType(type);
 
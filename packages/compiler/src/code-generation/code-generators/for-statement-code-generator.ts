@@ -3,6 +3,7 @@ import * as ts from "typescript";
 import {CodeGenerationContext} from "../code-generation-context";
 import {SyntaxCodeGenerator} from "../syntax-code-generator";
 import {generateCondition} from "../util/conditions";
+import {generateReservePushHint} from "../util/push-loops";
 
 class ForStatementCodeGenerator implements SyntaxCodeGenerator<ts.ForStatement, void> {
     syntaxKind = ts.SyntaxKind.ForStatement;
@@ -12,6 +13,8 @@ class ForStatementCodeGenerator implements SyntaxCodeGenerator<ts.ForStatement,
             context.generate(forStatement.initializer);
         }
 
+        generateReservePushHint(forStatement, context);
+
         let head: llvm.BasicBlock;
         const fun = context.scope.enclosingFunction;
         const end = llvm.BasicBlock.create(context.llvmContext, "for.end");
@@ -11,7 +11,9 @@ import {DefaultCodeGenerationContext} from "./default-code-generation-context";
 import {FallbackCodeGenerator} from "./fallback-code-generator";
 import {SyntaxCodeGenerator} from "./syntax-code-generator";
 import {ArrayClassReference} from "./value/array-class-reference";
+import {MAP_CLASS_NAMES, MapClassReference} from "./value/map-class-reference";
 import {MathClassReference} from "./value/math-class-reference";
+import {TYPED_ARRAY_NAMES, TypedArrayClassReference} from "./value/typed-array-class-reference";
 import {Primitive} from "./value/primitive";
 import {UnresolvedFunctionReference} from "./value/unresolved-function-reference";
 import {Value} from "./value/value";
@@ -53,6 +55,24 @@ export class DefaultCodeGenerationContextFactory implements CodeGenerationContex
             context.scope.addClass(builtins.get("ArrayConstructor")!, arrayClassReference);
         }
 
+        for (const typedArrayName of TYPED_ARRAY_NAMES) {
+            const typedArraySymbol = builtins.get(typedArrayName);
+            if (typedArraySymbol) {
+                const typedArrayClassReference = TypedArrayClassReference.create(typedArraySymbol, context);
+                context.scope.addClass(typedArraySymbol, typedArrayClassReference);
+                context.scope.addClass(builtins.get(`${typedArrayName}Constructor`)!, typedArrayClassReference);
+            }
+        }
+
+        for (const mapClassName of MAP_CLASS_NAMES) {
+            const mapSymbol = builtins.get(mapClassName);
+            if (mapSymbol) {
+                const mapClassReference = MapClassReference.create(mapSymbol, context);
+                context.scope.addClass(mapSymbol, mapClassReference);
+                context.scope.addClass(builtins.get(`${mapClassName}Constructor`)!, mapClassReference);
+            }
+        }
+
         const mathSymbol = builtins.get("Math");
         if (mathSymbol) {
             const mathClassReference = MathClassReference.create(mathSymbol, context);
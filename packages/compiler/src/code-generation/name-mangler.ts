@@ -35,6 +35,7 @@ export interface NameMangler {
      * Returns the mangled function name for the object indexer
      * @param element the element access
      * @param setter indicator if the name for the getter (false) or setter should be returned
+     * @param unchecked indicator if the name of the accessor without bounds checks should be returned
      */
-    mangleIndexer(element: ts.ElementAccessExpression, setter: boolean): string;
+    mangleIndexer(element: ts.ElementAccessExpression, setter: boolean, unchecked?: boolean): string;
 }
@@ -8,12 +8,24 @@ declare function fetch(url: string): Promise<any>;
 declare function read(filename: string, type: "binary"): Uint8Array;
 declare function read(filename: string, type?: string): string;
 declare var window: any;
+declare var Worker: any;
+declare var Blob: any;
+declare var URL: any;
+declare var location: any;
+declare var self: any;
+declare var performance: any;
+declare function importScripts(...urls: string[]): void;
 
 interface Type {
     primitive: boolean;
     fields: Array<{ name: string, type: string }>;
     constructor?: Function;
     typeArguments: string[];
+
+    /**
+     * Indicator if the objects of this class are stored inline in arrays (see the valueArrays compiler option)
+     */
+    valueClass?: boolean;
 }
 
 interface Types {
@@ -25,11 +37,213 @@ interface Options {
     initialMemory: int;
     globalBase: int;
     staticBump: int;
+
+    /**
+     * Hash of the wasm file, used as key for the compiled modules shared by the loaders
+     */
+    moduleHash?: string;
+
+    /**
+     * The number of workers executing the calls dispatched by callInWorker, 0 to execute the calls on the calling thread
+     */
+    workers?: int;
+
+    /**
+     * Indicator if the workers should not nuke the heap after a call
+     */
+    disableHeapNukeOnExit?: boolean;
+
+    /**
+     * Indicator if the wasmUri is an absolute url or path (used by the workers)
+     */
+    absoluteUri?: boolean;
+
+    /**
+     * The results of the snapshot functions (by the name of the wasm function) that have been executed at build time.
+     * The objects referenced by the results are part of the heap snapshot stored in the data segments of the module.
+     */
+    snapshotResults?: { [name: string]: number };
+}
+
+interface PoolSizeClassStatistics {
+    /**
+     * The size of the blocks of this size class in bytes
+     */
+    size: int;
+
+    /**
+     * The number of allocations served by the free list or the current slab
+     */
+    hits: int;
+
+    /**
+     * The number of allocations that required a new slab
+     */
+    misses: int;
+}
+
+interface RuntimeStatistics {
+    /**
+     * The number of allocations of array storage
+     */
+    elementAllocations: number;
+
+    /**
+     * The number of times the storage of an array has been grown
+     */
+    arrayGrowths: number;
+
+    /**
+     * The total number of bytes requested for array storage
+     */
+    allocatedElementBytes: number;
+
+    /**
+     * Histogram of the sizes of the array storage allocations. The bucket 0 counts the empty allocations and the
+     * bucket i the allocations with a size in [2^(i-1), 2^i) bytes, the last bucket also counts all larger allocations.
+     */
+    elementAllocationSizes: number[];
+
+    /**
+     * The number of gc calls
+     */
+    gcCalls: number;
+
+    /**
+     * The total number of allocations freed by the gc (0 for the arena allocator that resets at once)
+     */
+    gcReleasedAllocations: number;
+
+    /**
+     * The total number of bytes released by the gc
+     */
+    gcReleasedBytes: number;
+
+    /**
+     * Histogram (with the buckets of elementAllocationSizes) of the number of allocations freed by a single gc call
+     */
+    gcReleasedAllocationsPerCall: number[];
+
+    /**
+     * The total time spent in the gc in milliseconds
+     */
+    gcTime: number;
+
+    /**
+     * The longest gc call in milliseconds
+     */
+    gcMaxTime: number;
+
+    /**
+     * The size of the linear memory in bytes (the memory only grows, this is the high water mark)
+     */
+    memorySize: number;
+
+    /**
+     * The number of bytes of the memory used by the heap (sbrk)
+     */
+    heapSize: number;
+
+    /**
+     * The total time in milliseconds spent to copy the arguments to and the results from the linear memory
+     */
+    marshallingTime: number;
+
+    /**
+     * The time in milliseconds until the compiled module was available (fetch and compile or the code cache lookup)
+     */
+    compileTime: number;
+
+    /**
+     * The time in milliseconds needed to instantiate the compiled module
+     */
+    instantiateTime: number;
+}
+
+/**
+ * An array that is allocated in the linear memory of the WASM module and is not released by the gc. A pinned array can
+ * be passed to multiple calls and the elements can be read and written without copying them between the JS and WASM heap.
+ */
+interface PinnedArray {
+    /**
+     * The pointer to the Speedy.js array object
+     */
+    readonly ptr: int;
+
+    /**
+     * The type of the elements, i32 or double
+     */
+    readonly elementType: "i32" | "double";
+
+    /**
+     * The number of elements in the array
+     */
+    readonly length: int;
+
+    /**
+     * View of the elements in the linear memory. The view needs to be requested again after calling into the WASM
+     * module as the array storage might have been reallocated or the memory might have grown.
+     */
+    readonly elements: Int32Array | Float64Array;
 }
 
 interface ModuleLoader {
     (): Promise<WebAssemblyInstance>;
     gc(): void;
+
+    /**
+     * Allocates a pinned array with the given length in the linear memory. The array needs to be released using
+     * releaseArray. Pinned arrays are passed without copying the elements to functions expecting an int[] or number[].
+     * @param elementType the element type of the array, i32 for int[] and double for number[]
+     * @param length the length of the array, the elements are initialized with zero
+     */
+    allocateArray(elementType: "i32" | "double", length: int): Promise<PinnedArray>;
+
+    /**
+     * Releases a pinned array. The array can no longer be used after it has been released.
+     */
+    releaseArray(array: PinnedArray): void;
+
+    /**
+     * Retains the given object or array in the WASM heap across calls. The value is converted when it is passed to an
+     * entry function the first time. Later calls pass the retained WASM object without converting the value again and
+     * the retained object is not released by the gc. Changes to the JS value after the first call are not visible to
+     * the WASM code (and vice versa). The WASM code must not store per call objects in the retained value as these
+     * are released by the gc. Boolean arrays cannot be retained.
+     * @param value the object or array to retain
+     * @return the passed value
+     */
+    retain<T extends object>(value: T): T;
+
+    /**
+     * Releases a value retained by retain. Releasing a value that is not retained has no effect. The WASM object of a
+     * value that is referenced by another retained value is released together with the referencing value.
+     */
+    release(value: object): void;
+
+    /**
+     * Returns the hit and miss counters of the size classes of the pool allocator used for the array and class instances.
+     * Returns an empty array if the module has not yet been loaded or the module does not include the runtime.
+     */
+    poolStatistics(): PoolSizeClassStatistics[];
+
+    /**
+     * Resets the hit and miss counters of the pool allocator
+     */
+    resetPoolStatistics(): void;
+
+    /**
+     * Returns a snapshot of the counters of the instrumented runtime (see the instrumentRuntime compiler option).
+     * Returns undefined if the module has not yet been loaded or the module does not include the instrumented runtime.
+     * Only the calls executed on the calling thread are counted, the workers have their own instances.
+     */
+    runtimeStatistics(): RuntimeStatistics | undefined;
+
+    /**
+     * Resets the counters of the instrumented runtime
+     */
+    resetRuntimeStatistics(): void;
+
     /**
      * Converts the given value to the JS equivalent
      * @param ptr the ptr of the WASM object in the heap
@@ -38,6 +252,52 @@ interface ModuleLoader {
      */
     toJSObject(ptr: int, type: string, types: Types): any;
 
+    /**
+     * Returns the result of a snapshot function that has been executed at build time. The result is converted once
+     * and all calls return the same value. An object result is retained, passing it to an entry function passes the
+     * snapshotted WASM object without converting it again.
+     * @param name the name of the wasm function
+     * @param returnType the type name of the result or void
+     * @param types the reflection information of the used types
+     */
+    snapshotResult(name: string, returnType: string, types: Types): Promise<any>;
+
+    /**
+     * Calls the WASM function in a worker of the worker pool. Each worker has its own instance of the module (and its
+     * own memory), independent calls therefore run in parallel. The arguments and the result are copied using the
+     * structured clone algorithm, only primitives and arrays (of arrays) of primitives are supported. The calls are
+     * executed on the calling thread if the pool has no workers or the environment does not support workers.
+     * @param name the name of the exported function
+     * @param args the arguments
+     * @param argumentTypes the type names of the arguments
+     * @param returnType the type name of the result
+     * @param types the reflection information of the used types
+     */
+    callInWorker(name: string, args: any[], argumentTypes: string[], returnType: string, types: Types): Promise<any>;
+
+    /**
+     * Calls the batch entry function (see the batchEntryFunctions compiler option) that invokes the entry function
+     * once for each of the argument tuples with a single call into WASM. The arguments are copied into the linear
+     * memory up front, the heap is nuked once after all invocations (unless disableHeapNukeOnExit is set).
+     * @param name the name of the exported batch function
+     * @param argumentTuples the arguments of the invocations, all primitives
+     * @param argumentTypes the type names of the arguments (i1, i32 or double)
+     * @param returnType the type name of the result (i1, i32, double or void)
+     * @return the results of the invocations in the order of the argument tuples (undefined for void functions)
+     */
+    callBatch(name: string, argumentTuples: any[][], argumentTypes: string[], returnType: string): Promise<any[]>;
+
+    /**
+     * Returns a lazy view of the WASM object that decodes the fields (or array elements) when they are accessed instead
+     * of converting the whole object graph up front. The view reads from the WASM heap and therefore is only valid
+     * until the next gc (the next call of an entry function or an explicit call to speedyJsGc). Accessing a view
+     * after the gc throws an error. Views are read only.
+     * @param ptr the ptr of the WASM object in the heap
+     * @param type the type of the object
+     * @param types the reflection information of the types
+     */
+    toLazyJSObject(ptr: int, type: string, types: Types): any;
+
     /**
      * Converts the js object (array or object) to a WASM pointer
      * @param jsObject the js object
@@ -47,18 +307,32 @@ interface ModuleLoader {
      * equality across the boundary
      */
     toWASM(jsObject: object, type: string, types: Types, objectReferences: Map<object, int>): int | undefined;
+
+    /**
+     * Translates a trap raised by the runtime (e.g. an out of bounds array access) into the matching JS error.
+     * The heap of the aborted call is released (unless disableHeapNukeOnExit is set). Errors that have not been raised
+     * by the runtime are rethrown unchanged.
+     * @param error the error thrown by the call of the entry function
+     */
+    translateError(error: any): never;
 }
 
 function __moduleLoader(this: any, wasmUri: string, options: Options): ModuleLoader {
     const PTR_SIZE = 4;
     const PTR_SHIFT = Math.log2(PTR_SIZE);
+    // Size of the inline elements storage of the runtime array objects, see ARRAY_INLINE_STORAGE_SIZE
+    const ARRAY_INLINE_STORAGE_SIZE = 32;
 
     function sizeOf(type: string): int {
         switch (type) {
             case "i1":
             case "i8":
+            case "u8":
                 return 1;
+            case "i16":
+                return 2;
             case "i32":
+            case "float":
                 return 4;
             case "double":
                 return 8;
@@ -67,6 +341,51 @@ function __moduleLoader(this: any, wasmUri: string, options: Options): ModuleLoa
         }
     }
 
+    /**
+     * Returns the element type of the runtime array storing the elements of a typed array
+     * @param constructor the constructor of the type
+     * @return the element type or undefined if the constructor is not a supported typed array
+     */
+    function typedArrayElementType(constructor?: Function): string | undefined {
+        switch (constructor) {
+            case Float32Array:
+                return "float";
+            case Int8Array:
+                return "i8";
+            case Int16Array:
+                return "i16";
+            case Uint8Array:
+                return "u8";
+            default:
+                return undefined;
+        }
+    }
+
+    /**
+     * Creates a typed array view of the heap for the elements of a runtime array
+     * @param elementType the element type of the runtime array
+     * @param begin the address of the first element
+     * @param length the number of elements
+     */
+    function heapView(elementType: string, begin: int, length: int): Int8Array | Uint8Array | Int16Array | Int32Array | Float32Array | Float64Array {
+        switch (elementType) {
+            case "i8":
+                return new Int8Array(memory.buffer, begin, length);
+            case "u8":
+                return new Uint8Array(memory.buffer, begin, length);
+            case "i16":
+                return new Int16Array(memory.buffer, begin, length);
+            case "i32":
+                return new Int32Array(memory.buffer, begin, length);
+            case "float":
+                return new Float32Array(memory.buffer, begin, length);
+            case "double":
+                return new Float64Array(memory.buffer, begin, length);
+            default:
+                throw new Error("No heap view for the element type " + elementType);
+        }
+    }
+
     function getHeapValue(ptr: int, type: string) {
         switch (type) {
             case "i1":
@@ -105,6 +424,118 @@ function __moduleLoader(this: any, wasmUri: string, options: Options): ModuleLoa
 
     let malloc: (size: int) => int = () => { throw new Error("malloc not defined"); };
     let free: (ptr: int) => void = () => void 0;
+    let allocateObject: (size: int) => int = size => malloc(size);
+    let allocateRetained: (size: int, scope: int) => int = () => { throw new Error("The module does not support retained values"); };
+    let createRetainScope: () => int = () => { throw new Error("The module does not support retained values"); };
+    let releaseRetainScope: (scope: int) => void = () => void 0;
+
+    interface RetainedValue {
+        typeName?: string;
+        ptr?: int;
+        scope: int;
+
+        /**
+         * The retained values that are referenced by the WASM object of this value
+         */
+        references: object[];
+
+        /**
+         * The number of retained values whose WASM objects reference the WASM object of this value. The scope is only
+         * released if no other retained value references the object.
+         */
+        referencedBy: int;
+
+        /**
+         * Indicator if release has been called for this value
+         */
+        released: boolean;
+    }
+
+    const retainedValues = new Map<object, RetainedValue>();
+    // The scope of the value that is converted right now, the allocations of a retained value survive the gc
+    let retainScope = 0;
+    // The retained value that is converted right now
+    let convertedRetained: RetainedValue | undefined;
+
+    function createRetainedValue(ptr?: int, typeName?: string): RetainedValue {
+        return { ptr, typeName, scope: 0, references: [], referencedBy: 0, released: false };
+    }
+
+    function allocateHeap(size: int): int {
+        return retainScope === 0 ? malloc(size) : allocateRetained(size, retainScope);
+    }
+
+    function allocateHeapObject(size: int): int {
+        return retainScope === 0 ? allocateObject(size) : allocateRetained(size, retainScope);
+    }
+
+    /**
+     * Converts a retained value when it is passed the first time and returns the retained WASM object for later calls.
+     * A retained value referenced by another retained value is converted once (in its own scope) and shared by both.
+     */
+    function retainedToWasm(jsValue: object, retained: RetainedValue, typeName: string, types: Types): int {
+        if (typeof(retained.ptr) === "undefined") {
+            if (retained.scope !== 0) {
+                throw new Error("Retained values cannot reference each other cyclically");
+            }
+
+            const parentScope = retainScope;
+            const parent = convertedRetained;
+            retained.scope = retainScope = createRetainScope();
+            convertedRetained = retained;
+
+            try {
+                // Objects converted for this call only are released by the gc and must not be referenced by the retained value
+                retained.ptr = jsToWasm(jsValue, typeName, types, new Map<object, int>()) as int;
+                retained.typeName = typeName;
+            } catch (e) {
+                releaseRetained(jsValue, retained);
+                throw e;
+            } finally {
+                retainScope = parentScope;
+                convertedRetained = parent;
+            }
+        } else if (retained.typeName !== typeName) {
+            throw new Error(`The retained value has been converted to ${retained.typeName} and cannot be passed as ${typeName}`);
+        }
+
+        if (convertedRetained && convertedRetained.references.indexOf(jsValue) === -1) {
+            convertedRetained.references.push(jsValue);
+            ++retained.referencedBy;
+        }
+
+        return retained.ptr!;
+    }
+
+    /**
+     * Releases the scope of the retained value if it has been released and is not referenced by another retained value.
+     * Releases the retained values referenced by this value that have been released before.
+     */
+    function releaseRetained(jsValue: object, retained: RetainedValue) {
+        if (retained.referencedBy > 0) {
+            return;
+        }
+
+        if (retained.released) {
+            retainedValues.delete(jsValue);
+        }
+
+        if (retained.scope !== 0) {
+            releaseRetainScope(retained.scope);
+        }
+
+        const references = retained.references;
+        retained.ptr = retained.typeName = undefined;
+        retained.scope = 0;
+        retained.references = [];
+
+        for (const reference of references) {
+            const referenced = retainedValues.get(reference)!;
+            if (--referenced.referencedBy === 0 && referenced.released) {
+                releaseRetained(reference, referenced);
+            }
+        }
+    }
 
     function updateHeap(buffer: ArrayBuffer) {
         heap8 = new Int8Array(buffer);
@@ -113,13 +544,68 @@ function __moduleLoader(this: any, wasmUri: string, options: Options): ModuleLoa
     }
 
     /**
-     * Computes the size of a not packed object
+     * Computes the size of a not packed object. The size of an object stored inline in an array includes the padding
+     * needed to align the following element.
+     */
+    function computeObjectSize(type: Type, inline = false) {
+        let size = 0;
+        let alignment = 1;
+
+        for (const field of type.fields) {
+            const fieldSize = sizeOf(field.type);
+            size = alignMemory(size, fieldSize) + fieldSize;
+            alignment = Math.max(alignment, fieldSize);
+        }
+
+        return inline ? alignMemory(size, alignment) : size;
+    }
+
+    /**
+     * Returns the type of the value class with the given name or undefined if the type is not a value class
+     */
+    function valueClassOf(typeName: string, types: Types): Type | undefined {
+        const type = types[typeName];
+        return type && type.valueClass ? type : undefined;
+    }
+
+    /**
+     * Writes the fields of the JS object into the not packed object stored at the given address
+     */
+    function writeObject(objPtr: int, jsValue: any, type: Type, types: Types, objectReferences: Map<object, int>) {
+        if (typeof(jsValue) !== "object") {
+            throw new Error(`Expected argument of type object but was typeof ${typeof(jsValue)}.`);
+        }
+
+        if (jsValue.constructor !== type.constructor) {
+            throw new Error(`Expected object of type ${type.constructor} but was ${jsValue.constructor} (inheritance is not supported).`);
+        }
+
+        let offset = 0;
+        for (const field of type.fields) {
+            const fieldSize = sizeOf(field.type);
+            offset = alignMemory(offset, fieldSize);
+
+            setHeapValue(objPtr + offset, jsToWasm(jsValue[field.name], field.type, types, objectReferences), field.type);
+
+            offset += fieldSize;
+        }
+    }
+
+    /**
+     * Reads the not packed object stored at the given address into a new instance of the class
      */
-    function computeObjectSize(type: Type) {
-        return type.fields.reduce((memo, field) => {
+    function readObject(objPtr: int, type: Type, types: Types, returnedObjects: Map<int, object>) {
+        const obj: { [name: string]: any } = Object.create(type.constructor!.prototype); // ensure it is an instance of the class
+        let memoryOffset = objPtr;
+
+        for (const field of type.fields) {
             const fieldSize = sizeOf(field.type);
-            return alignMemory(memo + fieldSize, fieldSize);
-        }, 0);
+            memoryOffset = alignMemory(memoryOffset, fieldSize);
+            obj[field.name] = wasmToJs(getHeapValue(memoryOffset, field.type), field.type, types, returnedObjects);
+            memoryOffset += fieldSize;
+        }
+
+        return obj;
     }
 
     function jsToWasm(jsValue: any, typeName: string, types: Types, objectReferences: Map<object, int>): any {
@@ -144,7 +630,36 @@ function __moduleLoader(this: any, wasmUri: string, options: Options): ModuleLoa
             return ptr;
         }
 
-        if (type.constructor === Array) {
+        const retained = retainedValues.get(jsValue);
+        if (typeof(retained) !== "undefined" && !retained.released) {
+            ptr = retainedToWasm(jsValue, retained, typeName, types);
+            objectReferences.set(jsValue, ptr);
+            return ptr;
+        }
+
+        if (jsValue instanceof RuntimePinnedArray) {
+            if (type.constructor !== Array || type.typeArguments[0] !== jsValue.elementType) {
+                throw new Error(`Expected argument of type ${typeName} but was pinned array of ${jsValue.elementType}`);
+            }
+
+            return jsValue.ptr;
+        }
+
+        const typedElementType = typedArrayElementType(type.constructor);
+
+        if (typeof(typedElementType) !== "undefined") {
+            if (!(jsValue instanceof type.constructor!)) {
+                throw new Error(`Expected argument of type ${typeName}`);
+            }
+
+            ptr = RuntimeArray.from(jsValue as ArrayLike<number>, typedElementType, types, objectReferences).ptr;
+        } else if (type.constructor === Map || type.constructor === Set) {
+            if (!(jsValue instanceof type.constructor)) {
+                throw new Error(`Expected argument of type ${typeName}`);
+            }
+
+            ptr = RuntimeMap.from(jsValue, type, types, objectReferences).ptr;
+        } else if (type.constructor === Array) {
             if (!Array.isArray(jsValue)) {
                 throw new Error("Expected argument of type Array");
             }
@@ -156,26 +671,13 @@ function __moduleLoader(this: any, wasmUri: string, options: Options): ModuleLoa
                 throw new Error(`Expected argument of type object but was typeof ${typeof(jsValue)}.`);
             }
 
-            if (jsValue.constructor !== type.constructor) {
-                throw new Error(`Expected object of type ${type.constructor} but was ${jsValue.constructor} (inheritance is not supported).`);
-            }
-
             const size = computeObjectSize(type);
-            const objPtr = malloc(size);
+            const objPtr = allocateHeapObject(size);
             if (objPtr === 0) {
                 throw new Error("Failed to allocate object");
             }
 
-            let offset = 0;
-            for (const field of type.fields) {
-                const fieldSize = sizeOf(field.type);
-                offset = alignMemory(offset, fieldSize);
-
-                setHeapValue(objPtr + offset, jsToWasm(jsValue[field.name], field.type, types, objectReferences), field.type);
-
-                offset += fieldSize;
-            }
-
+            writeObject(objPtr, jsValue, type, types, objectReferences);
             ptr = objPtr;
         }
 
@@ -205,21 +707,18 @@ function __moduleLoader(this: any, wasmUri: string, options: Options): ModuleLoa
 
         if (ptr === 0) {
             return undefined;
+        } else if (pinnedArrays.has(ptr)) {
+            return pinnedArrays.get(ptr);
+        } else if (typeof(typedArrayElementType(type.constructor)) !== "undefined") {
+            objectReference = new RuntimeArray(ptr, typedArrayElementType(type.constructor)!).toTypedArray();
+        } else if (type.constructor === Map || type.constructor === Set) {
+            objectReference = new RuntimeMap(ptr, type).toNative(types, returnedObjects);
         } else if (type.constructor === Array) {
-            objectReference = new RuntimeArray(ptr, type.typeArguments[0]).toArray(types, returnedObjects);
+            const elementType = type.typeArguments[0];
+            objectReference = new RuntimeArray(ptr, elementType, valueClassOf(elementType, types)).toArray(types, returnedObjects);
         } else {
             // Object
-            const obj: { [name: string]: any } = Object.create(type.constructor!.prototype); // ensure it is an instance of the class
-            let memoryOffset = wasmValue as int;
-
-            for (const field of type.fields) {
-                const fieldSize = sizeOf(field.type);
-                memoryOffset = alignMemory(memoryOffset, fieldSize);
-                obj[field.name] = wasmToJs(getHeapValue(memoryOffset, field.type), field.type, types, returnedObjects);
-                memoryOffset += fieldSize;
-            }
-
-            objectReference = obj;
+            objectReference = readObject(ptr, type, types, returnedObjects);
         }
 
         returnedObjects.set(ptr, objectReference);
@@ -229,33 +728,56 @@ function __moduleLoader(this: any, wasmUri: string, options: Options): ModuleLoa
 
     class RuntimeArray {
         /**
-         * Allocates a Speedy.js array for the given JS array
+         * Allocates a Speedy.js array for the given JS array (or typed array)
          * @param native the js array
          * @param elementType the element type
          * @param types the reflection information of the used types
          * @param objectReferences map from JS to WASM pointers of already deserialized objects
          * @return {RuntimeArray} the Speedy.js Array
          */
-        static from(native: any[], elementType: string, types: Types, objectReferences: Map<object, int>): RuntimeArray {
-            // begin, back, capacity
-            const size = PTR_SIZE * 2 + sizeOf("i32");
-            const arrayPtr = malloc(size);
+        static from(native: ArrayLike<any>, elementType: string, types: Types, objectReferences: Map<object, int>): RuntimeArray {
+            if (elementType === "i1") {
+                return RuntimeArray.fromBooleans(native as boolean[]);
+            }
+
+            const valueClass = valueClassOf(elementType, types);
+            if (valueClass) {
+                return RuntimeArray.fromValueObjects(native, elementType, valueClass, types, objectReferences);
+            }
+
             const elementSize = sizeOf(elementType);
-            const elementsPtr = malloc(elementSize * native.length);
+            // begin, back, capacity, front, ownership, followed by the inline storage
+            const inlineStorageOffset = alignMemory(PTR_SIZE * 2 + 3 * sizeOf("i32"), elementSize);
+            const inlineCapacity = ARRAY_INLINE_STORAGE_SIZE / elementSize;
+            const arrayPtr = allocateHeapObject(inlineStorageOffset + ARRAY_INLINE_STORAGE_SIZE);
 
-            if (arrayPtr === 0 || elementsPtr === 0) {
+            if (arrayPtr === 0) {
                 throw new Error("Failed to allocate array");
             }
 
+            let elementsPtr = arrayPtr + inlineStorageOffset;
+            let capacity = inlineCapacity;
+
+            if (native.length > inlineCapacity) {
+                elementsPtr = allocateHeap(elementSize * native.length);
+                capacity = native.length;
+
+                if (elementsPtr === 0) {
+                    throw new Error("Failed to allocate array");
+                }
+            }
+
             const begin = elementsPtr;
             const back = elementsPtr + (elementSize * native.length);
 
             heapPtr[arrayPtr >> PTR_SHIFT] = begin;
             heapPtr[(arrayPtr + PTR_SIZE) >> PTR_SHIFT] = back;
-            heap32[(arrayPtr + 2 * PTR_SIZE) >> 2] = native.length | 0;
+            heap32[(arrayPtr + 2 * PTR_SIZE) >> 2] = capacity | 0;
+            heap32[(arrayPtr + 2 * PTR_SIZE + 4) >> 2] = 0; // no unused elements in front of begin
+            // the array owns the storage, retained arrays are pinned to grow in the scope of the retained value
+            heap32[(arrayPtr + 2 * PTR_SIZE + 8) >> 2] = retainScope === 0 ? 0 : 2;
 
             switch (elementType) {
-                case "i1":
                 case "i8":
                     heap8.set(native, begin);
                     break;
@@ -265,6 +787,11 @@ function __moduleLoader(this: any, wasmUri: string, options: Options): ModuleLoa
                 case "double":
                     heap64.set(native, begin >> 3);
                     break;
+                case "u8":
+                case "i16":
+                case "float":
+                    heapView(elementType, begin, native.length).set(native);
+                    break;
                 default:
                     heapPtr.set(Int32Array.from(native, object => jsToWasm(object, elementType, types, objectReferences)), begin >> PTR_SHIFT);
             }
@@ -272,7 +799,101 @@ function __moduleLoader(this: any, wasmUri: string, options: Options): ModuleLoa
             return new RuntimeArray(arrayPtr, elementType);
         }
 
-        constructor(public ptr: int, private elementType: string) {
+        /**
+         * Allocates a Speedy.js boolean array. Boolean arrays store the elements as bits in 32 bit words
+         * (see Array<bool> in bool-array.h). The layout is words, length (in bits), capacity (in bits), followed
+         * by the inline words. All bits after the length need to be zero.
+         * @param native the js array
+         * @return {RuntimeArray} the Speedy.js Array
+         */
+        static fromBooleans(native: boolean[]): RuntimeArray {
+            if (retainScope !== 0) {
+                // Boolean arrays have no ownership flag and would grow on the heap released by the gc
+                throw new Error("Boolean arrays cannot be retained");
+            }
+
+            const inlineStorageOffset = PTR_SIZE + 2 * sizeOf("i32");
+            const inlineWords = ARRAY_INLINE_STORAGE_SIZE / 4;
+            const arrayPtr = allocateHeapObject(inlineStorageOffset + ARRAY_INLINE_STORAGE_SIZE);
+
+            if (arrayPtr === 0) {
+                throw new Error("Failed to allocate array");
+            }
+
+            let wordsPtr = arrayPtr + inlineStorageOffset;
+            const wordCount = Math.max(inlineWords, Math.ceil(native.length / 32));
+
+            if (wordCount > inlineWords) {
+                wordsPtr = allocateHeap(wordCount * 4);
+
+                if (wordsPtr === 0) {
+                    throw new Error("Failed to allocate array");
+                }
+            }
+
+            heapPtr[arrayPtr >> PTR_SHIFT] = wordsPtr;
+            heap32[(arrayPtr + PTR_SIZE) >> 2] = native.length | 0;
+            heap32[(arrayPtr + PTR_SIZE + 4) >> 2] = (wordCount * 32) | 0;
+
+            const words = heap32.subarray(wordsPtr >> 2, (wordsPtr >> 2) + wordCount);
+            words.fill(0);
+
+            for (let i = 0; i < native.length; ++i) {
+                if (native[i]) {
+                    words[i >> 5] |= 1 << (i & 31);
+                }
+            }
+
+            return new RuntimeArray(arrayPtr, "i1");
+        }
+
+        /**
+         * Allocates a Speedy.js array of a value class (see ValueArray in value-array.h). The layout is begin, back,
+         * capacity (in elements) and the element size. The fields of the objects are stored inline, one object after another.
+         * @param native the js array
+         * @param elementType the name of the value class
+         * @param valueClass the type of the value class
+         * @param types the reflection information of the used types
+         * @param objectReferences map from JS to WASM pointers of already deserialized objects
+         * @return {RuntimeArray} the Speedy.js Array
+         */
+        static fromValueObjects(native: ArrayLike<any>, elementType: string, valueClass: Type, types: Types, objectReferences: Map<object, int>): RuntimeArray {
+            if (retainScope !== 0) {
+                // Value arrays have no ownership flag and would grow on the heap released by the gc
+                throw new Error("Arrays of value classes cannot be retained");
+            }
+
+            const elementSize = computeObjectSize(valueClass, true);
+            const arrayPtr = allocateHeapObject(PTR_SIZE * 2 + 2 * sizeOf("i32"));
+            const begin = native.length === 0 ? 0 : allocateHeap(elementSize * native.length);
+
+            if (arrayPtr === 0 || (native.length > 0 && begin === 0)) {
+                throw new Error("Failed to allocate array");
+            }
+
+            for (let i = 0; i < native.length; ++i) {
+                if (native[i] === null || typeof(native[i]) === "undefined") {
+                    throw new Error("Undefined and null values are not supported");
+                }
+
+                // The object is copied, a reference to it is not registered in objectReferences
+                writeObject(begin + i * elementSize, native[i], valueClass, types, objectReferences);
+            }
+
+            heapPtr[arrayPtr >> PTR_SHIFT] = begin;
+            heapPtr[(arrayPtr + PTR_SIZE) >> PTR_SHIFT] = begin + elementSize * native.length;
+            heap32[(arrayPtr + 2 * PTR_SIZE) >> 2] = native.length | 0;
+            heap32[(arrayPtr + 2 * PTR_SIZE + 4) >> 2] = elementSize | 0;
+
+            return new RuntimeArray(arrayPtr, elementType, valueClass);
+        }
+
+        /**
+         * @param ptr the address of the array
+         * @param elementType the name of the element type
+         * @param valueClass the type of the elements if the array is an array of a value class whose objects are stored inline
+         */
+        constructor(public ptr: int, private elementType: string, private valueClass?: Type) {
         }
 
         get begin(): int {
@@ -283,6 +904,21 @@ function __moduleLoader(this: any, wasmUri: string, options: Options): ModuleLoa
             return heapPtr[(this.ptr + PTR_SIZE) >> PTR_SHIFT] | 0;
         }
 
+        /**
+         * The number of elements. The second field of boolean arrays is the length and not the back pointer.
+         */
+        get length(): int {
+            if (this.elementType === "i1") {
+                return heap32[(this.ptr + PTR_SIZE) >> 2] | 0;
+            }
+
+            return (this.back - this.begin) / this.elementSize;
+        }
+
+        get elementSize(): int {
+            return this.valueClass ? computeObjectSize(this.valueClass, true) : sizeOf(this.elementType);
+        }
+
         /**
          * Converts a Speedy.js array to a native JS array
          * @param types the reflection information of the object types
@@ -291,8 +927,18 @@ function __moduleLoader(this: any, wasmUri: string, options: Options): ModuleLoa
          */
         toArray(types: Types, objectReferences: Map<int, object>): any[] {
             switch (this.elementType) {
-                case "i1":
-                    return Array.from(heap8.subarray(this.begin, this.back), value => value !== 0); // Elements need to be converted to bool
+                case "i1": {
+                    // The elements are bits, the second field is the length and not the back pointer
+                    const wordsPtr = this.begin;
+                    const length = heap32[(this.ptr + PTR_SIZE) >> 2] | 0;
+                    const result = new Array<boolean>(length);
+
+                    for (let i = 0; i < length; ++i) {
+                        result[i] = ((heap32[(wordsPtr >> 2) + (i >> 5)] >>> (i & 31)) & 1) !== 0;
+                    }
+
+                    return result;
+                }
                 case "i8":
                     return Array.from(heap8.subarray(this.begin, this.back));
                 case "i32":
@@ -300,14 +946,325 @@ function __moduleLoader(this: any, wasmUri: string, options: Options): ModuleLoa
                 case "double":
                     return Array.from(heap64.subarray(this.begin >> 3, this.back >> 3));
                 default:
+                    if (this.valueClass) {
+                        const result = new Array<object>(this.length);
+
+                        for (let i = 0; i < result.length; ++i) {
+                            result[i] = readObject(this.begin + i * this.elementSize, this.valueClass, types, objectReferences);
+                        }
+
+                        return result;
+                    }
+
                     return Array.from(
                         heapPtr.subarray(this.begin >> PTR_SHIFT, this.back >> PTR_SHIFT),
                         objectPtr => wasmToJs(objectPtr, this.elementType, types, objectReferences)
                     );
             }
         }
+
+        /**
+         * Copies the elements of a Speedy.js array storing the elements of a typed array into a new JS typed array
+         * @return the typed array (e.g. a Float32Array for float elements)
+         */
+        toTypedArray(): Int8Array | Uint8Array | Int16Array | Int32Array | Float32Array | Float64Array {
+            return heapView(this.elementType, this.begin, this.length).slice();
+        }
     }
 
+    /**
+     * A Speedy.js Map or Set (see HashTable in hash-map.h). The layout is entries, slots, entriesCount, entriesCapacity,
+     * count and slotMask. The entries {hash, key, value} are stored in insertion order, removed entries have the hash 0.
+     */
+    class RuntimeMap {
+        private keyType: string;
+        private valueType: string | undefined;
+
+        /**
+         * Allocates a Speedy.js map or set for the given JS Map or Set. Only the entries are stored, the runtime builds
+         * the index (slots) and computes the hashes when the map is accessed the first time.
+         * @param native the JS Map or Set
+         * @param type the type of the map or set
+         * @param types the reflection information of the used types
+         * @param objectReferences map from JS to WASM pointers of already deserialized objects
+         * @return {RuntimeMap} the Speedy.js map or set
+         */
+        static from(native: Map<any, any> | Set<any>, type: Type, types: Types, objectReferences: Map<object, int>): RuntimeMap {
+            if (retainScope !== 0) {
+                // The entries would grow on the heap released by the gc
+                throw new Error("Maps and Sets cannot be retained");
+            }
+
+            const mapPtr = allocateHeapObject(2 * PTR_SIZE + 4 * sizeOf("i32"));
+            const map = new RuntimeMap(mapPtr, type);
+            const entrySize = map.entrySize;
+            const entriesPtr = native.size === 0 ? 0 : allocateHeap(entrySize * native.size);
+
+            if (mapPtr === 0 || (native.size > 0 && entriesPtr === 0)) {
+                throw new Error("Failed to allocate map");
+            }
+
+            let entryPtr = entriesPtr;
+            native.forEach((value: any, key: any) => {
+                heap32[entryPtr >> 2] = 1; // any hash but the one of removed entries
+                setHeapValue(entryPtr + map.keyOffset, key, map.keyType);
+
+                if (typeof(map.valueType) !== "undefined") {
+                    setHeapValue(entryPtr + map.valueOffset, jsToWasm(value, map.valueType, types, objectReferences), map.valueType);
+                }
+
+                entryPtr += entrySize;
+            });
+
+            heapPtr[mapPtr >> PTR_SHIFT] = entriesPtr;
+            heapPtr[(mapPtr + PTR_SIZE) >> PTR_SHIFT] = 0; // no index
+            heap32[(mapPtr + 2 * PTR_SIZE) >> 2] = native.size | 0;
+            heap32[(mapPtr + 2 * PTR_SIZE + 4) >> 2] = native.size | 0;
+            heap32[(mapPtr + 2 * PTR_SIZE + 8) >> 2] = native.size | 0;
+            heap32[(mapPtr + 2 * PTR_SIZE + 12) >> 2] = 0;
+
+            return map;
+        }
+
+        constructor(public ptr: int, private type: Type) {
+            this.keyType = type.typeArguments[0];
+            this.valueType = type.constructor === Map ? type.typeArguments[1] : undefined;
+        }
+
+        private get keyOffset(): int {
+            return alignMemory(sizeOf("i32"), sizeOf(this.keyType));
+        }
+
+        private get valueOffset(): int {
+            return alignMemory(this.keyOffset + sizeOf(this.keyType), sizeOf(this.valueType!));
+        }
+
+        private get entrySize(): int {
+            const end = typeof(this.valueType) === "undefined" ? this.keyOffset + sizeOf(this.keyType) : this.valueOffset + sizeOf(this.valueType);
+            const alignment = Math.max(sizeOf("i32"), sizeOf(this.keyType), typeof(this.valueType) === "undefined" ? 0 : sizeOf(this.valueType));
+            return alignMemory(end, alignment);
+        }
+
+        /**
+         * Converts the Speedy.js map or set to a JS Map or Set, the entries are added in insertion order
+         * @param types the reflection information of the object types
+         * @param objectReferences map from WASM pointers to the deserialized JS objects
+         */
+        toNative(types: Types, objectReferences: Map<int, object>): Map<any, any> | Set<any> {
+            const entriesPtr = heapPtr[this.ptr >> PTR_SHIFT] | 0;
+            const entriesCount = heap32[(this.ptr + 2 * PTR_SIZE) >> 2] | 0;
+            const entrySize = this.entrySize;
+            const result = this.type.constructor === Map ? new Map<any, any>() : new Set<any>();
+
+            for (let entryPtr = entriesPtr; entryPtr < entriesPtr + entriesCount * entrySize; entryPtr += entrySize) {
+                if (heap32[entryPtr >> 2] === 0) {
+                    continue; // removed
+                }
+
+                const key = getHeapValue(entryPtr + this.keyOffset, this.keyType);
+
+                if (typeof(this.valueType) === "undefined") {
+                    (result as Set<any>).add(key);
+                } else {
+                    const value = wasmToJs(getHeapValue(entryPtr + this.valueOffset, this.valueType), this.valueType, types, objectReferences);
+                    (result as Map<any, any>).set(key, value);
+                }
+            }
+
+            return result;
+        }
+    }
+
+    // Incremented by every gc, lazy views created before the gc are no longer valid
+    let heapGeneration = 0;
+
+    /**
+     * Creates lazy views of the objects in the WASM heap. The views of a single result share the same factory to
+     * ensure reference equality of objects referenced multiple times.
+     */
+    class LazyViewFactory {
+        private views = new Map<int, object>();
+        private generation = heapGeneration;
+
+        constructor(private types: Types) {
+        }
+
+        view(wasmValue: any, typeName: string): any {
+            const type = this.types[typeName];
+            if (!type) { throw new Error("Unknown type " + typeName); }
+
+            if (type.primitive) {
+                return typeName === "i1" ? wasmValue !== 0 : wasmValue;
+            }
+
+            const ptr = wasmValue as int;
+            if (ptr === 0) {
+                return undefined;
+            }
+
+            if (pinnedArrays.has(ptr)) {
+                return pinnedArrays.get(ptr);
+            }
+
+            let view = this.views.get(ptr);
+            if (typeof view === "undefined") {
+                const typedElementType = typedArrayElementType(type.constructor);
+
+                if (typeof(typedElementType) !== "undefined") {
+                    // a typed array view of the heap would be detached when the memory grows, the elements are copied instead
+                    view = new RuntimeArray(ptr, typedElementType).toTypedArray();
+                } else if (type.constructor === Map || type.constructor === Set) {
+                    // the entries are copied as the iteration order of the views would be up to the runtime
+                    view = new RuntimeMap(ptr, type).toNative(this.types, new Map<int, object>());
+                } else {
+                    view = type.constructor === Array ? this.arrayView(ptr, type.typeArguments[0]) : this.objectView(ptr, type);
+                }
+
+                this.views.set(ptr, view);
+            }
+
+            return view;
+        }
+
+        private checkAlive() {
+            if (this.generation !== heapGeneration) {
+                throw new Error("The lazy result is no longer valid, the WASM heap has been released by the gc");
+            }
+        }
+
+        private objectView(ptr: int, type: Type): object {
+            const view: { [name: string]: any } = Object.create(type.constructor!.prototype); // ensure it is an instance of the class
+            const factory = this;
+            let offset = ptr;
+
+            for (const field of type.fields) {
+                const fieldSize = sizeOf(field.type);
+                offset = alignMemory(offset, fieldSize);
+                const fieldPtr = offset;
+
+                Object.defineProperty(view, field.name, {
+                    enumerable: true,
+                    get() {
+                        factory.checkAlive();
+                        return factory.view(getHeapValue(fieldPtr, field.type), field.type);
+                    }
+                });
+
+                offset += fieldSize;
+            }
+
+            return view;
+        }
+
+        private arrayView(ptr: int, elementType: string): object {
+            const factory = this;
+            const valueClass = valueClassOf(elementType, this.types);
+            const array = new RuntimeArray(ptr, elementType, valueClass);
+            const elementSize = array.elementSize;
+
+            function isIndex(property: PropertyKey): property is string {
+                return typeof property === "string" && /^(0|[1-9][0-9]*)$/.test(property);
+            }
+
+            function getElement(index: int) {
+                if (elementType === "i1") {
+                    return ((heap32[(array.begin >> 2) + (index >> 5)] >>> (index & 31)) & 1) !== 0;
+                }
+
+                if (valueClass) {
+                    // the objects are stored inline, the address of the element is the address of the object
+                    return factory.view(array.begin + index * elementSize, elementType);
+                }
+
+                return factory.view(getHeapValue(array.begin + index * elementSize, elementType), elementType);
+            }
+
+            // The target is an array so that Array.isArray is true and the array methods can be used on the view
+            return new Proxy([], {
+                get(target: any[], property: PropertyKey) {
+                    factory.checkAlive();
+
+                    if (property === "length") {
+                        return array.length;
+                    }
+
+                    if (isIndex(property)) {
+                        return +property < array.length ? getElement(+property) : undefined;
+                    }
+
+                    return (target as any)[property];
+                },
+                has(target: any[], property: PropertyKey) {
+                    factory.checkAlive();
+
+                    if (isIndex(property)) {
+                        return +property < array.length;
+                    }
+
+                    return property in target;
+                },
+                // Object.keys, Object.entries and the own property checks see the elements of the heap array
+                ownKeys(target: any[]) {
+                    factory.checkAlive();
+
+                    const keys: PropertyKey[] = [];
+                    for (let i = 0; i < array.length; ++i) {
+                        keys.push(String(i));
+                    }
+
+                    return keys.concat(Reflect.ownKeys(target).filter(key => !isIndex(key)));
+                },
+                getOwnPropertyDescriptor(target: any[], property: PropertyKey) {
+                    factory.checkAlive();
+
+                    if (property === "length") {
+                        // the length of the target is not configurable, the reported descriptor needs to be compatible
+                        return { value: array.length, writable: true, enumerable: false, configurable: false };
+                    }
+
+                    if (isIndex(property)) {
+                        if (+property >= array.length) {
+                            return undefined;
+                        }
+
+                        return { value: getElement(+property), writable: false, enumerable: true, configurable: true };
+                    }
+
+                    return Object.getOwnPropertyDescriptor(target, property);
+                },
+                set() {
+                    throw new Error("Lazy results are read only");
+                }
+            });
+        }
+    }
+
+    class RuntimePinnedArray implements PinnedArray {
+        constructor(public readonly ptr: int, public readonly elementType: "i32" | "double") {
+        }
+
+        private get array() {
+            return new RuntimeArray(this.ptr, this.elementType);
+        }
+
+        get length(): int {
+            return this.array.length;
+        }
+
+        get elements(): Int32Array | Float64Array {
+            const array = this.array;
+
+            if (this.elementType === "i32") {
+                return heap32.subarray(array.begin >> 2, array.back >> 2);
+            }
+
+            return heap64.subarray(array.begin >> 3, array.back >> 3);
+        }
+    }
+
+    // pointer of the array object -> pinned array, ensures that returned pinned arrays keep their identity
+    const pinnedArrays = new Map<int, RuntimePinnedArray>();
+
     const TOTAL_STACK = options.totalStack;
     const INITIAL_MEMORY = options.initialMemory;
     let totalMemory: number = INITIAL_MEMORY;
@@ -386,114 +1343,240 @@ function __moduleLoader(this: any, wasmUri: string, options: Options): ModuleLoa
         return x;
     }
 
-    function loadInstance(): Promise<WebAssemblyInstance> {
-        let instance: WebAssemblyInstance;
+    // browser window or a web worker (of the worker pool)
+    const isBrowser = typeof window !== "undefined" || (typeof self !== "undefined" && typeof importScripts === "function");
 
-        let wasmLoaded: Promise<ArrayBuffer>;
-        // browser
-        if (typeof window !== "undefined") {
-            if (typeof fetch !== "function") {
-                throw new Error("Your browser does not support the fetch API. Include a fetch polyfill to load the WASM module");
+    /**
+     * Fetches the wasm file in the browser and returns the response
+     */
+    function fetchWasm(): Promise<any> {
+        if (typeof fetch !== "function") {
+            throw new Error("Your browser does not support the fetch API. Include a fetch polyfill to load the WASM module");
+        }
+
+        return fetch(wasmUri).then(function(response: any) {
+            if (response.ok) {
+                return response;
             }
 
-            wasmLoaded = fetch(wasmUri).then(function(response: any) {
-                if (response.ok) {
-                    return response.arrayBuffer();
-                }
+            throw new Error("Failed to load WASM module from " + wasmUri + " (" + response.statusText + ").");
+        });
+    }
 
-                throw new Error("Failed to load WASM module from " + wasmUri + " (" + response.statusText + ").");
-            });
+    /**
+     * Node.js require that is not detected by webpack. Webpack should not include the required files as we only
+     * want to execute this code if we are in node and use the fetch api in the browser.
+     */
+    function nodeRequire(name: string): any {
+        const req = (module as any).require as NodeRequire;
+        return req(name);
+    }
+
+    function readWasm(): Promise<ArrayBuffer> {
+        // browser
+        if (isBrowser) {
+            return fetchWasm().then(response => response.arrayBuffer());
         } else if (typeof module !== "undefined" && module.exports) { // Node.js
-            wasmLoaded = new Promise(function(resolve, reject) {
-                // trick webpack to not detect the require call. Webpack should not include the required files as we only
-                // want to execute this code if we are in node and use the fetch api in the browser.
-                const req = (module as any).require as NodeRequire;
-                const fs = req("fs");
-                const path = req("path");
-                fs.readFile(path.join(__dirname, wasmUri), function(error: any, data: Buffer) {
+            return new Promise(function(resolve, reject) {
+                const fs = nodeRequire("fs");
+                const path = nodeRequire("path");
+                fs.readFile(options.absoluteUri ? wasmUri : path.join(__dirname, wasmUri), function(error: any, data: Buffer) {
                     if (error) {
                         reject(error);
                     } else {
-                        resolve(data.buffer);
+                        resolve(data.buffer.slice(data.byteOffset, data.byteOffset + data.byteLength));
                     }
                 });
             });
         } else if (typeof read !== "undefined") { // Spidermonkey shell
-            wasmLoaded = Promise.resolve(read(wasmUri, "binary").buffer);
-        } else {
-            throw new Error("Unknown environment, can not load WASM module");
+            return Promise.resolve(read(wasmUri, "binary").buffer);
         }
 
-        return wasmLoaded.then(function(buffer) {
-            return WebAssembly.instantiate(buffer, {
+        throw new Error("Unknown environment, can not load WASM module");
+    }
+
+    /**
+     * Compiles the wasm module. The response is compiled while it is downloaded if the browser supports streaming compilation.
+     * Browsers cache the code compiled from a streamed response together with the HTTP cache entry of the wasm file,
+     * a later page load with a cached wasm file therefore does not need to compile the module again.
+     */
+    function compileWasm(): Promise<WebAssemblyModule> {
+        if (isBrowser && typeof WebAssembly.compileStreaming === "function") {
+            return WebAssembly.compileStreaming(fetchWasm()).catch(function() {
+                // e.g. the server does not send the application/wasm content type
+                return readWasm().then(buffer => WebAssembly.compile(buffer));
+            });
+        }
+
+        return readWasm().then(buffer => WebAssembly.compile(buffer));
+    }
+
+    /**
+     * Returns the compiled module. The module is compiled only once per wasm file and shared by all loaders
+     * (and therefore instances) of the file.
+     */
+    function loadModule(): Promise<WebAssemblyModule> {
+        const compiledModules: { [uri: string]: Promise<WebAssemblyModule> } =
+            (__moduleLoader as any).compiledModules = (__moduleLoader as any).compiledModules || {};
+        const key = options.moduleHash || wasmUri;
+
+        if (!compiledModules[key]) {
+            compiledModules[key] = compileWasm();
+
+            // do not cache failed compilations, e.g. the network was not available
+            compiledModules[key].catch(() => delete compiledModules[key]);
+        }
+
+        return compiledModules[key];
+    }
+
+    function loadInstance(): Promise<WebAssemblyInstance> {
+        const loadStart = now();
+        let instantiateStart = 0;
+
+        return loadModule().then(function(compiled) {
+            instantiateStart = now();
+            compileTime = instantiateStart - loadStart;
+
+            return WebAssembly.instantiate(compiled, {
                 env: {
                     memory,
                     STACKTOP: STACK_TOP,
                     __dso_handle: 0,
-                    __cxa_allocate_exception(size: int) {
-                        return malloc(size);
-                    },
-                    __cxa_throw() {
-                        throw new Error("Exceptions not yet supported");
-                    },
-                    __cxa_find_matching_catch_2() {
-                        throw new Error("Exceptions not yet supported");
-                    },
-                    __cxa_free_exception(ptr: int) {
-                        try {
-                            return free(ptr);
-                        } catch (e) {
-                            // tslint:disable-next-line:no-console
-                            console.error("exception during cxa_free_exception: " + e);
-                        }
-                    },
-                    __resumeException() {
-                        throw new Error("Exceptions not yet supported");
-                    },
                     __cxa_atexit() {
                         throw new Error("Exceptions not yet supported");
                     },
-                    pow: Math.pow,
-                    fmod(x: number, y: number) {
-                        return x % y;
-                    },
                     abort(what: any) {
                         // tslint:disable-next-line:no-console
                         console.error("Abort WASM for reason: " + what);
                     },
-                    invoke_ii(index: number, a1: number) {
-                        return instance.exports.dynCall_ii(index, a1);
-                    },
-                    invoke_iii(index: number, a1: number, a2: number) {
-                        return instance.exports.dynCall_iii(index, a1, a2);
-                    },
-                    invoke_iiii(index: number, a1: number, a2: number, a3: number) {
-                        return instance.exports.dynCall_iiii(index, a1, a2, a3);
-                    },
-                    invoke_iiiii(index: number, a1: number, a2: number, a3: number, a4: number) {
-                        return instance.exports.dynCall_iiiii(index, a1, a2, a3, a4);
-                    },
-                    invoke_viii(index: void, a1: number, a2: number, a3: number) {
-                        return instance.exports.dynCall_viii(index, a1, a2, a3);
-                    },
                     sbrk
                 }
             });
-        }).then(result => {
-            instance = result.instance;
+        }).then(instance => {
+            instantiateTime = now() - instantiateStart;
             free = instance.exports.free || free;
-            malloc = instance.exports.malloc || malloc;
+            malloc = instance.exports.speedyJsMalloc || instance.exports.malloc || malloc;
+            allocateObject = instance.exports.speedyJsAllocateObject || malloc;
+            allocateRetained = instance.exports.speedyJsAllocateRetained || allocateRetained;
+            createRetainScope = instance.exports.speedyJsCreateRetainScope || createRetainScope;
+            releaseRetainScope = instance.exports.speedyJsReleaseRetainScope || releaseRetainScope;
             return instance;
         });
     }
 
     let speedyJsGc: () => void | undefined;
     function gc() {
-        if (speedyJsGc) {
+        ++heapGeneration;
+
+        if (speedyJsGc && speedyJsRuntimeStatistics) {
+            const start = now();
+            speedyJsGc();
+            const duration = now() - start;
+            gcTime += duration;
+            gcMaxTime = Math.max(gcMaxTime, duration);
+        } else if (speedyJsGc) {
             speedyJsGc();
         }
     }
 
+    function now(): number {
+        return typeof(performance) !== "undefined" ? performance.now() : Date.now();
+    }
+
+    // Error codes of the runtime, need to match RuntimeError in errors.h
+    const RUNTIME_ERRORS: { [code: number]: () => Error } = {
+        1: () => new RangeError("Invalid array index"),
+        2: () => new RangeError("Invalid array length"),
+        3: () => new Error("Out of memory")
+    };
+
+    let speedyJsTakeError: () => int | undefined;
+    function translateError(error: any): never {
+        const code = speedyJsTakeError ? speedyJsTakeError() : 0;
+
+        if (code === 0) {
+            throw error;
+        }
+
+        // The trap unwound the WASM stack without restoring the stack pointer
+        heap32[GLOBAL_BASE >> 2] = STACK_TOP;
+
+        if (!options.disableHeapNukeOnExit) {
+            gc();
+        }
+
+        throw RUNTIME_ERRORS[code] ? RUNTIME_ERRORS[code]() : new Error("Runtime error " + code);
+    }
+
+    let speedyJsPoolStatistics: () => int | undefined;
+    let speedyJsResetPoolStatistics: () => void | undefined;
+
+    function poolStatistics(): PoolSizeClassStatistics[] {
+        if (!speedyJsPoolStatistics) {
+            return [];
+        }
+
+        // number of size classes followed by size, hits, misses of each size class
+        const statisticsPtr = speedyJsPoolStatistics() >> 2;
+        const sizeClasses = heap32[statisticsPtr];
+        const result: PoolSizeClassStatistics[] = [];
+
+        for (let i = 0; i < sizeClasses; ++i) {
+            const sizeClassPtr = statisticsPtr + 1 + 3 * i;
+            result.push({ size: heap32[sizeClassPtr], hits: heap32[sizeClassPtr + 1] >>> 0, misses: heap32[sizeClassPtr + 2] >>> 0 });
+        }
+
+        return result;
+    }
+
+    let speedyJsRuntimeStatistics: () => int | undefined;
+    let speedyJsResetRuntimeStatistics: () => void | undefined;
+    let gcTime = 0;
+    let gcMaxTime = 0;
+    let marshallingTime = 0;
+    let compileTime = 0;
+    let instantiateTime = 0;
+
+    function runtimeStatistics(): RuntimeStatistics | undefined {
+        if (!speedyJsRuntimeStatistics) {
+            return undefined;
+        }
+
+        // layout of the snapshot, see speedyJsRuntimeStatistics in instrumentation.cc
+        const snapshotPtr = speedyJsRuntimeStatistics() >> 2;
+        const buckets = heap32[snapshotPtr];
+        const uint64 = (ptr: int) => (heap32[ptr] >>> 0) + (heap32[ptr + 1] >>> 0) * 4294967296;
+        const histogram = (ptr: int) => {
+            const counts: number[] = [];
+            for (let i = 0; i < buckets; ++i) {
+                counts.push(heap32[ptr + i] >>> 0);
+            }
+            return counts;
+        };
+
+        return {
+            elementAllocations: heap32[snapshotPtr + 1] >>> 0,
+            arrayGrowths: heap32[snapshotPtr + 2] >>> 0,
+            allocatedElementBytes: uint64(snapshotPtr + 3),
+            gcCalls: heap32[snapshotPtr + 5] >>> 0,
+            gcReleasedAllocations: heap32[snapshotPtr + 6] >>> 0,
+            gcReleasedBytes: uint64(snapshotPtr + 7),
+            elementAllocationSizes: histogram(snapshotPtr + 9),
+            gcReleasedAllocationsPerCall: histogram(snapshotPtr + 9 + buckets),
+            gcTime,
+            gcMaxTime,
+            memorySize: memory.buffer.byteLength,
+            heapSize: heap32[DYNAMIC_TOP_PTR >> 2] - DYNAMIC_BASE,
+            marshallingTime,
+            compileTime,
+            instantiateTime
+        };
+    }
+
+    // A pinned array can only be allocated if the module has been loaded, therefore, release needs no loaded check
+    const releasePinnedArray: { [elementType: string]: (ptr: int) => void } = {};
+
     let loaded: Promise<WebAssemblyInstance> | undefined;
     const loader = function loader() {
         if (loaded) {
@@ -502,18 +1585,467 @@ function __moduleLoader(this: any, wasmUri: string, options: Options): ModuleLoa
 
         loaded = loadInstance().then(instance => {
             speedyJsGc = instance.exports.speedyJsGc;
+            speedyJsTakeError = instance.exports.speedyJsTakeError;
+            speedyJsPoolStatistics = instance.exports.speedyJsPoolStatistics;
+            speedyJsResetPoolStatistics = instance.exports.speedyJsResetPoolStatistics;
+            speedyJsRuntimeStatistics = instance.exports.speedyJsRuntimeStatistics;
+            speedyJsResetRuntimeStatistics = instance.exports.speedyJsResetRuntimeStatistics;
+            releasePinnedArray.i32 = instance.exports.ArrayIi_releasePinned;
+            releasePinnedArray.double = instance.exports.ArrayId_releasePinned;
             return instance;
         });
         return loaded;
     } as ModuleLoader;
 
     loader.gc = gc;
+    loader.translateError = translateError;
+    loader.poolStatistics = poolStatistics;
+    loader.resetPoolStatistics = function() {
+        if (speedyJsResetPoolStatistics) {
+            speedyJsResetPoolStatistics();
+        }
+    };
+    loader.runtimeStatistics = runtimeStatistics;
+    loader.resetRuntimeStatistics = function() {
+        gcTime = 0;
+        gcMaxTime = 0;
+        marshallingTime = 0;
+
+        if (speedyJsResetRuntimeStatistics) {
+            speedyJsResetRuntimeStatistics();
+        }
+    };
+    loader.allocateArray = function(elementType: "i32" | "double", length: int) {
+        return loader().then(instance => {
+            const createPinned = elementType === "i32" ? instance.exports.ArrayIi_createPinnedi : instance.exports.ArrayId_createPinnedi;
+
+            if (!createPinned) {
+                throw new Error("The module does not support pinned arrays of type " + elementType);
+            }
+
+            const array = new RuntimePinnedArray(createPinned(length | 0) | 0, elementType);
+            pinnedArrays.set(array.ptr, array);
+            return array as PinnedArray;
+        });
+    };
+    loader.releaseArray = function(array: PinnedArray) {
+        if (!pinnedArrays.delete(array.ptr)) {
+            return;
+        }
+
+        releasePinnedArray[array.elementType](array.ptr);
+    };
+    loader.retain = function<T extends object>(value: T) {
+        const retained = retainedValues.get(value);
+        if (typeof(retained) === "undefined") {
+            retainedValues.set(value, createRetainedValue());
+        } else {
+            retained.released = false;
+        }
+
+        return value;
+    };
+    loader.release = function(value: object) {
+        const retained = retainedValues.get(value);
+        if (typeof(retained) === "undefined" || retained.released) {
+            return;
+        }
+
+        retained.released = true;
+        releaseRetained(value, retained);
+    };
     loader.toWASM = function(jsObject: Object, objectTypeName: string, types: Types, objectReferences: Map<object, int>) {
-        return jsToWasm(jsObject, objectTypeName, types, objectReferences) as int;
+        if (!speedyJsRuntimeStatistics) {
+            return jsToWasm(jsObject, objectTypeName, types, objectReferences) as int;
+        }
+
+        const start = now();
+        const result = jsToWasm(jsObject, objectTypeName, types, objectReferences) as int;
+        marshallingTime += now() - start;
+        return result;
+    };
+
+    /**
+     * Calls the function on the calling thread. Used by the workers and if no worker pool is available
+     */
+    function callOnThread(name: string, args: any[], argumentTypes: string[], returnType: string, types: Types) {
+        return loader().then(instance => {
+            const argumentObjects = new Map<object, int>();
+            const wasmArgs = args.map((arg, i) => jsToWasm(arg, argumentTypes[i], types, argumentObjects));
+            const result = wasmToJs(instance.exports[name].apply(undefined, wasmArgs), returnType, types, new Map<int, object>());
+
+            if (!options.disableHeapNukeOnExit) {
+                gc();
+            }
+
+            return result;
+        }).catch(translateError);
+    }
+
+    // Size of an argument or result slot of a batch call, see BATCH_SLOT_SIZE
+    const BATCH_SLOT_SIZE = 8;
+
+    function callBatch(name: string, argumentTuples: any[][], argumentTypes: string[], returnType: string) {
+        return loader().then(instance => {
+            const count = argumentTuples.length;
+            const tupleSize = BATCH_SLOT_SIZE * argumentTypes.length;
+            const argumentsPtr = allocateHeap(Math.max(tupleSize * count, BATCH_SLOT_SIZE));
+            const resultsPtr = allocateHeap(Math.max(BATCH_SLOT_SIZE * count, BATCH_SLOT_SIZE));
+
+            if (argumentsPtr === 0 || resultsPtr === 0) {
+                throw new Error("Failed to allocate the arguments of the batch call");
+            }
+
+            for (let i = 0; i < count; ++i) {
+                const tuple = argumentTuples[i];
+                const tuplePtr = argumentsPtr + i * tupleSize;
+
+                for (let j = 0; j < argumentTypes.length; ++j) {
+                    const slotPtr = tuplePtr + j * BATCH_SLOT_SIZE;
+
+                    if (argumentTypes[j] === "double") {
+                        heap64[slotPtr >> 3] = tuple[j];
+                    } else {
+                        heap32[slotPtr >> 2] = argumentTypes[j] === "i1" ? (tuple[j] ? 1 : 0) : tuple[j] | 0;
+                    }
+                }
+            }
+
+            instance.exports[name](argumentsPtr, resultsPtr, count);
+
+            const results = new Array<any>(count);
+            if (returnType !== "void") {
+                for (let i = 0; i < count; ++i) {
+                    const slotPtr = resultsPtr + i * BATCH_SLOT_SIZE;
+
+                    switch (returnType) {
+                        case "i1":
+                            results[i] = heap32[slotPtr >> 2] !== 0;
+                            break;
+                        case "i32":
+                            results[i] = heap32[slotPtr >> 2] | 0;
+                            break;
+                        default:
+                            results[i] = heap64[slotPtr >> 3];
+                    }
+                }
+            }
+
+            if (!options.disableHeapNukeOnExit) {
+                gc();
+            }
+
+            return results;
+        }).catch(translateError);
+    }
+
+    // The constructors of the collections that can be passed to a worker by the name posted to the worker
+    const WORKER_COLLECTIONS: { [name: string]: Function } = {
+        Array,
+        Map,
+        Set
+    };
+
+    /**
+     * Replaces the Array, Map and Set constructors with their name as functions cannot be posted to a worker
+     */
+    function serializeTypes(types: Types) {
+        const serialized: { [name: string]: any } = {};
+
+        for (const name of Object.keys(types)) {
+            const type = types[name];
+            const collection = Object.keys(WORKER_COLLECTIONS).find(candidate => WORKER_COLLECTIONS[candidate] === type.constructor);
+
+            if (!type.primitive && !collection) {
+                throw new Error("Only primitives, arrays, maps and sets can be passed to a worker");
+            }
+
+            serialized[name] = { primitive: type.primitive, fields: type.fields, typeArguments: type.typeArguments, collection };
+        }
+
+        return serialized;
+    }
+
+    function deserializeTypes(serialized: { [name: string]: any }): Types {
+        const types: Types = {};
+
+        for (const name of Object.keys(serialized)) {
+            const type = serialized[name];
+            const constructor = type.collection ? WORKER_COLLECTIONS[type.collection] : undefined;
+            types[name] = { primitive: type.primitive, fields: type.fields, typeArguments: type.typeArguments, constructor };
+        }
+
+        return types;
+    }
+
+    // Error types that are rebuilt on the calling thread for an error thrown in a worker
+    const ERROR_TYPES: { [name: string]: new (message?: string) => Error } = {
+        Error,
+        RangeError,
+        TypeError,
+        ReferenceError
     };
 
+    /**
+     * Converts an error to a message that can be posted from a worker to the calling thread (errors are not cloneable
+     * in all environments)
+     */
+    function serializeError(error: any): { name: string, message: string } {
+        if (error instanceof Error) {
+            return { name: error.name, message: error.message };
+        }
+
+        return { name: "Error", message: String(error) };
+    }
+
+    /**
+     * Creates the error posted by a worker with the same type as the error thrown in the worker,
+     * e.g. the RangeError created by translateError
+     */
+    function deserializeError(error: { name: string, message: string }): Error {
+        const ErrorType = ERROR_TYPES[error.name] || Error;
+        return new ErrorType(error.message);
+    }
+
+    /**
+     * Entry point of a worker. The function is serialized and executes in the global scope of the worker
+     */
+    function workerMain(this: any,
+                        factory: typeof __moduleLoader,
+                        uri: string,
+                        workerOptions: Options,
+                        post: (message: any) => void,
+                        onMessage: (handler: (message: any) => void) => void) {
+        const workerLoader = factory(uri, workerOptions) as any;
+
+        onMessage(function(message: any) {
+            workerLoader.handleWorkerMessage(message).then(
+                (result: any) => post({ id: message.id, result }),
+                (error: any) => post({ id: message.id, error: workerLoader.serializeError(error) })
+            );
+        });
+    }
+
+    interface WorkerTask {
+        message: { id: int, name: string, args: any[], argumentTypes: string[], returnType: string, types: any };
+        resolve: (result: any) => void;
+        reject: (error: Error) => void;
+    }
+
+    interface PoolWorker {
+        post(message: any): void;
+        busy: boolean;
+
+        /**
+         * The id of the task executed by the worker right now
+         */
+        taskId?: int;
+
+        /**
+         * The number of tasks completed by this worker
+         */
+        completedTasks: int;
+        failed: boolean;
+    }
+
+    const workerPool = {
+        workers: [] as PoolWorker[],
+        queue: [] as WorkerTask[],
+        pending: new Map<int, WorkerTask>(),
+        nextTaskId: 0,
+        unavailable: false,
+
+        spawn(): PoolWorker | undefined {
+            const source = `(${workerMain.toString()})`;
+            const uri = this.absoluteUri();
+            const workerOptions: Options = Object.assign({}, options, { workers: 0, absoluteUri: true });
+            const factory = `(${__moduleLoader.toString()})`;
+
+            try {
+                if (isBrowser && typeof Worker !== "undefined") {
+                    const code = `${source}.call(self, ${factory}, ${JSON.stringify(uri)}, ${JSON.stringify(workerOptions)}, ` +
+                        `function(message) { self.postMessage(message); }, ` +
+                        `function(handler) { self.onmessage = function(event) { handler(event.data); }; });`;
+                    const worker = new Worker(URL.createObjectURL(new Blob([code], { type: "application/javascript" })));
+                    const poolWorker = this.createPoolWorker((message: any) => worker.postMessage(message));
+                    worker.onmessage = (event: any) => this.completed(poolWorker, event.data);
+                    worker.onerror = (event: any) => {
+                        event.preventDefault();
+                        this.failed(poolWorker, new Error("The worker failed: " + (event.message || "unknown error")));
+                    };
+                    return poolWorker;
+                } else if (!isBrowser && typeof module !== "undefined" && module.exports) {
+                    const threads = nodeRequire("worker_threads");
+                    const code = `var threads = require("worker_threads"); var module = { exports: {}, require: require }; ` +
+                        `${source}.call(this, ${factory}, ${JSON.stringify(uri)}, ${JSON.stringify(workerOptions)}, ` +
+                        `function(message) { threads.parentPort.postMessage(message); }, function(handler) { threads.parentPort.on("message", handler); });`;
+                    const worker = new threads.Worker(code, { eval: true });
+                    const poolWorker = this.createPoolWorker((message: any) => worker.postMessage(message));
+                    worker.on("message", (message: any) => this.completed(poolWorker, message));
+                    worker.on("error", (error: any) => this.failed(poolWorker, new Error("The worker failed: " + (error && error.message || error))));
+                    worker.on("exit", (code: number) => this.failed(poolWorker, new Error("The worker stopped with exit code " + code)));
+                    worker.unref();
+                    return poolWorker;
+                }
+            } catch (e) {
+                // workers are not supported in this environment, the calls are executed on the calling thread
+            }
+
+            return undefined;
+        },
+
+        createPoolWorker(post: (message: any) => void): PoolWorker {
+            return { post, busy: false, completedTasks: 0, failed: false };
+        },
+
+        absoluteUri(): string {
+            if (options.absoluteUri) {
+                return wasmUri;
+            }
+
+            if (isBrowser) {
+                return new URL(wasmUri, location.href).href;
+            }
+
+            return nodeRequire("path").join(__dirname, wasmUri);
+        },
+
+        dispatch(task: WorkerTask) {
+            let worker = this.workers.find(candidate => !candidate.busy);
+
+            if (!worker && !this.unavailable && this.workers.length < (options.workers || 0)) {
+                worker = this.spawn();
+                if (worker) {
+                    this.workers.push(worker);
+                } else if (this.workers.length === 0) {
+                    this.unavailable = true;
+                    const { name, args, argumentTypes, returnType, types } = task.message;
+                    callOnThread(name, args, argumentTypes, returnType, deserializeTypes(types)).then(task.resolve, task.reject);
+                    return;
+                }
+            }
+
+            if (!worker) {
+                this.queue.push(task);
+                return;
+            }
+
+            worker.busy = true;
+            worker.taskId = task.message.id;
+            this.pending.set(task.message.id, task);
+            worker.post(task.message);
+        },
+
+        completed(worker: PoolWorker, message: { id: int, result?: any, error?: { name: string, message: string } }) {
+            const task = this.pending.get(message.id)!;
+            this.pending.delete(message.id);
+            worker.busy = false;
+            worker.taskId = undefined;
+            ++worker.completedTasks;
+
+            if (typeof message.error !== "undefined") {
+                task.reject(deserializeError(message.error));
+            } else {
+                task.resolve(message.result);
+            }
+
+            const next = this.queue.shift();
+            if (next) {
+                this.dispatch(next);
+            }
+        },
+
+        /**
+         * Removes a crashed or terminated worker from the pool and rejects the task it was executing. The worker is
+         * replaced by a new worker for the queued tasks. A worker that fails before completing any task indicates that
+         * the workers cannot execute the module in this environment, no new workers are spawned and the later calls are
+         * executed on the calling thread. The queued tasks are rejected if no other worker remains to execute them.
+         */
+        failed(worker: PoolWorker, error: Error) {
+            // a failed node worker emits error and exit
+            if (worker.failed) {
+                return;
+            }
+
+            worker.failed = true;
+            this.workers.splice(this.workers.indexOf(worker), 1);
+
+            if (typeof worker.taskId !== "undefined") {
+                const task = this.pending.get(worker.taskId)!;
+                this.pending.delete(worker.taskId);
+                worker.taskId = undefined;
+                task.reject(error);
+            }
+
+            if (worker.completedTasks === 0) {
+                this.unavailable = true;
+            }
+
+            if (this.unavailable && this.workers.length === 0) {
+                for (const task of this.queue.splice(0, this.queue.length)) {
+                    task.reject(error);
+                }
+            } else {
+                const next = this.queue.shift();
+                if (next) {
+                    this.dispatch(next);
+                }
+            }
+        }
+    };
+
+    loader.callInWorker = function(name: string, args: any[], argumentTypes: string[], returnType: string, types: Types) {
+        if (!options.workers || workerPool.unavailable) {
+            return callOnThread(name, args, argumentTypes, returnType, types);
+        }
+
+        return new Promise((resolve, reject) => {
+            const message = { id: workerPool.nextTaskId++, name, args, argumentTypes, returnType, types: serializeTypes(types) };
+            workerPool.dispatch({ message, resolve, reject });
+        });
+    };
+
+    loader.callBatch = callBatch;
+
+    (loader as any).handleWorkerMessage = function(message: WorkerTask["message"]) {
+        return callOnThread(message.name, message.args, message.argumentTypes, message.returnType, deserializeTypes(message.types));
+    };
+
+    (loader as any).serializeError = serializeError;
+
     loader.toJSObject = function(objectPointer: int, objectTypeName: string, types: Types) {
-        return wasmToJs(objectPointer, objectTypeName, types, new Map<int, object>());
+        if (!speedyJsRuntimeStatistics) {
+            return wasmToJs(objectPointer, objectTypeName, types, new Map<int, object>());
+        }
+
+        const start = now();
+        const result = wasmToJs(objectPointer, objectTypeName, types, new Map<int, object>());
+        marshallingTime += now() - start;
+        return result;
+    };
+
+    // name of the snapshot function -> the converted result
+    const snapshotValues = new Map<string, any>();
+    loader.snapshotResult = function(name: string, returnType: string, types: Types) {
+        return loader().then(() => {
+            if (!snapshotValues.has(name)) {
+                const ptr = options.snapshotResults![name];
+                const value = returnType === "void" ? undefined : wasmToJs(ptr, returnType, types, new Map<int, object>());
+
+                // The snapshotted objects survive the gc, the value is therefore retained without a scope
+                if (typeof(value) === "object" && value !== null) {
+                    retainedValues.set(value, createRetainedValue(ptr, returnType));
+                }
+
+                snapshotValues.set(name, value);
+            }
+
+            return snapshotValues.get(name);
+        });
+    };
+
+    loader.toLazyJSObject = function(objectPointer: int, objectTypeName: string, types: Types) {
+        return new LazyViewFactory(types).view(objectPointer, objectTypeName);
     };
 
     return loader;
@@ -0,0 +1,223 @@
+import * as fs from "fs";
+import * as path from "path";
+import * as ts from "typescript";
+import {CodeGenerationDiagnostics} from "../../code-generation-diagnostic";
+import {CompilationContext} from "../../compilation-context";
+
+const WASM_PAGE_SIZE = 64 * 1024;
+
+/**
+ * Unchanged bytes in between two changed ranges that are included in a single data segment instead of starting a new one
+ */
+const MAX_SEGMENT_GAP = 32;
+
+/**
+ * The layout of the linear memory, needs to match the layout created by the module loader (see __moduleLoader)
+ */
+export interface MemoryLayout {
+    globalBase: number;
+    staticBump: number;
+    totalStack: number;
+    initialMemory: number;
+}
+
+/**
+ * The heap snapshot of a wasm module, created by executing the snapshot functions at build time
+ */
+export interface HeapSnapshot {
+    /**
+     * The size of the linear memory in bytes needed to hold the snapshot (a multiple of the wasm page size)
+     */
+    memorySize: number;
+
+    /**
+     * The values returned by the snapshot functions (by the name of the wasm function), pointers for objects
+     */
+    results: { [functionName: string]: number };
+}
+
+export interface DataSegment {
+    offset: number;
+    data: Uint8Array;
+}
+
+/**
+ * Tests if the entry function is one of the snapshot functions. The snapshot functions are qualified by the path of
+ * their source file relative to the root directory, e.g. "lookup/tables.ts:createTable", as entry functions of different
+ * source files can have the same name. A diagnostic is reported for a snapshot function that is not qualified.
+ * @param functionDeclaration the entry function
+ * @param compilationContext the compilation context
+ */
+export function isSnapshotFunction(functionDeclaration: ts.FunctionDeclaration, compilationContext: CompilationContext) {
+    const name = functionDeclaration.name!.text;
+    const relativePath = path.relative(compilationContext.rootDir, functionDeclaration.getSourceFile().fileName).replace(/\\/g, "/");
+    const qualifiedName = `${relativePath}:${name}`;
+    const snapshotFunctions = compilationContext.compilerOptions.snapshotFunctions;
+
+    if (snapshotFunctions.indexOf(name) !== -1) {
+        throw CodeGenerationDiagnostics.unqualifiedSnapshotFunction(functionDeclaration, qualifiedName);
+    }
+
+    return snapshotFunctions.indexOf(qualifiedName) !== -1;
+}
+
+/**
+ * Rounds the static bump of the wast meta data up to the alignment used by the loader
+ */
+export function alignStaticBump(staticBump: number | undefined) {
+    return alignMemory(staticBump || 0);
+}
+
+/**
+ * Instantiates the wasm module, calls the snapshot functions and captures the memory that has been changed by them.
+ * The heap is frozen after the functions have been executed so that the created objects survive the gc.
+ * The global data (including the state of the allocators and the heap top) and the heap are captured as data segments.
+ * @param wasmFileName the wasm file to instantiate
+ * @param layout the memory layout used by the loader
+ * @param functionNames the names of the parameterless wasm functions to execute
+ * @return the snapshot and the data segments to add to the module
+ */
+export function createHeapSnapshot(wasmFileName: string, layout: MemoryLayout, functionNames: string[]): { snapshot: HeapSnapshot, segments: DataSegment[] } {
+    const staticTop = layout.globalBase + layout.staticBump;
+    const stackBase = alignMemory(staticTop);
+    const stackTop = stackBase + layout.totalStack;
+    const dynamicBase = alignMemory(stackTop);
+    // the top of the heap
+    const dynamicTopPtr = staticTop;
+
+    const memory = new WebAssembly.Memory({ initial: layout.initialMemory / WASM_PAGE_SIZE });
+    new Int32Array(memory.buffer)[layout.globalBase >> 2] = stackTop;
+    new Int32Array(memory.buffer)[dynamicTopPtr >> 2] = dynamicBase;
+
+    function sbrk(increment: number) {
+        const heap32 = new Int32Array(memory.buffer);
+        const oldDynamicTop = heap32[dynamicTopPtr >> 2];
+        const newDynamicTop = oldDynamicTop + ((increment + 15) & -16);
+
+        if (newDynamicTop > memory.buffer.byteLength) {
+            memory.grow(Math.ceil((newDynamicTop - memory.buffer.byteLength) / WASM_PAGE_SIZE));
+        }
+
+        new Int32Array(memory.buffer)[dynamicTopPtr >> 2] = newDynamicTop;
+        return oldDynamicTop;
+    }
+
+    const wasmModule = new WebAssembly.Module(fs.readFileSync(wasmFileName));
+    const instance = new WebAssembly.Instance(wasmModule, {
+        env: {
+            memory,
+            STACKTOP: stackTop,
+            __dso_handle: 0,
+            __cxa_atexit() {
+                throw new Error("Exceptions not yet supported");
+            },
+            abort(what: any) {
+                throw new Error("Abort WASM for reason: " + what);
+            },
+            sbrk
+        }
+    });
+
+    // the memory as initialized by the loader and the data segments of the module
+    const initialGlobals = new Uint8Array(memory.buffer).slice(0, dynamicTopPtr + 4);
+    const results: { [functionName: string]: number } = {};
+
+    for (const name of functionNames) {
+        try {
+            const result = instance.exports[name]();
+            results[name] = typeof(result) === "undefined" ? 0 : result;
+        } catch (error) {
+            throw new Error(`The snapshot function ${name} failed: ${error.message}`);
+        }
+    }
+
+    if (!instance.exports.speedyJsFreezeHeap()) {
+        throw new Error("Failed to freeze the heap of the snapshot");
+    }
+
+    const heap8 = new Uint8Array(memory.buffer);
+    const heapTop = new Int32Array(memory.buffer)[dynamicTopPtr >> 2];
+    const segments = [
+        ...changedRanges(heap8, initialGlobals, layout.globalBase, dynamicTopPtr + 4),
+        ...changedRanges(heap8, undefined, dynamicBase, heapTop)
+    ];
+
+    return {
+        snapshot: { memorySize: memory.buffer.byteLength, results },
+        segments
+    };
+}
+
+/**
+ * Adds the data segments to the module of the wast file and grows the initial size of the imported memory to the size of
+ * the snapshot (a data segment needs to fit into the initial memory). The segments are placed after the segments of
+ * the module and therefore override them.
+ * @param wast the content of the wast file
+ * @param snapshot the snapshot
+ * @param segments the data segments of the snapshot
+ * @return the wast file including the snapshot
+ */
+export function addHeapSnapshotToWast(wast: string, snapshot: HeapSnapshot, segments: DataSegment[]): string {
+    const metaDataIndex = wast.indexOf("\n;; METADATA:");
+    const moduleEnd = wast.lastIndexOf(")", metaDataIndex === -1 ? wast.length : metaDataIndex);
+    const dataSegments = segments.map(segment => ` (data (i32.const ${segment.offset}) "${escapeWastString(segment.data)}")\n`).join("");
+
+    const withSegments = wast.substring(0, moduleEnd) + dataSegments + wast.substring(moduleEnd);
+    return withSegments.replace(/(\(import "env" "memory" \(memory \$0 )(\d+)/, (match, declaration, pages) => {
+        return declaration + Math.max(parseInt(pages, 10), snapshot.memorySize / WASM_PAGE_SIZE);
+    });
+}
+
+/**
+ * Returns the ranges of the memory in between start and end that differ from the initial memory (or from zero)
+ */
+export function changedRanges(memory: Uint8Array, initial: Uint8Array | undefined, start: number, end: number): DataSegment[] {
+    const segments: DataSegment[] = [];
+    let segmentStart = -1;
+    let lastChanged = -1;
+
+    for (let i = start; i < end; ++i) {
+        if (memory[i] === (initial ? initial[i] : 0)) {
+            continue;
+        }
+
+        if (segmentStart !== -1 && i - lastChanged > MAX_SEGMENT_GAP) {
+            segments.push({ offset: segmentStart, data: memory.slice(segmentStart, lastChanged + 1) });
+            segmentStart = -1;
+        }
+
+        if (segmentStart === -1) {
+            segmentStart = i;
+        }
+
+        lastChanged = i;
+    }
+
+    if (segmentStart !== -1) {
+        segments.push({ offset: segmentStart, data: memory.slice(segmentStart, lastChanged + 1) });
+    }
+
+    return segments;
+}
+
+/**
+ * Escapes the bytes for a wast string literal, non printable characters are written as hex escape sequence (\xx)
+ */
+export function escapeWastString(data: Uint8Array) {
+    let result = "";
+
+    for (const byte of Array.from(data)) {
+        // printable ascii characters except " and \
+        if (byte >= 0x20 && byte < 0x7f && byte !== 0x22 && byte !== 0x5c) {
+            result += String.fromCharCode(byte);
+        } else {
+            result += "\\" + (byte < 16 ? "0" : "") + byte.toString(16);
+        }
+    }
+
+    return result;
+}
+
+function alignMemory(size: number): number {
+    return Math.ceil(size / 16) * 16;
+}
@@ -1,4 +1,5 @@
 import * as ts from "typescript";
+import {HeapSnapshot} from "./heap-snapshot";
 import {PerFileSourceFileRewirter} from "./per-file-source-file-rewriter";
 import {WastMetaData} from "./wast-meta-data";
 
@@ -12,6 +13,12 @@ export class NoopSourceFileRewriter implements PerFileSourceFileRewirter {
     setWasmUrl(wasmUrl: string): void {
         // noop
     }
+    setWasmHash(wasmHash: string): void {
+        // noop
+    }
+    setHeapSnapshot(snapshot: HeapSnapshot): void {
+        // noop
+    }
 
     rewriteEntryFunction(name: string, functionDeclaration: ts.FunctionDeclaration): ts.FunctionDeclaration {
         return functionDeclaration;
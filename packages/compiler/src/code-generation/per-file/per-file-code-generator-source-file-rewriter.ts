@@ -1,8 +1,18 @@
 import * as assert from "assert";
 import * as ts from "typescript";
+import {CodeGenerationDiagnostics} from "../../code-generation-diagnostic";
 import {TypeChecker} from "../../type-checker";
 import {CodeGenerationContext} from "../code-generation-context";
+import {
+    BATCH_FUNCTION_POSTFIX,
+    createBatchFunctionDeclaration,
+    declaresValue,
+    getBatchFunctionName,
+    hasBatchEntryFunction
+} from "../util/batch-entry-function";
 import {isMaybeObjectType} from "../util/types";
+import {isValueClass} from "../util/value-classes";
+import {alignStaticBump, HeapSnapshot, isSnapshotFunction} from "./heap-snapshot";
 import {PerFileSourceFileRewirter} from "./per-file-source-file-rewriter";
 
 import {MODULE_LOADER_FACTORY_NAME, PerFileWasmLoaderEmitHelper} from "./per-file-wasm-loader-emit-helper";
@@ -14,6 +24,7 @@ interface Types {
         fields: Array<{ name: string, type: string }>,
         constructor?: ts.Identifier;
         typeArguments: string[];
+        valueClass?: boolean;
     };
 }
 
@@ -22,11 +33,14 @@ interface Types {
  */
 export class PerFileCodeGeneratorSourceFileRewriter implements PerFileSourceFileRewirter {
 
-    private loadWasmFunctionIdentifier: ts.Identifier | undefined;
+    protected loadWasmFunctionIdentifier: ts.Identifier | undefined;
     private wasmUrl: string | undefined;
+    private wasmHash: string | undefined;
     private wastMetaData: Partial<WastMetaData> = {};
+    private batchEntryFunctions: ts.FunctionDeclaration[] = [];
+    private heapSnapshot: HeapSnapshot | undefined;
 
-    constructor(private context: CodeGenerationContext) {}
+    constructor(protected context: CodeGenerationContext) {}
 
     setWastMetaData(metadata: WastMetaData): void {
         this.wastMetaData = metadata;
@@ -36,6 +50,14 @@ export class PerFileCodeGeneratorSourceFileRewriter implements PerFileSourceFile
         this.wasmUrl = wasmUrl;
     }
 
+    setWasmHash(wasmHash: string): void {
+        this.wasmHash = wasmHash;
+    }
+
+    setHeapSnapshot(snapshot: HeapSnapshot): void {
+        this.heapSnapshot = snapshot;
+    }
+
     /**
      * Generates a new function declaration with an equal signature but replaced body. The body looks like
      * @code
@@ -46,6 +68,15 @@ export class PerFileCodeGeneratorSourceFileRewriter implements PerFileSourceFile
      *
      * return result; // result is potentially casted
      *
+     * A trap raised by the runtime (e.g. an invalid array index) is translated into the JS error by translateError.
+     *
+     * With a worker pool, the call is dispatched to a worker if all argument and return types can be posted to a worker.
+     *
+     * With lazyResults, the returned objects are lazy views of the heap and the gc is called before the function is
+     * invoked (releasing the heap of the previous call) instead of on exit.
+     *
+     * A snapshot function is not called, it returns its result of the execution at build time (see snapshotFunctions).
+     *
      * fn is replaced with the passed in name
      * @param name the name of the function in the compilation
      * @param functionDeclaration the function declaration to transform
@@ -63,6 +94,39 @@ export class PerFileCodeGeneratorSourceFileRewriter implements PerFileSourceFile
         const typesIdentifier = ts.createUniqueName("types");
         const typesDeclaration = ts.createVariableStatement(undefined , [ts.createVariableDeclaration(typesIdentifier, undefined, serializedTypes)]);
 
+        const compilerOptions = this.context.compilationContext.compilerOptions;
+
+        // return loadWasmModule.snapshotResult("fn", returnType, types);
+        if (!compilerOptions.wholeProgram && isSnapshotFunction(functionDeclaration, this.context.compilationContext)) {
+            const returnType = signature.getReturnType();
+            const snapshotResult = ts.createCall(ts.createPropertyAccess(this.loadWasmFunctionIdentifier, "snapshotResult"), undefined, [
+                ts.createLiteral(name),
+                ts.createLiteral(returnType.flags & ts.TypeFlags.Void ? "void" : serializedTypeName(returnType, this.context.typeChecker)),
+                typesIdentifier
+            ]);
+
+            return this.updateEntryFunction(functionDeclaration, [typesDeclaration, ts.createReturn(snapshotResult)]);
+        }
+
+        if (hasBatchEntryFunction(functionDeclaration, argumentTypes, signature.getReturnType(), compilerOptions)) {
+            this.batchEntryFunctions.push(this.createBatchEntryFunction(name, functionDeclaration, argumentTypes, signature.getReturnType()));
+        }
+
+        // return loadWasmModule.callInWorker("fn", [args], [argumentTypes], returnType, types);
+        if (compilerOptions.workers > 0 && [...argumentTypes, signature.getReturnType()].every(type => this.isWorkerTransferable(type))) {
+            const callInWorker = ts.createCall(ts.createPropertyAccess(this.loadWasmFunctionIdentifier, "callInWorker"), undefined, [
+                ts.createLiteral(name),
+                ts.createArrayLiteral(signature.declaration.parameters.map(parameter => {
+                    return ts.createIdentifier(this.context.typeChecker.getSymbolAtLocation(parameter.name).name);
+                })),
+                toLiteral(argumentTypes.map(argumentType => serializedTypeName(argumentType, this.context.typeChecker))),
+                ts.createLiteral(serializedTypeName(signature.getReturnType(), this.context.typeChecker)),
+                typesIdentifier
+            ]);
+
+            return this.updateEntryFunction(functionDeclaration, [typesDeclaration, ts.createReturn(callInWorker)]);
+        }
+
         let argumentObjects: ts.Identifier;
         // argumentObjects = new Map();
         if (argumentTypes.findIndex(argumentType => (argumentType.flags & ts.TypeFlags.Object) !== 0 || isMaybeObjectType(argumentType)) !== -1) {
@@ -84,15 +148,22 @@ export class PerFileCodeGeneratorSourceFileRewriter implements PerFileSourceFile
             argumentObjects)
         );
 
+        const nukeHeap = ts.createStatement(ts.createCall(ts.createPropertyAccess(this.loadWasmFunctionIdentifier, "gc"), [], []));
+
+        if (compilerOptions.lazyResults && !compilerOptions.disableHeapNukeOnExit) {
+            // speedyJsGc(); releases the heap (and invalidates the lazy results) of the previous call
+            bodyStatements.push(nukeHeap);
+        }
+
         const functionCall = ts.createCall(targetFunction, [], args);
         const castedResult = this.castToJs(functionCall, signature.getReturnType(), this.loadWasmFunctionIdentifier!, typesIdentifier);
         const resultIdentifier = ts.createUniqueName("result");
         const resultVariable = ts.createVariableDeclaration(resultIdentifier, undefined, castedResult);
         bodyStatements.push(ts.createVariableStatement(undefined, [resultVariable]));
 
-        if (!this.context.compilationContext.compilerOptions.disableHeapNukeOnExit) {
+        if (!compilerOptions.lazyResults && !compilerOptions.disableHeapNukeOnExit) {
             // speedyJsGc();
-            bodyStatements.push(ts.createStatement(ts.createCall(ts.createPropertyAccess(this.loadWasmFunctionIdentifier, "gc"), [], [])));
+            bodyStatements.push(nukeHeap);
         }
 
         bodyStatements.push(ts.createReturn(resultIdentifier));
@@ -102,10 +173,61 @@ export class PerFileCodeGeneratorSourceFileRewriter implements PerFileSourceFile
         const loadHandlerBody = ts.createBlock(bodyStatements);
         const loadedHandler = ts.createFunctionExpression(undefined, undefined, "instanceLoaded", undefined, [ instanceParameter ], undefined, loadHandlerBody);
 
-        // loadWasmModule().then(instance => );
+        // loadWasmModule().then(instance => ).catch(loadWasmModule.translateError);
         const loadInstance = ts.createCall(this.loadWasmFunctionIdentifier, [], []);
         const instanceLoaded = ts.createCall(ts.createPropertyAccess(loadInstance, "then"), [], [ loadedHandler ]);
+        const translateError = ts.createPropertyAccess(this.loadWasmFunctionIdentifier, "translateError");
+        const errorsTranslated = ts.createCall(ts.createPropertyAccess(instanceLoaded, "catch"), [], [ translateError ]);
+
+        return this.updateEntryFunction(functionDeclaration, [typesDeclaration, ts.createReturn(errorsTranslated)]);
+    }
+
+    /**
+     * Creates the batch function for the entry function fn that calls the batch entry function of the wasm module
+     * (see defineBatchEntryFunction). The function is exported by name and its declaration is added to the declaration
+     * file of the source file (see createBatchFunctionDeclaration).
+     * @code
+     * export function fnBatch(argumentTuples) {
+     *     return loadWasmModule.callBatch("fnBatch", argumentTuples, [argumentTypes], returnType);
+     * }
+     */
+    private createBatchEntryFunction(name: string, functionDeclaration: ts.FunctionDeclaration, argumentTypes: ts.Type[], returnType: ts.Type) {
+        const sourceFile = functionDeclaration.getSourceFile();
+        const batchFunctionName = getBatchFunctionName(functionDeclaration);
+        if (declaresValue(sourceFile, batchFunctionName)) {
+            throw CodeGenerationDiagnostics.batchFunctionNameCollision(functionDeclaration, batchFunctionName);
+        }
+
+        const additionalDeclarations = this.context.compilationContext.additionalDeclarations;
+        additionalDeclarations.set(sourceFile.fileName, [
+            ...(additionalDeclarations.get(sourceFile.fileName) || []),
+            createBatchFunctionDeclaration(functionDeclaration, argumentTypes, returnType, this.context.typeChecker)
+        ]);
+
+        const argumentTuplesIdentifier = ts.createIdentifier("argumentTuples");
+        const callBatch = ts.createCall(ts.createPropertyAccess(this.loadWasmFunctionIdentifier!, "callBatch"), undefined, [
+            ts.createLiteral(name + BATCH_FUNCTION_POSTFIX),
+            argumentTuplesIdentifier,
+            toLiteral(argumentTypes.map(argumentType => serializedTypeName(argumentType, this.context.typeChecker))),
+            ts.createLiteral(returnType.flags & ts.TypeFlags.Void ? "void" : serializedTypeName(returnType, this.context.typeChecker))
+        ]);
+
+        return ts.createFunctionDeclaration(
+            undefined,
+            [ ts.createToken(ts.SyntaxKind.ExportKeyword) ],
+            undefined,
+            batchFunctionName,
+            undefined,
+            [ ts.createParameter(undefined, undefined, undefined, argumentTuplesIdentifier) ],
+            undefined,
+            ts.createBlock([ ts.createReturn(callBatch) ])
+        );
+    }
 
+    /**
+     * Replaces the body of the entry function (and removes the async modifier as the new body returns the promise)
+     */
+    private updateEntryFunction(functionDeclaration: ts.FunctionDeclaration, body: ts.Statement[]) {
         return ts.updateFunctionDeclaration(
             functionDeclaration,
             functionDeclaration.decorators,
@@ -115,10 +237,29 @@ export class PerFileCodeGeneratorSourceFileRewriter implements PerFileSourceFile
             functionDeclaration.typeParameters,
             functionDeclaration.parameters,
             functionDeclaration.type,
-            ts.createBlock([typesDeclaration, ts.createReturn(instanceLoaded)])
+            ts.createBlock(body)
         );
     }
 
+    /**
+     * Only primitives and arrays, maps and sets of primitives can be posted to a worker (class instances would lose their prototype)
+     */
+    private isWorkerTransferable(type: ts.Type): boolean {
+        if (type.flags & (ts.TypeFlags.BooleanLike | ts.TypeFlags.IntLike | ts.TypeFlags.NumberLike)) {
+            return true;
+        }
+
+        const builtIns = this.context.compilationContext.builtIns;
+        const collectionSymbols = [builtIns.get("Array"), builtIns.get("Map"), builtIns.get("Set")];
+
+        if (type.flags & ts.TypeFlags.Object && collectionSymbols.indexOf(type.getSymbol()) !== -1) {
+            const typeArguments = (type as ts.TypeReference).typeArguments || [];
+            return typeArguments.every(typeArgument => this.isWorkerTransferable(typeArgument));
+        }
+
+        return false;
+    }
+
     rewriteSourceFile(sourceFile: ts.SourceFile, requestEmitHelper: (emitHelper: ts.EmitHelper) => void): ts.SourceFile {
         assert (this.wasmUrl, `No wasm fetch expression set but requested to transform the source file`);
 
@@ -128,41 +269,87 @@ export class PerFileCodeGeneratorSourceFileRewriter implements PerFileSourceFile
 
         requestEmitHelper(new PerFileWasmLoaderEmitHelper());
 
+        // var loadWasmModule = _moduleLoader(...);
+        const loaderVariable = ts.createVariableDeclaration(this.loadWasmFunctionIdentifier, undefined, this.createModuleLoader());
+        const loaderDeclaration = ts.createVariableDeclarationList([loaderVariable]);
+
+        return ts.updateSourceFileNode(sourceFile, [
+            ts.createVariableStatement([], loaderDeclaration),
+            ...this.createLoaderExports(),
+            ...sourceFile.statements
+        ]);
+    }
+
+    /**
+     * Creates the call to the module loader factory for the wasm file
+     * @code
+     * __moduleLoader(wasmUrl, { totalStack, initialMemory, ... })
+     *
+     * The initial memory is grown to the size of the heap snapshot if the wasm file contains a snapshot.
+     */
+    createModuleLoader(): ts.CallExpression {
         const compilerOptions = this.context.compilationContext.compilerOptions;
-        let staticBump = this.wastMetaData.staticBump || 0;
-        if (staticBump % 16 !== 0) {
-            staticBump += 16 - staticBump % 16;
-        }
+        const heapSnapshot = this.heapSnapshot;
 
         const options = toLiteral({
             totalStack: compilerOptions.totalStack,
-            initialMemory: compilerOptions.initialMemory,
+            initialMemory: heapSnapshot ? Math.max(compilerOptions.initialMemory, heapSnapshot.memorySize) : compilerOptions.initialMemory,
             globalBase: compilerOptions.globalBase,
-            staticBump,
-            exposeGc: compilerOptions.exportGc || compilerOptions.exposeGc
+            staticBump: alignStaticBump(this.wastMetaData.staticBump),
+            exposeGc: compilerOptions.exportGc || compilerOptions.exposeGc,
+            moduleHash: this.wasmHash,
+            workers: compilerOptions.workers,
+            disableHeapNukeOnExit: compilerOptions.disableHeapNukeOnExit,
+            snapshotResults: heapSnapshot ? heapSnapshot.results : undefined
         });
 
-        const initializer = ts.createCall(ts.createIdentifier(MODULE_LOADER_FACTORY_NAME), [], [
+        return ts.createCall(ts.createIdentifier(MODULE_LOADER_FACTORY_NAME), [], [
             ts.createLiteral(this.wasmUrl!),
             options
         ]);
+    }
 
-        const statements = sourceFile.statements;
-        const statementsToInsert = [];
-
-        // var loadWasmModule = _moduleLoader(...);
-        const loaderDeclaration = ts.createVariableDeclarationList([ts.createVariableDeclaration(this.loadWasmFunctionIdentifier, undefined, initializer)]);
-        statementsToInsert.push(ts.createVariableStatement([], loaderDeclaration));
+    /**
+     * Creates the declarations of the loader functions exposed or exported by the source file (e.g. speedyJsGc)
+     */
+    protected createLoaderExports(): ts.Statement[] {
+        const compilerOptions = this.context.compilationContext.compilerOptions;
+        const statements: ts.Statement[] = [];
 
         // export let speedyJsGc = loadWasmModule_1.gc; or without export if only expose
         if (compilerOptions.exposeGc || compilerOptions.exportGc) {
-            const speedyJsGcVariable = ts.createVariableDeclaration("speedyJsGc", undefined, ts.createPropertyAccess(this.loadWasmFunctionIdentifier, "gc"));
+            const speedyJsGcVariable = ts.createVariableDeclaration("speedyJsGc", undefined, ts.createPropertyAccess(this.loadWasmFunctionIdentifier!, "gc"));
             const speedyJsGcDeclaration = ts.createVariableDeclarationList([speedyJsGcVariable], ts.NodeFlags.Const);
             const modifiers = compilerOptions.exportGc ? [ ts.createToken(ts.SyntaxKind.ExportKeyword) ] : [];
-            statementsToInsert.push(ts.createVariableStatement(modifiers, speedyJsGcDeclaration));
+            statements.push(ts.createVariableStatement(modifiers, speedyJsGcDeclaration));
+        }
+
+        // export const speedyJsAllocateArray = loadWasmModule_1.allocateArray; export const speedyJsReleaseArray = ...
+        const exportedLoaderFunctions: Array<[string, string]> = [];
+        if (compilerOptions.exportArrayAllocator) {
+            exportedLoaderFunctions.push(["speedyJsAllocateArray", "allocateArray"], ["speedyJsReleaseArray", "releaseArray"]);
         }
 
-        return ts.updateSourceFileNode(sourceFile, [...statementsToInsert, ...statements]);
+        // export const speedyJsRetain = loadWasmModule_1.retain; export const speedyJsRelease = loadWasmModule_1.release;
+        if (compilerOptions.exportRetain) {
+            exportedLoaderFunctions.push(["speedyJsRetain", "retain"], ["speedyJsRelease", "release"]);
+        }
+
+        // export const speedyJsRuntimeStatistics = loadWasmModule_1.runtimeStatistics; ...
+        if (compilerOptions.instrumentRuntime) {
+            exportedLoaderFunctions.push(["speedyJsRuntimeStatistics", "runtimeStatistics"], ["speedyJsResetRuntimeStatistics", "resetRuntimeStatistics"]);
+        }
+
+        for (const [name, loaderFunction] of exportedLoaderFunctions) {
+            const variable = ts.createVariableDeclaration(name, undefined, ts.createPropertyAccess(this.loadWasmFunctionIdentifier!, loaderFunction));
+            const declaration = ts.createVariableDeclarationList([variable], ts.NodeFlags.Const);
+            statements.push(ts.createVariableStatement([ ts.createToken(ts.SyntaxKind.ExportKeyword) ], declaration));
+        }
+
+        // export function fnBatch(argumentTuples) { ... }
+        statements.push(...this.batchEntryFunctions);
+
+        return statements;
     }
 
     private castToJs(returnValue: ts.Expression, type: ts.Type, loadWasmFunctionIdentifier: ts.Identifier, typesIdentifier: ts.Identifier): ts.Expression {
@@ -172,7 +359,8 @@ export class PerFileCodeGeneratorSourceFileRewriter implements PerFileSourceFile
         }
 
         if (type.flags & ts.TypeFlags.Object || isMaybeObjectType(type)) {
-            return ts.createCall(ts.createPropertyAccess(loadWasmFunctionIdentifier, "toJSObject"), undefined, [
+            const toJSObject = this.context.compilationContext.compilerOptions.lazyResults ? "toLazyJSObject" : "toJSObject";
+            return ts.createCall(ts.createPropertyAccess(loadWasmFunctionIdentifier, toJSObject), undefined, [
                 returnValue,
                 ts.createLiteral(serializedTypeName(type, this.context.typeChecker)),
                 typesIdentifier
@@ -249,6 +437,11 @@ export class PerFileCodeGeneratorSourceFileRewriter implements PerFileSourceFile
                 constructor,
                 typeArguments
             };
+
+            // The loader stores the objects of value classes inline when converting arrays (see isValueClass)
+            if (this.context.compilationContext.compilerOptions.valueArrays && isValueClass(type, this.context)) {
+                types[name].valueClass = true;
+            }
         }
 
         return toLiteral(types);
@@ -1,23 +1,29 @@
 import * as assert from "assert";
+import * as crypto from "crypto";
 import * as debug from "debug";
 import * as fs from "fs";
 import * as llvm from "llvm-node";
 import * as path from "path";
+import {COMPILER_RT_FILE, getRuntimeFile, LIBC_RT_FILE, RuntimeVariant, SHARED_LIBRARIES_DIRECTORY} from "speedyjs-runtime";
 import * as ts from "typescript";
 
+import {CodeGenerationDiagnostics} from "../../code-generation-diagnostic";
 import {CompilationContext} from "../../compilation-context";
 import {wasmOpt} from "../../external-tools/binaryen-opt";
 import {s2wasm} from "../../external-tools/binaryen-s2wasm";
 import {wasmAs} from "../../external-tools/binaryen-wasm-as";
 import {LLVMLink} from "../../external-tools/llvm-link";
 import {llc} from "../../external-tools/llvm-llc";
-import {optimize, optimizeLinked} from "../../external-tools/llvm-opt";
+import {getLinkTimeOptimizationArguments, getOptimizationArguments, optimize, optimizeLinked} from "../../external-tools/llvm-opt";
+import {BuildCache} from "../build-cache";
 import {BuildDirectory} from "../build-directory";
 import {CodeGenerationContext} from "../code-generation-context";
 import {CodeGenerator} from "../code-generator";
 import {DefaultCodeGenerationContextFactory} from "../default-code-generation-context-factory";
+import {defineBatchEntryFunction, hasBatchEntryFunction} from "../util/batch-entry-function";
 import {FunctionBuilder} from "../util/function-builder";
 import {createResolvedFunctionFromSignature} from "../value/resolved-function";
+import {addHeapSnapshotToWast, alignStaticBump, createHeapSnapshot, HeapSnapshot, isSnapshotFunction} from "./heap-snapshot";
 import {NoopSourceFileRewriter} from "./llvm-emit-source-file-rewriter";
 import {PerFileCodeGeneratorSourceFileRewriter} from "./per-file-code-generator-source-file-rewriter";
 import {PerFileSourceFileRewirter} from "./per-file-source-file-rewriter";
@@ -30,6 +36,11 @@ interface SourceFileState {
     context: CodeGenerationContext;
     sourceFileRewriter: PerFileSourceFileRewirter;
     requestEmitHelper: (emitHelper: ts.EmitHelper) => void;
+
+    /**
+     * The names of the wasm functions of the snapshot functions declared in the source file
+     */
+    snapshotFunctions: string[];
 }
 
 /**
@@ -37,6 +48,7 @@ interface SourceFileState {
  */
 export class PerFileCodeGenerator implements CodeGenerator {
     private sourceFileStates = new Map<string, SourceFileState>();
+    private buildCache: BuildCache | undefined;
 
     constructor(private context: llvm.LLVMContext, private codeGenerationContextFactory = new DefaultCodeGenerationContextFactory()) {
     }
@@ -47,6 +59,7 @@ export class PerFileCodeGenerator implements CodeGenerator {
         this.sourceFileStates.set(sourceFile.fileName, {
             context,
             requestEmitHelper,
+            snapshotFunctions: [],
             sourceFileRewriter: emitsWasm ? new PerFileCodeGeneratorSourceFileRewriter(context) : new NoopSourceFileRewriter()
         });
     }
@@ -66,6 +79,22 @@ export class PerFileCodeGenerator implements CodeGenerator {
         builder.define(resolvedFunction.definition!);
         context.addEntryFunction(mangledName);
 
+        if (isSnapshotFunction(functionDeclaration, context.compilationContext)) {
+            if (resolvedFunction.parameters.length > 0) {
+                throw CodeGenerationDiagnostics.snapshotFunctionWithParameters(functionDeclaration);
+            }
+
+            state.snapshotFunctions.push(mangledName);
+        }
+
+        // snapshot functions are never called at runtime
+        const parameterTypes = resolvedFunction.parameters.map(parameter => parameter.type);
+        if (hasBatchEntryFunction(functionDeclaration, parameterTypes, resolvedFunction.returnType, context.compilationContext.compilerOptions)
+            && state.snapshotFunctions.indexOf(mangledName) === -1) {
+            const batchFunction = defineBatchEntryFunction(context.module.getFunction(mangledName)!, resolvedFunction, context);
+            context.addEntryFunction(batchFunction.name);
+        }
+
         return state.sourceFileRewriter.rewriteEntryFunction(mangledName, functionDeclaration, state.requestEmitHelper);
     }
 
@@ -83,7 +112,7 @@ export class PerFileCodeGenerator implements CodeGenerator {
 
         LOG(`Emit module for source file ${sourceFile.fileName}.`);
         llvm.verifyModule(context.module);
-        this.writeModule(sourceFile, state);
+        writeModule(sourceFile, context, state.sourceFileRewriter, this.getBuildCache(context), state.snapshotFunctions);
         LOG(`Module for source file ${sourceFile.fileName} emitted.`);
 
         return state.sourceFileRewriter.rewriteSourceFile(sourceFile, state.requestEmitHelper);
@@ -91,102 +120,153 @@ export class PerFileCodeGenerator implements CodeGenerator {
 
     completeCompilation() {
         this.sourceFileStates.clear();
+        this.buildCache = undefined;
     }
 
-    private writeModule(sourceFile: ts.SourceFile, state: SourceFileState) {
-        const context = state.context;
-        const buildDirectory = BuildDirectory.createTempBuildDirectory();
-        const plainFileName = path.basename(sourceFile.fileName.replace(".ts", ""));
-
-        if (context.compilationContext.compilerOptions.emitLLVM) {
-            const llc = context.module.print();
-            context.compilationContext.compilerHost.writeFile(getOutputFileName(sourceFile, context, ".ll"), llc, false);
-        } else {
-            const transforms = PerFileCodeGenerator.createTransformationChain(context);
-            const transformationContext = {
-                sourceFile,
-                codeGenerationContext: context,
-                buildDirectory,
-                plainFileName,
-                sourceFileRewriter: state.sourceFileRewriter
-            };
-
-            const biteCodeFileName = buildDirectory.getTempFileName(`${plainFileName}.bc`);
-            llvm.writeBitcodeToFile(context.module, biteCodeFileName);
-
-            transforms.reduce((inputFileName, transformation) => transformation.transform(inputFileName, transformationContext), biteCodeFileName);
+    private getBuildCache(context: CodeGenerationContext): BuildCache | undefined {
+        if (!this.buildCache) {
+            this.buildCache = BuildCache.create(context.compilationContext);
         }
 
-        buildDirectory.remove();
+        return this.buildCache;
     }
 
-    private static createTransformationChain(context: CodeGenerationContext) {
-        const optimizationLevel = context.compilationContext.compilerOptions.optimizationLevel;
-
-        const transforms: TransformationStep[] = [
-            LinkTransformationStep.createRuntimeLinking()
-        ];
+    private getSourceFileState(node: ts.Node): SourceFileState {
+        const sourceFile = node.getSourceFile();
+        const state = this.sourceFileStates.get(sourceFile.fileName);
 
-        if (optimizationLevel !== "0") {
-            transforms.push(new OptimizationTransformationStep());
-        }
+        // tslint:disable-next-line:max-line-length
+        assert(state, `First call beginSourceFile before calling any other functions on the code generator (state missing for source file ${sourceFile.fileName}).`);
 
-        transforms.push(
-            LinkTransformationStep.createSharedLibsLinking(),
-            new LinkTimeOptimizationTransformationStep());
+        return state!;
+    }
 
-        if (context.compilationContext.compilerOptions.saveBc) {
-            transforms.push(new CopyFileToOutputDirectoryTransformationStep(".bc", true));
-        }
+    private createContext(sourceFile: ts.SourceFile, compilationContext: CompilationContext): CodeGenerationContext {
+        const relativePath = path.relative(compilationContext.rootDir, sourceFile.fileName);
+        const module = createWasmModule(sourceFile.moduleName || relativePath, relativePath, this.context);
 
-        transforms.push(
-            new LLCTransformationStep(),
-            new S2WasmTransformationStep()
-        );
+        return this.codeGenerationContextFactory.createContext(compilationContext, module);
+    }
+}
 
-        if (context.compilationContext.compilerOptions.binaryenOpt && optimizationLevel !== "0") {
-            transforms.push(new BinaryenOptTransformationStep());
-        }
+/**
+ * Creates an llvm module that targets wasm32
+ * @param moduleName the name of the module
+ * @param sourceFileName the name of the source file of the module
+ * @param context the llvm context
+ */
+export function createWasmModule(moduleName: string, sourceFileName: string, context: llvm.LLVMContext): llvm.Module {
+    const module = new llvm.Module(moduleName, context);
+    module.sourceFileName = sourceFileName;
 
-        if (context.compilationContext.compilerOptions.saveWast) {
-            transforms.push(new CopyFileToOutputDirectoryTransformationStep(".wast"));
-        }
+    const target = llvm.TargetRegistry.lookupTarget(WASM_TRIPLE);
+    const targetMachine = target.createTargetMachine(WASM_TRIPLE, "generic");
+    module.dataLayout = targetMachine.createDataLayout();
+    module.targetTriple = WASM_TRIPLE;
 
-        transforms.push(new WasmToAsTransformationStep());
+    return module;
+}
 
-        return transforms;
+/**
+ * Writes the llvm module of the source file. Emits the .ll file if emitLLVM is set, otherwise, the module is linked with
+ * the runtime and compiled to a .wasm file. The url, hash and glue meta data of the wasm file are passed to the
+ * source file rewriter.
+ * @param sourceFile the source file, determines the names of the output files
+ * @param context the code generation context of the module
+ * @param sourceFileRewriter the rewriter of the source file
+ * @param buildCache the build cache or undefined if the external tools are always to be executed
+ * @param snapshotFunctions the names of the wasm functions that are executed to create the heap snapshot
+ */
+export function writeModule(sourceFile: ts.SourceFile,
+                            context: CodeGenerationContext,
+                            sourceFileRewriter: PerFileSourceFileRewirter,
+                            buildCache: BuildCache | undefined,
+                            snapshotFunctions: string[] = []) {
+    const buildDirectory = BuildDirectory.createTempBuildDirectory();
+    const plainFileName = path.basename(sourceFile.fileName.replace(".ts", ""));
+
+    if (context.compilationContext.compilerOptions.emitLLVM) {
+        const llc = context.module.print();
+        context.compilationContext.compilerHost.writeFile(getOutputFileName(sourceFile, context, ".ll"), llc, false);
+    } else {
+        const transforms = createTransformationChain(context, snapshotFunctions);
+        const transformationContext: TransformationContext = {
+            sourceFile,
+            codeGenerationContext: context,
+            buildDirectory,
+            buildCache,
+            plainFileName,
+            sourceFileRewriter,
+            snapshotFunctions
+        };
+
+        const biteCodeFileName = buildDirectory.getTempFileName(`${plainFileName}.bc`);
+        llvm.writeBitcodeToFile(context.module, biteCodeFileName);
+
+        transforms.reduce((inputFileName, transformation) => transformation.transform(inputFileName, transformationContext), biteCodeFileName);
     }
 
-    private getSourceFileState(node: ts.Node): SourceFileState {
-        const sourceFile = node.getSourceFile();
-        const state = this.sourceFileStates.get(sourceFile.fileName);
+    buildDirectory.remove();
+}
 
-        // tslint:disable-next-line:max-line-length
-        assert(state, `First call beginSourceFile before calling any other functions on the code generator (state missing for source file ${sourceFile.fileName}).`);
+function createTransformationChain(context: CodeGenerationContext, snapshotFunctions: string[]) {
+    const optimizationLevel = context.compilationContext.compilerOptions.optimizationLevel;
 
-        return state!;
+    const transforms: TransformationStep[] = [
+        LinkTransformationStep.createRuntimeLinking()
+    ];
+
+    if (optimizationLevel !== "0") {
+        transforms.push(new OptimizationTransformationStep());
     }
 
-    private createContext(sourceFile: ts.SourceFile, compilationContext: CompilationContext): CodeGenerationContext {
-        const relativePath = path.relative(compilationContext.rootDir, sourceFile.fileName);
-        const module = new llvm.Module(sourceFile.moduleName || relativePath, this.context);
-        module.sourceFileName = relativePath;
+    transforms.push(
+        LinkTransformationStep.createSharedLibsLinking(),
+        new LinkTimeOptimizationTransformationStep());
 
-        const target = llvm.TargetRegistry.lookupTarget(WASM_TRIPLE);
-        const targetMachine = target.createTargetMachine(WASM_TRIPLE, "generic");
-        module.dataLayout = targetMachine.createDataLayout();
-        module.targetTriple = WASM_TRIPLE;
+    if (context.compilationContext.compilerOptions.saveBc) {
+        transforms.push(new CopyFileToOutputDirectoryTransformationStep(".bc", true));
+    }
 
-        return this.codeGenerationContextFactory.createContext(compilationContext, module);
+    transforms.push(
+        new LLCTransformationStep(),
+        new S2WasmTransformationStep(),
+        new WastMetaDataTransformationStep()
+    );
+
+    if (context.compilationContext.compilerOptions.binaryenOpt && optimizationLevel !== "0") {
+        transforms.push(new BinaryenOptTransformationStep());
+    }
+
+    if (snapshotFunctions.length > 0) {
+        transforms.push(new HeapSnapshotTransformationStep(), new HeapSnapshotMetaDataTransformationStep());
+    }
+
+    if (context.compilationContext.compilerOptions.saveWast) {
+        transforms.push(new CopyFileToOutputDirectoryTransformationStep(".wast"));
     }
+
+    transforms.push(
+        new WasmToAsTransformationStep(),
+        new WriteWasmFileTransformationStep()
+    );
+
+    return transforms;
 }
 
 interface TransformationContext {
     plainFileName: string;
     buildDirectory: BuildDirectory;
+    buildCache: BuildCache | undefined;
     sourceFile: ts.SourceFile;
     codeGenerationContext: CodeGenerationContext;
     sourceFileRewriter: PerFileSourceFileRewirter;
+    snapshotFunctions: string[];
+
+    /**
+     * The glue meta data of the wast file, set by the WastMetaDataTransformationStep
+     */
+    wastMetaData?: WastMetaData;
 }
 
 interface TransformationStep {
@@ -198,16 +278,66 @@ interface TransformationStep {
     transform(inputFileName: string, transformationContext: TransformationContext): string;
 }
 
-class OptimizationTransformationStep implements TransformationStep {
-    transform(inputFileName: string, {plainFileName, buildDirectory, codeGenerationContext}: TransformationContext): string {
-        const optimizedFileName = buildDirectory.getTempFileName(`${plainFileName}-opt.bc`);
+/**
+ * Step that executes an external tool. The output only depends on the input file and the parameters of the step and,
+ * therefore, is restored from the build cache if the cache contains an entry for the same input and parameters.
+ */
+abstract class CachedTransformationStep implements TransformationStep {
+    /**
+     * @param name the name of the step, part of the cache key
+     * @param postfix the postfix of the output file name
+     */
+    constructor(private name: string, private postfix: string) {}
+
+    transform(inputFileName: string, transformationContext: TransformationContext): string {
+        const { buildCache, buildDirectory, plainFileName } = transformationContext;
+        const outputFileName = buildDirectory.getTempFileName(`${plainFileName}${this.postfix}`);
+
+        if (!buildCache) {
+            return this.execute(inputFileName, outputFileName, transformationContext);
+        }
+
+        const key = buildCache.computeKey(this.name, inputFileName, this.getParameters(transformationContext, buildCache));
+        if (buildCache.restore(key, outputFileName)) {
+            return outputFileName;
+        }
+
+        const result = this.execute(inputFileName, outputFileName, transformationContext);
+        buildCache.store(key, result);
+        return result;
+    }
+
+    /**
+     * Returns the values besides the input file that affect the output of the step
+     */
+    protected abstract getParameters(transformationContext: TransformationContext, buildCache: BuildCache): any[];
+
+    /**
+     * Executes the external tool
+     * @param inputFileName the input file name
+     * @param outputFileName the name of the file to which the output is to be written
+     * @return the name of the output file
+     */
+    protected abstract execute(inputFileName: string, outputFileName: string, transformationContext: TransformationContext): string;
+}
+
+class OptimizationTransformationStep extends CachedTransformationStep {
+    constructor() {
+        super("opt", "-opt.bc");
+    }
+
+    protected getParameters({codeGenerationContext}: TransformationContext): any[] {
+        return [getOptimizationArguments(codeGenerationContext.compilationContext.compilerOptions.optimizationLevel)];
+    }
+
+    protected execute(inputFileName: string, outputFileName: string, {codeGenerationContext}: TransformationContext): string {
         const optimizationLevel = codeGenerationContext.compilationContext.compilerOptions.optimizationLevel;
 
-        return optimize(inputFileName, optimizedFileName, optimizationLevel);
+        return optimize(inputFileName, outputFileName, optimizationLevel);
     }
 }
 
-class LinkTransformationStep implements TransformationStep {
+class LinkTransformationStep extends CachedTransformationStep {
 
     static createRuntimeLinking() {
         return new LinkTransformationStep(true);
@@ -218,31 +348,60 @@ class LinkTransformationStep implements TransformationStep {
     }
 
     private constructor(private runtime: boolean) {
+        super(runtime ? "link-runtime" : "link-shared-libs", "-linked.o");
+    }
 
+    protected getParameters({codeGenerationContext}: TransformationContext, buildCache: BuildCache): any[] {
+        const entryFunctions = codeGenerationContext.getEntryFunctionNames();
+
+        if (this.runtime) {
+            return [entryFunctions, buildCache.hashFile(getRuntimeFile(LinkTransformationStep.getRuntimeVariant(codeGenerationContext)))];
+        }
+
+        const sharedLibs = fs.readdirSync(SHARED_LIBRARIES_DIRECTORY).filter(file => /\.(a|bc|o)$/.test(file)).sort();
+        return [entryFunctions, sharedLibs.map(file => buildCache.hashFile(path.join(SHARED_LIBRARIES_DIRECTORY, file)))];
     }
 
-    transform(inputFileName: string, {plainFileName, buildDirectory, codeGenerationContext}: TransformationContext): string {
+    protected execute(inputFileName: string, outputFileName: string, {buildDirectory, codeGenerationContext}: TransformationContext): string {
         const llvmLinker = new LLVMLink(buildDirectory);
         const entryFunctions = codeGenerationContext.getEntryFunctionNames();
 
         llvmLinker.addByteCodeFile(inputFileName);
 
         if (this.runtime) {
-            llvmLinker.addRuntime(codeGenerationContext.compilationContext.compilerOptions.unsafe);
+            llvmLinker.addRuntime(LinkTransformationStep.getRuntimeVariant(codeGenerationContext));
         } else {
             llvmLinker.addSharedLibs();
         }
 
-        return llvmLinker.link(buildDirectory.getTempFileName(`${plainFileName}-linked.o`), entryFunctions);
+        return llvmLinker.link(outputFileName, entryFunctions);
+    }
+
+    private static getRuntimeVariant(codeGenerationContext: CodeGenerationContext): RuntimeVariant {
+        const compilerOptions = codeGenerationContext.compilationContext.compilerOptions;
+        return {
+            unsafe: compilerOptions.unsafe,
+            arena: compilerOptions.arenaAllocator,
+            simd: compilerOptions.simd,
+            instrumented: compilerOptions.instrumentRuntime
+        };
     }
 }
 
-class LinkTimeOptimizationTransformationStep implements TransformationStep {
-    transform(inputFileName: string, {plainFileName, buildDirectory, codeGenerationContext}: TransformationContext): string {
-        const optimizedFileName = buildDirectory.getTempFileName(`${plainFileName}-lopt.bc`);
+class LinkTimeOptimizationTransformationStep extends CachedTransformationStep {
+    constructor() {
+        super("lto", "-lopt.bc");
+    }
+
+    protected getParameters({codeGenerationContext}: TransformationContext): any[] {
+        const optimizationLevel = codeGenerationContext.compilationContext.compilerOptions.optimizationLevel;
+        return [getLinkTimeOptimizationArguments(codeGenerationContext.getEntryFunctionNames(), optimizationLevel)];
+    }
+
+    protected execute(inputFileName: string, outputFileName: string, {codeGenerationContext}: TransformationContext): string {
         const entryFunctionNames = codeGenerationContext.getEntryFunctionNames();
 
-        return optimizeLinked(inputFileName, entryFunctionNames, optimizedFileName, codeGenerationContext.compilationContext.compilerOptions.optimizationLevel);
+        return optimizeLinked(inputFileName, entryFunctionNames, outputFileName, codeGenerationContext.compilationContext.compilerOptions.optimizationLevel);
     }
 }
 
@@ -263,19 +422,47 @@ class CopyFileToOutputDirectoryTransformationStep implements TransformationStep
     }
 }
 
-class LLCTransformationStep implements TransformationStep {
-    transform(inputFileName: string, { plainFileName, buildDirectory }: TransformationContext): string {
-        return llc(inputFileName, buildDirectory.getTempFileName(`${plainFileName}.s`));
+class LLCTransformationStep extends CachedTransformationStep {
+    constructor() {
+        super("llc", ".s");
+    }
+
+    protected getParameters({codeGenerationContext}: TransformationContext): any[] {
+        return [LLCTransformationStep.getAttributes(codeGenerationContext)];
+    }
+
+    protected execute(inputFileName: string, outputFileName: string, {codeGenerationContext}: TransformationContext): string {
+        return llc(inputFileName, outputFileName, LLCTransformationStep.getAttributes(codeGenerationContext));
+    }
+
+    private static getAttributes(codeGenerationContext: CodeGenerationContext) {
+        return codeGenerationContext.compilationContext.compilerOptions.simd ? ["+simd128"] : [];
     }
 }
 
-class S2WasmTransformationStep implements TransformationStep {
-    transform(inputFileName: string, {buildDirectory, plainFileName, codeGenerationContext, sourceFileRewriter}: TransformationContext): string {
-        const compilerOptions = codeGenerationContext.compilationContext.compilerOptions;
-        const wastFileName = s2wasm(inputFileName, buildDirectory.getTempFileName(`${plainFileName}.wast`), compilerOptions);
-        const glue = S2WasmTransformationStep.getGlueMetadata(wastFileName);
-        sourceFileRewriter.setWastMetaData(glue);
-        return wastFileName;
+class S2WasmTransformationStep extends CachedTransformationStep {
+    constructor() {
+        super("s2wasm", ".wast");
+    }
+
+    protected getParameters({codeGenerationContext}: TransformationContext, buildCache: BuildCache): any[] {
+        const { globalBase, initialMemory } = codeGenerationContext.compilationContext.compilerOptions;
+        return [globalBase, initialMemory, buildCache.hashFile(COMPILER_RT_FILE), buildCache.hashFile(LIBC_RT_FILE)];
+    }
+
+    protected execute(inputFileName: string, outputFileName: string, {codeGenerationContext}: TransformationContext): string {
+        return s2wasm(inputFileName, outputFileName, codeGenerationContext.compilationContext.compilerOptions);
+    }
+}
+
+/**
+ * Passes the glue meta data of the wast file to the source file rewriter
+ */
+class WastMetaDataTransformationStep implements TransformationStep {
+    transform(inputFileName: string, transformationContext: TransformationContext): string {
+        transformationContext.wastMetaData = WastMetaDataTransformationStep.getGlueMetadata(inputFileName);
+        transformationContext.sourceFileRewriter.setWastMetaData(transformationContext.wastMetaData);
+        return inputFileName;
     }
 
     // glue code https://github.com/kripken/emscripten/blob/5387c1e5f1f55b69c41b94cf044062c59e052f0b/emscripten.py#L1415
@@ -288,28 +475,96 @@ class S2WasmTransformationStep implements TransformationStep {
     }
 }
 
-class BinaryenOptTransformationStep implements TransformationStep {
-    transform(inputFileName: string, { buildDirectory, plainFileName, codeGenerationContext }: TransformationContext): string {
-        const outputFile = buildDirectory.getTempFileName(`${plainFileName}-opt.wast`);
-        return wasmOpt(inputFileName, outputFile);
+class BinaryenOptTransformationStep extends CachedTransformationStep {
+    constructor() {
+        super("wasm-opt", "-opt.wast");
+    }
+
+    protected getParameters(): any[] {
+        return [];
+    }
+
+    protected execute(inputFileName: string, outputFileName: string): string {
+        return wasmOpt(inputFileName, outputFileName);
     }
 }
 
-class WasmToAsTransformationStep implements TransformationStep {
-    transform(inputFileName: string, { buildDirectory, plainFileName, sourceFileRewriter, sourceFile, codeGenerationContext}: TransformationContext): string {
-        const wasmFileName = buildDirectory.getTempFileName(`${plainFileName}.wasm`);
+const HEAP_SNAPSHOT_MARKER = "\n;; HEAP SNAPSHOT:";
+
+/**
+ * Executes the snapshot functions and adds the heap snapshot as data segments to the wast file.
+ * The snapshot meta data is stored in the last line of the wast file (after the HEAP SNAPSHOT marker).
+ */
+class HeapSnapshotTransformationStep extends CachedTransformationStep {
+    constructor() {
+        super("heap-snapshot", "-snapshot.wast");
+    }
+
+    protected getParameters({codeGenerationContext, snapshotFunctions, wastMetaData}: TransformationContext): any[] {
+        const { globalBase, initialMemory, totalStack } = codeGenerationContext.compilationContext.compilerOptions;
+        return [snapshotFunctions, globalBase, initialMemory, totalStack, wastMetaData!.staticBump];
+    }
+
+    protected execute(inputFileName: string, outputFileName: string, transformationContext: TransformationContext): string {
+        const { buildDirectory, codeGenerationContext, plainFileName, snapshotFunctions, wastMetaData } = transformationContext;
+        const { globalBase, initialMemory, totalStack } = codeGenerationContext.compilationContext.compilerOptions;
+
+        const wasmFileName = buildDirectory.getTempFileName(`${plainFileName}-snapshot.wasm`);
         wasmAs(inputFileName, wasmFileName);
 
+        const layout = { globalBase, initialMemory, totalStack, staticBump: alignStaticBump(wastMetaData!.staticBump) };
+        const { snapshot, segments } = createHeapSnapshot(wasmFileName, layout, snapshotFunctions);
+        const wast = addHeapSnapshotToWast(ts.sys.readFile(inputFileName), snapshot, segments);
+
+        ts.sys.writeFile(outputFileName, wast + HEAP_SNAPSHOT_MARKER + " " + JSON.stringify(snapshot) + "\n");
+        return outputFileName;
+    }
+}
+
+/**
+ * Passes the heap snapshot meta data of the wast file to the source file rewriter
+ */
+class HeapSnapshotMetaDataTransformationStep implements TransformationStep {
+    transform(inputFileName: string, {sourceFileRewriter}: TransformationContext): string {
+        const parts = ts.sys.readFile(inputFileName).split(HEAP_SNAPSHOT_MARKER);
+        sourceFileRewriter.setHeapSnapshot(JSON.parse(parts[1]) as HeapSnapshot);
+        return inputFileName;
+    }
+}
+
+class WasmToAsTransformationStep extends CachedTransformationStep {
+    constructor() {
+        super("wasm-as", ".wasm");
+    }
+
+    protected getParameters(): any[] {
+        return [];
+    }
+
+    protected execute(inputFileName: string, outputFileName: string): string {
+        wasmAs(inputFileName, outputFileName);
+        return outputFileName;
+    }
+}
+
+/**
+ * Writes the wasm file to the output directory (using the wasm file writer) and passes its url and hash to the source
+ * file rewriter
+ */
+class WriteWasmFileTransformationStep implements TransformationStep {
+    transform(inputFileName: string, { sourceFileRewriter, sourceFile, codeGenerationContext}: TransformationContext): string {
         const wasmFileWriter = codeGenerationContext.compilationContext.compilerOptions.wasmFileWriter;
         const finalWasmFileName = getOutputFileName(sourceFile, codeGenerationContext);
-        const wasmFetchExpression = wasmFileWriter.writeWasmFile(finalWasmFileName, fs.readFileSync(wasmFileName), codeGenerationContext);
+        const wasmContent = fs.readFileSync(inputFileName);
+        const wasmFetchExpression = wasmFileWriter.writeWasmFile(finalWasmFileName, wasmContent, codeGenerationContext);
         sourceFileRewriter.setWasmUrl(wasmFetchExpression);
+        sourceFileRewriter.setWasmHash(crypto.createHash("sha256").update(wasmContent).digest("hex"));
 
-        return wasmFileName;
+        return inputFileName;
     }
 }
 
-function getOutputFileName(sourceFile: ts.SourceFile, context: CodeGenerationContext, fileExtension = ".wasm") {
+export function getOutputFileName(sourceFile: ts.SourceFile, context: CodeGenerationContext, fileExtension = ".wasm") {
     const withNewExtension = sourceFile.fileName.replace(".ts", fileExtension);
     if (context.compilationContext.compilerOptions.outDir) {
         const relativeName = path.relative(context.compilationContext.rootDir, withNewExtension);
@@ -1,4 +1,5 @@
 import * as ts from "typescript";
+import {HeapSnapshot} from "./heap-snapshot";
 import {WastMetaData} from "./wast-meta-data";
 
 export type EmitHelperProvider = (emitHelper: ts.EmitHelper) => void;
@@ -20,6 +21,18 @@ export interface PerFileSourceFileRewirter {
      */
     setWasmUrl(wasmUrl: string): void;
 
+    /**
+     * Sets the hash of the wasm file content
+     * @param wasmHash the hash of the wasm file, identifies the compiled module
+     */
+    setWasmHash(wasmHash: string): void;
+
+    /**
+     * Sets the heap snapshot of the wasm file (only called if the source file declares snapshot functions)
+     * @param snapshot the heap snapshot
+     */
+    setHeapSnapshot(snapshot: HeapSnapshot): void;
+
     /**
      * Rewrites a SpeedyJS entry function
      * @param name the name of the function in the compilation
@@ -18,10 +18,22 @@ declare interface WebAssemblyMemoryConstructor {
     new (memoryDescriptor: { initial: number, maximum?: number }): WebAssemblyMemory;
 }
 
+declare interface WebAssemblyModuleConstructor extends Function {
+    new (buffer: ArrayBuffer | Uint8Array): WebAssemblyModule;
+}
+
+declare interface WebAssemblyInstanceConstructor {
+    new (module: WebAssemblyModule, imports?: ImportObject): WebAssemblyInstance;
+}
+
 declare interface WebAssemblyConstructor {
     Memory: WebAssemblyMemoryConstructor;
+    Instance: WebAssemblyInstanceConstructor;
     instantiate(buffer: ArrayBuffer, imports?: ImportObject): Promise<{ instance: WebAssemblyInstance, module: WebAssemblyModule}>;
     instantiate(module: WebAssemblyModule, imports?: ImportObject): Promise<WebAssemblyInstance>;
+    compile(buffer: ArrayBuffer): Promise<WebAssemblyModule>;
+    compileStreaming?: (source: Promise<any>) => Promise<WebAssemblyModule>;
+    Module: WebAssemblyModuleConstructor;
 }
 
 declare const WebAssembly: WebAssemblyConstructor;
@@ -0,0 +1,202 @@
+import * as llvm from "llvm-node";
+import * as ts from "typescript";
+import {SpeedyJSCompilerOptions} from "../../speedyjs-compiler-options";
+import {TypeChecker} from "../../type-checker";
+import {CodeGenerationContext} from "../code-generation-context";
+import {ResolvedFunction} from "../value/resolved-function";
+import {toLLVMType} from "./types";
+
+/**
+ * The size of a single argument or result slot of a batch call in bytes. Every argument and the result use a slot of
+ * eight bytes independent of their type (int and boolean are stored as i32, number as double).
+ */
+export const BATCH_SLOT_SIZE = 8;
+
+/**
+ * Postfix of the name of the batch entry function (e.g. _isPrimeBatch for the entry function _isPrime)
+ */
+export const BATCH_FUNCTION_POSTFIX = "Batch";
+
+function isPrimitive(type: ts.Type) {
+    return (type.flags & (ts.TypeFlags.BooleanLike | ts.TypeFlags.IntLike | ts.TypeFlags.NumberLike)) !== 0;
+}
+
+/**
+ * Tests if a batch entry function can be generated for the given entry function. This is the case if all parameters
+ * are primitives (and neither optional nor variadic) and the function returns a primitive or void.
+ * @param parameterTypes the types of the parameters of the entry function
+ * @param returnType the return type of the entry function
+ */
+export function supportsBatchInvocation(parameterTypes: ts.Type[], returnType: ts.Type) {
+    return parameterTypes.every(isPrimitive) && (isPrimitive(returnType) || (returnType.flags & ts.TypeFlags.Void) !== 0);
+}
+
+/**
+ * Tests if a batch function is created for the given entry function. The batch functions are only created for exported
+ * entry functions (a batch function is only of use for the callers in other modules) if the batchEntryFunctions option
+ * is set and the entry function supports batch invocations.
+ * @param functionDeclaration the declaration of the entry function
+ * @param parameterTypes the types of the parameters of the entry function
+ * @param returnType the return type of the entry function
+ * @param compilerOptions the compiler options
+ */
+export function hasBatchEntryFunction(functionDeclaration: ts.FunctionDeclaration, parameterTypes: ts.Type[], returnType: ts.Type,
+                                      compilerOptions: SpeedyJSCompilerOptions) {
+    const exported = (functionDeclaration.modifiers || [] as ts.Modifier[]).some(modifier => modifier.kind === ts.SyntaxKind.ExportKeyword);
+    return compilerOptions.batchEntryFunctions && exported && supportsBatchInvocation(parameterTypes, returnType);
+}
+
+/**
+ * Returns the name of the JS batch function of the given entry function (e.g. isPrimeBatch for isPrime)
+ */
+export function getBatchFunctionName(functionDeclaration: ts.FunctionDeclaration) {
+    return functionDeclaration.name!.text + BATCH_FUNCTION_POSTFIX;
+}
+
+/**
+ * Tests if a top level statement of the source file declares a value with the given name
+ * @param sourceFile the source file
+ * @param name the name of the value
+ */
+export function declaresValue(sourceFile: ts.SourceFile, name: string): boolean {
+    const isName = (identifier: ts.Identifier | undefined) => !!identifier && identifier.text === name;
+
+    return sourceFile.statements.some(statement => {
+        switch (statement.kind) {
+            case ts.SyntaxKind.FunctionDeclaration:
+            case ts.SyntaxKind.ClassDeclaration:
+            case ts.SyntaxKind.EnumDeclaration:
+                return isName((statement as ts.FunctionDeclaration | ts.ClassDeclaration | ts.EnumDeclaration).name);
+            case ts.SyntaxKind.VariableStatement:
+                return (statement as ts.VariableStatement).declarationList.declarations.some(declaration => {
+                    return declaration.name.kind === ts.SyntaxKind.Identifier && isName(declaration.name as ts.Identifier);
+                });
+            case ts.SyntaxKind.ImportDeclaration: {
+                const importClause = (statement as ts.ImportDeclaration).importClause;
+                if (!importClause) {
+                    return false;
+                }
+
+                const namedBindings = importClause.namedBindings;
+                if (namedBindings && namedBindings.kind === ts.SyntaxKind.NamespaceImport) {
+                    return isName(importClause.name) || isName((namedBindings as ts.NamespaceImport).name);
+                }
+
+                const elements = namedBindings ? (namedBindings as ts.NamedImports).elements : [];
+                return isName(importClause.name) || elements.some(element => isName(element.name));
+            }
+            default:
+                return false;
+        }
+    });
+}
+
+/**
+ * Creates the declaration of the JS batch function of an entry function, added to the declaration file (.d.ts) of the
+ * source file. The batch function is created by the transformation and, therefore, is not part of the declarations
+ * emitted by TypeScript.
+ * @code
+ * export declare function fnBatch(argumentTuples: Array<[int, number]>): Promise<number[]>;
+ */
+export function createBatchFunctionDeclaration(functionDeclaration: ts.FunctionDeclaration, parameterTypes: ts.Type[], returnType: ts.Type,
+                                               typeChecker: TypeChecker): string {
+    const tupleType = `[${parameterTypes.map(parameterType => typeChecker.typeToString(parameterType)).join(", ")}]`;
+    const resultType = returnType.flags & ts.TypeFlags.Void ? "void" : typeChecker.typeToString(returnType);
+    return `export declare function ${getBatchFunctionName(functionDeclaration)}(argumentTuples: Array<${tupleType}>): Promise<${resultType}[]>;`;
+}
+
+/**
+ * Defines the batch entry function that calls the entry function once for each argument tuple
+ * @code
+ * void fnBatch(i8* arguments, i8* results, i32 count) {
+ *     for (i32 i = 0; i < count; ++i) {
+ *         results[i] = fn(arguments[i][0], ..., arguments[i][n - 1]);
+ *     }
+ * }
+ *
+ * The arguments are stored tuple after tuple, every argument and the result in a slot of BATCH_SLOT_SIZE bytes.
+ * A single call from JS therefore executes count invocations without converting the arguments and nuking the heap
+ * after each invocation.
+ * @param entryFunction the entry function to call
+ * @param resolvedFunction the resolved entry function, needs to support batch invocations
+ * @param context the code generation context
+ * @return the batch entry function
+ */
+export function defineBatchEntryFunction(entryFunction: llvm.Function, resolvedFunction: ResolvedFunction, context: CodeGenerationContext): llvm.Function {
+    const int8PtrType = llvm.Type.getInt8PtrTy(context.llvmContext);
+    const int32Type = llvm.Type.getInt32Ty(context.llvmContext);
+    const batchFunctionType = llvm.FunctionType.get(llvm.Type.getVoidTy(context.llvmContext), [int8PtrType, int8PtrType, int32Type], false);
+    const batchFunction = llvm.Function.create(
+        batchFunctionType,
+        llvm.LinkageTypes.ExternalLinkage,
+        entryFunction.name + BATCH_FUNCTION_POSTFIX,
+        context.module
+    );
+
+    const [argumentsPtr, resultsPtr, count] = batchFunction.getArguments();
+    argumentsPtr.name = "arguments";
+    resultsPtr.name = "results";
+    count.name = "count";
+
+    const entryBlock = llvm.BasicBlock.create(context.llvmContext, "entry", batchFunction);
+    const loopBlock = llvm.BasicBlock.create(context.llvmContext, "for.body", batchFunction);
+    const exitBlock = llvm.BasicBlock.create(context.llvmContext, "for.end", batchFunction);
+
+    context.builder.setInsertionPoint(entryBlock);
+    const zero = llvm.ConstantInt.get(context.llvmContext, 0);
+    context.builder.createCondBr(context.builder.createICmpSGT(count, zero), loopBlock, exitBlock);
+
+    context.builder.setInsertionPoint(loopBlock);
+    const index = context.builder.createPhi(int32Type, 2, "i");
+    index.addIncoming(zero, entryBlock);
+
+    const tupleSize = llvm.ConstantInt.get(context.llvmContext, BATCH_SLOT_SIZE * resolvedFunction.parameters.length);
+    const tuplePtr = context.builder.createInBoundsGEP(argumentsPtr, [context.builder.createMul(index, tupleSize)], "tuple");
+
+    const args = resolvedFunction.parameters.map((parameter, i) => {
+        const slotPtr = context.builder.createInBoundsGEP(tuplePtr, [llvm.ConstantInt.get(context.llvmContext, i * BATCH_SLOT_SIZE)]);
+        return loadSlot(slotPtr, parameter.type, parameter.name, context);
+    });
+
+    const result = context.builder.createCall(entryFunction, args);
+
+    if (!(resolvedFunction.returnType.flags & ts.TypeFlags.Void)) {
+        const slotSize = llvm.ConstantInt.get(context.llvmContext, BATCH_SLOT_SIZE);
+        const slotPtr = context.builder.createInBoundsGEP(resultsPtr, [context.builder.createMul(index, slotSize)]);
+        storeSlot(slotPtr, result, resolvedFunction.returnType, context);
+    }
+
+    const nextIndex = context.builder.createAdd(index, llvm.ConstantInt.get(context.llvmContext, 1), "inc");
+    index.addIncoming(nextIndex, loopBlock);
+    context.builder.createCondBr(context.builder.createICmpSLT(nextIndex, count), loopBlock, exitBlock);
+
+    context.builder.setInsertionPoint(exitBlock);
+    context.builder.createRetVoid();
+
+    return batchFunction;
+}
+
+function loadSlot(slotPtr: llvm.Value, type: ts.Type, name: string, context: CodeGenerationContext): llvm.Value {
+    if (type.flags & ts.TypeFlags.BooleanLike) {
+        const intPtr = context.builder.createBitCast(slotPtr, llvm.Type.getInt32Ty(context.llvmContext).getPointerTo());
+        const value = context.builder.createAlignedLoad(intPtr, 4, name);
+        return context.builder.createICmpNE(value, llvm.ConstantInt.get(context.llvmContext, 0));
+    }
+
+    const llvmType = toLLVMType(type, context);
+    const typedPtr = context.builder.createBitCast(slotPtr, llvmType.getPointerTo());
+    return context.builder.createAlignedLoad(typedPtr, context.module.dataLayout.getTypeStoreSize(llvmType), name);
+}
+
+function storeSlot(slotPtr: llvm.Value, value: llvm.Value, type: ts.Type, context: CodeGenerationContext): void {
+    if (type.flags & ts.TypeFlags.BooleanLike) {
+        const int32Type = llvm.Type.getInt32Ty(context.llvmContext);
+        const intPtr = context.builder.createBitCast(slotPtr, int32Type.getPointerTo());
+        context.builder.createAlignedStore(context.builder.createZExt(value, int32Type), intPtr, 4);
+        return;
+    }
+
+    const llvmType = toLLVMType(type, context);
+    const typedPtr = context.builder.createBitCast(slotPtr, llvmType.getPointerTo());
+    context.builder.createAlignedStore(value, typedPtr, context.module.dataLayout.getTypeStoreSize(llvmType));
+}
@@ -0,0 +1,178 @@
+import * as ts from "typescript";
+import {CodeGenerationContext} from "../code-generation-context";
+import {isIncrementByOne} from "./push-loops";
+import {isFunctionType} from "./types";
+
+/**
+ * Array methods that might reduce the length of an array
+ */
+const SHRINKING_ARRAY_METHODS = ["pop", "shift", "splice"];
+
+/**
+ * Tests if the index of the element access is known to be in bound of the array. This is the case for the counter of
+ * loops of the form for (let i = start; i < array.length; ++i) { array[i] } where start is a non negative int literal,
+ * the counter is not assigned in the body and the body cannot shrink the array. The bounds check of the access
+ * can be omitted in this case without losing memory safety.
+ * @param element the element access
+ * @param context the context
+ * @return true if the index is in bound of the array
+ */
+export function isIndexInBounds(element: ts.ElementAccessExpression, context: CodeGenerationContext): boolean {
+    const index = element.argumentExpression;
+    if (!index || index.kind !== ts.SyntaxKind.Identifier || element.expression.kind !== ts.SyntaxKind.Identifier) {
+        return false;
+    }
+
+    const counterSymbol = context.typeChecker.getSymbolAtLocation(index);
+    const arraySymbol = context.typeChecker.getSymbolAtLocation(element.expression);
+    if (!counterSymbol || !arraySymbol) {
+        return false;
+    }
+
+    // The closest loop iterating the counter, closures are not considered as these might be called after the loop
+    let node: ts.Node = element;
+    while (node.parent && !isFunctionLike(node.parent)) {
+        const parent = node.parent;
+
+        if (parent.kind === ts.SyntaxKind.ForStatement && (parent as ts.ForStatement).statement === node) {
+            const forStatement = parent as ts.ForStatement;
+            if (isCountingLoop(forStatement, counterSymbol, arraySymbol, context)) {
+                return !assignsSymbol(forStatement.statement, counterSymbol, context) &&
+                    !assignsSymbol(forStatement.statement, arraySymbol, context) &&
+                    !mightShrinkArrays(forStatement.statement, context);
+            }
+        }
+
+        node = parent;
+    }
+
+    return false;
+}
+
+/**
+ * for (let i = start; i < array.length; ++i)
+ */
+function isCountingLoop(forStatement: ts.ForStatement, counter: ts.Symbol, array: ts.Symbol, context: CodeGenerationContext) {
+    const initializer = forStatement.initializer;
+    if (!initializer || initializer.kind !== ts.SyntaxKind.VariableDeclarationList || !forStatement.condition || !forStatement.incrementor) {
+        return false;
+    }
+
+    const declarations = (initializer as ts.VariableDeclarationList).declarations;
+    const declaration = declarations.find(candidate => context.typeChecker.getSymbolAtLocation(candidate.name) === counter);
+    if (!declaration || !declaration.initializer || declaration.initializer.kind !== ts.SyntaxKind.NumericLiteral ||
+        !(context.typeChecker.getTypeAtLocation(declaration.name).flags & ts.TypeFlags.IntLike)) {
+        return false;
+    }
+
+    const start = +(declaration.initializer as ts.NumericLiteral).text;
+    if (!(start >= 0 && start <= 2147483647)) {
+        return false;
+    }
+
+    const condition = forStatement.condition;
+    if (condition.kind !== ts.SyntaxKind.BinaryExpression) {
+        return false;
+    }
+
+    const comparison = condition as ts.BinaryExpression;
+    if (comparison.operatorToken.kind !== ts.SyntaxKind.LessThanToken || context.typeChecker.getSymbolAtLocation(comparison.left) !== counter ||
+        comparison.right.kind !== ts.SyntaxKind.PropertyAccessExpression) {
+        return false;
+    }
+
+    const bound = comparison.right as ts.PropertyAccessExpression;
+    return bound.name.text === "length" && context.typeChecker.getSymbolAtLocation(bound.expression) === array &&
+        isIncrementByOne(forStatement.incrementor, declaration.name as ts.Identifier);
+}
+
+/**
+ * Tests if the symbol is assigned (=, +=, ++, ...) anywhere in the given node
+ */
+function assignsSymbol(node: ts.Node, symbol: ts.Symbol, context: CodeGenerationContext): boolean {
+    const isSymbol = (target: ts.Node) => context.typeChecker.getSymbolAtLocation(target) === symbol;
+
+    switch (node.kind) {
+        case ts.SyntaxKind.BinaryExpression: {
+            const binary = node as ts.BinaryExpression;
+            if (isAssignmentOperator(binary.operatorToken.kind) && isSymbol(binary.left)) {
+                return true;
+            }
+            break;
+        }
+        case ts.SyntaxKind.PrefixUnaryExpression:
+        case ts.SyntaxKind.PostfixUnaryExpression: {
+            const unary = node as ts.PrefixUnaryExpression | ts.PostfixUnaryExpression;
+            if ((unary.operator === ts.SyntaxKind.PlusPlusToken || unary.operator === ts.SyntaxKind.MinusMinusToken) && isSymbol(unary.operand)) {
+                return true;
+            }
+            break;
+        }
+    }
+
+    return !!ts.forEachChild(node, child => assignsSymbol(child, symbol, context) || undefined);
+}
+
+/**
+ * Tests if the node might reduce the length of any array. Calls to functions (other than the Math functions) might
+ * shrink an array through an alias and therefore are considered as shrinking too. The same applies to functions passed
+ * by reference to an array method (e.g. array.sort(comparator)), only the bodies of inline closures can be analyzed.
+ */
+function mightShrinkArrays(node: ts.Node, context: CodeGenerationContext): boolean {
+    if (node.kind === ts.SyntaxKind.CallExpression) {
+        const call = node as ts.CallExpression;
+        if (call.expression.kind !== ts.SyntaxKind.PropertyAccessExpression) {
+            return true;
+        }
+
+        const callee = call.expression as ts.PropertyAccessExpression;
+        const objectSymbol = context.typeChecker.getTypeAtLocation(callee.expression).getSymbol();
+        const builtIns = context.compilationContext.builtIns;
+
+        if (objectSymbol === builtIns.get("Array")) {
+            if (SHRINKING_ARRAY_METHODS.indexOf(callee.name.text) !== -1 || call.arguments.some(argument => isFunctionReference(argument, context))) {
+                return true;
+            }
+        } else if (objectSymbol !== builtIns.get("Math")) {
+            return true;
+        }
+    } else if (node.kind === ts.SyntaxKind.NewExpression) {
+        // constructors might shrink an array passed as argument
+        return true;
+    } else if (node.kind === ts.SyntaxKind.BinaryExpression) {
+        const binary = node as ts.BinaryExpression;
+        if (isAssignmentOperator(binary.operatorToken.kind) && isLengthAccess(binary.left)) {
+            return true;
+        }
+    } else if (node.kind === ts.SyntaxKind.PrefixUnaryExpression || node.kind === ts.SyntaxKind.PostfixUnaryExpression) {
+        // array.length--, --array.length
+        const unary = node as ts.PrefixUnaryExpression | ts.PostfixUnaryExpression;
+        if ((unary.operator === ts.SyntaxKind.PlusPlusToken || unary.operator === ts.SyntaxKind.MinusMinusToken) && isLengthAccess(unary.operand)) {
+            return true;
+        }
+    }
+
+    return !!ts.forEachChild(node, child => mightShrinkArrays(child, context) || undefined);
+}
+
+function isLengthAccess(node: ts.Node) {
+    return node.kind === ts.SyntaxKind.PropertyAccessExpression && (node as ts.PropertyAccessExpression).name.text === "length";
+}
+
+/**
+ * Tests if the argument is a function that is not defined inline (and therefore cannot be analyzed), e.g. a function identifier
+ */
+function isFunctionReference(argument: ts.Expression, context: CodeGenerationContext) {
+    return argument.kind !== ts.SyntaxKind.ArrowFunction && argument.kind !== ts.SyntaxKind.FunctionExpression &&
+        isFunctionType(context.typeChecker.getTypeAtLocation(argument));
+}
+
+function isAssignmentOperator(kind: ts.SyntaxKind) {
+    return kind >= ts.SyntaxKind.FirstAssignment && kind <= ts.SyntaxKind.LastAssignment;
+}
+
+function isFunctionLike(node: ts.Node) {
+    return node.kind === ts.SyntaxKind.FunctionDeclaration || node.kind === ts.SyntaxKind.FunctionExpression ||
+        node.kind === ts.SyntaxKind.ArrowFunction || node.kind === ts.SyntaxKind.MethodDeclaration ||
+        node.kind === ts.SyntaxKind.Constructor || node.kind === ts.SyntaxKind.GetAccessor || node.kind === ts.SyntaxKind.SetAccessor;
+}
@@ -9,6 +9,7 @@ import {toLLVMType} from "./types";
 
 export class ObjectIndexReferenceBuilder {
     private runtimeFn = false;
+    private uncheckedAccess = false;
 
     private constructor(private element: ts.ElementAccessExpression, private context: CodeGenerationContext) {
     }
@@ -26,6 +27,14 @@ export class ObjectIndexReferenceBuilder {
         return this;
     }
 
+    /**
+     * Uses the accessors without bounds checks, requires that the index is known to be in bound
+     */
+    unchecked(uncheckedAccess = true) {
+        this.uncheckedAccess = uncheckedAccess;
+        return this;
+    }
+
     build(objectReference: ObjectReference) {
         const elementType = this.context.typeChecker.getTypeAtLocation(this.element);
         const llvmElementType = toLLVMType(elementType, this.context);
@@ -44,7 +53,7 @@ export class ObjectIndexReferenceBuilder {
     }
 
     private createGetter(thisType: llvm.Type, elementType: llvm.Type, objectReference: ObjectReference): llvm.Function {
-        const getterName = this.getNameMangler().mangleIndexer(this.element, false);
+        const getterName = this.getNameMangler().mangleIndexer(this.element, false, this.uncheckedAccess);
         let getter = this.context.module.getFunction(getterName);
 
         if (!getter) {
@@ -64,7 +73,7 @@ export class ObjectIndexReferenceBuilder {
     }
 
     private createSetter(thisType: llvm.Type, elementType: llvm.Type, objectReference: ObjectReference): llvm.Function {
-        const setterName = this.getNameMangler().mangleIndexer(this.element, true);
+        const setterName = this.getNameMangler().mangleIndexer(this.element, true, this.uncheckedAccess);
         let setter = this.context.module.getFunction(setterName);
 
         if (!setter) {
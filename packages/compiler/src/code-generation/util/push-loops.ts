@@ -0,0 +1,192 @@
+import * as llvm from "llvm-node";
+import * as ts from "typescript";
+import {CodeGenerationContext} from "../code-generation-context";
+import {RuntimeSystemNameMangler} from "../runtime-system-name-mangler";
+import {Primitive} from "../value/primitive";
+import {toLLVMType} from "./types";
+import {isValueArrayType} from "./value-classes";
+
+/**
+ * A for loop of the form for (let i = start; i < end; ++i) { array.push(value); } for which the number of pushed
+ * elements is known before the loop is entered.
+ */
+interface PushLoop {
+    counter: ts.Identifier;
+    bound: ts.Expression;
+    inclusive: boolean;
+    array: ts.Identifier;
+    push: ts.CallExpression;
+}
+
+/**
+ * Reserves the capacity for the elements pushed by the given for loop if the number of iterations is known when the loop
+ * is entered. Avoids that the array is grown (and copied) multiple times while the loop is executed. Needs to be called
+ * after the initializer of the loop has been generated.
+ * @param forStatement the for statement
+ * @param context the context
+ */
+export function generateReservePushHint(forStatement: ts.ForStatement, context: CodeGenerationContext): void {
+    const pushLoop = analyzePushLoop(forStatement, context);
+    if (!pushLoop) {
+        return;
+    }
+
+    // the number of iterations is only computed for int counters
+    const intType = context.typeChecker.getTypeAtLocation(pushLoop.counter);
+    if (!(intType.flags & ts.TypeFlags.IntLike)) {
+        return;
+    }
+
+    const arrayType = context.typeChecker.getTypeAtLocation(pushLoop.array) as ts.ObjectType;
+    const arrayValue = context.generateValue(pushLoop.array).dereference(context);
+    const start = context.generateValue(pushLoop.counter).generateIR(context);
+    const boundType = context.typeChecker.getTypeAtLocation(pushLoop.bound);
+    const end = Primitive.toInt32(context.generateValue(pushLoop.bound), boundType, intType, context).generateIR();
+
+    let count = context.builder.createSub(end, start, "reserve.count");
+    if (pushLoop.inclusive) {
+        count = context.builder.createAdd(count, llvm.ConstantInt.get(context.llvmContext, 1), "reserve.count");
+    }
+
+    const reserveName = new RuntimeSystemNameMangler(context.compilationContext).mangleMethodName(arrayType, "reservePush", [intType]);
+    let reserve = context.module.getFunction(reserveName);
+
+    if (!reserve) {
+        const llvmArrayType = toLLVMType(arrayType, context);
+        const functionType = llvm.FunctionType.get(llvm.Type.getVoidTy(context.llvmContext), [llvmArrayType, llvm.Type.getInt32Ty(context.llvmContext)], false);
+        reserve = llvm.Function.create(functionType, llvm.LinkageTypes.ExternalLinkage, reserveName, context.module);
+        reserve.addFnAttr(llvm.Attribute.AttrKind.AlwaysInline);
+        reserve.getArguments()[0].addAttr(llvm.Attribute.AttrKind.NoCapture);
+    }
+
+    context.builder.createCall(reserve, [arrayValue.generateIR(context), count]);
+}
+
+function analyzePushLoop(forStatement: ts.ForStatement, context: CodeGenerationContext): PushLoop | undefined {
+    const condition = forStatement.condition;
+    if (!condition || condition.kind !== ts.SyntaxKind.BinaryExpression || !forStatement.incrementor) {
+        return undefined;
+    }
+
+    // i < bound, i <= bound
+    const comparison = condition as ts.BinaryExpression;
+    const inclusive = comparison.operatorToken.kind === ts.SyntaxKind.LessThanEqualsToken;
+    if (!inclusive && comparison.operatorToken.kind !== ts.SyntaxKind.LessThanToken) {
+        return undefined;
+    }
+
+    if (comparison.left.kind !== ts.SyntaxKind.Identifier || !isInvariantBound(comparison.right)) {
+        return undefined;
+    }
+
+    const counter = comparison.left as ts.Identifier;
+    if (!isIncrementByOne(forStatement.incrementor, counter)) {
+        return undefined;
+    }
+
+    const push = findPushStatement(forStatement.statement);
+    if (!push || containsJump(forStatement.statement)) {
+        return undefined;
+    }
+
+    const array = (push.expression as ts.PropertyAccessExpression).expression as ts.Identifier;
+    const arraySymbol = context.typeChecker.getSymbolAtLocation(array);
+    const builtInArray = context.compilationContext.builtIns.get("Array");
+
+    if (!arraySymbol || !arraySymbol.valueDeclaration || isWithin(arraySymbol.valueDeclaration, forStatement) ||
+        context.typeChecker.getTypeAtLocation(array).getSymbol() !== builtInArray || isValueArrayType(context.typeChecker.getTypeAtLocation(array), context)) {
+        return undefined;
+    }
+
+    return { counter, bound: comparison.right, inclusive, array, push };
+}
+
+/**
+ * Only bounds without side effects are supported, e.g. n, 100 or array.length
+ */
+function isInvariantBound(bound: ts.Expression) {
+    if (bound.kind === ts.SyntaxKind.Identifier || bound.kind === ts.SyntaxKind.NumericLiteral) {
+        return true;
+    }
+
+    if (bound.kind === ts.SyntaxKind.PropertyAccessExpression) {
+        const propertyAccess = bound as ts.PropertyAccessExpression;
+        return propertyAccess.name.text === "length" && propertyAccess.expression.kind === ts.SyntaxKind.Identifier;
+    }
+
+    return false;
+}
+
+/**
+ * ++i, i++, i += 1
+ */
+export function isIncrementByOne(incrementor: ts.Expression, counter: ts.Identifier) {
+    const isCounter = (node: ts.Node) => node.kind === ts.SyntaxKind.Identifier && (node as ts.Identifier).text === counter.text;
+
+    if (incrementor.kind === ts.SyntaxKind.PrefixUnaryExpression || incrementor.kind === ts.SyntaxKind.PostfixUnaryExpression) {
+        const unary = incrementor as ts.PrefixUnaryExpression | ts.PostfixUnaryExpression;
+        return unary.operator === ts.SyntaxKind.PlusPlusToken && isCounter(unary.operand);
+    }
+
+    if (incrementor.kind === ts.SyntaxKind.BinaryExpression) {
+        const binary = incrementor as ts.BinaryExpression;
+        return binary.operatorToken.kind === ts.SyntaxKind.PlusEqualsToken && isCounter(binary.left) &&
+            binary.right.kind === ts.SyntaxKind.NumericLiteral && (binary.right as ts.NumericLiteral).text === "1";
+    }
+
+    return false;
+}
+
+/**
+ * Returns the array.push(value) call if it is a top level statement of the loop body (executed in every iteration)
+ */
+function findPushStatement(body: ts.Statement): ts.CallExpression | undefined {
+    const statements = body.kind === ts.SyntaxKind.Block ? (body as ts.Block).statements : [body];
+
+    for (const statement of statements) {
+        if (statement.kind !== ts.SyntaxKind.ExpressionStatement) {
+            continue;
+        }
+
+        const expression = (statement as ts.ExpressionStatement).expression;
+        if (expression.kind !== ts.SyntaxKind.CallExpression) {
+            continue;
+        }
+
+        const call = expression as ts.CallExpression;
+        if (call.arguments.length !== 1 || call.expression.kind !== ts.SyntaxKind.PropertyAccessExpression) {
+            continue;
+        }
+
+        const callee = call.expression as ts.PropertyAccessExpression;
+        if (callee.name.text === "push" && callee.expression.kind === ts.SyntaxKind.Identifier) {
+            return call;
+        }
+    }
+
+    return undefined;
+}
+
+/**
+ * Tests if the loop body might leave the loop or skip the rest of an iteration (break, continue, return or throw).
+ * Nested functions are not considered.
+ */
+function containsJump(node: ts.Node): boolean {
+    switch (node.kind) {
+        case ts.SyntaxKind.BreakStatement:
+        case ts.SyntaxKind.ContinueStatement:
+        case ts.SyntaxKind.ReturnStatement:
+        case ts.SyntaxKind.ThrowStatement:
+            return true;
+        case ts.SyntaxKind.FunctionDeclaration:
+        case ts.SyntaxKind.FunctionExpression:
+        case ts.SyntaxKind.ArrowFunction:
+            return false;
+        default:
+            return !!ts.forEachChild(node, child => containsJump(child) || undefined);
+    }
+}
+
+function isWithin(node: ts.Node, container: ts.Node) {
+    return node.pos >= container.pos && node.end <= container.end;
+}
@@ -0,0 +1,263 @@
+import * as ts from "typescript";
+import {isSpeedyJSEntryFunction} from "../../util/speedyjs-function";
+import {CodeGenerationContext} from "../code-generation-context";
+import {getArrayElementType} from "./types";
+
+/**
+ * The result of isValueClass by the symbol of the class
+ */
+const valueClasses = new WeakMap<ts.Symbol, boolean>();
+
+/**
+ * The kinds of the expressions whose contextual type might be an array of another element type, e.g. an argument
+ */
+const CONVERTIBLE_EXPRESSIONS = [
+    ts.SyntaxKind.Identifier,
+    ts.SyntaxKind.CallExpression,
+    ts.SyntaxKind.NewExpression,
+    ts.SyntaxKind.ArrayLiteralExpression,
+    ts.SyntaxKind.PropertyAccessExpression,
+    ts.SyntaxKind.ElementAccessExpression,
+    ts.SyntaxKind.ParenthesizedExpression,
+    ts.SyntaxKind.ConditionalExpression
+];
+
+/**
+ * Tests if the elements of an array of the given type are stored inline (see ValueArray in the runtime). This is the
+ * case if the valueArrays option is enabled and the element type is a value class.
+ * @param arrayType the type of the array
+ * @param context the context
+ * @return true if the array is a value array
+ */
+export function isValueArrayType(arrayType: ts.Type, context: CodeGenerationContext): boolean {
+    if (!context.compilationContext.compilerOptions.valueArrays || !isArrayType(arrayType, context)) {
+        return false;
+    }
+
+    return isValueClass(getArrayElementType(arrayType), context);
+}
+
+/**
+ * Tests if the instances of the class can be stored inline in the elements of an array. The instances are copied into
+ * the array and an element access yields the storage of the element itself. This is only the same as in JS if the
+ * identity of the objects stored in an array is never observed. A class is a value class if
+ * - it is declared in the analyzed source file without export, inheritance or type parameters,
+ * - it only has instance fields of primitive types and a constructor that only accesses this to set its fields,
+ * - only new instances are added to an array (push, array literals and element assignments),
+ * - an element is only used to access a field (points[i].x) or is overridden by a new instance,
+ * - push and length are the only array members used and the arrays are not iterated, spread or passed as rest arguments,
+ * - and the arrays are not converted to arrays of other element types or exposed by exported functions that are not entry functions.
+ * Entry functions are called through the loader that copies the arguments and results anyway.
+ * @param type the type of the class instances
+ * @param context the context
+ * @return true if the class is a value class
+ */
+export function isValueClass(type: ts.Type, context: CodeGenerationContext): boolean {
+    const symbol = type.getSymbol();
+    if (!(type.flags & ts.TypeFlags.Object) || !symbol || !(symbol.flags & ts.SymbolFlags.Class)) {
+        return false;
+    }
+
+    let valueClass = valueClasses.get(symbol);
+
+    if (typeof(valueClass) === "undefined") {
+        const declaration = symbol.valueDeclaration as ts.ClassDeclaration;
+        valueClass = isValueClassDeclaration(declaration, symbol, context) &&
+            !hasIdentityUse(declaration.getSourceFile(), new ValueClassUses(symbol, declaration, context));
+        valueClasses.set(symbol, valueClass);
+    }
+
+    return valueClass;
+}
+
+function isValueClassDeclaration(declaration: ts.ClassDeclaration | undefined, symbol: ts.Symbol, context: CodeGenerationContext) {
+    if (!declaration || declaration.kind !== ts.SyntaxKind.ClassDeclaration || hasModifier(declaration, ts.SyntaxKind.ExportKeyword) ||
+        hasModifier(declaration, ts.SyntaxKind.DeclareKeyword) || declaration.heritageClauses || declaration.typeParameters) {
+        return false;
+    }
+
+    const members = declaration.members.every(member => {
+        if (member.kind === ts.SyntaxKind.Constructor) {
+            return !!(member as ts.ConstructorDeclaration).body;
+        }
+
+        return member.kind === ts.SyntaxKind.PropertyDeclaration && !hasModifier(member, ts.SyntaxKind.StaticKeyword);
+    });
+
+    const classType = context.typeChecker.getDeclaredTypeOfSymbol(symbol);
+    const fields = classType.getApparentProperties();
+
+    return members && fields.length > 0 && fields.every(field => {
+        const fieldType = context.typeChecker.getTypeOfSymbolAtLocation(field, field.valueDeclaration!);
+        return !!(field.flags & ts.SymbolFlags.Property) && !!(fieldType.flags & (ts.TypeFlags.BooleanLike | ts.TypeFlags.NumberLike | ts.TypeFlags.IntLike));
+    });
+}
+
+function hasIdentityUse(node: ts.Node, uses: ValueClassUses): boolean {
+    return uses.isIdentityUse(node) || !!ts.forEachChild(node, child => hasIdentityUse(child, uses) || undefined);
+}
+
+/**
+ * Classifies the uses of a class and its arrays in the source file declaring the class
+ */
+class ValueClassUses {
+    constructor(private classSymbol: ts.Symbol, private declaration: ts.ClassDeclaration, private context: CodeGenerationContext) {
+    }
+
+    /**
+     * Tests if the node might observe the identity of an instance stored in an array of the class
+     */
+    isIdentityUse(node: ts.Node): boolean {
+        if (CONVERTIBLE_EXPRESSIONS.indexOf(node.kind) !== -1 && this.isArrayOfClass(node) && this.changesElementType(node as ts.Expression)) {
+            return true;
+        }
+
+        switch (node.kind) {
+            case ts.SyntaxKind.ElementAccessExpression:
+                const elementAccess = node as ts.ElementAccessExpression;
+                return this.isArrayOfClass(elementAccess.expression) && !isFieldAccessOrOverride(elementAccess, this);
+            case ts.SyntaxKind.ArrayLiteralExpression:
+                return this.isArrayOfClass(node) && !(node as ts.ArrayLiteralExpression).elements.every(element => this.isNewInstance(element));
+            case ts.SyntaxKind.PropertyAccessExpression:
+                const propertyAccess = node as ts.PropertyAccessExpression;
+                return this.isArrayOfClass(propertyAccess.expression) && !this.isSupportedArrayMember(propertyAccess);
+            case ts.SyntaxKind.NewExpression:
+                // new Array<Point>(size), the elements are zero initialized
+                const args = (node as ts.NewExpression).arguments || [] as ts.Expression[];
+                return this.isArrayOfClass(node) && args.some(argument => !(this.typeOf(argument).flags & ts.TypeFlags.IntLike));
+            case ts.SyntaxKind.ThisKeyword:
+                return this.isWithinClass(node) && !isPropertyAccessOf(node);
+            case ts.SyntaxKind.Parameter:
+                return !!(node as ts.ParameterDeclaration).dotDotDotToken && this.isArrayOfClass(node);
+            case ts.SyntaxKind.ForOfStatement:
+            case ts.SyntaxKind.ForInStatement:
+                return this.isArrayOfClass((node as ts.ForOfStatement | ts.ForInStatement).expression);
+            case ts.SyntaxKind.SpreadElement:
+                return this.isArrayOfClass((node as ts.SpreadElement).expression);
+            case ts.SyntaxKind.ArrayBindingPattern:
+                return this.isArrayOfClass(node);
+            case ts.SyntaxKind.AsExpression:
+            case ts.SyntaxKind.TypeAssertionExpression:
+                return this.isArrayOfClass((node as ts.AsExpression | ts.TypeAssertion).expression);
+            case ts.SyntaxKind.FunctionDeclaration:
+                return this.isExposedBy(node as ts.FunctionDeclaration);
+            default:
+                return false;
+        }
+    }
+
+    /**
+     * Tests if the type of the node is an array whose elements are instances of the class
+     */
+    isArrayOfClass(node: ts.Node) {
+        const type = this.typeOf(node);
+        return isArrayType(type, this.context) && this.isClass(getArrayElementType(type));
+    }
+
+    /**
+     * Tests if the expression creates a new instance of the class, e.g. new Point(1, 2)
+     */
+    isNewInstance(expression: ts.Expression) {
+        return expression.kind === ts.SyntaxKind.NewExpression && this.isClass(this.typeOf(expression));
+    }
+
+    private isClass(type: ts.Type) {
+        return !!(type.flags & ts.TypeFlags.Object) && type.getSymbol() === this.classSymbol;
+    }
+
+    private typeOf(node: ts.Node) {
+        return this.context.typeChecker.getTypeAtLocation(node);
+    }
+
+    /**
+     * array.length or array.push(new Point(...), ...)
+     */
+    private isSupportedArrayMember(propertyAccess: ts.PropertyAccessExpression) {
+        if (propertyAccess.name.text === "length") {
+            return true;
+        }
+
+        const call = propertyAccess.parent as ts.CallExpression;
+        return propertyAccess.name.text === "push" && !!call && call.kind === ts.SyntaxKind.CallExpression && call.expression === propertyAccess &&
+            call.arguments.every(argument => this.isNewInstance(argument));
+    }
+
+    /**
+     * Tests if the array is converted to an array of another element type, e.g. when passed to a Array<Point | undefined> parameter
+     */
+    private changesElementType(expression: ts.Expression) {
+        const contextualType = this.context.typeChecker.getContextualType(expression);
+        return !!contextualType && isArrayType(contextualType, this.context) && contextualType !== this.typeOf(expression);
+    }
+
+    private isWithinClass(node: ts.Node) {
+        for (let parent = node.parent; parent; parent = parent.parent) {
+            if (parent.kind === ts.SyntaxKind.ClassDeclaration || parent.kind === ts.SyntaxKind.ClassExpression) {
+                return parent === this.declaration;
+            }
+        }
+
+        return false;
+    }
+
+    /**
+     * Tests if the function is exported and the class is used by its signature. Calls from other source files cannot be analyzed.
+     */
+    private isExposedBy(functionDeclaration: ts.FunctionDeclaration) {
+        if (!hasModifier(functionDeclaration, ts.SyntaxKind.ExportKeyword) || isSpeedyJSEntryFunction(functionDeclaration)) {
+            return false;
+        }
+
+        const signature = this.context.typeChecker.getSignatureFromDeclaration(functionDeclaration);
+        const signatureTypes = [
+            this.context.typeChecker.getReturnTypeOfSignature(signature),
+            ...functionDeclaration.parameters.map(parameter => this.typeOf(parameter))
+        ];
+
+        return signatureTypes.some(type => this.references(type));
+    }
+
+    private references(type: ts.Type): boolean {
+        if (this.isClass(type)) {
+            return true;
+        }
+
+        if (type.flags & ts.TypeFlags.Union) {
+            return (type as ts.UnionType).types.some(member => this.references(member));
+        }
+
+        const typeArguments = type.flags & ts.TypeFlags.Object && (type as ts.ObjectType).objectFlags & ts.ObjectFlags.Reference ?
+            (type as ts.TypeReference).typeArguments || [] : [];
+        return typeArguments.some(typeArgument => this.references(typeArgument));
+    }
+}
+
+/**
+ * points[i].x or points[i] = new Point(...)
+ */
+function isFieldAccessOrOverride(element: ts.ElementAccessExpression, uses: ValueClassUses) {
+    const parent = element.parent!;
+
+    if (isPropertyAccessOf(element)) {
+        return true;
+    }
+
+    if (parent.kind === ts.SyntaxKind.BinaryExpression) {
+        const assignment = parent as ts.BinaryExpression;
+        return assignment.operatorToken.kind === ts.SyntaxKind.EqualsToken && assignment.left === element && uses.isNewInstance(assignment.right);
+    }
+
+    return false;
+}
+
+function isPropertyAccessOf(node: ts.Node) {
+    return !!node.parent && node.parent.kind === ts.SyntaxKind.PropertyAccessExpression && (node.parent as ts.PropertyAccessExpression).expression === node;
+}
+
+function isArrayType(type: ts.Type, context: CodeGenerationContext) {
+    return !!(type.flags & ts.TypeFlags.Object) && type.getSymbol() === context.compilationContext.builtIns.get("Array");
+}
+
+function hasModifier(node: ts.Node, kind: ts.SyntaxKind) {
+    return !!node.modifiers && node.modifiers.some(modifier => modifier.kind === kind);
+}
@@ -54,7 +54,7 @@ export abstract class AbstractFunctionReference implements FunctionReference {
         return createResolvedFunctionFromSignature(signature, compilationContext, this.classType);
     }
 
-    private invokeResolvedFunction(resolvedFunction: ResolvedFunction, args: llvm.Value[], callerContext: CodeGenerationContext) {
+    protected invokeResolvedFunction(resolvedFunction: ResolvedFunction, args: llvm.Value[], callerContext: CodeGenerationContext) {
         const llvmFunction = this.getLLVMFunction(resolvedFunction, callerContext, args);
         assert(llvmFunction.type.isPointerTy() && (llvmFunction.type as llvm.PointerType).elementType.isFunctionTy(), "Expected pointer to a function type");
 
@@ -161,7 +161,7 @@ export abstract class AbstractFunctionReference implements FunctionReference {
     }
 }
 
-function toLlvmArgumentValues(args: ts.Expression[], resolvedFunction: ResolvedFunction, callerContext: CodeGenerationContext) {
+export function toLlvmArgumentValues(args: ts.Expression[], resolvedFunction: ResolvedFunction, callerContext: CodeGenerationContext) {
     const values: llvm.Value[] = [];
     for (let i = 0; i < Math.min(args.length, resolvedFunction.parameters.length); ++i) {
         const parameter = resolvedFunction.parameters[i];
@@ -4,14 +4,19 @@ import {CompilationContext} from "../../compilation-context";
 import {CodeGenerationContext} from "../code-generation-context";
 import {RuntimeSystemNameMangler} from "../runtime-system-name-mangler";
 import {getArrayElementType, isMaybeObjectType, toLLVMType} from "../util/types";
+import {isValueArrayType} from "../util/value-classes";
 import {Address} from "./address";
+import {Allocation} from "./allocation";
 
 import {ArrayReference} from "./array-reference";
 import {ClassReference} from "./class-reference";
 import {FunctionReference} from "./function-reference";
+import {ObjectReference} from "./object-reference";
 import {createResolvedFunction, createResolvedParameter} from "./resolved-function";
 import {ResolvedFunctionReference} from "./resolved-function-reference";
 import {UnresolvedFunctionReference} from "./unresolved-function-reference";
+import {Value} from "./value";
+import {ValueArrayReference} from "./value-array-reference";
 
 function getLLVMArrayElementType(tsElementType: ts.Type, context: CodeGenerationContext) {
     if (isMaybeObjectType(tsElementType)) {
@@ -37,6 +42,7 @@ function getLLVMArrayElementType(tsElementType: ts.Type, context: CodeGeneration
 export class ArrayClassReference extends ClassReference {
 
     private llvmTypes = new Map<ts.Type, llvm.StructType>();
+    private valueArrayType: llvm.StructType | undefined;
 
     private constructor(typeInformation: llvm.GlobalVariable, symbol: ts.Symbol, compilationContext: CompilationContext) {
         super(typeInformation, symbol, compilationContext);
@@ -52,9 +58,13 @@ export class ArrayClassReference extends ClassReference {
      * @param type the type of the array
      * @param elements the elements that are to be stored in the created array
      * @param context the code generation context
-     * @return {ArrayReference} the created array
+     * @return {ObjectReference} the created array
      */
-    static fromLiteral(type: ts.ObjectType, elements: llvm.Value[], context: CodeGenerationContext): ArrayReference {
+    static fromLiteral(type: ts.ObjectType, elements: llvm.Value[], context: CodeGenerationContext): ObjectReference {
+        if (isValueArrayType(type, context)) {
+            return ArrayClassReference.valueArrayFromLiteral(type, elements, context);
+        }
+
         const parameters = [ createResolvedParameter("items", type, false, undefined, true) ];
         const resolvedConstructor = createResolvedFunction("constructor", [], parameters, type, type.getSymbol().getDeclarations()[0].getSourceFile(), type);
         const constructorFunction = ResolvedFunctionReference.createRuntimeFunction(resolvedConstructor, context);
@@ -85,7 +95,35 @@ export class ArrayClassReference extends ClassReference {
         return context.value(arrayPtr, type) as ArrayReference;
     }
 
-    objectFor(address: Address, type: ts.ObjectType) {
+    /**
+     * Copies the objects of an array literal into the storage of the created value array
+     */
+    private static valueArrayFromLiteral(type: ts.ObjectType, elements: llvm.Value[], context: CodeGenerationContext) {
+        const constructorArguments: llvm.Value[] = [ llvm.ConstantInt.get(context.llvmContext, elements.length), getValueArrayElementSize(type, context) ];
+        let constructorName = "ValueArray_constructorii";
+
+        if (elements.length > 0) {
+            const elementType = (toLLVMType(getArrayElementType(type), context) as llvm.PointerType).elementType;
+            const elementsAllocation = Allocation.createAllocaInstInEntryBlock(llvm.ArrayType.get(elementType, elements.length), context, "elements");
+
+            for (let i = 0; i < elements.length; ++i) {
+                const elementIndex = [ llvm.ConstantInt.get(context.llvmContext, 0), llvm.ConstantInt.get(context.llvmContext, i) ];
+                const elementPtr = context.builder.createInBoundsGEP(elementsAllocation, elementIndex);
+                context.builder.createStore(context.builder.createLoad(elements[i]), elementPtr);
+            }
+
+            constructorName = "ValueArray_constructorPvui";
+            constructorArguments.unshift(context.builder.createBitCast(elementsAllocation, llvm.Type.getInt8PtrTy(context.llvmContext)));
+        }
+
+        return createValueArray(type, constructorName, constructorArguments, context);
+    }
+
+    objectFor(address: Address, type: ts.ObjectType, context: CodeGenerationContext): ObjectReference {
+        if (isValueArrayType(type, context)) {
+            return new ValueArrayReference(address, type, this);
+        }
+
         return new ArrayReference(address, type, this);
     }
 
@@ -94,6 +132,11 @@ export class ArrayClassReference extends ClassReference {
     }
 
     getConstructor(newExpression: ts.NewExpression, context: CodeGenerationContext): FunctionReference {
+        const arrayType = context.typeChecker.getTypeAtLocation(newExpression) as ts.ObjectType;
+        if (isValueArrayType(arrayType, context)) {
+            return new ValueArrayConstructorReference(arrayType);
+        }
+
         const constructorSignature = context.typeChecker.getResolvedSignature(newExpression);
         context.requiresGc = true;
 
@@ -101,6 +144,10 @@ export class ArrayClassReference extends ClassReference {
     }
 
     getLLVMType(type: ts.Type, context: CodeGenerationContext): llvm.Type {
+        if (isValueArrayType(type, context)) {
+            return this.getValueArrayLLVMType(context);
+        }
+
         let elementType = getArrayElementType(type);
 
         if (isMaybeObjectType(elementType)) {
@@ -117,6 +164,9 @@ export class ArrayClassReference extends ClassReference {
 
         const llvmElementType = getLLVMArrayElementType(elementType, context);
 
+        // Only the leading begin, back and capacity fields are declared. The runtime appends the inline storage
+        // for small arrays (see ArrayInlineCapacity) that is never accessed by the generated code.
+        // Boolean arrays store bits (words, length, capacity), the fields are only accessed by the runtime.
         forwardDeclaration.setBody([
             llvmElementType.getPointerTo(),
             llvmElementType.getPointerTo(),
@@ -125,4 +175,85 @@ export class ArrayClassReference extends ClassReference {
 
         return forwardDeclaration;
     }
+
+    /**
+     * The arrays of value classes share a single type (begin, back, capacity, elementSize) as the elements are only
+     * accessed by the runtime
+     */
+    private getValueArrayLLVMType(context: CodeGenerationContext) {
+        if (!this.valueArrayType) {
+            const int8PtrType = llvm.Type.getInt8PtrTy(context.llvmContext);
+            const int32Type = llvm.Type.getInt32Ty(context.llvmContext);
+
+            this.valueArrayType = llvm.StructType.create(context.llvmContext, "class.ValueArray");
+            this.valueArrayType.setBody([ int8PtrType, int8PtrType, int32Type, int32Type ]);
+        }
+
+        return this.valueArrayType;
+    }
+}
+
+/**
+ * Returns the size of an element of a value array, the size of the object including the padding required to align the next element
+ */
+function getValueArrayElementSize(arrayType: ts.ObjectType, context: CodeGenerationContext) {
+    const elementType = getArrayElementType(arrayType) as ts.ObjectType;
+    const elementSize = context.resolveClass(elementType)!.getTypeStoreSize(elementType, context);
+    return llvm.ConstantInt.get(context.llvmContext, elementSize);
+}
+
+/**
+ * Calls a constructor of the value array runtime
+ */
+function createValueArray(arrayType: ts.ObjectType, constructorName: string, args: llvm.Value[], context: CodeGenerationContext) {
+    let constructorFn = context.module.getFunction(constructorName);
+
+    if (!constructorFn) {
+        const constructorType = llvm.FunctionType.get(toLLVMType(arrayType, context), args.map(arg => arg.type), false);
+        constructorFn = llvm.Function.create(constructorType, llvm.LinkageTypes.ExternalLinkage, constructorName, context.module);
+        constructorFn.addFnAttr(llvm.Attribute.AttrKind.AlwaysInline);
+    }
+
+    const arrayPtr = context.builder.createCall(constructorFn, args);
+
+    context.requiresGc = true;
+    return context.value(arrayPtr, arrayType) as ObjectReference;
+}
+
+/**
+ * new Array<Point>(size) of a value array, the elements are zero initialized
+ */
+class ValueArrayConstructorReference implements FunctionReference {
+    constructor(private arrayType: ts.ObjectType) {
+    }
+
+    invoke(newExpression: ts.CallExpression | ts.NewExpression, callerContext: CodeGenerationContext): Value {
+        const args = (newExpression.arguments || [] as ts.Expression[]).map(argument => callerContext.generateValue(argument).generateIR(callerContext));
+        return this.invokeWith(args, callerContext);
+    }
+
+    invokeWith(args: llvm.Value[], callerContext: CodeGenerationContext): Value {
+        const size = args.length === 0 ? llvm.ConstantInt.get(callerContext.llvmContext, 0) : args[0];
+        return createValueArray(this.arrayType, "ValueArray_constructorii", [ size, getValueArrayElementSize(this.arrayType, callerContext) ], callerContext);
+    }
+
+    generateIR(): llvm.Value {
+        throw new Error("The constructor of a value array cannot be used as a function reference");
+    }
+
+    isObject(): this is ObjectReference {
+        return false;
+    }
+
+    isAssignable() {
+        return false;
+    }
+
+    dereference() {
+        return this;
+    }
+
+    castImplicit(): undefined {
+        return undefined;
+    }
 }
@@ -0,0 +1,70 @@
+import * as llvm from "llvm-node";
+import * as ts from "typescript";
+import {CodeGenerationContext} from "../code-generation-context";
+import {RuntimeSystemNameMangler} from "../runtime-system-name-mangler";
+import {getArrayElementType} from "../util/types";
+import {toLlvmArgumentValues} from "./abstract-function-reference";
+import {FunctionFactory} from "./function-factory";
+import {ObjectReference} from "./object-reference";
+import {createResolvedParameter} from "./resolved-function";
+import {UnresolvedMethodReference} from "./unresolved-method-reference";
+import {Value} from "./value";
+
+/**
+ * Reference to Array.push, Array.unshift and Array.splice. Calls to push or unshift with a single element are lowered to
+ * the single element variants of the runtime that take the element by value instead of a pointer to a var args array.
+ * A call to splice whose result is not used is lowered to spliceDiscard that does not copy the deleted elements into a new array.
+ */
+export class ArrayMutatorMethodReference extends UnresolvedMethodReference {
+
+    /**
+     * Creates a reference to the push, unshift or splice method of the given array
+     * @param array the array
+     * @param name the name of the method
+     * @param signatures the signatures of the method
+     * @param context the context
+     */
+    static create(array: ObjectReference, name: string, signatures: ts.Signature[], context: CodeGenerationContext) {
+        const functionFactory = new FunctionFactory(new RuntimeSystemNameMangler(context.compilationContext));
+        return new ArrayMutatorMethodReference(array, name, signatures, functionFactory);
+    }
+
+    protected constructor(private array: ObjectReference, private name: string, signatures: ts.Signature[], llvmFunctionFactory: FunctionFactory) {
+        super(array, signatures, llvmFunctionFactory, { linkage: llvm.LinkageTypes.ExternalLinkage, alwaysInline: true });
+    }
+
+    invoke(callExpression: ts.CallExpression | ts.NewExpression, callerContext: CodeGenerationContext): void | Value {
+        const args = callExpression.arguments || [] as ts.Expression[];
+
+        if (this.name === "splice") {
+            if (!isResultUnused(callExpression)) {
+                return super.invoke(callExpression, callerContext);
+            }
+
+            const resolvedSignature = callerContext.typeChecker.getResolvedSignature(callExpression);
+            const resolvedFunction = Object.assign({}, this.getResolvedFunctionFromSignature(resolvedSignature, callerContext.compilationContext), {
+                functionName: "spliceDiscard"
+            });
+
+            return this.invokeResolvedFunction(resolvedFunction, toLlvmArgumentValues(args, resolvedFunction, callerContext), callerContext);
+        }
+
+        if (args.length !== 1) {
+            return super.invoke(callExpression, callerContext);
+        }
+
+        const resolvedSignature = callerContext.typeChecker.getResolvedSignature(callExpression);
+        const resolvedFunction = Object.assign({}, this.getResolvedFunctionFromSignature(resolvedSignature, callerContext.compilationContext), {
+            parameters: [ createResolvedParameter("item", getArrayElementType(this.array.type)) ]
+        });
+
+        return this.invokeResolvedFunction(resolvedFunction, toLlvmArgumentValues(args, resolvedFunction, callerContext), callerContext);
+    }
+}
+
+/**
+ * Tests if the value of the call expression is discarded, e.g. array.splice(0, 1);
+ */
+function isResultUnused(callExpression: ts.CallExpression | ts.NewExpression) {
+    return !!callExpression.parent && callExpression.parent.kind === ts.SyntaxKind.ExpressionStatement;
+}
@@ -1,11 +1,14 @@
 import * as ts from "typescript";
 
 import {CodeGenerationContext} from "../code-generation-context";
+import {isIndexInBounds} from "../util/bounds-checks";
 import {ComputedObjectPropertyReferenceBuilder} from "../util/computed-object-property-reference-builder";
 import {ObjectIndexReferenceBuilder} from "../util/object-index-reference-builder";
 import {getArrayElementType} from "../util/types";
 import {Address} from "./address";
 import {ArrayClassReference} from "./array-class-reference";
+import {ArrayMutatorMethodReference} from "./array-mutator-method-reference";
+import {ArraySortMethodReference} from "./array-sort-method-reference";
 import {BuiltInObjectReference} from "./built-in-object-reference";
 import {FunctionReference} from "./function-reference";
 import {ObjectIndexReference} from "./object-index-reference";
@@ -41,14 +44,17 @@ export class ArrayReference extends BuiltInObjectReference {
                                 context: CodeGenerationContext): FunctionReference {
         switch (symbol.name) {
             case "fill":
-            case "unshift":
-            case "push":
             case "pop":
             case "shift":
+            case "reverse":
             case "slice":
-            case "sort":
-            case "splice":
                 return UnresolvedMethodReference.createRuntimeMethod(this, signatures, context);
+            case "push":
+            case "unshift":
+            case "splice":
+                return ArrayMutatorMethodReference.create(this, symbol.name, signatures, context);
+            case "sort":
+                return ArraySortMethodReference.create(this, signatures, context);
             default:
                 return this.throwUnsupportedBuiltIn(propertyAccess);
         }
@@ -71,6 +77,7 @@ export class ArrayReference extends BuiltInObjectReference {
         return ObjectIndexReferenceBuilder
             .forElement(elementAccessExpression, context)
             .fromRuntime()
+            .unchecked(!context.compilationContext.compilerOptions.unsafe && isIndexInBounds(elementAccessExpression, context))
             .build(this);
     }
 }
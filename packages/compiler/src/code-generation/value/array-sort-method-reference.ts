@@ -0,0 +1,101 @@
+import * as llvm from "llvm-node";
+import * as ts from "typescript";
+import {CodeGenerationContext} from "../code-generation-context";
+import {RuntimeSystemNameMangler} from "../runtime-system-name-mangler";
+import {getArrayElementType} from "../util/types";
+import {FunctionFactory} from "./function-factory";
+import {ObjectReference} from "./object-reference";
+import {UnresolvedMethodReference} from "./unresolved-method-reference";
+import {Value} from "./value";
+
+/**
+ * Reference to Array.sort. Calls with the comparators (a, b) => a - b or (a, b) => b - a on int or number arrays are
+ * lowered to the ascending or descending sort of the runtime that do not need to call the comparator for every comparison.
+ */
+export class ArraySortMethodReference extends UnresolvedMethodReference {
+
+    /**
+     * Creates a reference to the sort method of the given array
+     * @param array the array
+     * @param signatures the signatures of the sort method
+     * @param context the context
+     */
+    static create(array: ObjectReference, signatures: ts.Signature[], context: CodeGenerationContext) {
+        const functionFactory = new FunctionFactory(new RuntimeSystemNameMangler(context.compilationContext));
+        return new ArraySortMethodReference(array, signatures, functionFactory);
+    }
+
+    protected constructor(private array: ObjectReference, signatures: ts.Signature[], llvmFunctionFactory: FunctionFactory) {
+        super(array, signatures, llvmFunctionFactory, { linkage: llvm.LinkageTypes.ExternalLinkage, alwaysInline: true });
+    }
+
+    invoke(callExpression: ts.CallExpression | ts.NewExpression, callerContext: CodeGenerationContext): void | Value {
+        const elementType = getArrayElementType(this.array.type);
+        const args = callExpression.arguments || [] as ts.Expression[];
+
+        if (args.length !== 1 || !(elementType.flags & (ts.TypeFlags.IntLike | ts.TypeFlags.NumberLike))) {
+            return super.invoke(callExpression, callerContext);
+        }
+
+        const order = getComparatorOrder(args[0]);
+        if (!order) {
+            return super.invoke(callExpression, callerContext);
+        }
+
+        const resolvedSignature = callerContext.typeChecker.getResolvedSignature(callExpression);
+        const resolvedFunction = this.getResolvedFunctionFromSignature(resolvedSignature, callerContext.compilationContext);
+        const functionName = order === "ascending" ? "sort" : "sortDescending";
+
+        // Calling without arguments omits the optional comparator
+        return this.invokeResolvedFunction(Object.assign({}, resolvedFunction, { functionName }), [], callerContext);
+    }
+}
+
+/**
+ * Returns the order of a comparator of the form (a, b) => a - b (ascending) or (a, b) => b - a (descending)
+ * @param comparator the comparator passed to sort
+ * @return the sort order or undefined if the comparator is not one of these forms
+ */
+function getComparatorOrder(comparator: ts.Expression): "ascending" | "descending" | undefined {
+    if (comparator.kind !== ts.SyntaxKind.ArrowFunction && comparator.kind !== ts.SyntaxKind.FunctionExpression) {
+        return undefined;
+    }
+
+    const fn = comparator as ts.ArrowFunction | ts.FunctionExpression;
+    if (fn.parameters.length !== 2 || !fn.parameters.every(parameter => parameter.name.kind === ts.SyntaxKind.Identifier && !parameter.initializer)) {
+        return undefined;
+    }
+
+    let body: ts.Node = fn.body;
+    if (body.kind === ts.SyntaxKind.Block) {
+        const statements = (body as ts.Block).statements;
+        if (statements.length !== 1 || statements[0].kind !== ts.SyntaxKind.ReturnStatement || !(statements[0] as ts.ReturnStatement).expression) {
+            return undefined;
+        }
+
+        body = (statements[0] as ts.ReturnStatement).expression!;
+    }
+
+    // (a - b), a - b as number
+    while (body.kind === ts.SyntaxKind.ParenthesizedExpression || body.kind === ts.SyntaxKind.AsExpression) {
+        body = (body as ts.ParenthesizedExpression | ts.AsExpression).expression;
+    }
+
+    if (body.kind !== ts.SyntaxKind.BinaryExpression || (body as ts.BinaryExpression).operatorToken.kind !== ts.SyntaxKind.MinusToken) {
+        return undefined;
+    }
+
+    const subtraction = body as ts.BinaryExpression;
+    const [first, second] = fn.parameters.map(parameter => (parameter.name as ts.Identifier).text);
+    const isParameter = (node: ts.Expression, name: string) => node.kind === ts.SyntaxKind.Identifier && (node as ts.Identifier).text === name;
+
+    if (isParameter(subtraction.left, first) && isParameter(subtraction.right, second)) {
+        return "ascending";
+    }
+
+    if (isParameter(subtraction.left, second) && isParameter(subtraction.right, first)) {
+        return "descending";
+    }
+
+    return undefined;
+}
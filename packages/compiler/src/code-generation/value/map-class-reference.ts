@@ -0,0 +1,81 @@
+import * as llvm from "llvm-node";
+import * as ts from "typescript";
+import {CodeGenerationDiagnostics} from "../../code-generation-diagnostic";
+import {CompilationContext} from "../../compilation-context";
+import {CodeGenerationContext} from "../code-generation-context";
+import {Address} from "./address";
+
+import {ClassReference} from "./class-reference";
+import {FunctionReference} from "./function-reference";
+import {MapReference} from "./map-reference";
+import {UnresolvedFunctionReference} from "./unresolved-function-reference";
+
+/**
+ * The keyed collections supported by the runtime (see HashMap and HashSet in hash-map.h)
+ */
+export const MAP_CLASS_NAMES = ["Map", "Set"];
+
+/**
+ * Implements the static methods of the Map<K, V> and Set<K> classes. Only int and number keys are supported.
+ */
+export class MapClassReference extends ClassReference {
+
+    private llvmType: llvm.StructType | undefined;
+
+    private constructor(typeInformation: llvm.GlobalVariable, symbol: ts.Symbol, compilationContext: CompilationContext) {
+        super(typeInformation, symbol, compilationContext);
+    }
+
+    static create(symbol: ts.Symbol, context: CodeGenerationContext) {
+        const typeInformation = ClassReference.createTypeDescriptor(symbol, context);
+        return new MapClassReference(typeInformation, symbol, context.compilationContext);
+    }
+
+    objectFor(address: Address, type: ts.ObjectType) {
+        return new MapReference(address, type, this);
+    }
+
+    getFields() {
+        return [];
+    }
+
+    getConstructor(newExpression: ts.NewExpression, context: CodeGenerationContext): FunctionReference {
+        const type = context.typeChecker.getTypeAtLocation(newExpression) as ts.TypeReference;
+        const keyType = (type.typeArguments || [])[0];
+
+        if (!keyType || !(keyType.flags & (ts.TypeFlags.IntLike | ts.TypeFlags.NumberLike))) {
+            const keyTypeName = keyType ? context.typeChecker.typeToString(keyType) : "any";
+            throw CodeGenerationDiagnostics.unsupportedKeyType(newExpression, this.symbol.name, keyTypeName);
+        }
+
+        // Initializing the collection with the entries passed to the constructor is not supported
+        if (newExpression.arguments && newExpression.arguments.length > 0) {
+            throw CodeGenerationDiagnostics.unsupportedSyntaxKind(newExpression.arguments[0]);
+        }
+
+        const constructorSignature = context.typeChecker.getResolvedSignature(newExpression);
+        context.requiresGc = true;
+
+        return UnresolvedFunctionReference.createRuntimeFunction([constructorSignature], context);
+    }
+
+    getLLVMType(type: ts.Type, context: CodeGenerationContext): llvm.Type {
+        if (this.llvmType) {
+            return this.llvmType;
+        }
+
+        // entries, slots, entriesCount, entriesCapacity, count and slotMask. The fields are only accessed by the runtime
+        const int32Type = llvm.Type.getInt32Ty(context.llvmContext);
+        this.llvmType = llvm.StructType.create(context.llvmContext, "class.HashTable");
+        this.llvmType.setBody([
+            llvm.Type.getInt8PtrTy(context.llvmContext),
+            int32Type.getPointerTo(),
+            int32Type,
+            int32Type,
+            int32Type,
+            int32Type
+        ]);
+
+        return this.llvmType;
+    }
+}
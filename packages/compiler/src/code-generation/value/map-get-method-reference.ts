@@ -0,0 +1,42 @@
+import * as llvm from "llvm-node";
+import * as ts from "typescript";
+import {CodeGenerationContext} from "../code-generation-context";
+import {RuntimeSystemNameMangler} from "../runtime-system-name-mangler";
+import {isMaybeObjectType} from "../util/types";
+import {toLlvmArgumentValues} from "./abstract-function-reference";
+import {FunctionFactory} from "./function-factory";
+import {ObjectReference} from "./object-reference";
+import {UnresolvedMethodReference} from "./unresolved-method-reference";
+import {Value} from "./value";
+
+/**
+ * Reference to Map.get. The declared return type is V | undefined. The runtime returns the default value of V for
+ * absent keys of primitive values (as Array.get for out of bound indices) and the nullptr (undefined) for objects.
+ */
+export class MapGetMethodReference extends UnresolvedMethodReference {
+
+    /**
+     * Creates a reference to the get method of the given map
+     * @param map the map
+     * @param signatures the signatures of the get method
+     * @param context the context
+     */
+    static create(map: ObjectReference, signatures: ts.Signature[], context: CodeGenerationContext) {
+        const functionFactory = new FunctionFactory(new RuntimeSystemNameMangler(context.compilationContext));
+        return new MapGetMethodReference(map, signatures, functionFactory);
+    }
+
+    protected constructor(map: ObjectReference, signatures: ts.Signature[], llvmFunctionFactory: FunctionFactory) {
+        super(map, signatures, llvmFunctionFactory, { linkage: llvm.LinkageTypes.ExternalLinkage, alwaysInline: true });
+    }
+
+    invoke(callExpression: ts.CallExpression | ts.NewExpression, callerContext: CodeGenerationContext): void | Value {
+        const resolvedSignature = callerContext.typeChecker.getResolvedSignature(callExpression);
+        const resolvedFunction = this.getResolvedFunctionFromSignature(resolvedSignature, callerContext.compilationContext);
+        const returnType = isMaybeObjectType(resolvedFunction.returnType) ? resolvedFunction.returnType : resolvedFunction.returnType.getNonNullableType();
+        const valueFunction = Object.assign({}, resolvedFunction, { returnType });
+
+        const args = toLlvmArgumentValues(callExpression.arguments || [] as ts.Expression[], valueFunction, callerContext);
+        return this.invokeResolvedFunction(valueFunction, args, callerContext);
+    }
+}
@@ -0,0 +1,63 @@
+import * as ts from "typescript";
+
+import {CodeGenerationContext} from "../code-generation-context";
+import {ComputedObjectPropertyReferenceBuilder} from "../util/computed-object-property-reference-builder";
+import {Address} from "./address";
+import {BuiltInObjectReference} from "./built-in-object-reference";
+import {FunctionReference} from "./function-reference";
+import {MapClassReference} from "./map-class-reference";
+import {MapGetMethodReference} from "./map-get-method-reference";
+import {ObjectPropertyReference} from "./object-property-reference";
+import {UnresolvedMethodReference} from "./unresolved-method-reference";
+
+/**
+ * Reference to a Map<K, V> or Set<K> object. The methods that iterate the entries (forEach, keys, ...) are not supported.
+ */
+export class MapReference extends BuiltInObjectReference {
+
+    /**
+     * Creates a new instance
+     * @param address the address of the map or set object
+     * @param mapType the type of the map or set
+     * @param mapClass the class of the map or set
+     */
+    constructor(address: Address, mapType: ts.ObjectType, mapClass: MapClassReference) {
+        super(address, mapType, mapClass);
+    }
+
+    protected get typeName(): string {
+        return this.clazz.symbol.name;
+    }
+
+    protected createFunctionFor(symbol: ts.Symbol,
+                                signatures: ts.Signature[],
+                                propertyAccess: ts.PropertyAccessExpression,
+                                context: CodeGenerationContext): FunctionReference {
+        switch (symbol.name) {
+            case "get":
+                return MapGetMethodReference.create(this, signatures, context);
+            case "add":
+            case "set":
+            case "has":
+            case "delete":
+            case "clear":
+                return UnresolvedMethodReference.createRuntimeMethod(this, signatures, context);
+            default:
+                return this.throwUnsupportedBuiltIn(propertyAccess);
+        }
+    }
+
+    protected createPropertyReference(symbol: ts.Symbol, propertyAccess: ts.PropertyAccessExpression, context: CodeGenerationContext): ObjectPropertyReference {
+        switch (symbol.name) {
+            case "size":
+                return ComputedObjectPropertyReferenceBuilder
+                    .forProperty(propertyAccess, context)
+                    .fromRuntime()
+                    .readonly()
+                    .build(this);
+
+            default:
+                return this.throwUnsupportedBuiltIn(propertyAccess);
+        }
+    }
+}
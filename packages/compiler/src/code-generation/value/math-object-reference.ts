@@ -29,10 +29,12 @@ export class MathObjectReference extends BuiltInObjectReference {
             // use the llvm intrinsic whenever a web assembly instruction exists
             case "pow":
             case "sqrt":
+            case "exp":
             case "log":
             case "sin":
             case "cos":
             case "max":
+            case "min":
                 return UnresolvedMethodReference.createRuntimeMethod(this, signatures, context, { readnone: true, noUnwind: true });
             default:
                 throw CodeGenerationDiagnostics.builtInMethodNotSupported(propertyAccessExpression, "Math", symbol.name);
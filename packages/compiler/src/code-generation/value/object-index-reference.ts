@@ -10,10 +10,10 @@ import {AssignableValue, Value} from "./value";
 export class ObjectIndexReference implements AssignableValue {
 
     constructor(public type: ts.Type,
-                private object: ObjectReference,
-                private index: Value,
-                private getter: llvm.Function | undefined,
-                private setter: llvm.Function | undefined) {
+                protected object: ObjectReference,
+                protected index: Value,
+                protected getter: llvm.Function | undefined,
+                protected setter: llvm.Function | undefined) {
     }
 
     generateIR(context: CodeGenerationContext): llvm.Value {
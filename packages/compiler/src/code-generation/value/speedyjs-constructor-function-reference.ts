@@ -105,7 +105,8 @@ class ConstructorFunctionBuilder {
         const objectType = this.classReference.getLLVMType(this.classReference.type, this.context);
         const pointerType = llvm.Type.getInt8PtrTy(this.context.llvmContext);
         const mallocFunctionType = llvm.FunctionType.get(pointerType, [llvm.Type.getInt32Ty(this.context.llvmContext)], false);
-        const malloc = this.context.module.getOrInsertFunction("malloc", mallocFunctionType);
+        // The size of the object is known at compile time, therefore, it can be allocated from the pool of the runtime
+        const malloc = this.context.module.getOrInsertFunction("speedyJsAllocateObject", mallocFunctionType);
         const size = sizeof(objectType, this.context);
 
         const result = this.context.builder.createCall(malloc, [size], "thisVoid*");
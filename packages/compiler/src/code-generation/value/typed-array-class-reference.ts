@@ -0,0 +1,77 @@
+import * as llvm from "llvm-node";
+import * as ts from "typescript";
+import {CompilationContext} from "../../compilation-context";
+import {CodeGenerationContext} from "../code-generation-context";
+import {Address} from "./address";
+
+import {ClassReference} from "./class-reference";
+import {FunctionReference} from "./function-reference";
+import {TypedArrayReference} from "./typed-array-reference";
+import {UnresolvedFunctionReference} from "./unresolved-function-reference";
+
+/**
+ * The typed arrays supported by the runtime. The runtime stores the elements in an Array<T> of the narrow element type
+ * (see DEFINE_TYPED_ARRAY_API in array-api.cc), the elements are read and written as number.
+ */
+export const TYPED_ARRAY_NAMES = ["Float32Array", "Int8Array", "Int16Array", "Uint8Array"];
+
+function getLLVMTypedArrayElementType(name: string, context: CodeGenerationContext): llvm.Type {
+    switch (name) {
+        case "Float32Array":
+            return llvm.Type.getFloatTy(context.llvmContext);
+        case "Int16Array":
+            return llvm.Type.getInt16Ty(context.llvmContext);
+        default:
+            return llvm.Type.getInt8Ty(context.llvmContext);
+    }
+}
+
+/**
+ * Implements the static methods of a typed array class (e.g. Float32Array)
+ */
+export class TypedArrayClassReference extends ClassReference {
+
+    private llvmType: llvm.StructType | undefined;
+
+    private constructor(typeInformation: llvm.GlobalVariable, symbol: ts.Symbol, compilationContext: CompilationContext) {
+        super(typeInformation, symbol, compilationContext);
+    }
+
+    static create(symbol: ts.Symbol, context: CodeGenerationContext) {
+        const typeInformation = ClassReference.createTypeDescriptor(symbol, context);
+        return new TypedArrayClassReference(typeInformation, symbol, context.compilationContext);
+    }
+
+    objectFor(address: Address, type: ts.ObjectType) {
+        return new TypedArrayReference(address, type, this);
+    }
+
+    getFields() {
+        return [];
+    }
+
+    getConstructor(newExpression: ts.NewExpression, context: CodeGenerationContext): FunctionReference {
+        const constructorSignature = context.typeChecker.getResolvedSignature(newExpression);
+        context.requiresGc = true;
+
+        return UnresolvedFunctionReference.createRuntimeFunction([constructorSignature], context);
+    }
+
+    getLLVMType(type: ts.Type, context: CodeGenerationContext): llvm.Type {
+        if (this.llvmType) {
+            return this.llvmType;
+        }
+
+        const llvmElementType = getLLVMTypedArrayElementType(this.symbol.name, context);
+
+        // Same leading fields as the Array<T> of the narrow element type (begin, back and capacity)
+        this.llvmType = llvm.StructType.create(context.llvmContext, "class.Array");
+        this.llvmType.setBody([
+            llvmElementType.getPointerTo(),
+            llvmElementType.getPointerTo(),
+            llvm.Type.getInt32Ty(context.llvmContext)
+        ]);
+
+        return this.llvmType;
+    }
+}
@@ -0,0 +1,71 @@
+import * as ts from "typescript";
+
+import {CodeGenerationContext} from "../code-generation-context";
+import {isIndexInBounds} from "../util/bounds-checks";
+import {ComputedObjectPropertyReferenceBuilder} from "../util/computed-object-property-reference-builder";
+import {ObjectIndexReferenceBuilder} from "../util/object-index-reference-builder";
+import {Address} from "./address";
+import {BuiltInObjectReference} from "./built-in-object-reference";
+import {FunctionReference} from "./function-reference";
+import {ObjectIndexReference} from "./object-index-reference";
+import {ObjectPropertyReference} from "./object-property-reference";
+import {TypedArrayClassReference} from "./typed-array-class-reference";
+import {UnresolvedMethodReference} from "./unresolved-method-reference";
+
+/**
+ * Reference to a typed array object (e.g. Float32Array). Typed arrays have a fixed length, only the methods that
+ * do not change the length are supported.
+ */
+export class TypedArrayReference extends BuiltInObjectReference {
+
+    /**
+     * Creates a new instance
+     * @param address the address of the typed array object
+     * @param typedArrayType the type of the typed array
+     * @param typedArrayClass the class of the typed array
+     */
+    constructor(address: Address, typedArrayType: ts.ObjectType, typedArrayClass: TypedArrayClassReference) {
+        super(address, typedArrayType, typedArrayClass);
+    }
+
+    protected get typeName(): string {
+        return this.clazz.symbol.name;
+    }
+
+    protected createFunctionFor(symbol: ts.Symbol,
+                                signatures: ts.Signature[],
+                                propertyAccess: ts.PropertyAccessExpression,
+                                context: CodeGenerationContext): FunctionReference {
+        switch (symbol.name) {
+            case "fill":
+            case "reverse":
+            case "slice":
+            case "sort":
+                return UnresolvedMethodReference.createRuntimeMethod(this, signatures, context);
+            default:
+                return this.throwUnsupportedBuiltIn(propertyAccess);
+        }
+    }
+
+    protected createPropertyReference(symbol: ts.Symbol, propertyAccess: ts.PropertyAccessExpression, context: CodeGenerationContext): ObjectPropertyReference {
+        switch (symbol.name) {
+            case "length":
+                return ComputedObjectPropertyReferenceBuilder
+                    .forProperty(propertyAccess, context)
+                    .fromRuntime()
+                    .readonly()
+                    .build(this);
+
+            default:
+                return this.throwUnsupportedBuiltIn(propertyAccess);
+        }
+    }
+
+    getIndexer(elementAccessExpression: ts.ElementAccessExpression, context: CodeGenerationContext): ObjectIndexReference {
+        return ObjectIndexReferenceBuilder
+            .forElement(elementAccessExpression, context)
+            .fromRuntime()
+            .unchecked(!context.compilationContext.compilerOptions.unsafe && isIndexInBounds(elementAccessExpression, context))
+            .build(this);
+    }
+}
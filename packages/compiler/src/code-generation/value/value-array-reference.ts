@@ -0,0 +1,215 @@
+import * as llvm from "llvm-node";
+import * as ts from "typescript";
+
+import {CodeGenerationContext} from "../code-generation-context";
+import {isIndexInBounds} from "../util/bounds-checks";
+import {getArrayElementType, toLLVMType} from "../util/types";
+import {Address} from "./address";
+import {ArrayClassReference} from "./array-class-reference";
+import {BuiltInObjectReference} from "./built-in-object-reference";
+import {FunctionReference} from "./function-reference";
+import {ObjectIndexReference} from "./object-index-reference";
+import {ObjectPropertyReference} from "./object-property-reference";
+import {ObjectReference} from "./object-reference";
+import {Primitive} from "./primitive";
+import {Value} from "./value";
+
+/**
+ * Reference to an array of a value class whose elements are stored inline (see ValueArray in the runtime and isValueClass).
+ * Only push, length and the element access are supported, an element is the storage of the object in the array.
+ */
+export class ValueArrayReference extends BuiltInObjectReference {
+
+    private elementType: ts.ObjectType;
+
+    /**
+     * Creates a new instance
+     * @param address the address of the array object
+     * @param arrayType the type of the array
+     * @param arrayClass the arrayClass
+     */
+    constructor(address: Address, arrayType: ts.ObjectType, arrayClass: ArrayClassReference) {
+        super(address, arrayType, arrayClass);
+
+        this.elementType = getArrayElementType(arrayType) as ts.ObjectType;
+    }
+
+    protected get typeName(): string {
+        return "Array";
+    }
+
+    protected createFunctionFor(symbol: ts.Symbol,
+                                signatures: ts.Signature[],
+                                propertyAccess: ts.PropertyAccessExpression,
+                                context: CodeGenerationContext): FunctionReference {
+        switch (symbol.name) {
+            case "push":
+                return new ValueArrayPushMethodReference(this);
+            default:
+                return this.throwUnsupportedBuiltIn(propertyAccess);
+        }
+    }
+
+    protected createPropertyReference(symbol: ts.Symbol, propertyAccess: ts.PropertyAccessExpression, context: CodeGenerationContext): ObjectPropertyReference {
+        switch (symbol.name) {
+            case "length":
+                const intType = llvm.Type.getInt32Ty(context.llvmContext);
+                const getter = getRuntimeFunction(this, "ValueArray_length", intType, [], true, context);
+                const setter = getRuntimeFunction(this, "ValueArray_lengthi", llvm.Type.getVoidTy(context.llvmContext), [intType], false, context);
+                const lengthType = context.typeChecker.getTypeAtLocation(propertyAccess);
+
+                return ObjectPropertyReference.createComputedPropertyReference(lengthType, this, symbol, getter, setter);
+            default:
+                return this.throwUnsupportedBuiltIn(propertyAccess);
+        }
+    }
+
+    getIndexer(elementAccessExpression: ts.ElementAccessExpression, context: CodeGenerationContext): ObjectIndexReference {
+        const intType = llvm.Type.getInt32Ty(context.llvmContext);
+        const i8PtrType = llvm.Type.getInt8PtrTy(context.llvmContext);
+        const unchecked = !context.compilationContext.compilerOptions.unsafe && isIndexInBounds(elementAccessExpression, context);
+
+        const getter = getRuntimeFunction(this, unchecked ? "ValueArray_elementAtUncheckedi" : "ValueArray_elementAti", i8PtrType, [intType], true, context);
+        const setter = getRuntimeFunction(this, "ValueArray_setiPv", llvm.Type.getVoidTy(context.llvmContext), [intType, i8PtrType], false, context);
+        const index = context.generateValue(elementAccessExpression.argumentExpression!);
+
+        return new ValueArrayElementReference(this.elementType, this, index, getter, setter);
+    }
+
+    /**
+     * Returns the runtime function that appends the given number of elements stored at a pointer to the array
+     */
+    getPushFunction(context: CodeGenerationContext) {
+        const intType = llvm.Type.getInt32Ty(context.llvmContext);
+        return getRuntimeFunction(this, "ValueArray_pushPvu", intType, [llvm.Type.getInt8PtrTy(context.llvmContext), intType], false, context);
+    }
+}
+
+/**
+ * Reference to an element of a value array. The element is not loaded, instead, the fields of the element are accessed
+ * through the address returned by the runtime.
+ */
+class ValueArrayElementReference extends ObjectIndexReference {
+
+    generateIR(context: CodeGenerationContext): llvm.Value {
+        const elementPtr = super.generateIR(context);
+        return context.builder.createBitCast(elementPtr, toLLVMType(this.type, context), "&[i]");
+    }
+
+    getValue(context: CodeGenerationContext): Value {
+        const elementClass = context.resolveClass(this.type)!;
+
+        // The address is recomputed for every access as the elements move if the array grows
+        return elementClass.objectFor(new ValueArrayElementAddress(this), this.type as ts.ObjectType, context);
+    }
+
+    generateAssignmentIR(value: Value, context: CodeGenerationContext): void {
+        const objectPtr = context.builder.createBitCast(value.generateIR(context), llvm.Type.getInt8PtrTy(context.llvmContext));
+        context.builder.createCall(this.setter!, [this.object.generateIR(context), this.index.generateIR(context), objectPtr]);
+    }
+}
+
+class ValueArrayElementAddress implements Address {
+    constructor(private element: ValueArrayElementReference) {
+    }
+
+    get(context: CodeGenerationContext) {
+        return this.element.generateIR(context);
+    }
+
+    isPointer() {
+        return false;
+    }
+}
+
+/**
+ * Array.push of a value array, copies the pushed objects into the array
+ */
+class ValueArrayPushMethodReference implements FunctionReference {
+    constructor(private array: ValueArrayReference) {
+    }
+
+    invoke(callExpression: ts.CallExpression | ts.NewExpression, callerContext: CodeGenerationContext): Value {
+        const args = (callExpression.arguments || [] as ts.Expression[]).map(argument => callerContext.generateValue(argument).generateIR(callerContext));
+        return new Primitive(this.push(args, callerContext), callerContext.typeChecker.getTypeAtLocation(callExpression));
+    }
+
+    invokeWith(args: llvm.Value[], callerContext: CodeGenerationContext): void {
+        this.push(args, callerContext);
+    }
+
+    /**
+     * Pushes the objects one after another and returns the new length of the array
+     */
+    private push(objects: llvm.Value[], context: CodeGenerationContext): llvm.Value {
+        const intType = llvm.Type.getInt32Ty(context.llvmContext);
+
+        if (objects.length === 0) {
+            const lengthFn = getRuntimeFunction(this.array, "ValueArray_length", intType, [], true, context);
+            return context.builder.createCall(lengthFn, [this.array.generateIR(context)], "length");
+        }
+
+        const pushFn = this.array.getPushFunction(context);
+        const one = llvm.ConstantInt.get(context.llvmContext, 1);
+        let length: llvm.Value | undefined;
+
+        for (const object of objects) {
+            const objectPtr = context.builder.createBitCast(object, llvm.Type.getInt8PtrTy(context.llvmContext));
+            length = context.builder.createCall(pushFn, [this.array.generateIR(context), objectPtr, one], "length");
+        }
+
+        return length!;
+    }
+
+    generateIR(): llvm.Value {
+        throw new Error("Array.push of a value array cannot be used as a function reference");
+    }
+
+    isObject(): this is ObjectReference {
+        return false;
+    }
+
+    isAssignable() {
+        return false;
+    }
+
+    dereference() {
+        return this;
+    }
+
+    castImplicit(): undefined {
+        return undefined;
+    }
+}
+
+/**
+ * Declares a function of the value array runtime. The first argument of the function is the array. Functions
+ * not modifying the array are declared as read only so that LLVM can hoist repeated element accesses.
+ */
+function getRuntimeFunction(array: ValueArrayReference,
+                            name: string,
+                            returnType: llvm.Type,
+                            parameters: llvm.Type[],
+                            readOnly: boolean,
+                            context: CodeGenerationContext) {
+    let fn = context.module.getFunction(name);
+
+    if (!fn) {
+        const arrayType = toLLVMType(array.type, context);
+        const functionType = llvm.FunctionType.get(returnType, [arrayType, ...parameters], false);
+        fn = llvm.Function.create(functionType, llvm.LinkageTypes.ExternalLinkage, name, context.module);
+        fn.addFnAttr(llvm.Attribute.AttrKind.AlwaysInline);
+
+        if (readOnly) {
+            fn.addFnAttr(llvm.Attribute.AttrKind.ReadOnly);
+            fn.addFnAttr(llvm.Attribute.AttrKind.NoUnwind);
+            fn.addFnAttr(llvm.Attribute.AttrKind.NoRecurse);
+        }
+
+        const self = fn.getArguments()[0];
+        self.addDereferenceableAttr(array.getTypeStoreSize(context));
+        self.addAttr(llvm.Attribute.AttrKind.NoCapture);
+    }
+
+    return fn;
+}
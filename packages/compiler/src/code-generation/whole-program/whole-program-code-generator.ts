@@ -0,0 +1,185 @@
+import * as assert from "assert";
+import * as debug from "debug";
+import * as llvm from "llvm-node";
+import * as path from "path";
+import * as ts from "typescript";
+
+import {CodeGenerationDiagnostics} from "../../code-generation-diagnostic";
+import {CompilationContext} from "../../compilation-context";
+import {BuildCache} from "../build-cache";
+import {CodeGenerationContext} from "../code-generation-context";
+import {CodeGenerator} from "../code-generator";
+import {DefaultCodeGenerationContextFactory} from "../default-code-generation-context-factory";
+import {NoopSourceFileRewriter} from "../per-file/llvm-emit-source-file-rewriter";
+import {createWasmModule, getOutputFileName, writeModule} from "../per-file/per-file-code-generator";
+import {PerFileCodeGeneratorSourceFileRewriter} from "../per-file/per-file-code-generator-source-file-rewriter";
+import {PerFileSourceFileRewirter} from "../per-file/per-file-source-file-rewriter";
+import {PerFileWasmLoaderEmitHelper} from "../per-file/per-file-wasm-loader-emit-helper";
+import {defineBatchEntryFunction, hasBatchEntryFunction} from "../util/batch-entry-function";
+import {FunctionBuilder} from "../util/function-builder";
+import {createResolvedFunctionFromSignature} from "../value/resolved-function";
+import {getModuleKind, WholeProgramSourceFileRewriter} from "./whole-program-source-file-rewriter";
+
+const LOG = debug("code-generation/whole-program-code-generator");
+
+/**
+ * The name of the wasm file and of the loader module of the program (without extension)
+ */
+export const PROGRAM_MODULE_NAME = "speedyjs-program";
+
+interface SourceFileState {
+    sourceFileRewriter: PerFileSourceFileRewirter;
+    requestEmitHelper: (emitHelper: ts.EmitHelper) => void;
+    entryFunctions: number;
+}
+
+/**
+ * Code Generator that creates a single WASM Module for all source files of the program. The speedy js functions of all
+ * files are linked with a single copy of the runtime and the calls between functions of different files are direct
+ * wasm calls. The module is compiled when the compilation of all source files is complete and is loaded by the program
+ * loader module (speedyjs-program.js) that is imported by the source files with entry functions.
+ */
+export class WholeProgramCodeGenerator implements CodeGenerator {
+    private sourceFileStates = new Map<string, SourceFileState>();
+    private programContext: CodeGenerationContext | undefined;
+
+    constructor(private context: llvm.LLVMContext, private codeGenerationContextFactory = new DefaultCodeGenerationContextFactory()) {
+    }
+
+    beginSourceFile(sourceFile: ts.SourceFile, compilationContext: CompilationContext, requestEmitHelper: (emitHelper: ts.EmitHelper) => void) {
+        const context = this.getProgramContext(compilationContext);
+        const emitsWasm = !compilationContext.compilerOptions.emitLLVM;
+        const programLoaderModule = getProgramLoaderModuleSpecifier(sourceFile, context);
+
+        this.sourceFileStates.set(sourceFile.fileName, {
+            requestEmitHelper,
+            sourceFileRewriter: emitsWasm ? new WholeProgramSourceFileRewriter(context, programLoaderModule) : new NoopSourceFileRewriter(),
+            entryFunctions: 0
+        });
+    }
+
+    generateEntryFunction(functionDeclaration: ts.FunctionDeclaration): ts.FunctionDeclaration {
+        const state = this.getSourceFileState(functionDeclaration);
+        const context = this.programContext!;
+
+        // a script cannot import the program loader module
+        if (!context.compilationContext.compilerOptions.emitLLVM && !ts.isExternalModule(functionDeclaration.getSourceFile())) {
+            throw CodeGenerationDiagnostics.wholeProgramEntryFunctionOutsideOfModule(functionDeclaration);
+        }
+
+        // function is async, therefore, return type is a promise of T. We compile it down to a function just returning T
+        const signature = context.typeChecker.getSignatureFromDeclaration(functionDeclaration);
+        const resolvedFunction = createResolvedFunctionFromSignature(signature, context.compilationContext);
+
+        // Entry functions of different source files might have the same name
+        let mangledName = `_${resolvedFunction.functionName}`;
+        for (let i = 1; context.module.getFunction(mangledName); ++i) {
+            mangledName = `_${resolvedFunction.functionName}_${i}`;
+        }
+
+        const builder = FunctionBuilder.create(resolvedFunction, context)
+            .name(mangledName)
+            .externalLinkage();
+
+        builder.define(resolvedFunction.definition!);
+        context.addEntryFunction(mangledName);
+
+        const parameterTypes = resolvedFunction.parameters.map(parameter => parameter.type);
+        if (hasBatchEntryFunction(functionDeclaration, parameterTypes, resolvedFunction.returnType, context.compilationContext.compilerOptions)) {
+            const batchFunction = defineBatchEntryFunction(context.module.getFunction(mangledName)!, resolvedFunction, context);
+            context.addEntryFunction(batchFunction.name);
+        }
+        ++state.entryFunctions;
+
+        return state.sourceFileRewriter.rewriteEntryFunction(mangledName, functionDeclaration, state.requestEmitHelper);
+    }
+
+    completeSourceFile(sourceFile: ts.SourceFile): ts.SourceFile {
+        const state = this.getSourceFileState(sourceFile);
+
+        if (state.entryFunctions === 0) {
+            return sourceFile;
+        }
+
+        return state.sourceFileRewriter.rewriteSourceFile(sourceFile, state.requestEmitHelper);
+    }
+
+    completeCompilation() {
+        const context = this.programContext;
+        this.sourceFileStates.clear();
+        this.programContext = undefined;
+
+        if (!context || context.getEntryFunctionNames().length === 0) {
+            return;
+        }
+
+        if (context.requiresGc) {
+            context.module.getOrInsertFunction("speedyJsGc", llvm.FunctionType.get(llvm.Type.getVoidTy(context.llvmContext), [], false));
+        }
+
+        const programFile = createProgramFile(context);
+        const buildCache = BuildCache.create(context.compilationContext);
+
+        LOG("Emit module for the program.");
+        llvm.verifyModule(context.module);
+
+        if (context.compilationContext.compilerOptions.emitLLVM) {
+            writeModule(programFile, context, new NoopSourceFileRewriter(), buildCache);
+        } else {
+            const programRewriter = new PerFileCodeGeneratorSourceFileRewriter(context);
+            writeModule(programFile, context, programRewriter, buildCache);
+            writeProgramLoaderModule(programFile, programRewriter, context);
+        }
+
+        LOG("Module for the program emitted.");
+    }
+
+    private getProgramContext(compilationContext: CompilationContext): CodeGenerationContext {
+        if (!this.programContext) {
+            const module = createWasmModule(PROGRAM_MODULE_NAME, `${PROGRAM_MODULE_NAME}.ts`, this.context);
+            this.programContext = this.codeGenerationContextFactory.createContext(compilationContext, module);
+        }
+
+        return this.programContext;
+    }
+
+    private getSourceFileState(node: ts.Node): SourceFileState {
+        const sourceFile = node.getSourceFile();
+        const state = this.sourceFileStates.get(sourceFile.fileName);
+
+        // tslint:disable-next-line:max-line-length
+        assert(state, `First call beginSourceFile before calling any other functions on the code generator (state missing for source file ${sourceFile.fileName}).`);
+
+        return state!;
+    }
+}
+
+/**
+ * Creates the (empty) source file of the program that determines the names of the program output files
+ */
+function createProgramFile(context: CodeGenerationContext): ts.SourceFile {
+    return ts.createSourceFile(path.join(context.compilationContext.rootDir, `${PROGRAM_MODULE_NAME}.ts`), "", ts.ScriptTarget.Latest);
+}
+
+/**
+ * Returns the specifier of the program loader module relative to the output file of the given source file
+ */
+function getProgramLoaderModuleSpecifier(sourceFile: ts.SourceFile, context: CodeGenerationContext) {
+    const programLoaderFileName = getOutputFileName(createProgramFile(context), context, "");
+    const sourceFileDirectory = path.dirname(getOutputFileName(sourceFile, context, ".js"));
+    const relativePath = path.relative(sourceFileDirectory, programLoaderFileName).replace(/\\/g, "/");
+
+    return relativePath.startsWith(".") ? relativePath : `./${relativePath}`;
+}
+
+/**
+ * Writes the program loader module that contains the module loader and exports the loader of the program as loadWasmModule
+ */
+function writeProgramLoaderModule(programFile: ts.SourceFile, programRewriter: PerFileCodeGeneratorSourceFileRewriter, context: CodeGenerationContext) {
+    const compilerOptions = context.compilationContext.compilerOptions;
+    const moduleLoader = ts.createPrinter().printNode(ts.EmitHint.Expression, programRewriter.createModuleLoader(), programFile);
+    const loaderExport = getModuleKind(compilerOptions) >= ts.ModuleKind.ES2015 ? "export var loadWasmModule" : "exports.loadWasmModule";
+
+    const content = `${new PerFileWasmLoaderEmitHelper().text}\n${loaderExport} = ${moduleLoader};\n`;
+    context.compilationContext.compilerHost.writeFile(getOutputFileName(programFile, context, ".js"), content, false);
+}
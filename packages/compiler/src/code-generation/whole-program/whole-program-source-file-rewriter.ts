@@ -0,0 +1,64 @@
+import * as ts from "typescript";
+import {CodeGenerationContext} from "../code-generation-context";
+import {PerFileCodeGeneratorSourceFileRewriter} from "../per-file/per-file-code-generator-source-file-rewriter";
+
+/**
+ * Rewrites the entry functions of a source file to call the wasm module of the whole program. The module loader is not
+ * inserted into the source file. Instead, it is imported from the program loader module that is written when the
+ * compilation of all source files is complete.
+ */
+export class WholeProgramSourceFileRewriter extends PerFileCodeGeneratorSourceFileRewriter {
+
+    /**
+     * @param context the code generation context of the program
+     * @param programLoaderModule the module specifier of the program loader module, relative to the source file
+     */
+    constructor(context: CodeGenerationContext, private programLoaderModule: string) {
+        super(context);
+    }
+
+    rewriteSourceFile(sourceFile: ts.SourceFile, requestEmitHelper: (emitHelper: ts.EmitHelper) => void): ts.SourceFile {
+        if (!this.loadWasmFunctionIdentifier) {
+            return sourceFile;
+        }
+
+        const programIdentifier = ts.createUniqueName("speedyJsProgram");
+
+        // var loadWasmModule = speedyJsProgram.loadWasmModule;
+        const loaderVariable = ts.createVariableDeclaration(
+            this.loadWasmFunctionIdentifier,
+            undefined,
+            ts.createPropertyAccess(programIdentifier, "loadWasmModule")
+        );
+
+        return ts.updateSourceFileNode(sourceFile, [
+            this.createProgramLoaderImport(programIdentifier),
+            ts.createVariableStatement([], ts.createVariableDeclarationList([loaderVariable])),
+            ...this.createLoaderExports(),
+            ...sourceFile.statements
+        ]);
+    }
+
+    /**
+     * Creates the import of the program loader module. The module transformation of TypeScript rewrites the import for
+     * the module kind of the emitted files (e.g. to a require call for CommonJS).
+     * @code
+     * import * as speedyJsProgram from "./speedyjs-program";
+     */
+    private createProgramLoaderImport(programIdentifier: ts.Identifier): ts.Statement {
+        const importClause = ts.createImportClause(undefined, ts.createNamespaceImport(programIdentifier));
+        return ts.createImportDeclaration(undefined, undefined, importClause, ts.createLiteral(this.programLoaderModule));
+    }
+}
+
+/**
+ * Returns the module kind of the emitted JS files. If no module kind is set, then ES2015 modules are emitted for ES2015
+ * and later targets and CommonJS modules otherwise.
+ */
+export function getModuleKind(compilerOptions: ts.CompilerOptions): ts.ModuleKind {
+    if (typeof(compilerOptions.module) !== "undefined") {
+        return compilerOptions.module;
+    }
+
+    return (compilerOptions.target || ts.ScriptTarget.ES3) >= ts.ScriptTarget.ES2015 ? ts.ModuleKind.ES2015 : ts.ModuleKind.CommonJS;
+}
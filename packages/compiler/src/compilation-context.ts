@@ -39,4 +39,10 @@ export interface CompilationContext {
      * The root directory where the source files are located
      */
     readonly rootDir: string;
+
+    /**
+     * The declarations of the values added to a source file by the transformation (by the name of the source file).
+     * These are appended to the declaration file (.d.ts) of the source file.
+     */
+    readonly additionalDeclarations: Map<string, string[]>;
 }
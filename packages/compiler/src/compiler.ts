@@ -6,6 +6,7 @@ import {CodeGenerationDiagnostics, isCodeGenerationDiagnostic} from "./code-gene
 import {DefaultCodeGenerationContextFactory} from "./code-generation/default-code-generation-context-factory";
 import {NotYetImplementedCodeGenerator} from "./code-generation/not-yet-implemented-code-generator";
 import {PerFileCodeGenerator} from "./code-generation/per-file/per-file-code-generator";
+import {WholeProgramCodeGenerator} from "./code-generation/whole-program/whole-program-code-generator";
 import {CompilationContext} from "./compilation-context";
 import {SpeedyJSCompilerOptions} from "./speedyjs-compiler-options";
 import {LogUnknownTransformVisitor} from "./transform/log-unknown-transform-visitor";
@@ -57,7 +58,8 @@ export class Compiler {
             compilerOptions: this.compilerOptions,
             llvmContext: context,
             typeChecker: new TypeScriptTypeChecker(program.getTypeChecker()),
-            rootDir: (program as any).getCommonSourceDirectory()
+            rootDir: (program as any).getCommonSourceDirectory(),
+            additionalDeclarations: new Map<string, string[]>()
         };
 
         return Compiler.emit(program, compilationContext);
@@ -71,15 +73,35 @@ export class Compiler {
         llvm.initializeAllAsmParsers();
     }
 
+    /**
+     * Creates a write file callback that appends the additional declarations of a source file (e.g. of the batch functions)
+     * to its declaration file. The declarations are emitted after the transformation (that registers them) has
+     * been applied to all source files.
+     */
+    private static createWriteFile(compilationContext: CompilationContext): ts.WriteFileCallback {
+        const compilerHost = compilationContext.compilerHost;
+
+        return (fileName, data, writeByteOrderMark, onError, sourceFiles) => {
+            if (fileName.endsWith(".d.ts") && sourceFiles && sourceFiles.length === 1) {
+                const declarations = compilationContext.additionalDeclarations.get(sourceFiles[0].fileName) || [];
+                data += declarations.map(declaration => declaration + compilerHost.getNewLine()).join("");
+            }
+
+            compilerHost.writeFile(fileName, data, writeByteOrderMark, onError, sourceFiles);
+        };
+    }
+
     private static emit(program: ts.Program, compilationContext: CompilationContext) {
         const codeGenerationContextFactory = new DefaultCodeGenerationContextFactory(new NotYetImplementedCodeGenerator());
-        const codeGenerator = new PerFileCodeGenerator(compilationContext.llvmContext, codeGenerationContextFactory);
+        const codeGenerator = compilationContext.compilerOptions.wholeProgram ?
+            new WholeProgramCodeGenerator(compilationContext.llvmContext, codeGenerationContextFactory) :
+            new PerFileCodeGenerator(compilationContext.llvmContext, codeGenerationContextFactory);
 
         const logUnknownVisitor = new LogUnknownTransformVisitor();
         const speedyJSVisitor = new SpeedyJSTransformVisitor(compilationContext, codeGenerator);
 
         try {
-            const emitResult = program.emit(undefined, undefined, undefined, undefined, { before: [
+            const emitResult = program.emit(undefined, Compiler.createWriteFile(compilationContext), undefined, undefined, { before: [
                 createTransformVisitorFactory(logUnknownVisitor),
                 createTransformVisitorFactory(speedyJSVisitor)
             ]});
@@ -2,7 +2,7 @@ import * as assert from "assert";
 import * as debug from "debug";
 import * as fs from "fs";
 import * as path from "path";
-import {COMPILER_RT_FILE, LIBC_RT_FILE, SAFE_RUNTIME, SHARED_LIBRARIES_DIRECTORY, UNSAFE_RUNTIME} from "speedyjs-runtime";
+import {COMPILER_RT_FILE, getRuntimeFile, LIBC_RT_FILE, RuntimeVariant, SHARED_LIBRARIES_DIRECTORY} from "speedyjs-runtime";
 import * as ts from "typescript";
 import {BuildDirectory} from "../code-generation/build-directory";
 import {LLVMByteCodeSymbolsResolver} from "./llvm-nm";
@@ -40,14 +40,10 @@ export class LLVMLink {
 
     /**
      * Adds the files needed by the runtime
-     * @param unsafe should the unsafe runtime (without safe memory guarantees) be used
+     * @param variant the variant of the runtime to use (e.g. unsafe, without safe memory guarantees)
      */
-    addRuntime(unsafe = false): void {
-        if (unsafe) {
-            this.addByteCodeFile(UNSAFE_RUNTIME);
-        } else {
-            this.addByteCodeFile(SAFE_RUNTIME);
-        }
+    addRuntime(variant: RuntimeVariant = {}): void {
+        this.addByteCodeFile(getRuntimeFile(variant));
     }
 
     /**
@@ -11,13 +11,15 @@ const DEFAULT_OPTIONS = ["-march=wasm32",  "-filetype=asm", "-asm-verbose=false"
  * Generates the static assembly using llc
  * @param input the input file name (absolute)
  * @param sFileName the name of the resulting s file
+ * @param attributes the target attributes to enable (e.g. +simd128)
  * @returns the name of the generated assembly file. The caller is responsible for deleting either the working directory
  * or the assembly file
  */
-export function llc(input: string, sFileName: string): string {
+export function llc(input: string, sFileName: string, attributes: string[] = []): string {
     LOG(`Execute LLC for file ${input}`);
 
-    LOG(execLLVM(EXECUTABLE_NAME, DEFAULT_OPTIONS.concat([input, "-o", sFileName])));
+    const options = attributes.length > 0 ? DEFAULT_OPTIONS.concat([`-mattr=${attributes.join(",")}`]) : DEFAULT_OPTIONS;
+    LOG(execLLVM(EXECUTABLE_NAME, options.concat([input, "-o", sFileName])));
 
     return sFileName;
 }
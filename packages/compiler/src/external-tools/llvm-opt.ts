@@ -6,7 +6,28 @@ const LOG = debug("external-tools/llvm-opt");
 const EXECUTABLE_NAME = "opt";
 // tslint:disable-next-line:max-line-length
 const LINK_TIME_OPTIMIZATIONS = ["-strip-debug", "-internalize", "-globaldce", "-disable-loop-vectorization", "-disable-slp-vectorization", "-vectorize-loops=false", "-vectorize-slp=false", "-vectorize-slp-aggressive=false"]; // Vectorization is not yet supported by the linker backend llc
-const DEFAULT_PUBLIC = "speedyJsGc,malloc,__errno_location";
+const DEFAULT_PUBLIC = [
+    "speedyJsGc",
+    "speedyJsMalloc",
+    "speedyJsAllocateObject",
+    "speedyJsPoolStatistics",
+    "speedyJsResetPoolStatistics",
+    "speedyJsRuntimeStatistics",
+    "speedyJsResetRuntimeStatistics",
+    "ArrayIi_createPinnedi",
+    "ArrayIi_releasePinned",
+    "ArrayId_createPinnedi",
+    "ArrayId_releasePinned",
+    "speedyJsCreateRetainScope",
+    "speedyJsAllocateRetained",
+    "speedyJsReleaseRetainScope",
+    "speedyJsFreezeHeap",
+    "speedyJsTakeError",
+    "malloc",
+    "pow",
+    "fmod",
+    "__errno_location"
+];
 
 /**
  * Executes the LLVM Optimizer on the given input file
@@ -17,10 +38,18 @@ const DEFAULT_PUBLIC = "speedyJsGc,malloc,__errno_location";
  */
 export function optimize(filename: string, optimizedFileName: string, level: OptimizationLevel) {
     LOG(`Optimization of file ${filename}`);
-    LOG(execLLVM(EXECUTABLE_NAME, [filename, "-o", optimizedFileName, `-O${level}`, "-loop-unswitch", "-loop-unswitch", "-licm", "-irce"]));
+    LOG(execLLVM(EXECUTABLE_NAME, [filename, "-o", optimizedFileName].concat(getOptimizationArguments(level))));
     return optimizedFileName;
 }
 
+/**
+ * Returns the arguments passed to the optimizer (besides the input and output file), part of the build cache key
+ * @param level the optimization level
+ */
+export function getOptimizationArguments(level: OptimizationLevel): string[] {
+    return [`-O${level}`, "-loop-unswitch", "-loop-unswitch", "-licm", "-irce"];
+}
+
 /**
  * Executes the link time optimizations on the given input file
  * @param filename the input file (absolute path)
@@ -30,12 +59,22 @@ export function optimize(filename: string, optimizedFileName: string, level: Opt
  * @returns the name of the optimized file
  */
 export function optimizeLinked(filename: string, publicFunctions: string[], optimizedFileName: string, level: OptimizationLevel) {
-    const publicApi = publicFunctions.concat(DEFAULT_PUBLIC).join(",");
-    const linkTimeOpts = ["2", "3", "z", "s" ].indexOf(level) !== -1;
-    const optimizations = (linkTimeOpts ? ["-std-link-opts"] : []).concat(LINK_TIME_OPTIMIZATIONS);
-    const args = [filename, "-o", optimizedFileName, `-internalize-public-api-list=${publicApi}`].concat(optimizations);
+    const args = [filename, "-o", optimizedFileName].concat(getLinkTimeOptimizationArguments(publicFunctions, level));
 
     LOG(`Link time optimization of file ${filename}`);
     LOG(execLLVM(EXECUTABLE_NAME, args));
     return optimizedFileName;
 }
+
+/**
+ * Returns the arguments passed to the optimizer for the link time optimizations (besides the input and output file),
+ * part of the build cache key
+ * @param publicFunctions name of the public functions
+ * @param level the used optimization level
+ */
+export function getLinkTimeOptimizationArguments(publicFunctions: string[], level: OptimizationLevel): string[] {
+    const publicApi = publicFunctions.concat(DEFAULT_PUBLIC).join(",");
+    const linkTimeOpts = ["2", "3", "z", "s" ].indexOf(level) !== -1;
+    const optimizations = (linkTimeOpts ? ["-std-link-opts"] : []).concat(LINK_TIME_OPTIMIZATIONS);
+    return [`-internalize-public-api-list=${publicApi}`].concat(optimizations);
+}
@@ -1,6 +1,7 @@
 import * as assert from "assert";
 import * as path from "path";
 import * as ts from "typescript";
+import {PROGRAM_MODULE_NAME} from "./code-generation/whole-program/whole-program-code-generator";
 import {Compiler} from "./compiler";
 
 import {
@@ -37,7 +38,7 @@ export function compileSourceCode(sourceCode: string, inputFileName: string, opt
     const defaultHost = ts.createCompilerHost(initializedOptions);
 
     let sourceFile: ts.SourceFile | undefined;
-    const outputs: { js?: string, wasm?: any[], wast?: string, sourceMapText?: string } = {};
+    const outputs: { js?: string, programLoader?: string, declaration?: string, wasm?: any[], wast?: string, sourceMapText?: string } = {};
 
     const compilerHost: ts.CompilerHost = {
         directoryExists() {
@@ -90,6 +91,12 @@ export function compileSourceCode(sourceCode: string, inputFileName: string, opt
             if (name.endsWith(".map")) {
                 assert(outputs.sourceMapText === undefined, `Unexpected multiple source map outputs for the file '${name}'`);
                 outputs.sourceMapText = text;
+            } else if (path.basename(name) === `${PROGRAM_MODULE_NAME}.js`) {
+                // the loader module of the whole program (wholeProgram option)
+                outputs.programLoader = text;
+            } else if (name.endsWith(".d.ts")) {
+                assert(outputs.declaration === undefined, `Unexpected multiple declaration outputs for the file: '${name}'`);
+                outputs.declaration = text;
             } else if (name.endsWith(".js")) {
                 assert(outputs.js === undefined, `Unexpected multiple outputs for the file: '${name}'`);
                 outputs.js = text;
@@ -108,6 +115,8 @@ export function compileSourceCode(sourceCode: string, inputFileName: string, opt
 
     return {
         js: outputs.js!,
+        programLoader: outputs.programLoader,
+        declaration: outputs.declaration,
         wasm: outputs.wasm,
         wast: outputs.wast,
         diagnostics: result.diagnostics,
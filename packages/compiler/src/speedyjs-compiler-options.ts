@@ -67,6 +67,24 @@ export interface SpeedyJSCompilerOptions extends CompilerOptions {
      */
     disableHeapNukeOnExit: boolean;
 
+    /**
+     * Indicator if entry functions return lazy views of the returned objects and arrays instead of converting the whole
+     * object graph on return. The views read from the WASM heap and are valid until the heap is nuked. The heap is
+     * therefore nuked when the next entry function is called and not on exit (or when speedyJsGc is called if
+     * disableHeapNukeOnExit is set).
+     * @default false
+     */
+    lazyResults: boolean;
+
+    /**
+     * The number of workers used to execute the calls of entry functions. Each worker has its own instance of the module,
+     * independent calls therefore run in parallel instead of blocking the calling thread. Only entry functions with
+     * primitive arguments and return types or arrays, maps and sets of primitives are executed in the workers, the other entry
+     * functions still execute on the calling thread. 0 disables the worker pool.
+     * @default 0
+     */
+    workers: number;
+
     /**
      * Indicator if the gc should be exposed inside a module using speedy js functions using the speedyJsGc variable.
      * @default false
@@ -79,12 +97,99 @@ export interface SpeedyJSCompilerOptions extends CompilerOptions {
      */
     exportGc: boolean;
 
+    /**
+     * Indicator if the functions speedyJsAllocateArray and speedyJsReleaseArray should be exported. The functions allocate
+     * int and number arrays in the WASM memory that survive the gc and are passed to speedy js functions without copying.
+     * @default false
+     */
+    exportArrayAllocator: boolean;
+
+    /**
+     * Indicator if the functions speedyJsRetain and speedyJsRelease should be exported. Retained objects and arrays
+     * stay in the WASM memory across calls (they survive the heap nuke) and are not converted again when passed to
+     * another call. Only the per call allocations are released when the heap is nuked.
+     * @default false
+     */
+    exportRetain: boolean;
+
+    /**
+     * Indicator if the runtime variant should be used that allocates from an arena (bump allocator) instead of malloc.
+     * Allocations are cheaper and the gc only resets the arena instead of freeing every allocation.
+     * @default false
+     */
+    arenaAllocator: boolean;
+
+    /**
+     * Indicator if the runtime variant should be used that implements the bulk array operations (fill, copy, reverse, min / max)
+     * using 128 bit vectors. The generated code requires a WebAssembly engine with simd128 support.
+     * @default false
+     */
+    simd: boolean;
+
+    /**
+     * Indicator if the instrumented runtime variant should be used that counts the array allocations and growths and
+     * the calls to the gc. The counters are read using the runtimeStatistics function of the module loader that is
+     * exported as speedyJsRuntimeStatistics (and speedyJsResetRuntimeStatistics) from each compiled module.
+     * @default false
+     */
+    instrumentRuntime: boolean;
+
+    /**
+     * Indicator if a batch entry function is generated for each exported entry function whose parameters and return type
+     * are primitives. The batch function fnBatch(argumentTuples) is exported next to fn (and declared in the declaration
+     * file) and calls fn once for each tuple of arguments inside of WASM. The arguments are copied into the linear
+     * memory at once and the heap is only nuked after the last call, reducing the cost of many calls of small functions
+     * to a loop iteration.
+     * @default false
+     */
+    batchEntryFunctions: boolean;
+
+    /**
+     * Indicator if arrays of value classes store the fields of their elements inline (one element after another)
+     * instead of pointers to separately allocated objects. A class is a value class if it is declared in the same
+     * source file without export, only has fields of primitive types and an instance stored in an array is never
+     * used by identity (e.g. assigned to a variable or compared). The elements of such an array are copied when they
+     * are added and points[i].x is a single load. See isValueClass for the exact rules.
+     * @default false
+     */
+    valueArrays: boolean;
+
+    /**
+     * The names of the parameterless entry functions that are executed once at build time, e.g. a function that
+     * creates a lookup table. A name is qualified by the path of the source file relative to the root directory,
+     * e.g. "lookup/tables.ts:createTable". The linear memory after their execution (the heap snapshot) is stored in
+     * the data segments of the wasm file and the objects created by the functions survive the gc. Calling a snapshot
+     * function returns the snapshotted result without executing the function again, an instance therefore starts with
+     * the initialized heap. The snapshotted objects are shared by all calls and must not be grown by later calls.
+     * Only supported by the per file code generator.
+     * @default []
+     */
+    snapshotFunctions: string[];
+
     /**
      * The optimization level passed to llvm
      * @default "3"
      */
     optimizationLevel: OptimizationLevel;
 
+    /**
+     * Indicator if a single WASM module should be created for all speedy js functions of the program instead of a
+     * module per source file. The calls between functions of different source files are direct wasm calls and the
+     * program only includes a single copy of the runtime. The module is loaded by the program loader module
+     * speedyjs-program.js (in the output directory) that is imported by the source files with entry functions.
+     * @default false
+     */
+    wholeProgram: boolean;
+
+    /**
+     * The directory of the build cache. The outputs of the external tools (llvm-link, opt, llc, s2wasm, wasm-opt and
+     * wasm-as) are stored in this directory keyed by the hash of their input and the compiler options. Unchanged source
+     * files are not recompiled by the external tools in later builds. The cache is disabled if no directory is set.
+     * A relative path is resolved against the root directory.
+     * @default undefined
+     */
+    buildCache: string | undefined;
+
     /**
      * The implementation that writes the wasm file
      */
@@ -114,9 +219,21 @@ export function initializeCompilerOptions(compilerOptions: UninitializedSpeedyJS
         globalBase: 8,
         saveBc: false,
         disableHeapNukeOnExit: false,
+        lazyResults: false,
+        workers: 0,
         exposeGc: false,
         exportGc: false,
+        exportArrayAllocator: false,
+        exportRetain: false,
+        arenaAllocator: false,
+        simd: false,
+        instrumentRuntime: false,
+        batchEntryFunctions: false,
+        valueArrays: false,
+        snapshotFunctions: [],
         optimizationLevel: "2",
+        wholeProgram: false,
+        buildCache: undefined,
         wasmFileWriter: new DefaultWasmFileWriter()
     };
 
@@ -0,0 +1,215 @@
+//
+// Benchmarks of the Array<T> operations at different array sizes.
+//
+
+#include <random>
+#include <vector>
+#include "benchmark/benchmark.h"
+#include "../lib/array.h"
+
+/**
+ * Returns count pseudo random elements (the same for every run)
+ */
+template<typename T>
+static std::vector<T> randomElements(size_t count) {
+    std::mt19937 random(42);
+    std::uniform_int_distribution<int32_t> distribution(-1000000, 1000000);
+    std::vector<T> elements(count);
+
+    for (size_t i = 0; i < count; ++i) {
+        elements[i] = static_cast<T>(distribution(random));
+    }
+
+    return elements;
+}
+
+static void arraySizes(benchmark::internal::Benchmark* benchmark) {
+    benchmark->RangeMultiplier(8)->Range(8, 1 << 18);
+}
+
+// -----------------------------------------
+// push
+// -----------------------------------------
+
+template<typename T>
+static void BM_ArrayPush(benchmark::State& state) {
+    const size_t count = static_cast<size_t>(state.range(0));
+
+    for (auto _ : state) {
+        Array<T> array {};
+
+        for (size_t i = 0; i < count; ++i) {
+            T value = static_cast<T>(i);
+            array.push(&value, 1);
+        }
+
+        benchmark::DoNotOptimize(array.get(0));
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK_TEMPLATE(BM_ArrayPush, int32_t)->Apply(arraySizes);
+BENCHMARK_TEMPLATE(BM_ArrayPush, double)->Apply(arraySizes);
+BENCHMARK_TEMPLATE(BM_ArrayPush, bool)->Apply(arraySizes);
+
+// -----------------------------------------
+// get / set
+// -----------------------------------------
+
+template<typename T>
+static void BM_ArrayGet(benchmark::State& state) {
+    const int32_t length = static_cast<int32_t>(state.range(0));
+    Array<T> array { length };
+
+    for (auto _ : state) {
+        T sum {};
+        for (int32_t i = 0; i < length; ++i) {
+            sum += array.get(i);
+        }
+
+        benchmark::DoNotOptimize(sum);
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK_TEMPLATE(BM_ArrayGet, int32_t)->Apply(arraySizes);
+BENCHMARK_TEMPLATE(BM_ArrayGet, double)->Apply(arraySizes);
+
+template<typename T>
+static void BM_ArraySet(benchmark::State& state) {
+    const int32_t length = static_cast<int32_t>(state.range(0));
+    Array<T> array { length };
+
+    for (auto _ : state) {
+        for (int32_t i = 0; i < length; ++i) {
+            array.set(i, static_cast<T>(i));
+        }
+
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK_TEMPLATE(BM_ArraySet, int32_t)->Apply(arraySizes);
+BENCHMARK_TEMPLATE(BM_ArraySet, double)->Apply(arraySizes);
+BENCHMARK_TEMPLATE(BM_ArraySet, bool)->Apply(arraySizes);
+
+// -----------------------------------------
+// shift
+// -----------------------------------------
+
+template<typename T>
+static void BM_ArrayShift(benchmark::State& state) {
+    const auto elements = randomElements<T>(static_cast<size_t>(state.range(0)));
+
+    for (auto _ : state) {
+        Array<T> array { elements.data(), elements.size() };
+
+        while (array.length() > 0) {
+            benchmark::DoNotOptimize(array.shift());
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK_TEMPLATE(BM_ArrayShift, int32_t)->Apply(arraySizes);
+BENCHMARK_TEMPLATE(BM_ArrayShift, double)->Apply(arraySizes);
+
+// -----------------------------------------
+// slice / splice
+// -----------------------------------------
+
+template<typename T>
+static void BM_ArraySlice(benchmark::State& state) {
+    const auto elements = randomElements<T>(static_cast<size_t>(state.range(0)));
+    Array<T> array { elements.data(), elements.size() };
+    const int32_t length = array.length();
+
+    for (auto _ : state) {
+        Array<T>* sliced = array.slice(length / 4, length - length / 4);
+        benchmark::DoNotOptimize(sliced->get(0));
+        delete sliced;
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0) / 2);
+}
+BENCHMARK_TEMPLATE(BM_ArraySlice, int32_t)->Apply(arraySizes);
+BENCHMARK_TEMPLATE(BM_ArraySlice, double)->Apply(arraySizes);
+
+template<typename T>
+static void BM_ArraySplice(benchmark::State& state) {
+    const auto elements = randomElements<T>(static_cast<size_t>(state.range(0)));
+    Array<T> array { elements.data(), elements.size() };
+    T inserted[2] = { T {}, T {} };
+
+    // removes two elements from the middle and inserts two new ones, the length stays the same
+    for (auto _ : state) {
+        Array<T>* deleted = array.splice(array.length() / 2, 2, inserted, 2);
+        benchmark::DoNotOptimize(deleted->get(0));
+        delete deleted;
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK_TEMPLATE(BM_ArraySplice, int32_t)->Apply(arraySizes);
+BENCHMARK_TEMPLATE(BM_ArraySplice, double)->Apply(arraySizes);
+
+// -----------------------------------------
+// sort
+// -----------------------------------------
+
+template<typename T>
+static void BM_ArraySort(benchmark::State& state) {
+    const auto elements = randomElements<T>(static_cast<size_t>(state.range(0)));
+
+    for (auto _ : state) {
+        state.PauseTiming();
+        Array<T> array { elements.data(), elements.size() };
+        state.ResumeTiming();
+
+        array.sort();
+        benchmark::DoNotOptimize(array.get(0));
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK_TEMPLATE(BM_ArraySort, int32_t)->Apply(arraySizes);
+BENCHMARK_TEMPLATE(BM_ArraySort, double)->Apply(arraySizes);
+
+template<typename T>
+static void BM_ArraySortWithComparator(benchmark::State& state) {
+    const auto elements = randomElements<T>(static_cast<size_t>(state.range(0)));
+
+    for (auto _ : state) {
+        state.PauseTiming();
+        Array<T> array { elements.data(), elements.size() };
+        state.ResumeTiming();
+
+        array.sort([](const T a, const T b) { return static_cast<double>(a) - static_cast<double>(b); });
+        benchmark::DoNotOptimize(array.get(0));
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK_TEMPLATE(BM_ArraySortWithComparator, int32_t)->Apply(arraySizes);
+BENCHMARK_TEMPLATE(BM_ArraySortWithComparator, double)->Apply(arraySizes);
+
+// -----------------------------------------
+// fill
+// -----------------------------------------
+
+template<typename T>
+static void BM_ArrayFill(benchmark::State& state) {
+    const int32_t length = static_cast<int32_t>(state.range(0));
+    Array<T> array { length };
+
+    for (auto _ : state) {
+        array.fill(T { 1 }, 0, length);
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK_TEMPLATE(BM_ArrayFill, int32_t)->Apply(arraySizes);
+BENCHMARK_TEMPLATE(BM_ArrayFill, double)->Apply(arraySizes);
+BENCHMARK_TEMPLATE(BM_ArrayFill, bool)->Apply(arraySizes);
@@ -0,0 +1,74 @@
+//
+// Benchmarks of the number conversions of the runtime. The static_cast benchmark is the baseline of the UNSAFE
+// variants, the difference to toInt32d of the SAFE variant (runBenchmarks) is the cost of the exact ToInt32 semantics.
+//
+
+#include <cstdint>
+#include <random>
+#include <vector>
+#include "benchmark/benchmark.h"
+
+extern "C" int32_t toInt32d(double value);
+extern "C" uint32_t toUint32d(double value);
+
+/**
+ * Returns count pseudo random values in between -magnitude and magnitude (the same for every run)
+ */
+static std::vector<double> randomValues(size_t count, double magnitude) {
+    std::mt19937 random(42);
+    std::uniform_real_distribution<double> distribution(-magnitude, magnitude);
+    std::vector<double> values(count);
+
+    for (auto& value : values) {
+        value = distribution(random);
+    }
+
+    return values;
+}
+
+/**
+ * Converts the values with the given conversion, values inside of the int32 range are converted on the fast path of
+ * every implementation, larger values need to be wrapped.
+ */
+template<typename Conversion>
+static void benchmarkConversion(benchmark::State& state, double magnitude, Conversion conversion) {
+    const std::vector<double> values = randomValues(static_cast<size_t>(state.range(0)), magnitude);
+
+    for (auto _ : state) {
+        uint32_t sum = 0;
+        for (double value : values) {
+            sum ^= static_cast<uint32_t>(conversion(value));
+        }
+
+        benchmark::DoNotOptimize(sum);
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+/**
+ * The conversion of the UNSAFE variants. Not inlined, like the runtime functions that are defined in another translation unit
+ */
+__attribute__((noinline)) static int32_t staticCast(double value) {
+    return static_cast<int32_t>(static_cast<int64_t>(value));
+}
+
+static void BM_StaticCast(benchmark::State& state, double magnitude) {
+    benchmarkConversion(state, magnitude, staticCast);
+}
+
+static void BM_ToInt32d(benchmark::State& state, double magnitude) {
+    benchmarkConversion(state, magnitude, toInt32d);
+}
+
+static void BM_ToUint32d(benchmark::State& state, double magnitude) {
+    benchmarkConversion(state, magnitude, toUint32d);
+}
+
+BENCHMARK_CAPTURE(BM_StaticCast, int32_range, 2e9)->RangeMultiplier(8)->Range(8, 1 << 18);
+BENCHMARK_CAPTURE(BM_StaticCast, large, 1e10)->RangeMultiplier(8)->Range(8, 1 << 18);
+BENCHMARK_CAPTURE(BM_ToInt32d, int32_range, 2e9)->RangeMultiplier(8)->Range(8, 1 << 18);
+BENCHMARK_CAPTURE(BM_ToInt32d, large, 1e10)->RangeMultiplier(8)->Range(8, 1 << 18);
+BENCHMARK_CAPTURE(BM_ToInt32d, huge, 1e30)->RangeMultiplier(8)->Range(8, 1 << 18);
+BENCHMARK_CAPTURE(BM_ToUint32d, int32_range, 2e9)->RangeMultiplier(8)->Range(8, 1 << 18);
+BENCHMARK_CAPTURE(BM_ToUint32d, large, 1e10)->RangeMultiplier(8)->Range(8, 1 << 18);
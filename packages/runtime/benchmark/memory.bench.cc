@@ -0,0 +1,52 @@
+//
+// Benchmarks of the allocation functions and of speedyJsGc.
+//
+
+#include <cstdint>
+#include "benchmark/benchmark.h"
+#include "../lib/allocator.h"
+#include "../lib/pool.h"
+
+static void BM_AllocateObject(benchmark::State& state) {
+    const size_t count = static_cast<size_t>(state.range(0));
+
+    for (auto _ : state) {
+        for (size_t i = 0; i < count; ++i) {
+            benchmark::DoNotOptimize(runtimePool.allocate(24));
+        }
+
+        state.PauseTiming();
+        runtimePool.reset();
+        state.ResumeTiming();
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_AllocateObject)->RangeMultiplier(8)->Range(8, 1 << 15);
+
+#ifdef ARENA
+
+extern "C" void speedyJsGc();
+extern "C" void* speedyJsMalloc(size_t size);
+
+/**
+ * Measures the release of all allocations of a run of a compiled function with the given number of allocations
+ */
+static void BM_SpeedyJsGc(benchmark::State& state) {
+    const size_t count = static_cast<size_t>(state.range(0));
+
+    for (auto _ : state) {
+        state.PauseTiming();
+        for (size_t i = 0; i < count; ++i) {
+            benchmark::DoNotOptimize(speedyJsMalloc(64 + i % 256));
+        }
+        state.ResumeTiming();
+
+        speedyJsGc();
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_SpeedyJsGc)->RangeMultiplier(8)->Range(8, 1 << 15);
+
+#endif
@@ -124,10 +124,30 @@ gulp.task("test:clean", function () {
 gulp.task("test:build", function () {
     fs.mkdirSync("cmake-build-debug");
 
-    const command = "cmake -E chdir cmake-build-debug cmake -DCMAKE_BUILD_TYPE=Debug .. && cmake --build cmake-build-debug --target runUnitTests";
+    const command = "cmake -E chdir cmake-build-debug cmake -DCMAKE_BUILD_TYPE=Debug .. && cmake --build cmake-build-debug --target runUnitTests && cmake --build cmake-build-debug --target runSimdUnitTests && cmake --build cmake-build-debug --target runInstrumentedUnitTests";
     child_process.execSync(command, { stdio: "inherit" });
 });
 
 gulp.task("test:run", function () {
     child_process.execSync("./cmake-build-debug/test/runUnitTests", { stdio: "inherit" });
+    child_process.execSync("./cmake-build-debug/test/runSimdUnitTests", { stdio: "inherit" });
+    child_process.execSync("./cmake-build-debug/test/runInstrumentedUnitTests", { stdio: "inherit" });
+});
+
+/**
+ * Builds and runs the native benchmarks of the runtime primitives (requires google benchmark)
+ */
+gulp.task("benchmark", function () {
+    if (!fs.existsSync("cmake-build-benchmark")) {
+        fs.mkdirSync("cmake-build-benchmark");
+    }
+
+    const variants = ["runBenchmarks", "runBenchmarks-unsafe", "runBenchmarks-arena", "runBenchmarks-unsafe-arena"];
+    const targets = variants.map(variant => "--target " + variant).join(" ");
+
+    child_process.execSync("cmake -E chdir cmake-build-benchmark cmake -DCMAKE_BUILD_TYPE=Release .. && cmake --build cmake-build-benchmark " + targets, { stdio: "inherit" });
+
+    for (const variant of variants) {
+        child_process.execSync(util.format("./cmake-build-benchmark/benchmark/%s", variant), { stdio: "inherit" });
+    }
 });
@@ -14,6 +14,58 @@ export const SAFE_RUNTIME = path.join(BIN_DIRECTORY, "libspeedyjs-runtime.bc");
  */
 export const UNSAFE_RUNTIME = path.join(BIN_DIRECTORY, "libspeedyjs-runtime-unsafe.bc");
 
+/**
+ * Selects a variant of the runtime
+ */
+export interface RuntimeVariant {
+    /**
+     * Use the unsafe runtime (without safe memory guarantees)
+     */
+    unsafe?: boolean;
+
+    /**
+     * Use the runtime variant that allocates from an arena (bump allocator) instead of malloc
+     */
+    arena?: boolean;
+
+    /**
+     * Use the runtime variant that implements the bulk array operations using simd128
+     */
+    simd?: boolean;
+
+    /**
+     * Use the runtime variant that counts the array allocations and the gc calls (see speedyJsRuntimeStatistics)
+     */
+    instrumented?: boolean;
+}
+
+/**
+ * Returns the absolute path to the BC file of the given runtime variant
+ * @param variant the variant of the runtime
+ * @return {string} the path to the BC file
+ */
+export function getRuntimeFile(variant: RuntimeVariant): string {
+    let name = "libspeedyjs-runtime";
+
+    if (variant.unsafe) {
+        name += "-unsafe";
+    }
+
+    if (variant.arena) {
+        name += "-arena";
+    }
+
+    if (variant.simd) {
+        name += "-simd";
+    }
+
+    if (variant.instrumented) {
+        name += "-instrumented";
+    }
+
+    return path.join(BIN_DIRECTORY, `${name}.bc`);
+}
+
 /**
  * Path to the shared libraries (libc, malloc...)
  * @type {string}
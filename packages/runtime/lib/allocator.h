@@ -0,0 +1,60 @@
+//
+// Heap allocation functions used by the runtime.
+//
+
+#ifndef SPEEDYJS_RUNTIME_ALLOCATOR_H
+#define SPEEDYJS_RUNTIME_ALLOCATOR_H
+
+#include <cstdlib>
+#include "macros.h"
+
+#ifdef ARENA
+#include "arena.h"
+#endif
+
+/**
+ * Allocates a memory block of the given size from the runtime heap.
+ * The runtime heap is the malloc heap or the arena if the runtime is build with ARENA.
+ * @param size the size in bytes
+ * @return the allocated memory or the nullptr if the allocation failed
+ */
+ALWAYS_INLINE inline void* allocateMemory(size_t size) {
+#ifdef ARENA
+    return runtimeArena.allocate(size);
+#else
+    return std::malloc(size);
+#endif
+}
+
+/**
+ * Resizes a memory block allocated with {@link allocateMemory}
+ * @param allocation the allocation to resize or the nullptr
+ * @param oldSize the current size of the allocation (needed by the arena that does not track the allocation sizes)
+ * @param newSize the new size in bytes
+ * @return the resized allocation or the nullptr if the allocation failed
+ */
+ALWAYS_INLINE inline void* reallocateMemory(void* allocation, size_t oldSize, size_t newSize) {
+#ifdef ARENA
+    return runtimeArena.reallocate(allocation, oldSize, newSize);
+#else
+    (void) oldSize;
+    // LLVM can better optimize mallocs. If it detects an unused malloc, it is optimized away. Reallocs are not removed
+    return allocation == nullptr ? std::malloc(newSize) : std::realloc(allocation, newSize);
+#endif
+}
+
+/**
+ * Frees a memory block allocated with {@link allocateMemory}. The arena only reclaims the memory if it is the last allocation.
+ * @param allocation the allocation to free
+ * @param size the size of the allocation
+ */
+ALWAYS_INLINE inline void freeMemory(void* allocation, size_t size) {
+#ifdef ARENA
+    runtimeArena.release(allocation, size);
+#else
+    (void) size;
+    std::free(allocation);
+#endif
+}
+
+#endif //SPEEDYJS_RUNTIME_ALLOCATOR_H
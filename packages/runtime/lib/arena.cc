@@ -0,0 +1,104 @@
+//
+// Bump (arena) allocator used by the arena runtime variants.
+//
+
+#include <cstdlib>
+#include <cstring>
+#include <algorithm>
+#include "arena.h"
+
+Arena runtimeArena {};
+
+void* Arena::reallocate(void* allocation, size_t oldSize, size_t newSize) {
+    if (allocation == nullptr) {
+        return allocate(newSize);
+    }
+
+    char* const start = static_cast<char*>(allocation);
+
+    // Last allocation of the current chunk, grow or shrink in place
+    if (start + align(oldSize) == top && static_cast<size_t>(limit - start) >= align(newSize)) {
+        top = start + align(newSize);
+        return allocation;
+    }
+
+    if (newSize <= oldSize) {
+        return allocation;
+    }
+
+    void* result = allocate(newSize);
+    if (result != nullptr) {
+        std::memcpy(result, allocation, oldSize);
+    }
+
+    return result;
+}
+
+void Arena::reset() {
+    // The chunks up to the frozen chunk contain frozen allocations
+    Chunk** link = frozen == nullptr ? &first : &frozen->next;
+
+    while (*link != nullptr) {
+        Chunk* chunk = *link;
+
+        if (chunk->size > ARENA_CHUNK_SIZE) {
+            *link = chunk->next;
+            std::free(chunk);
+        } else {
+            link = &chunk->next;
+        }
+    }
+
+    current = frozen;
+    top = frozenTop;
+    limit = frozen == nullptr ? nullptr : frozen->data() + frozen->size;
+}
+
+void Arena::freeze() {
+    frozen = current;
+    frozenTop = top;
+}
+
+size_t Arena::reservedBytes() const {
+    size_t reserved = 0;
+
+    for (Chunk* chunk = first; chunk != nullptr; chunk = chunk->next) {
+        reserved += chunk->size + HEADER_SIZE;
+    }
+
+    return reserved;
+}
+
+bool Arena::nextChunk(size_t size) {
+    Chunk* previous = current;
+    Chunk* next = current == nullptr ? first : current->next;
+
+    // Reuse the retained chunks first
+    while (next != nullptr && next->size < size) {
+        previous = next;
+        next = next->next;
+    }
+
+    if (next == nullptr) {
+        const size_t chunkSize = std::max(size, ARENA_CHUNK_SIZE);
+        next = static_cast<Chunk*>(std::malloc(HEADER_SIZE + chunkSize));
+
+        if (next == nullptr) {
+            return false;
+        }
+
+        next->next = nullptr;
+        next->size = chunkSize;
+
+        if (previous == nullptr) {
+            first = next;
+        } else {
+            previous->next = next;
+        }
+    }
+
+    current = next;
+    top = next->data();
+    limit = top + next->size;
+    return true;
+}
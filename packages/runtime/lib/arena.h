@@ -0,0 +1,168 @@
+//
+// Bump (arena) allocator used by the arena runtime variants.
+//
+
+#ifndef SPEEDYJS_RUNTIME_ARENA_H
+#define SPEEDYJS_RUNTIME_ARENA_H
+
+#include <cstddef>
+#include <stdint.h>
+
+/**
+ * The size of the chunks the arena requests from malloc. Allocations larger then a chunk get a chunk on their own.
+ */
+const size_t ARENA_CHUNK_SIZE = 1024 * 1024;
+
+/**
+ * The alignment of all allocations returned by the arena
+ */
+const size_t ARENA_ALIGNMENT = 8;
+
+/**
+ * Bump allocator that serves all allocations from large chunks. Allocating is a pointer increment and
+ * releasing all allocations at once is a pointer reset. Individual allocations are (mostly) never freed.
+ * This matches the allocation pattern of speedy.js where the heap is nuked after each call to an entry function.
+ *
+ * The chunks are retained when the arena is reset and are reused by the next allocations, only oversized chunks
+ * (used for allocations larger than {@link ARENA_CHUNK_SIZE}) are returned to malloc.
+ *
+ * Freezing the arena makes the current allocations permanent, reset returns to the frozen position instead of the
+ * start of the first chunk. This is used by the heap snapshot that keeps the objects created at build time.
+ *
+ * The arena has a constexpr constructor and no destructor so that a global instance is constant initialized and
+ * neither needs static constructors nor atexit handlers.
+ */
+class Arena {
+private:
+    struct Chunk {
+        /**
+         * The next chunk in the list of chunks owned by the arena
+         */
+        Chunk* next;
+
+        /**
+         * The usable size of the chunk (without the header)
+         */
+        size_t size;
+
+        /**
+         * Returns the pointer to the first usable byte in the chunk
+         */
+        inline char* data() {
+            return reinterpret_cast<char*>(this) + HEADER_SIZE;
+        }
+    };
+
+    /**
+     * The size of the chunk header, rounded up to retain the alignment of the data
+     */
+    static const size_t HEADER_SIZE = (sizeof(Chunk) + ARENA_ALIGNMENT - 1) & ~(ARENA_ALIGNMENT - 1);
+
+    /**
+     * The first chunk of the arena
+     */
+    Chunk* first;
+
+    /**
+     * The chunk from which allocations are currently served
+     */
+    Chunk* current;
+
+    /**
+     * Pointer to the next free byte in the current chunk
+     */
+    char* top;
+
+    /**
+     * Pointer passed the end of the current chunk
+     */
+    char* limit;
+
+    /**
+     * The chunk that was current when the arena has been frozen or the nullptr if the arena is not frozen
+     */
+    Chunk* frozen;
+
+    /**
+     * The top of the frozen chunk at the time the arena has been frozen
+     */
+    char* frozenTop;
+
+public:
+    constexpr Arena() : first { nullptr }, current { nullptr }, top { nullptr }, limit { nullptr }, frozen { nullptr }, frozenTop { nullptr } {
+    }
+
+    /**
+     * Allocates a memory block of the given size
+     * @param size the size in bytes
+     * @return pointer to the allocated memory or the nullptr if no chunk can be allocated
+     */
+    inline void* allocate(size_t size) {
+        size = align(size);
+
+        if (top == nullptr || static_cast<size_t>(limit - top) < size) {
+            if (!nextChunk(size)) {
+                return nullptr;
+            }
+        }
+
+        void* allocation = top;
+        top += size;
+        return allocation;
+    }
+
+    /**
+     * Resizes the given allocation. The allocation is grown in place if it is the last allocation from the
+     * current chunk and the chunk has enough free space. Otherwise, a new block is allocated and the content copied.
+     * @param allocation the existing allocation or the nullptr
+     * @param oldSize the size of the existing allocation
+     * @param newSize the new size
+     * @return the pointer to the resized allocation or the nullptr if the allocation failed
+     */
+    void* reallocate(void* allocation, size_t oldSize, size_t newSize);
+
+    /**
+     * Releases the given allocation. The memory is only reclaimed if it is the last allocation from the current chunk.
+     * @param allocation the allocation to release
+     * @param size the size of the allocation
+     */
+    inline void release(void* allocation, size_t size) {
+        if (allocation != nullptr && static_cast<char*>(allocation) + align(size) == top) {
+            top = static_cast<char*>(allocation);
+        }
+    }
+
+    /**
+     * Releases all allocations at once (except the frozen allocations). The standard size chunks are retained for reuse.
+     */
+    void reset();
+
+    /**
+     * Freezes the current allocations, they are no longer released by reset
+     */
+    void freeze();
+
+    /**
+     * Returns the number of bytes reserved by the arena from malloc
+     */
+    size_t reservedBytes() const;
+
+private:
+    static inline size_t align(size_t size) {
+        return (size + ARENA_ALIGNMENT - 1) & ~(ARENA_ALIGNMENT - 1);
+    }
+
+    /**
+     * Makes the next chunk with at least the given free space the current chunk. Allocates a new chunk if needed.
+     * @param size the minimal size of the chunk
+     * @return true if a chunk is available, false if the allocation of a new chunk failed
+     */
+    bool nextChunk(size_t size);
+};
+
+/**
+ * The arena used by the runtime if it is build with ARENA
+ */
+extern Arena runtimeArena;
+
+#endif //SPEEDYJS_RUNTIME_ARENA_H
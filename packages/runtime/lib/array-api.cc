@@ -1,422 +1,374 @@
+#include <algorithm>
 #include <stdint.h>
 #include "macros.h"
 #include "array.h"
+#include "value-array.h"
 
 #ifndef SPEEDYJS_RUNTIME_ARRAY_API_H
 #define SPEEDYJS_RUNTIME_ARRAY_API_H
 
-// see RuntimeSystemNameMangler for the naming schema used
+// see RuntimeSystemNameMangler for the naming schema used. The entry points of the Array<T> instantiations are
+// generated by DEFINE_ARRAY_API, the ones of the typed arrays (Float32Array, Int8Array, ...) by DEFINE_TYPED_ARRAY_API.
 
 
-#ifdef __cplusplus
-extern "C" {
-#endif
-
-//---------------------------------------------------------------------------------
-// new
-//---------------------------------------------------------------------------------
-
-DLL_PUBLIC ALWAYS_INLINE Array<bool>* ArrayIb_constructori(int32_t size) {
-    return new Array<bool> { size };
-}
-
-DLL_PUBLIC ALWAYS_INLINE Array<bool>* ArrayIb_constructorPbu(bool* const elements, size_t elementsCount) {
-    return new Array<bool> { elements, elementsCount};
-}
-
-DLL_PUBLIC ALWAYS_INLINE Array<int32_t>* ArrayIi_constructori(int32_t size) {
-    return new Array<int32_t> { size };
-}
-
-DLL_PUBLIC ALWAYS_INLINE Array<int32_t>* ArrayIi_constructorPiu(int32_t* const elements, size_t elementsCount) {
-    return new Array<int32_t> { elements, elementsCount};
-}
-
-DLL_PUBLIC ALWAYS_INLINE Array<double>* ArrayId_constructori(const int32_t size) {
-    return new Array<double> { size };
-}
-
-DLL_PUBLIC ALWAYS_INLINE Array<double>* ArrayId_constructorPdu(double* const elements, size_t elementsCount) {
-    return new Array<double> { elements, elementsCount };
-}
-
-DLL_PUBLIC ALWAYS_INLINE Array<void*>* ArrayIPv_constructori(int32_t size) {
-    return new Array<void*> { size };
-}
-
-DLL_PUBLIC ALWAYS_INLINE Array<void*>* ArrayIPv_constructorPPvu(void** const elements, size_t elementsCount) {
-    return new Array<void*> { elements, elementsCount };
-}
-
-//---------------------------------------------------------------------------------
-// get
-//---------------------------------------------------------------------------------
-
-DLL_PUBLIC ALWAYS_INLINE bool ArrayIb_geti(const Array<bool>& array, int32_t index) {
-    return array.get(index);
-}
-
-DLL_PUBLIC ALWAYS_INLINE int32_t ArrayIi_geti(const Array<int32_t>& array, int32_t index) {
-    return array.get(index);
-}
-
-DLL_PUBLIC ALWAYS_INLINE double ArrayId_geti(const Array<double>& array, int32_t index) {
-    return array.get(index);
-}
-
-DLL_PUBLIC ALWAYS_INLINE void* ArrayIPv_geti(const Array<void*>& array, int32_t index) {
-    return array.get(index);
-}
-
-//---------------------------------------------------------------------------------
-// set
-//---------------------------------------------------------------------------------
-
-DLL_PUBLIC ALWAYS_INLINE void ArrayIb_setib(Array<bool>& array, int32_t index, bool value) {
-    array.set(index, value);
-}
-
-DLL_PUBLIC ALWAYS_INLINE void ArrayIi_setii(Array<int32_t>& array, int32_t index, int32_t value) {
-    array.set(index, value);
-}
-
-DLL_PUBLIC ALWAYS_INLINE void ArrayId_setid(Array<double>& array, int32_t index, double value) {
-    array.set(index, value);
-}
-
-DLL_PUBLIC ALWAYS_INLINE void ArrayIPv_setiPv(Array<void*>& array, int32_t index, void* value) {
-    array.set(index, value);
-}
-
-//---------------------------------------------------------------------------------
-// fill
-//---------------------------------------------------------------------------------
-
-DLL_PUBLIC ALWAYS_INLINE Array<bool>* ArrayIb_fillb(Array<bool>& array, bool value) {
-    array.fill(value);
-    return &array;
-}
-
-DLL_PUBLIC ALWAYS_INLINE Array<bool>* ArrayIb_fillbi(Array<bool>& array, bool value, int32_t start) {
-    array.fill(value, start);
-    return &array;
-}
-
-DLL_PUBLIC ALWAYS_INLINE Array<bool>* ArrayIb_fillbii(Array<bool>& array, bool value, int32_t start, int32_t end) {
-    array.fill(value, start, end);
-    return &array;
-}
+extern "C" int32_t toInt32d(double value);
 
-DLL_PUBLIC ALWAYS_INLINE Array<int32_t>* ArrayIi_filli(Array<int32_t>& array, int32_t value) {
-    array.fill(value);
-    return &array;
+/**
+ * Converts a JS number to the element type of a typed array. Floats are rounded, the integer types wrap around
+ * (ToInt8, ToInt16 and ToUint8 of the spec).
+ */
+template<typename T>
+ALWAYS_INLINE inline T toTypedArrayElement(double value) {
+    return static_cast<T>(toInt32d(value));
 }
 
-DLL_PUBLIC ALWAYS_INLINE Array<int32_t>* ArrayIi_fillii(Array<int32_t>& array, int32_t value, int32_t start) {
-    array.fill(value, start);
-    return &array;
+template<>
+ALWAYS_INLINE inline float toTypedArrayElement<float>(double value) {
+    return static_cast<float>(value);
 }
 
-DLL_PUBLIC ALWAYS_INLINE Array<int32_t>* ArrayIi_filliii(Array<int32_t>& array, int32_t value, int32_t start, int32_t end) {
-    array.fill(value, start, end);
-    return &array;
-}
-
-DLL_PUBLIC ALWAYS_INLINE Array<double>* ArrayId_filld(Array<double>& array, double value) {
-    array.fill(value);
-    return &array;
-}
+/**
+ * Converts the start or end argument of a typed array method to an int, the values outside of the int range are clamped
+ * (the methods clamp the positions to the array bounds) and NaN is 0.
+ */
+ALWAYS_INLINE inline int32_t toRelativeIndex(double value) {
+    if (value != value) {
+        return 0;
+    }
 
-DLL_PUBLIC ALWAYS_INLINE Array<double>* ArrayId_filldi(Array<double>& array, double value, int32_t start) {
-    array.fill(value, start);
-    return &array;
+    return static_cast<int32_t>(std::max(std::min(value, static_cast<double>(INT32_MAX)), static_cast<double>(INT32_MIN)));
 }
 
-DLL_PUBLIC ALWAYS_INLINE Array<double>* ArrayId_filldii(Array<double>& array, double value, int32_t start, int32_t end) {
-    array.fill(value, start, end);
-    return &array;
-}
-
-DLL_PUBLIC ALWAYS_INLINE Array<void*>* ArrayIPv_fillPv(Array<void*>& array, void* value) {
-    array.fill(value);
-    return &array;
-}
-
-DLL_PUBLIC ALWAYS_INLINE Array<void*>* ArrayIPv_fillPvi(Array<void*>& array, void* value, int32_t start) {
-    array.fill(value, start);
-    return &array;
-}
-
-DLL_PUBLIC ALWAYS_INLINE Array<void*>* ArrayIPv_fillPvii(Array<void*>& array, void* value, int32_t start, int32_t end) {
-    array.fill(value, start, end);
-    return &array;
-}
-
-//---------------------------------------------------------------------------------
-// push
-//---------------------------------------------------------------------------------
-
-DLL_PUBLIC ALWAYS_INLINE int32_t ArrayIb_pushPbu(Array<bool>& array, bool* elements, size_t numElements) {
-    return array.push(elements, numElements);
-}
-
-DLL_PUBLIC ALWAYS_INLINE int32_t ArrayIi_pushPiu(Array<int32_t>& array, int32_t* elements, size_t numElements) {
-    return array.push(elements, numElements);
-}
-
-DLL_PUBLIC ALWAYS_INLINE int32_t ArrayId_pushPdu(Array<double>& array, double* elements, size_t numElements) {
-    return array.push(elements, numElements);
-}
-
-DLL_PUBLIC ALWAYS_INLINE int32_t ArrayIPv_pushPPvu(Array<void*>& array, void** elements, size_t numElements) {
-    return array.push(elements, numElements);
-}
-
-//---------------------------------------------------------------------------------
-// unshift
-//---------------------------------------------------------------------------------
-
-DLL_PUBLIC ALWAYS_INLINE int32_t ArrayIb_unshiftPbu(Array<bool>& array, bool* elements, size_t numElements) {
-    return array.unshift(elements, numElements);
-}
+/**
+ * Converts the length argument of a typed array constructor to an int
+ */
+ALWAYS_INLINE inline int32_t toTypedArrayLength(double size) {
+#ifdef SAFE
+    if (!(size >= 0 && size <= INT32_MAX) || static_cast<double>(static_cast<int32_t>(size)) != size) {
+        RAISE_RUNTIME_ERROR(RuntimeError::INVALID_ARRAY_LENGTH, std::out_of_range("Invalid typed array length"));
+    }
+#endif
 
-DLL_PUBLIC ALWAYS_INLINE int32_t ArrayIi_unshiftPiu(Array<int32_t>& array, int32_t* elements, size_t numElements) {
-    return array.unshift(elements, numElements);
+    return static_cast<int32_t>(size);
 }
 
-DLL_PUBLIC ALWAYS_INLINE int32_t ArrayId_unshiftPdu(Array<double>& array, double* elements, size_t numElements)  {
-    return array.unshift(elements, numElements);
-}
+#ifdef __cplusplus
+extern "C" {
+#endif
 
-DLL_PUBLIC ALWAYS_INLINE int32_t ArrayIPv_unshiftPPvu(Array<void*>& array, void** elements, size_t numElements) {
-    return array.unshift(elements, numElements);
-}
+/**
+ * Defines the runtime entry points of the Array<T> class for the element type T.
+ * @param NAME the mangled class name, e.g. ArrayIi
+ * @param T the element type of the array
+ * @param CODE the type code of T used in the mangled names of the functions, e.g. i
+ */
+#define DEFINE_ARRAY_API(NAME, T, CODE) \
+    DLL_PUBLIC ALWAYS_INLINE Array<T>* NAME##_constructori(int32_t size) { \
+        return new Array<T> { size }; \
+    } \
+    \
+    DLL_PUBLIC ALWAYS_INLINE Array<T>* NAME##_constructorP##CODE##u(T* const elements, size_t elementsCount) { \
+        return new Array<T> { elements, elementsCount }; \
+    } \
+    \
+    DLL_PUBLIC ALWAYS_INLINE T NAME##_geti(const Array<T>& array, int32_t index) { \
+        return array.get(index); \
+    } \
+    \
+    DLL_PUBLIC ALWAYS_INLINE void NAME##_seti##CODE(Array<T>& array, int32_t index, T value) { \
+        array.set(index, value); \
+    } \
+    \
+    /* unchecked get / set, emitted for indices that are known to be in bound */ \
+    DLL_PUBLIC ALWAYS_INLINE T NAME##_getUncheckedi(const Array<T>& array, int32_t index) { \
+        return array.getUnchecked(index); \
+    } \
+    \
+    DLL_PUBLIC ALWAYS_INLINE void NAME##_setUncheckedi##CODE(Array<T>& array, int32_t index, T value) { \
+        array.setUnchecked(index, value); \
+    } \
+    \
+    DLL_PUBLIC ALWAYS_INLINE Array<T>* NAME##_fill##CODE(Array<T>& array, T value) { \
+        array.fill(value); \
+        return &array; \
+    } \
+    \
+    DLL_PUBLIC ALWAYS_INLINE Array<T>* NAME##_fill##CODE##i(Array<T>& array, T value, int32_t start) { \
+        array.fill(value, start); \
+        return &array; \
+    } \
+    \
+    DLL_PUBLIC ALWAYS_INLINE Array<T>* NAME##_fill##CODE##ii(Array<T>& array, T value, int32_t start, int32_t end) { \
+        array.fill(value, start, end); \
+        return &array; \
+    } \
+    \
+    DLL_PUBLIC ALWAYS_INLINE int32_t NAME##_pushP##CODE##u(Array<T>& array, T* elements, size_t numElements) { \
+        return array.push(elements, numElements); \
+    } \
+    \
+    DLL_PUBLIC ALWAYS_INLINE int32_t NAME##_unshiftP##CODE##u(Array<T>& array, T* elements, size_t numElements) { \
+        return array.unshift(elements, numElements); \
+    } \
+    \
+    /* push(x) and unshift(x) with a single element, emitted by the compiler instead of the variadic versions */ \
+    DLL_PUBLIC ALWAYS_INLINE int32_t NAME##_push##CODE(Array<T>& array, T element) { \
+        return array.push(element); \
+    } \
+    \
+    DLL_PUBLIC ALWAYS_INLINE int32_t NAME##_unshift##CODE(Array<T>& array, T element) { \
+        return array.unshift(element); \
+    } \
+    \
+    DLL_PUBLIC ALWAYS_INLINE T NAME##_pop(Array<T>& array) { \
+        return array.pop(); \
+    } \
+    \
+    DLL_PUBLIC ALWAYS_INLINE T NAME##_shift(Array<T>& array) { \
+        return array.shift(); \
+    } \
+    \
+    DLL_PUBLIC ALWAYS_INLINE Array<T>* NAME##_slice(const Array<T>& array) { \
+        return array.slice(); \
+    } \
+    \
+    DLL_PUBLIC ALWAYS_INLINE Array<T>* NAME##_slicei(const Array<T>& array, int32_t start) { \
+        return array.slice(start); \
+    } \
+    \
+    DLL_PUBLIC ALWAYS_INLINE Array<T>* NAME##_sliceii(const Array<T>& array, int32_t start, int32_t end) { \
+        return array.slice(start, end); \
+    } \
+    \
+    DLL_PUBLIC ALWAYS_INLINE Array<T>* NAME##_splicei(Array<T>& array, int32_t index) { \
+        return array.splice(index, array.length()); \
+    } \
+    \
+    DLL_PUBLIC ALWAYS_INLINE Array<T>* NAME##_spliceii(Array<T>& array, int32_t index, int32_t deleteCount) { \
+        return array.splice(index, deleteCount); \
+    } \
+    \
+    DLL_PUBLIC ALWAYS_INLINE Array<T>* NAME##_spliceiiP##CODE##u(Array<T>& array, int32_t index, int32_t deleteCount, T* elements, size_t elementsCount) { \
+        return array.splice(index, deleteCount, elements, elementsCount); \
+    } \
+    \
+    /* splice whose result is unused, emitted by the compiler. Returns the array itself instead of the deleted elements. */ \
+    DLL_PUBLIC ALWAYS_INLINE Array<T>* NAME##_spliceDiscardi(Array<T>& array, int32_t index) { \
+        array.spliceDiscard(index, array.length()); \
+        return &array; \
+    } \
+    \
+    DLL_PUBLIC ALWAYS_INLINE Array<T>* NAME##_spliceDiscardii(Array<T>& array, int32_t index, int32_t deleteCount) { \
+        array.spliceDiscard(index, deleteCount); \
+        return &array; \
+    } \
+    \
+    DLL_PUBLIC ALWAYS_INLINE Array<T>* NAME##_spliceDiscardiiP##CODE##u(Array<T>& array, int32_t index, int32_t deleteCount, T* elements, size_t elementsCount) { \
+        array.spliceDiscard(index, deleteCount, elements, elementsCount); \
+        return &array; \
+    } \
+    \
+    DLL_PUBLIC ALWAYS_INLINE int32_t NAME##_length(const Array<T>& array) { \
+        return array.length(); \
+    } \
+    \
+    DLL_PUBLIC ALWAYS_INLINE void NAME##_lengthi(Array<T>& array, int32_t size) { \
+        array.resize(size); \
+    } \
+    \
+    /* reservePush (emitted by the compiler for loops with a known number of pushes) */ \
+    DLL_PUBLIC ALWAYS_INLINE void NAME##_reservePushi(Array<T>& array, int32_t count) { \
+        array.reservePush(count); \
+    } \
+    \
+    DLL_PUBLIC ALWAYS_INLINE Array<T>* NAME##_sort(Array<T>& array) { \
+        array.sort(); \
+        return &array; \
+    } \
+    \
+    DLL_PUBLIC ALWAYS_INLINE Array<T>* NAME##_sortPFd##CODE##CODE(Array<T>& array, typename Array<T>::Comparator comparator) { \
+        array.sort(comparator); \
+        return &array; \
+    } \
+    \
+    DLL_PUBLIC ALWAYS_INLINE Array<T>* NAME##_reverse(Array<T>& array) { \
+        array.reverse(); \
+        return &array; \
+    }
+
+/**
+ * Defines the entry point for the descending sort, used if the compiler detects a (a, b) => b - a comparator
+ */
+#define DEFINE_ARRAY_SORT_DESCENDING_API(NAME, T) \
+    DLL_PUBLIC ALWAYS_INLINE Array<T>* NAME##_sortDescending(Array<T>& array) { \
+        array.sortDescending(); \
+        return &array; \
+    }
+
+/**
+ * Defines the runtime entry points of a typed array (e.g. Float32Array) whose elements are stored in an Array<T>.
+ * The elements are read and written as JS numbers (double) and are converted like the typed arrays do (float
+ * rounding, the integer types wrap around). In contrast to Array, writing beyond the length of the array is ignored.
+ * @param NAME the name of the typed array class, e.g. Float32Array
+ * @param T the element type of the storage
+ */
+#define DEFINE_TYPED_ARRAY_API(NAME, T) \
+    DLL_PUBLIC ALWAYS_INLINE Array<T>* NAME##_constructori(int32_t size) { \
+        return new Array<T> { size }; \
+    } \
+    \
+    DLL_PUBLIC ALWAYS_INLINE Array<T>* NAME##_constructord(double size) { \
+        return new Array<T> { toTypedArrayLength(size) }; \
+    } \
+    \
+    DLL_PUBLIC ALWAYS_INLINE Array<T>* NAME##_constructorPdu(double* const elements, size_t elementsCount) { \
+        auto* array = new Array<T> { static_cast<int32_t>(elementsCount) }; \
+        for (size_t i = 0; i < elementsCount; ++i) { \
+            array->setUnchecked(static_cast<int32_t>(i), toTypedArrayElement<T>(elements[i])); \
+        } \
+        return array; \
+    } \
+    \
+    DLL_PUBLIC ALWAYS_INLINE double NAME##_geti(const Array<T>& array, int32_t index) { \
+        return static_cast<double>(array.get(index)); \
+    } \
+    \
+    DLL_PUBLIC ALWAYS_INLINE double NAME##_getUncheckedi(const Array<T>& array, int32_t index) { \
+        return static_cast<double>(array.getUnchecked(index)); \
+    } \
+    \
+    DLL_PUBLIC ALWAYS_INLINE void NAME##_setid(Array<T>& array, int32_t index, double value) { \
+        if (index >= 0 && index < array.length()) { \
+            array.setUnchecked(index, toTypedArrayElement<T>(value)); \
+        } \
+    } \
+    \
+    DLL_PUBLIC ALWAYS_INLINE void NAME##_setUncheckedid(Array<T>& array, int32_t index, double value) { \
+        array.setUnchecked(index, toTypedArrayElement<T>(value)); \
+    } \
+    \
+    DLL_PUBLIC ALWAYS_INLINE Array<T>* NAME##_filld(Array<T>& array, double value) { \
+        array.fill(toTypedArrayElement<T>(value)); \
+        return &array; \
+    } \
+    \
+    DLL_PUBLIC ALWAYS_INLINE Array<T>* NAME##_filldd(Array<T>& array, double value, double start) { \
+        array.fill(toTypedArrayElement<T>(value), toRelativeIndex(start)); \
+        return &array; \
+    } \
+    \
+    DLL_PUBLIC ALWAYS_INLINE Array<T>* NAME##_fillddd(Array<T>& array, double value, double start, double end) { \
+        array.fill(toTypedArrayElement<T>(value), toRelativeIndex(start), toRelativeIndex(end)); \
+        return &array; \
+    } \
+    \
+    DLL_PUBLIC ALWAYS_INLINE Array<T>* NAME##_slice(const Array<T>& array) { \
+        return array.slice(); \
+    } \
+    \
+    DLL_PUBLIC ALWAYS_INLINE Array<T>* NAME##_sliced(const Array<T>& array, double start) { \
+        return array.slice(toRelativeIndex(start)); \
+    } \
+    \
+    DLL_PUBLIC ALWAYS_INLINE Array<T>* NAME##_slicedd(const Array<T>& array, double start, double end) { \
+        return array.slice(toRelativeIndex(start), toRelativeIndex(end)); \
+    } \
+    \
+    DLL_PUBLIC ALWAYS_INLINE int32_t NAME##_length(const Array<T>& array) { \
+        return array.length(); \
+    } \
+    \
+    DLL_PUBLIC ALWAYS_INLINE Array<T>* NAME##_sort(Array<T>& array) { \
+        array.sort(); \
+        return &array; \
+    } \
+    \
+    DLL_PUBLIC ALWAYS_INLINE Array<T>* NAME##_reverse(Array<T>& array) { \
+        array.reverse(); \
+        return &array; \
+    }
 
 //---------------------------------------------------------------------------------
-// pop
+// Array<T>
 //---------------------------------------------------------------------------------
 
-DLL_PUBLIC ALWAYS_INLINE bool ArrayIb_pop(Array<bool>& array) {
-    return array.pop();
-}
-
-DLL_PUBLIC ALWAYS_INLINE int32_t ArrayIi_pop(Array<int32_t>& array) {
-    return array.pop();
-}
-
-DLL_PUBLIC ALWAYS_INLINE double ArrayId_pop(Array<double>& array) {
-    return array.pop();
-}
+DEFINE_ARRAY_API(ArrayIb, bool, b)
+DEFINE_ARRAY_API(ArrayIi, int32_t, i)
+DEFINE_ARRAY_API(ArrayId, double, d)
+DEFINE_ARRAY_API(ArrayIPv, void*, Pv)
 
-DLL_PUBLIC ALWAYS_INLINE void* ArrayIPv_pop(Array<void*>& array) {
-    return array.pop();
-}
+DEFINE_ARRAY_SORT_DESCENDING_API(ArrayIi, int32_t)
+DEFINE_ARRAY_SORT_DESCENDING_API(ArrayId, double)
 
 //---------------------------------------------------------------------------------
-// shift
+// typed arrays
 //---------------------------------------------------------------------------------
 
-DLL_PUBLIC ALWAYS_INLINE bool ArrayIb_shift(Array<bool>& array) {
-    return array.shift();
-}
-
-DLL_PUBLIC ALWAYS_INLINE int32_t ArrayIi_shift(Array<int32_t>& array) {
-    return array.shift();
-}
-
-DLL_PUBLIC ALWAYS_INLINE double ArrayId_shift(Array<double>& array) {
-    return array.shift();
-}
-
-DLL_PUBLIC ALWAYS_INLINE void* ArrayIPv_shift(Array<void*>& array) {
-    return array.shift();
-}
+DEFINE_TYPED_ARRAY_API(Float32Array, float)
+DEFINE_TYPED_ARRAY_API(Int8Array, int8_t)
+DEFINE_TYPED_ARRAY_API(Int16Array, int16_t)
+DEFINE_TYPED_ARRAY_API(Uint8Array, uint8_t)
 
 //---------------------------------------------------------------------------------
-// slice
+// pinned (used by the loader to allocate arrays that survive the gc)
 //---------------------------------------------------------------------------------
-DLL_PUBLIC ALWAYS_INLINE Array<bool>* ArrayIb_slice(const Array<bool>& array) {
-    return array.slice();
-}
 
-DLL_PUBLIC ALWAYS_INLINE Array<bool>* ArrayIb_slicei(const Array<bool>& array, int32_t start) {
-    return array.slice(start);
+DLL_PUBLIC Array<int32_t>* ArrayIi_createPinnedi(int32_t size) {
+    return Array<int32_t>::createPinned(size);
 }
 
-DLL_PUBLIC ALWAYS_INLINE Array<bool>* ArrayIb_sliceii(const Array<bool>& array, int32_t start, int32_t end) {
-    return array.slice(start, end);
+DLL_PUBLIC void ArrayIi_releasePinned(Array<int32_t>* array) {
+    Array<int32_t>::releasePinned(array);
 }
 
-DLL_PUBLIC ALWAYS_INLINE Array<int32_t>* ArrayIi_slice(const Array<int32_t>& array) {
-    return array.slice();
+DLL_PUBLIC Array<double>* ArrayId_createPinnedi(int32_t size) {
+    return Array<double>::createPinned(size);
 }
 
-DLL_PUBLIC ALWAYS_INLINE Array<int32_t>* ArrayIi_slicei(const Array<int32_t>& array, int32_t start) {
-    return array.slice(start);
-}
-
-DLL_PUBLIC ALWAYS_INLINE Array<int32_t>* ArrayIi_sliceii(const Array<int32_t>& array, int32_t start, int32_t end) {
-    return array.slice(start, end);
-}
-
-DLL_PUBLIC ALWAYS_INLINE Array<double>* ArrayId_slice(const Array<double>& array) {
-    return array.slice();
-}
-
-DLL_PUBLIC ALWAYS_INLINE Array<double>* ArrayId_slicei(const Array<double>& array, int32_t start) {
-    return array.slice(start);
-}
-
-DLL_PUBLIC ALWAYS_INLINE Array<double>* ArrayId_sliceii(const Array<double>& array, int32_t start, int32_t end) {
-    return array.slice(start, end);
-}
-
-DLL_PUBLIC ALWAYS_INLINE Array<void*>* ArrayIPv_slice(const Array<void*>& array) {
-    return array.slice();
-}
-
-DLL_PUBLIC ALWAYS_INLINE Array<void*>* ArrayIPv_slicei(const Array<void*>& array, int32_t start) {
-    return array.slice(start);
-}
-
-DLL_PUBLIC ALWAYS_INLINE Array<void*>* ArrayIPv_sliceii(const Array<void*>& array, int32_t start, int32_t end) {
-    return array.slice(start, end);
+DLL_PUBLIC void ArrayId_releasePinned(Array<double>* array) {
+    Array<double>::releasePinned(array);
 }
 
 //---------------------------------------------------------------------------------
-// splice
+// value arrays (arrays of value classes, the fields of the objects are stored inline, see ValueArray)
 //---------------------------------------------------------------------------------
 
-DLL_PUBLIC ALWAYS_INLINE Array<bool>* ArrayIb_splicei(Array<bool>& array, int32_t index) {
-    return array.splice(index, array.length());
-}
-
-DLL_PUBLIC ALWAYS_INLINE Array<bool>* ArrayIb_spliceii(Array<bool>& array, int32_t index, int32_t deleteCount) {
-    return array.splice(index, deleteCount);
-}
-
-DLL_PUBLIC ALWAYS_INLINE Array<bool>* ArrayIb_spliceiiPbu(Array<bool>& array, int32_t index, int32_t deleteCount, bool* elements, size_t elementsCount) {
-    return array.splice(index, deleteCount, elements, elementsCount);
-}
-
-DLL_PUBLIC ALWAYS_INLINE Array<int32_t>* ArrayIi_splicei(Array<int32_t>& array, int32_t index) {
-    return array.splice(index, array.length());
-}
-
-DLL_PUBLIC ALWAYS_INLINE Array<int32_t>* ArrayIi_spliceii(Array<int32_t>& array, int32_t index, int32_t deleteCount) {
-    return array.splice(index, deleteCount);
+DLL_PUBLIC ALWAYS_INLINE ValueArray* ValueArray_constructorii(int32_t size, int32_t elementSize) {
+    return new ValueArray { size, elementSize };
 }
 
-DLL_PUBLIC ALWAYS_INLINE Array<int32_t>* ArrayIi_spliceiiPiu(Array<int32_t>& array, int32_t index, int32_t deleteCount, int32_t* elements, size_t elementsCount) {
-    return array.splice(index, deleteCount, elements, elementsCount);
+DLL_PUBLIC ALWAYS_INLINE ValueArray* ValueArray_constructorPvui(void* const elements, size_t elementsCount, int32_t elementSize) {
+    return new ValueArray { elements, elementsCount, elementSize };
 }
 
-DLL_PUBLIC ALWAYS_INLINE Array<double>* ArrayId_splicei(Array<double>& array, int32_t index) {
-    return array.splice(index, array.length());
+DLL_PUBLIC ALWAYS_INLINE void* ValueArray_elementAti(const ValueArray& array, int32_t index) {
+    return array.elementAt(index);
 }
 
-DLL_PUBLIC ALWAYS_INLINE Array<double>* ArrayId_spliceii(Array<double>& array, int32_t index, int32_t deleteCount) {
-    return array.splice(index, deleteCount);
+DLL_PUBLIC ALWAYS_INLINE void* ValueArray_elementAtUncheckedi(const ValueArray& array, int32_t index) {
+    return array.elementAtUnchecked(index);
 }
 
-DLL_PUBLIC ALWAYS_INLINE Array<double>* ArrayId_spliceiiPdu(Array<double>& array, int32_t index, int32_t deleteCount, double* elements, size_t elementsCount) {
-    return array.splice(index, deleteCount, elements, elementsCount);
-}
-
-DLL_PUBLIC ALWAYS_INLINE Array<void*>* ArrayIPv_splicei(Array<void*>& array, int32_t index) {
-    return array.splice(index, array.length());
-}
-
-DLL_PUBLIC ALWAYS_INLINE Array<void*>* ArrayIPv_spliceii(Array<void*>& array, int32_t index, int32_t deleteCount) {
-    return array.splice(index, deleteCount);
-}
-
-DLL_PUBLIC ALWAYS_INLINE Array<void*>* ArrayIPv_spliceiiPPvu(Array<void*>& array, int32_t index, int32_t deleteCount, void** elements, size_t elementsCount) {
-    return array.splice(index, deleteCount, elements, elementsCount);
-}
-
-//---------------------------------------------------------------------------------
-// length
-//---------------------------------------------------------------------------------
-
-DLL_PUBLIC ALWAYS_INLINE int32_t ArrayIb_length(const Array<bool>& array) {
-    return array.length();
-}
-
-DLL_PUBLIC ALWAYS_INLINE int32_t ArrayIi_length(const Array<int32_t>& array) {
-    return array.length();
+DLL_PUBLIC ALWAYS_INLINE void ValueArray_setiPv(ValueArray& array, int32_t index, void* value) {
+    array.set(index, value);
 }
 
-DLL_PUBLIC ALWAYS_INLINE int32_t ArrayId_length(const Array<double>& array) {
-    return array.length();
+DLL_PUBLIC ALWAYS_INLINE int32_t ValueArray_pushPvu(ValueArray& array, void* elements, size_t numElements) {
+    return array.push(elements, numElements);
 }
 
-DLL_PUBLIC ALWAYS_INLINE int32_t ArrayIPv_length(const Array<void*>& array) {
+DLL_PUBLIC ALWAYS_INLINE int32_t ValueArray_length(const ValueArray& array) {
     return array.length();
 }
 
-DLL_PUBLIC ALWAYS_INLINE void ArrayIb_lengthi(Array<bool>& array, int32_t size) {
-    array.resize(size);
-}
-
-DLL_PUBLIC ALWAYS_INLINE void ArrayIi_lengthi(Array<int32_t>& array, int32_t size) {
-    array.resize(size);
-}
-
-DLL_PUBLIC ALWAYS_INLINE void ArrayId_lengthi(Array<double>& array, int32_t size) {
-    array.resize(size);
-}
-
-DLL_PUBLIC ALWAYS_INLINE void ArrayIPv_lengthi(Array<void*>& array, int32_t size) {
-    array.resize(size);
-}
-
-//---------------------------------------------------------------------------------
-// length
-//---------------------------------------------------------------------------------
-
-DLL_PUBLIC ALWAYS_INLINE Array<bool>* ArrayIb_sort(Array<bool>& array) {
-    array.sort();
-    return &array;
-}
-
-typedef double (*BoolComparator)(const bool a, const bool b);
-DLL_PUBLIC ALWAYS_INLINE Array<bool>* ArrayIb_sortPFdbb(Array<bool>& array, BoolComparator comparator) {
-    array.sort(comparator);
-    return &array;
-}
-
-DLL_PUBLIC ALWAYS_INLINE Array<int32_t>* ArrayIi_sort(Array<int32_t>& array) {
-    array.sort();
-    return &array;
-}
-
-typedef double (*IntComparator)(const int32_t a, const int32_t b);
-DLL_PUBLIC ALWAYS_INLINE Array<int32_t>* ArrayIi_sortPFdii(Array<int32_t>& array, IntComparator comparator) {
-    array.sort(comparator);
-    return &array;
-}
-
-DLL_PUBLIC ALWAYS_INLINE Array<double>* ArrayId_sort(Array<double>& array) {
-    array.sort();
-    return &array;
-}
-
-typedef double (*DoubleComparator)(const double a, const double b);
-DLL_PUBLIC ALWAYS_INLINE Array<double>* ArrayId_sortPFddd(Array<double>& array, DoubleComparator comparator) {
-    array.sort(comparator);
-    return &array;
-}
-
-DLL_PUBLIC ALWAYS_INLINE Array<void*>* ArrayIPv_sort(Array<void*>& array) {
-    array.sort();
-    return &array;
-}
+DLL_PUBLIC ALWAYS_INLINE void ValueArray_lengthi(ValueArray& array, int32_t size) {
+#ifdef SAFE
+    if (size < 0) {
+        RAISE_RUNTIME_ERROR(RuntimeError::INVALID_ARRAY_LENGTH, std::out_of_range("Invalid array length"));
+    }
+#endif
 
-typedef double (*ObjectComparator)(void* const a, void* const b);
-DLL_PUBLIC ALWAYS_INLINE Array<void*>* ArrayIPv_sortPFdPvPv(Array<void*>& array, ObjectComparator comparator) {
-    array.sort(comparator);
-    return &array;
+    array.resize(static_cast<size_t>(size));
 }
 
 #ifdef __cplusplus
@@ -10,11 +10,100 @@
 #include <cstdlib>
 #include <algorithm>
 #include <functional>
+#include <new>
 #include "macros.h"
+#include "errors.h"
+#include "allocator.h"
+#include "instrumentation.h"
+#include "pool.h"
+#include "pinned.h"
+#include "simd.h"
+#include "sort.h"
+#include "parallel.h"
 
-const int32_t CAPACITY_GROW_FACTOR = 2;
+/**
+ * The growth of the capacity in percent if an array needs to grow, e.g. 150 for a growth factor of 1.5.
+ * 100 allocates exactly the required capacity. Can be changed at compile time, e.g. -DARRAY_GROWTH_PERCENT=150.
+ */
+#ifndef ARRAY_GROWTH_PERCENT
+    #define ARRAY_GROWTH_PERCENT 200
+#endif
+
+/**
+ * The capacity of an array is reduced if its length drops below the given percentage of the capacity. The capacity
+ * is reduced to twice the length (hysteresis). 0 disables shrinking. The arena cannot reuse the released memory,
+ * shrinking is therefore disabled by default in the arena variants.
+ */
+#ifndef ARRAY_SHRINK_PERCENT
+    #ifdef ARENA
+        #define ARRAY_SHRINK_PERCENT 0
+    #else
+        #define ARRAY_SHRINK_PERCENT 25
+    #endif
+#endif
+
+const size_t CAPACITY_GROWTH_PERCENT = ARRAY_GROWTH_PERCENT;
+const size_t CAPACITY_SHRINK_PERCENT = ARRAY_SHRINK_PERCENT;
 const int32_t DEFAULT_CAPACITY = 16;
 
+static_assert(ARRAY_GROWTH_PERCENT >= 100, "The array capacity cannot grow by less than 100%");
+static_assert(ARRAY_SHRINK_PERCENT < 50, "The array capacity needs to shrink to less than half of the capacity");
+
+/**
+ * Computes the new capacity of an array that needs to store at least min elements using the growth policy
+ * @param capacity the current capacity
+ * @param min the minimal required capacity
+ * @return the new capacity
+ */
+inline size_t grownCapacity(size_t capacity, size_t min) {
+    size_t newCapacity = capacity == 0 ? DEFAULT_CAPACITY : capacity * CAPACITY_GROWTH_PERCENT / 100;
+
+    if (newCapacity > INT32_MAX) {
+        newCapacity = INT32_MAX;
+    }
+
+    return std::max(newCapacity, min);
+}
+
+/**
+ * The size in bytes of the storage embedded in each array object. Arrays with few elements store the elements inline
+ * and therefore need a single allocation only.
+ */
+const size_t ARRAY_INLINE_STORAGE_SIZE = 32;
+
+/**
+ * Defines the number of elements of type T that are stored inline (without allocating a separate elements array).
+ * Can be specialized to change the threshold for a specific element type.
+ * @tparam T the type of the elements
+ */
+template<typename T>
+struct ArrayInlineCapacity {
+    static const size_t value = ARRAY_INLINE_STORAGE_SIZE / sizeof(T);
+};
+
+/**
+ * Defines who owns the storage of the elements of an array
+ */
+enum class ArrayStorageOwnership : int32_t {
+    /**
+     * The array owns the storage and is responsible to reallocate and release it
+     */
+    OWNED = 0,
+
+    /**
+     * The storage is shared with other arrays (slice views and their parent). The array needs to copy the elements
+     * before modifying them (copy on write) and never releases the storage (this is up to the gc).
+     */
+    SHARED = 1,
+
+    /**
+     * The array object and its storage are pinned allocations that survive the gc (arrays allocated by the loader
+     * in the linear memory, see createPinned, or arrays of values retained by the loader). The storage is reallocated from the pinned allocations when the array
+     * grows. Pinned arrays are never sliced into views as the views would not be pinned.
+     */
+    PINNED = 2
+};
+
 #ifdef SAFE
     const bool INITIALIZE = true;
 #else
@@ -32,9 +121,11 @@ const int32_t DEFAULT_CAPACITY = 16;
 template<typename T>
 class Array {
 private:
+    static const size_t INLINE_CAPACITY = ArrayInlineCapacity<T>::value;
+
     /**
      * The elements stored in the array. Has the size of {@link capacity}. All elements up to {@link length} are initialized
-     * with zero. Is the nullptr if the length is zero (no allocation is needed in this case)
+     * with zero. Points {@link front} elements passed the start of the allocation (or {@link inlineElements}).
      */
     T* begin;
 
@@ -44,31 +135,59 @@ private:
     T* back;
 
     /**
-     * The capacity of the {@link elements}
+     * The capacity of the {@link elements}, counted from begin
      */
     size_t capacity;
 
+    /**
+     * The number of unused elements in front of begin. The gap is left by shift and is used by unshift so that queue
+     * like usages are amortized O(1). The allocation starts at begin - front.
+     */
+    size_t front;
+
+    /**
+     * Defines if the storage is owned by this array or is shared with other arrays. Mutable as slice (const) shares
+     * the storage of the sliced array.
+     */
+    mutable ArrayStorageOwnership ownership;
+
+    /**
+     * The inline storage for arrays with at most INLINE_CAPACITY elements. Not initialized.
+     * The layout up to here (begin, back, capacity, front, ownership) is shared with the loader, the compiler only declares
+     * begin, back and capacity.
+     */
+    T inlineElements[INLINE_CAPACITY];
+
     /**
      * Creates a new array of the given size
      * @param size the size (length) of the new array
      * @param initialize indicator if the elements array is to be default initialized.
      */
-    inline Array(int32_t size, bool initialize) {
+    inline Array(int32_t size, bool initialize, ArrayStorageOwnership storageOwnership = ArrayStorageOwnership::OWNED) {
 #ifdef SAFE
         if (size < 0) {
-            throw std::out_of_range("Invalid array length");
+            RAISE_RUNTIME_ERROR(RuntimeError::INVALID_ARRAY_LENGTH, std::out_of_range("Invalid array length"));
         }
 #endif
 
-        begin = Array<T>::allocateElements(static_cast<size_t>(size));
+        const size_t elementsCount = static_cast<size_t>(size);
+        ownership = storageOwnership;
+        front = 0;
+
+        if (elementsCount <= INLINE_CAPACITY) {
+            begin = inlineElements;
+            capacity = INLINE_CAPACITY;
+        } else {
+            begin = allocateStorage(elementsCount);
+            capacity = elementsCount;
+        }
+
         back = &begin[size];
 
         if (initialize) {
             // This is quite expensive, if there is a GC that guarantees zeroed memory, this is no longer needed
             std::fill_n(begin, size, T {});
         }
-
-        capacity = static_cast<size_t>(size);
     }
 
 public:
@@ -89,8 +208,58 @@ public:
         std::copy(arrayElements, &arrayElements[elementsCount], begin);
     }
 
+    Array(const Array<T>&) = delete;
+    Array<T>& operator=(const Array<T>&) = delete;
+
     inline ~Array() {
-        std::free(begin);
+        if (ownership == ArrayStorageOwnership::OWNED && !usesInlineStorage()) {
+            freeMemory(allocationBase(), (front + capacity) * sizeof(T));
+        }
+    }
+
+    /**
+     * Allocates the array objects from the pool as all array objects have the same size
+     */
+    static inline void* operator new(size_t size) {
+        void* allocation = runtimePool.allocate(size);
+
+        if (allocation == nullptr) {
+            RAISE_RUNTIME_ERROR(RuntimeError::OUT_OF_MEMORY, std::bad_alloc {});
+        }
+
+        return allocation;
+    }
+
+    static inline void operator delete(void* allocation, size_t size) {
+        runtimePool.release(allocation, size);
+    }
+
+    /**
+     * Creates an array whose object and elements are pinned allocations that are not released by the gc. Used by the
+     * loader to allocate arrays in the linear memory that can be passed to multiple calls without copying the elements.
+     * @param size the length of the array
+     * @return the pinned array, needs to be released using releasePinned
+     */
+    static Array<T>* createPinned(int32_t size) __attribute__((returns_nonnull)) {
+        void* allocation = runtimePinnedAllocations.allocate(sizeof(Array<T>));
+
+        if (allocation == nullptr) {
+            RAISE_RUNTIME_ERROR(RuntimeError::OUT_OF_MEMORY, std::bad_alloc {});
+        }
+
+        return ::new (allocation) Array<T>(size, true, ArrayStorageOwnership::PINNED);
+    }
+
+    /**
+     * Releases an array created by createPinned
+     * @param array the pinned array
+     */
+    static void releasePinned(Array<T>* array) {
+        if (!array->usesInlineStorage()) {
+            runtimePinnedAllocations.release(array->allocationBase());
+        }
+
+        runtimePinnedAllocations.release(array);
     }
 
     /**
@@ -114,7 +283,11 @@ public:
      * @param index the index of the element where the value is to be set
      * @param value the value to set at the given index
      */
-    inline void set(int32_t index, T value) const {
+    inline void set(int32_t index, T value) {
+        if (__builtin_expect(ownership == ArrayStorageOwnership::SHARED, false)) {
+            unshare();
+        }
+
         auto const position = &begin[index];
  #ifdef SAFE
         if (position < begin || position >= back) {
@@ -122,14 +295,36 @@ public:
             // might not always be capable to prove that all array accesses are in bound (e.g. merge sort) and therefore
             // cannot optimize the begin ptr load out of the loop. This can be avoided by throwing instead (no resizing,
             // begin ptr remains constant
-            throw std::out_of_range("Invalid array index");
+            RAISE_RUNTIME_ERROR(RuntimeError::INVALID_ARRAY_INDEX, std::out_of_range("Invalid array index"));
         }
  #endif
 
         *position = value;
     }
 
-    inline void fill(const T value, int32_t start=0) const {
+    /**
+     * Returns the element at the given index without checking the bounds, even in safe mode. Used by the compiler for
+     * accesses where the index is known to be in bound (e.g. the counter of a loop over the array).
+     * @param index the index of the element, needs to be in between 0 and length - 1
+     */
+    inline T getUnchecked(int32_t index) const {
+        return begin[index];
+    }
+
+    /**
+     * Sets the element at the given index without checking the bounds, even in safe mode
+     * @param index the index of the element, needs to be in between 0 and length - 1
+     * @param value the value to set
+     */
+    inline void setUnchecked(int32_t index, T value) {
+        if (__builtin_expect(ownership == ArrayStorageOwnership::SHARED, false)) {
+            unshare();
+        }
+
+        begin[index] = value;
+    }
+
+    inline void fill(const T value, int32_t start=0) {
         fill(value, start, length());
     }
 
@@ -140,7 +335,9 @@ public:
      * @param endIndex the end where the value should no longer be set (exclusive)
      * @see https://developer.mozilla.org/en-US/docs/Web/JavaScript/Reference/Global_Objects/Array/fill
      */
-    inline void fill(const T value, int32_t startIndex, int32_t endIndex) const {
+    inline void fill(const T value, int32_t startIndex, int32_t endIndex) {
+        unshare();
+
         T* start = startIndex < 0 ? &back[startIndex] : &begin[startIndex];
         T* end = endIndex < 0 ? &back[endIndex] : &begin[endIndex];
 
@@ -149,23 +346,42 @@ public:
         end = std::min(std::max(end, start), back);
  #endif
 
-        std::fill(start, end, value);
+        parallelFill(start, end, value);
     }
 
     /**
      * Sorts the array elements using the default comparision (objects by pointer since to string conversion is not yet suppported)
      */
     inline void sort() {
-        std::sort(begin, back);
+        unshare();
+        parallelSort(begin, back);
+    }
+
+    /**
+     * Sorts the array elements in descending order. Used if the compiler detects a (a, b) => b - a comparator.
+     */
+    inline void sortDescending() {
+        unshare();
+        sortElementsDescending(begin, back);
     }
 
     typedef double (*Comparator)(const T a, const T b);
     inline void sort(Comparator comparator) {
+        unshare();
         std::sort(begin, back, [&comparator](T a, T b) {
             return comparator(a, b) < 0;
         });
     }
 
+    /**
+     * Reverses the elements of the array in place
+     * @see https://developer.mozilla.org/en-US/docs/Web/JavaScript/Reference/Global_Objects/Array/reverse
+     */
+    inline void reverse() {
+        unshare();
+        reverseElements(begin, back);
+    }
+
     /**
      * Adds one or several new elements to the and of the array
      * @param elementsToAdd the elements to add, not a nullptr
@@ -173,10 +389,29 @@ public:
      * @return the new length of the array
      */
     inline int32_t push(const T* elementsToAdd, size_t numElements) __attribute__((nonnull(2))) {
+        unshare();
         const size_t newLength = size() + numElements;
         ensureCapacity(newLength);
 
-        back = std::copy(elementsToAdd, &elementsToAdd[numElements], back);
+        back = moveElements(elementsToAdd, &elementsToAdd[numElements], back);
+        return length();
+    }
+
+    /**
+     * Adds a single element to the end of the array. Used by the compiler for push(x) instead of passing the element
+     * through a temporary array.
+     * @param element the element to add
+     * @return the new length of the array
+     */
+    inline int32_t push(const T element) {
+        unshare();
+
+        if (size() == capacity) {
+            ensureCapacity(size() + 1);
+        }
+
+        *back = element;
+        ++back;
         return length();
     }
 
@@ -188,11 +423,36 @@ public:
      * @see https://developer.mozilla.org/en-US/docs/Web/JavaScript/Reference/Global_Objects/Array/unshift
      */
     inline int32_t unshift(const T* elementsToAdd, size_t numElements) __attribute__((nonnull(2))) {
-        const size_t newLength = size() + numElements;
-        ensureCapacity(newLength);
+        unshare();
 
-        back = std::copy(begin, back, &begin[numElements]);
-        std::copy(elementsToAdd, &elementsToAdd[numElements], begin);
+        if (front < numElements) {
+            ensureFrontCapacity(numElements);
+        }
+
+        begin -= numElements;
+        front -= numElements;
+        capacity += numElements;
+        moveElements(elementsToAdd, &elementsToAdd[numElements], begin);
+
+        return length();
+    }
+
+    /**
+     * Adds a single element to the beginning of the array (unshift(x))
+     * @param element the element to add
+     * @return the new length of the array
+     */
+    inline int32_t unshift(const T element) {
+        unshare();
+
+        if (front == 0) {
+            ensureFrontCapacity(1);
+        }
+
+        --begin;
+        --front;
+        ++capacity;
+        *begin = element;
 
         return length();
     }
@@ -211,6 +471,7 @@ public:
 
         const T result = back[-1];
         back--;
+        shrinkIfSparse();
         return result;
     }
 
@@ -226,8 +487,20 @@ public:
         }
 #endif
 
+        // Advance begin instead of moving the elements, the gap is reused by unshift or reclaimed when growing
         const T element = begin[0];
-        back = std::copy(&begin[1], back, begin);
+        ++begin;
+        ++front;
+        --capacity;
+
+        if (begin == back) {
+            // Empty, the whole allocation can be reused from the start
+            begin = back = allocationBase();
+            capacity += front;
+            front = 0;
+        }
+
+        shrinkIfSparse();
         return element;
     }
 
@@ -236,7 +509,8 @@ public:
     }
 
     /**
-     * Returns a copy of the array containing the elements from start to end
+     * Returns a copy of the array containing the elements from start to end. Slices that do not fit into the inline
+     * storage are views that share the storage with this array. The elements are copied when either array is modified.
      * @see https://developer.mozilla.org/en/docs/Web/JavaScript/Reference/Global_Objects/Array/slice
      */
     Array<T>* slice(int32_t startIndex, int32_t endIndex) const  __attribute__((returns_nonnull)) {
@@ -244,14 +518,52 @@ public:
         T* end = endIndex < 0 ? &back[endIndex] : &begin[endIndex];
 
 #ifdef SAFE
-        start = std::min(start, back);
+        start = std::min(std::max(start, begin), back);
         end = std::max(start, std::min(end, back));
 #endif
         const size_t elementsCount = end - start;
-        return new Array<T>(start, elementsCount);
+
+        if (elementsCount <= INLINE_CAPACITY || ownership == ArrayStorageOwnership::PINNED) {
+            return new Array<T>(start, elementsCount);
+        }
+
+        auto* view = new Array<T>();
+        view->begin = start;
+        view->back = end;
+        view->capacity = elementsCount;
+        view->ownership = ArrayStorageOwnership::SHARED;
+
+        ownership = ArrayStorageOwnership::SHARED;
+        return view;
     }
 
     Array<T>* splice(int32_t index, int32_t deleteCount, T* elementsToAdd = nullptr, size_t elementsCount = 0)  __attribute__((returns_nonnull)) {
+        normalizeSpliceRange(index, deleteCount);
+        return splice(static_cast<size_t>(index), static_cast<size_t>(deleteCount), elementsToAdd, elementsCount);
+    }
+
+    Array<T>* splice(size_t index, size_t deleteCount, T* elementsToAdd = nullptr, size_t elementsCount = 0)  __attribute__((returns_nonnull)) {
+        // safe the deleted elements
+        Array<T>* deleted = new Array<T>(&begin[index], deleteCount);
+
+        replaceRange(index, deleteCount, elementsToAdd, elementsCount);
+        return deleted;
+    }
+
+    /**
+     * Splice that does not return the deleted elements. Used by the compiler if the result of splice is unused,
+     * avoids the allocation of the array with the deleted elements.
+     */
+    void spliceDiscard(int32_t index, int32_t deleteCount, T* elementsToAdd = nullptr, size_t elementsCount = 0) {
+        normalizeSpliceRange(index, deleteCount);
+        replaceRange(static_cast<size_t>(index), static_cast<size_t>(deleteCount), elementsToAdd, elementsCount);
+    }
+
+private:
+    /**
+     * Resolves a negative splice index relative to the end and (in safe mode) clamps the range to the array bounds
+     */
+    inline void normalizeSpliceRange(int32_t& index, int32_t& deleteCount) const {
         if (index < 0) {
             index = length() + index;
         }
@@ -260,11 +572,14 @@ public:
         index = std::max(std::min(index, length()), 0);
         deleteCount = std::min(std::max(deleteCount, 0), length() - index);
 #endif
-
-        return splice(static_cast<size_t>(index), static_cast<size_t>(deleteCount), elementsToAdd, elementsCount);
     }
 
-    Array<T>* splice(size_t index, size_t deleteCount, T* elementsToAdd = nullptr, size_t elementsCount = 0)  __attribute__((returns_nonnull)) {
+    /**
+     * Replaces the deleteCount elements starting at index with the given elements
+     */
+    void replaceRange(size_t index, size_t deleteCount, T* elementsToAdd, size_t elementsCount) {
+        unshare();
+
         if (deleteCount < elementsCount) {
             // Make place for the new items
             ensureCapacity(size() + elementsCount - deleteCount);
@@ -274,18 +589,19 @@ public:
         T* removeEnd = &begin[index + deleteCount];
         T* insertEnd = &begin[index + elementsCount];
 
-        // safe the deleted elements
-        Array<T>* deleted = new Array<T>(removeBegin, deleteCount);
-
         // Move the following elements into right place
-        back = std::move(removeEnd, back, insertEnd);
+        back = moveElements(removeEnd, back, insertEnd);
 
         // insert the new elements
         std::copy(elementsToAdd, &elementsToAdd[elementsCount], removeBegin);
 
-        return deleted;
+        if (elementsCount < deleteCount) {
+            shrinkIfSparse();
+        }
     }
 
+public:
+
     /**
      * Returns the size of the array
      * @return the size
@@ -302,6 +618,27 @@ public:
         return static_cast<int32_t>(size());
     }
 
+    /**
+     * Returns true if the elements are stored in the inline storage of the array object
+     */
+    inline bool usesInlineStorage() const {
+        return allocationBase() == inlineElements;
+    }
+
+    /**
+     * Returns true if the storage is shared with other arrays (a slice view or an array that has been sliced)
+     */
+    inline bool isShared() const {
+        return ownership == ArrayStorageOwnership::SHARED;
+    }
+
+    /**
+     * Returns true if the array has been created by createPinned
+     */
+    inline bool isPinned() const {
+        return ownership == ArrayStorageOwnership::PINNED;
+    }
+
     /**
      * Resizes the array to the new size.
      * @param newSize the new size
@@ -309,7 +646,7 @@ public:
     void resize(int32_t newSize) {
 #ifdef SAFE
         if (newSize < 0) {
-            throw std::out_of_range("Invalid array length");
+            RAISE_RUNTIME_ERROR(RuntimeError::INVALID_ARRAY_LENGTH, std::out_of_range("Invalid array length"));
         }
 #endif
 
@@ -317,6 +654,10 @@ public:
     }
 
     void resize(size_t newSize) {
+        if (newSize > size()) {
+            unshare();
+        }
+
         ensureCapacity(newSize);
 
 #ifdef SAFE
@@ -326,50 +667,227 @@ public:
         }
 #endif
 
+        const bool reduced = newSize < size();
         back = begin + newSize;
+
+        if (reduced) {
+            shrinkIfSparse();
+        }
+    }
+
+    /**
+     * Ensures that the given number of elements can be pushed without growing the array again. The capacity is
+     * increased exactly to the required capacity (no growth policy). Emitted by the compiler for loops where the number
+     * of pushed elements is known in advance.
+     * @param count the number of elements that are going to be pushed
+     */
+    inline void reservePush(int32_t count) {
+        if (count <= 0) {
+            return;
+        }
+
+        unshare();
+        ensureCapacity(size() + static_cast<size_t>(count), true);
+    }
+
+    /**
+     * Returns the number of elements that can be stored without growing the array (including the gap in front)
+     */
+    inline size_t totalCapacity() const {
+        return front + capacity;
     }
 
 private:
+    /**
+     * Copies the elements into a storage owned by this array if the storage is shared with other arrays.
+     * The shared storage is not released, it is still in use by the other arrays (or is released by the gc).
+     */
+    inline void unshare() {
+        if (ownership != ArrayStorageOwnership::SHARED) {
+            return;
+        }
+
+        const size_t length = size();
+        T* elements = length <= INLINE_CAPACITY ? inlineElements : Array<T>::allocateElements(length);
+
+        std::copy(begin, back, elements);
+        begin = elements;
+        back = elements + length;
+        capacity = length <= INLINE_CAPACITY ? INLINE_CAPACITY : length;
+        front = 0;
+        ownership = ArrayStorageOwnership::OWNED;
+    }
+
     /**
      * Ensures that the capacity of the array is at lest of the given size
      * @param min the minimal required capacity
+     * @param exact true if the capacity should be increased to exactly min instead of using the growth policy
      */
-    void ensureCapacity(size_t min) {
-        if (min < capacity) {
+    void ensureCapacity(size_t min, bool exact = false) {
+        if (min <= capacity) {
             return;
         }
 
-        size_t newCapacity = capacity == 0 ? DEFAULT_CAPACITY : capacity * CAPACITY_GROW_FACTOR;
+        const size_t length = this->size();
+        const size_t totalCapacity = front + capacity;
+
+        if (front > 0) {
+            // Reclaim the gap left by shift. Moving is amortized as long as it frees at least length elements at the back
+            moveToAllocationBase();
 
-        if (static_cast<size_t>(newCapacity) > INT32_MAX) {
-            newCapacity = INT32_MAX;
+            if (min + length <= totalCapacity || (exact && min <= totalCapacity)) {
+                return;
+            }
         }
 
-        newCapacity = std::max(newCapacity, static_cast<size_t>(min));
+        recordArrayGrowth();
+        reallocate(exact ? min : grownCapacity(totalCapacity, min));
+    }
+
+    /**
+     * Moves the elements to the start of the allocation to reclaim the gap in front
+     */
+    inline void moveToAllocationBase() {
+        T* base = allocationBase();
+        back = moveElements(begin, back, base);
+        begin = base;
+        capacity += front;
+        front = 0;
+    }
+
+    /**
+     * Reallocates the elements with the given capacity. Requires that there is no gap in front of the elements.
+     * Uses the inline storage if the elements fit into it.
+     * @param newCapacity the new capacity, at least the size of the array
+     */
+    void reallocate(size_t newCapacity) {
         const size_t length = this->size();
-        begin = Array<T>::allocateElements(newCapacity, begin);
+
+        if (usesInlineStorage()) {
+            T* elements = allocateStorage(newCapacity);
+            std::copy(begin, back, elements);
+            begin = elements;
+        } else if (newCapacity <= INLINE_CAPACITY) {
+            std::copy(begin, back, inlineElements);
+            releaseStorage(begin, capacity);
+            begin = inlineElements;
+            newCapacity = INLINE_CAPACITY;
+        } else {
+            begin = allocateStorage(newCapacity, begin, capacity);
+        }
         back = begin + length; // update the back pointer for the new allocation
 
         capacity = newCapacity;
     }
 
+    /**
+     * Reduces the capacity to twice the length if the length dropped below CAPACITY_SHRINK_PERCENT of the capacity.
+     * Arrays that fit into the inline storage move their elements back into the array object.
+     */
+    inline void shrinkIfSparse() {
+        const size_t totalCapacity = front + capacity;
+
+        if (__builtin_expect(size() * 100 < totalCapacity * CAPACITY_SHRINK_PERCENT, false)) {
+            const size_t length = size();
+            const size_t newCapacity = length <= INLINE_CAPACITY ? 0 : std::max(length * 2, static_cast<size_t>(DEFAULT_CAPACITY));
+
+            if (ownership == ArrayStorageOwnership::OWNED && !usesInlineStorage() && newCapacity < totalCapacity) {
+                moveToAllocationBase();
+                reallocate(newCapacity);
+            }
+        }
+    }
+
+    /**
+     * Ensures that there are at least the given number of unused elements in front of begin. The elements are
+     * centered in an allocation grown by the growth policy so that the following unshifts (and pushes) are amortized O(1).
+     * @param min the minimal number of unused elements in front of begin
+     */
+    void ensureFrontCapacity(size_t min) {
+        const size_t length = this->size();
+        const size_t required = length + min;
+        const size_t totalCapacity = front + capacity;
+        T* base = allocationBase();
+        T* elements = base;
+        size_t newTotalCapacity = totalCapacity;
+
+        if (totalCapacity < grownCapacity(required, required)) {
+            newTotalCapacity = grownCapacity(required, required);
+            elements = allocateStorage(newTotalCapacity);
+        }
+
+        const size_t newFront = min + (newTotalCapacity - required) / 2;
+        back = moveElements(begin, back, elements + newFront);
+        begin = elements + newFront;
+
+        if (elements != base && base != inlineElements) {
+            releaseStorage(base, totalCapacity);
+        }
+
+        front = newFront;
+        capacity = newTotalCapacity - newFront;
+    }
+
+    /**
+     * Returns the start of the allocation of the elements
+     */
+    inline T* allocationBase() const {
+        return begin - front;
+    }
+
+    /**
+     * (Re) Allocates the storage for the elements of this array, pinned arrays allocate pinned storage
+     * @see allocateElements
+     */
+    inline T* allocateStorage(size_t capacity, T* elements = nullptr, size_t oldCapacity = 0) const __attribute__((returns_nonnull)) {
+        if (__builtin_expect(ownership == ArrayStorageOwnership::PINNED, false)) {
+            // Storage allocated for an inline array belongs to the scope of the array object (e.g. a retained value)
+            const uint32_t scope = elements == nullptr ? runtimePinnedAllocations.scopeOf(this) : UNSCOPED;
+            void* allocation = runtimePinnedAllocations.reallocate(elements, capacity * sizeof(T), scope);
+            recordElementAllocation(capacity * sizeof(T));
+
+            if (allocation == nullptr) {
+                RAISE_RUNTIME_ERROR(RuntimeError::OUT_OF_MEMORY, std::bad_alloc {});
+            }
+
+            return static_cast<T*>(allocation);
+        }
+
+        return Array<T>::allocateElements(capacity, elements, oldCapacity);
+    }
+
+    /**
+     * Releases storage allocated by allocateStorage
+     */
+    inline void releaseStorage(T* elements, size_t capacity) const {
+        if (__builtin_expect(ownership == ArrayStorageOwnership::PINNED, false)) {
+            runtimePinnedAllocations.release(elements);
+        } else {
+            freeMemory(elements, capacity * sizeof(T));
+        }
+    }
+
     /**
      * (Re) Allocates an array for the elements with the given capacity
      * @param capacity the capacity to allocate
      * @param elements existing pointer to the elements array, in this case, a reallocate is performed
+     * @param oldCapacity the capacity of the existing elements array
      * @returns the pointer to the allocated array
      */
-    static inline T* allocateElements(size_t capacity, T* elements = nullptr)  __attribute__((returns_nonnull)) {
+    static inline T* allocateElements(size_t capacity, T* elements = nullptr, size_t oldCapacity = 0)  __attribute__((returns_nonnull)) {
         const auto size = capacity * sizeof(T);
-        // LLVM can better optimize mallocs. If it detects an unused malloc, it is optimized away. Reallocs are not removed
-        void* allocation = elements == nullptr ? std::malloc(size) : std::realloc(elements, size);
+        void* allocation = reallocateMemory(elements, oldCapacity * sizeof(T), size);
+        recordElementAllocation(size);
 
         if (allocation == nullptr) {
-            throw std::bad_alloc {};
+            RAISE_RUNTIME_ERROR(RuntimeError::OUT_OF_MEMORY, std::bad_alloc {});
         }
 
         return static_cast<T*>(allocation);
     }
 };
 
+// Array<bool> stores the elements as bits
+#include "bool-array.h"
+
 #endif //SPEEDYJS_RUNTIME_ARRAY_H
@@ -0,0 +1,628 @@
+//
+// Specialization of the JS Array for booleans that packs the elements into bits.
+//
+
+#ifndef SPEEDYJS_RUNTIME_BOOL_ARRAY_H
+#define SPEEDYJS_RUNTIME_BOOL_ARRAY_H
+
+#include "array.h"
+
+/**
+ * Implementation of the JS Array for booleans. Stores each element as a single bit in 32 bit words and therefore
+ * needs an eighth of the memory of the generic implementation. Bulk operations (fill, sort, shifts of ranges) operate
+ * on whole words.
+ *
+ * All bits at and after the length of the array are always zero. Growing the array (resize, push) therefore never
+ * needs to initialize the new elements and counting the set bits does not need to mask the last word.
+ */
+template<>
+class Array<bool> {
+private:
+    typedef uint32_t Word;
+
+    static const size_t WORD_BITS = sizeof(Word) * 8;
+    static const size_t WORD_SHIFT = 5;
+    static const size_t INLINE_WORDS = ARRAY_INLINE_STORAGE_SIZE / sizeof(Word);
+
+    /**
+     * The words storing the elements. Has the size of {@link capacity} / WORD_BITS. Points to {@link inlineWords}
+     * as long as the elements fit into the inline storage.
+     */
+    Word* words;
+
+    /**
+     * The number of elements (bits) in the array
+     */
+    size_t count;
+
+    /**
+     * The capacity in bits, always a multiple of WORD_BITS
+     */
+    size_t capacity;
+
+    /**
+     * The inline storage for arrays with at most INLINE_WORDS * WORD_BITS elements.
+     * The layout up to here (words, length, capacity) is shared with the loader.
+     */
+    Word inlineWords[INLINE_WORDS];
+
+public:
+    /**
+     * Creates a new array of the given size. The elements are always initialized with false as this is needed to
+     * maintain the invariant that unused bits are zero (and it is cheap, only a bit per element needs to be set).
+     * @param size the size (length) of the new array
+     */
+    inline Array(int32_t size = 0) {
+#ifdef SAFE
+        if (size < 0) {
+            RAISE_RUNTIME_ERROR(RuntimeError::INVALID_ARRAY_LENGTH, std::out_of_range("Invalid array length"));
+        }
+#endif
+
+        const size_t wordCount = wordsFor(static_cast<size_t>(size));
+
+        if (wordCount <= INLINE_WORDS) {
+            words = inlineWords;
+            capacity = INLINE_WORDS * WORD_BITS;
+            std::fill_n(words, INLINE_WORDS, 0);
+        } else {
+            words = allocateWords(wordCount);
+            capacity = wordCount * WORD_BITS;
+            std::fill_n(words, wordCount, 0);
+        }
+
+        count = static_cast<size_t>(size);
+    }
+
+    /**
+     * Creates a new array containing the passed in elements
+     * @param arrayElements the elements to be added to the array
+     * @param elementsCount the number of elements
+     */
+    inline Array(const bool* arrayElements, size_t elementsCount) __attribute__((nonnull(2))): Array(static_cast<int32_t>(elementsCount)) {
+        packElements(arrayElements, elementsCount, 0);
+    }
+
+    Array(const Array<bool>&) = delete;
+    Array<bool>& operator=(const Array<bool>&) = delete;
+
+    inline ~Array() {
+        if (!usesInlineStorage()) {
+            freeMemory(words, capacity / 8);
+        }
+    }
+
+    /**
+     * Allocates the array objects from the pool as all array objects have the same size
+     */
+    static inline void* operator new(size_t size) {
+        void* allocation = runtimePool.allocate(size);
+
+        if (allocation == nullptr) {
+            RAISE_RUNTIME_ERROR(RuntimeError::OUT_OF_MEMORY, std::bad_alloc {});
+        }
+
+        return allocation;
+    }
+
+    static inline void operator delete(void* allocation, size_t size) {
+        runtimePool.release(allocation, size);
+    }
+
+    /**
+     * Returns the element at the given index
+     * @param index the index of the element to return
+     * @return the element at the given index or false if the index is out of bound (only in safe mode)
+     */
+    inline bool get(int32_t index) const {
+#ifdef SAFE
+        if (static_cast<size_t>(index) >= count) {
+            return false;
+        }
+#endif
+
+        return (words[index >> WORD_SHIFT] >> (index & (WORD_BITS - 1))) & 1;
+    }
+
+    /**
+     * Sets the value at the given index position.
+     * @param index the index of the element where the value is to be set
+     * @param value the value to set at the given index
+     */
+    inline void set(int32_t index, bool value) const {
+#ifdef SAFE
+        if (static_cast<size_t>(index) >= count) {
+            // Throw instead of resizing, see Array<T>::set
+            RAISE_RUNTIME_ERROR(RuntimeError::INVALID_ARRAY_INDEX, std::out_of_range("Invalid array index"));
+        }
+#endif
+
+        const Word mask = Word { 1 } << (index & (WORD_BITS - 1));
+        Word& word = words[index >> WORD_SHIFT];
+        word = value ? word | mask : word & ~mask;
+    }
+
+    /**
+     * Returns the value at the given index without checking the bounds, see Array<T>::getUnchecked
+     */
+    inline bool getUnchecked(int32_t index) const {
+        return (words[index >> WORD_SHIFT] >> (index & (WORD_BITS - 1))) & 1;
+    }
+
+    /**
+     * Sets the value at the given index without checking the bounds, see Array<T>::setUnchecked
+     */
+    inline void setUnchecked(int32_t index, bool value) const {
+        const Word mask = Word { 1 } << (index & (WORD_BITS - 1));
+        Word& word = words[index >> WORD_SHIFT];
+        word = value ? word | mask : word & ~mask;
+    }
+
+    inline void fill(const bool value, int32_t start=0) {
+        fill(value, start, length());
+    }
+
+    /**
+     * Sets the value of the array elements in between start and end to the given constant
+     * @param value the value to set
+     * @param startIndex the start from which the values should be initialized
+     * @param endIndex the end where the value should no longer be set (exclusive)
+     * @see https://developer.mozilla.org/en-US/docs/Web/JavaScript/Reference/Global_Objects/Array/fill
+     */
+    inline void fill(const bool value, int32_t startIndex, int32_t endIndex) {
+        int32_t start = startIndex < 0 ? length() + startIndex : startIndex;
+        int32_t end = endIndex < 0 ? length() + endIndex : endIndex;
+
+#ifdef SAFE
+        start = std::min(std::max(start, 0), length());
+        end = std::min(std::max(end, start), length());
+#endif
+
+        fillBits(static_cast<size_t>(start), static_cast<size_t>(end), value);
+    }
+
+    /**
+     * Sorts the array elements ascending (false before true). Only counts the set bits and refills the array.
+     */
+    inline void sort() {
+        const size_t trueCount = countTrue();
+        fillBits(0, count - trueCount, false);
+        fillBits(count - trueCount, count, true);
+    }
+
+    typedef double (*Comparator)(const bool a, const bool b);
+    inline void sort(Comparator comparator) {
+        const size_t trueCount = countTrue();
+
+        // Two values only, the comparator either orders false before true, true before false, or considers them equal
+        if (comparator(false, true) < 0) {
+            fillBits(0, count - trueCount, false);
+            fillBits(count - trueCount, count, true);
+        } else if (comparator(true, false) < 0) {
+            fillBits(0, trueCount, true);
+            fillBits(trueCount, count, false);
+        }
+    }
+
+    /**
+     * Reverses the elements of the array in place
+     * @see https://developer.mozilla.org/en-US/docs/Web/JavaScript/Reference/Global_Objects/Array/reverse
+     */
+    void reverse() {
+        const size_t wordCount = wordsFor(count);
+
+        // Reversing the words and the bits in each word places the elements in the range [padding, wordCount * WORD_BITS)
+        std::reverse(words, words + wordCount);
+        for (size_t i = 0; i < wordCount; ++i) {
+            words[i] = reverseBits(words[i]);
+        }
+
+        const size_t padding = wordCount * WORD_BITS - count;
+        if (padding != 0) {
+            copyBits(words, padding, words, 0, count);
+            fillBits(count, wordCount * WORD_BITS, false);
+        }
+    }
+
+    /**
+     * Returns the number of elements that are true
+     */
+    inline size_t countTrue() const {
+        size_t result = 0;
+        const size_t wordCount = wordsFor(count);
+
+        for (size_t i = 0; i < wordCount; ++i) {
+            result += __builtin_popcount(words[i]);
+        }
+
+        return result;
+    }
+
+    /**
+     * Adds one or several new elements to the and of the array
+     * @param elementsToAdd the elements to add, not a nullptr
+     * @param numElements the number of elements to add
+     * @return the new length of the array
+     */
+    inline int32_t push(const bool* elementsToAdd, size_t numElements) __attribute__((nonnull(2))) {
+        ensureCapacity(count + numElements);
+
+        packElements(elementsToAdd, numElements, count);
+        count += numElements;
+        return length();
+    }
+
+    /**
+     * Adds a single element to the end of the array, see Array<T>::push(const T)
+     */
+    inline int32_t push(const bool element) {
+        ensureCapacity(count + 1);
+
+        setUnchecked(static_cast<int32_t>(count), element);
+        ++count;
+        return length();
+    }
+
+    /**
+     * Adds an element to the beginning of the array and returns the new length
+     * @param elementsToAdd the elements to add
+     * @param numElements the number of elements to add
+     * @return the new length after inserting the given element
+     * @see https://developer.mozilla.org/en-US/docs/Web/JavaScript/Reference/Global_Objects/Array/unshift
+     */
+    inline int32_t unshift(const bool* elementsToAdd, size_t numElements) __attribute__((nonnull(2))) {
+        ensureCapacity(count + numElements);
+
+        copyBits(words, 0, words, numElements, count);
+        packElements(elementsToAdd, numElements, 0);
+        count += numElements;
+
+        return length();
+    }
+
+    /**
+     * Adds a single element to the beginning of the array
+     */
+    inline int32_t unshift(const bool element) {
+        return unshift(&element, 1);
+    }
+
+    /**
+     * Removes the last element and returns it
+     * @return the last element or false if the array is empty
+     * @see https://developer.mozilla.org/en-US/docs/Web/JavaScript/Reference/Global_Objects/Array/pop
+     */
+    inline bool pop() {
+#ifdef SAFE
+        if (count == 0) {
+            return false;
+        }
+#endif
+
+        const bool result = get(length() - 1);
+        set(length() - 1, false);
+        --count;
+        return result;
+    }
+
+    /**
+     * Removes the first element and returns it
+     * @return the first element or false if the array is empty
+     * @see https://developer.mozilla.org/en-US/docs/Web/JavaScript/Reference/Global_Objects/Array/shift
+     */
+    inline bool shift() {
+#ifdef SAFE
+        if (count == 0) {
+            return false;
+        }
+#endif
+
+        const bool element = get(0);
+        copyBits(words, 1, words, 0, count - 1);
+        set(length() - 1, false);
+        --count;
+        return element;
+    }
+
+    inline Array<bool>* slice(int32_t start = 0) const  __attribute__((returns_nonnull)) {
+        return slice(start, length());
+    }
+
+    /**
+     * Returns a copy of the array containing the elements from start to end
+     * @see https://developer.mozilla.org/en/docs/Web/JavaScript/Reference/Global_Objects/Array/slice
+     */
+    Array<bool>* slice(int32_t startIndex, int32_t endIndex) const  __attribute__((returns_nonnull)) {
+        int32_t start = startIndex < 0 ? length() + startIndex : startIndex;
+        int32_t end = endIndex < 0 ? length() + endIndex : endIndex;
+
+#ifdef SAFE
+        start = std::min(std::max(start, 0), length());
+        end = std::max(start, std::min(end, length()));
+#endif
+
+        auto* result = new Array<bool>(end - start);
+        copyBits(words, static_cast<size_t>(start), result->words, 0, result->count);
+        return result;
+    }
+
+    Array<bool>* splice(int32_t index, int32_t deleteCount, bool* elementsToAdd = nullptr, size_t elementsCount = 0)  __attribute__((returns_nonnull)) {
+        normalizeSpliceRange(index, deleteCount);
+        return splice(static_cast<size_t>(index), static_cast<size_t>(deleteCount), elementsToAdd, elementsCount);
+    }
+
+    Array<bool>* splice(size_t index, size_t deleteCount, bool* elementsToAdd = nullptr, size_t elementsCount = 0)  __attribute__((returns_nonnull)) {
+        // safe the deleted elements
+        auto* deleted = new Array<bool>(static_cast<int32_t>(deleteCount));
+        copyBits(words, index, deleted->words, 0, deleteCount);
+
+        replaceRange(index, deleteCount, elementsToAdd, elementsCount);
+        return deleted;
+    }
+
+    /**
+     * Splice that does not return the deleted elements, see Array<T>::spliceDiscard
+     */
+    void spliceDiscard(int32_t index, int32_t deleteCount, bool* elementsToAdd = nullptr, size_t elementsCount = 0) {
+        normalizeSpliceRange(index, deleteCount);
+        replaceRange(static_cast<size_t>(index), static_cast<size_t>(deleteCount), elementsToAdd, elementsCount);
+    }
+
+private:
+    inline void normalizeSpliceRange(int32_t& index, int32_t& deleteCount) const {
+        if (index < 0) {
+            index = length() + index;
+        }
+
+#ifdef SAFE
+        index = std::max(std::min(index, length()), 0);
+        deleteCount = std::min(std::max(deleteCount, 0), length() - index);
+#endif
+    }
+
+    void replaceRange(size_t index, size_t deleteCount, bool* elementsToAdd, size_t elementsCount) {
+        if (deleteCount < elementsCount) {
+            // Make place for the new items
+            ensureCapacity(count + elementsCount - deleteCount);
+        }
+
+        // Move the following elements into right place
+        const size_t newCount = count - deleteCount + elementsCount;
+        copyBits(words, index + deleteCount, words, index + elementsCount, count - index - deleteCount);
+        if (newCount < count) {
+            fillBits(newCount, count, false);
+        }
+
+        // insert the new elements
+        packElements(elementsToAdd, elementsCount, index);
+        count = newCount;
+    }
+
+public:
+
+    /**
+     * Returns the size of the array
+     * @return the size
+     */
+    inline size_t size() const {
+        return count;
+    }
+
+    /**
+     * Returns the length of the array as int
+     * @return the size
+     */
+    inline int32_t length() const {
+        return static_cast<int32_t>(count);
+    }
+
+    /**
+     * Returns true if the elements are stored in the inline storage of the array object
+     */
+    inline bool usesInlineStorage() const {
+        return words == inlineWords;
+    }
+
+    /**
+     * Resizes the array to the new size.
+     * @param newSize the new size
+     */
+    void resize(int32_t newSize) {
+#ifdef SAFE
+        if (newSize < 0) {
+            RAISE_RUNTIME_ERROR(RuntimeError::INVALID_ARRAY_LENGTH, std::out_of_range("Invalid array length"));
+        }
+#endif
+
+        resize(static_cast<size_t>(newSize));
+    }
+
+    void resize(size_t newSize) {
+        ensureCapacity(newSize);
+
+        // The new elements are already false, but the removed ones need to be cleared
+        if (newSize < count) {
+            fillBits(newSize, count, false);
+        }
+
+        count = newSize;
+    }
+
+    /**
+     * Ensures that the given number of elements can be pushed without growing the array again
+     * @param elementsCount the number of elements that are going to be pushed
+     */
+    inline void reservePush(int32_t elementsCount) {
+        if (elementsCount > 0) {
+            ensureCapacity(count + static_cast<size_t>(elementsCount), true);
+        }
+    }
+
+private:
+    /**
+     * Returns the number of words needed to store the given number of bits
+     */
+    static inline size_t wordsFor(size_t bits) {
+        return (bits + WORD_BITS - 1) >> WORD_SHIFT;
+    }
+
+    /**
+     * Returns a mask with the lowest bitCount bits set
+     */
+    static inline Word lowMask(size_t bitCount) {
+        return bitCount >= WORD_BITS ? ~Word { 0 } : (Word { 1 } << bitCount) - 1;
+    }
+
+    static inline Word reverseBits(Word word) {
+        word = ((word >> 1) & 0x55555555u) | ((word & 0x55555555u) << 1);
+        word = ((word >> 2) & 0x33333333u) | ((word & 0x33333333u) << 2);
+        word = ((word >> 4) & 0x0F0F0F0Fu) | ((word & 0x0F0F0F0Fu) << 4);
+        word = ((word >> 8) & 0x00FF00FFu) | ((word & 0x00FF00FFu) << 8);
+        return (word >> 16) | (word << 16);
+    }
+
+    /**
+     * Reads up to WORD_BITS bits starting at the given bit index
+     */
+    static inline Word extractBits(const Word* source, size_t index, size_t bitCount) {
+        const size_t offset = index & (WORD_BITS - 1);
+        const Word* word = &source[index >> WORD_SHIFT];
+        Word value = word[0] >> offset;
+
+        if (offset + bitCount > WORD_BITS) {
+            value |= word[1] << (WORD_BITS - offset);
+        }
+
+        return value & lowMask(bitCount);
+    }
+
+    /**
+     * Writes up to WORD_BITS bits starting at the given bit index, the other bits remain unchanged
+     */
+    static inline void depositBits(Word* destination, size_t index, Word value, size_t bitCount) {
+        const size_t offset = index & (WORD_BITS - 1);
+        const Word mask = lowMask(bitCount);
+        Word* word = &destination[index >> WORD_SHIFT];
+        value &= mask;
+
+        word[0] = (word[0] & ~(mask << offset)) | (value << offset);
+
+        if (offset + bitCount > WORD_BITS) {
+            const size_t shift = WORD_BITS - offset;
+            word[1] = (word[1] & ~(mask >> shift)) | (value >> shift);
+        }
+    }
+
+    /**
+     * Copies the bits in the range [sourceIndex, sourceIndex + bitCount) to the destination, a word at a time.
+     * The ranges are allowed to overlap if source and destination are the same words (memmove semantics).
+     */
+    static void copyBits(const Word* source, size_t sourceIndex, Word* destination, size_t destinationIndex, size_t bitCount) {
+        if (source == destination && destinationIndex > sourceIndex) {
+            // Copy back to front, otherwise the chunks not yet read are overridden
+            size_t remaining = bitCount;
+            while (remaining > 0) {
+                const size_t chunk = remaining < WORD_BITS ? remaining : WORD_BITS;
+                remaining -= chunk;
+                depositBits(destination, destinationIndex + remaining, extractBits(source, sourceIndex + remaining, chunk), chunk);
+            }
+        } else {
+            for (size_t copied = 0; copied < bitCount; copied += WORD_BITS) {
+                const size_t chunk = bitCount - copied < WORD_BITS ? bitCount - copied : WORD_BITS;
+                depositBits(destination, destinationIndex + copied, extractBits(source, sourceIndex + copied, chunk), chunk);
+            }
+        }
+    }
+
+    /**
+     * Sets the bits in the range [start, end) to the given value. The words in between are filled as a whole.
+     */
+    inline void fillBits(size_t start, size_t end, bool value) {
+        if (start >= end) {
+            return;
+        }
+
+        const Word pattern = value ? ~Word { 0 } : 0;
+        const size_t firstFullWord = wordsFor(start);
+        const size_t lastFullWord = end >> WORD_SHIFT;
+
+        if (firstFullWord > lastFullWord) {
+            // start and end are in the same word
+            depositBits(words, start, pattern, end - start);
+            return;
+        }
+
+        if (start < firstFullWord * WORD_BITS) {
+            depositBits(words, start, pattern, firstFullWord * WORD_BITS - start);
+        }
+
+        fillElements(&words[firstFullWord], &words[lastFullWord], pattern);
+
+        if (lastFullWord * WORD_BITS < end) {
+            depositBits(words, lastFullWord * WORD_BITS, pattern, end - lastFullWord * WORD_BITS);
+        }
+    }
+
+    /**
+     * Packs the given elements into the bits starting at the given index
+     */
+    inline void packElements(const bool* elements, size_t elementsCount, size_t index) {
+        for (size_t packed = 0; packed < elementsCount; packed += WORD_BITS) {
+            const size_t chunk = elementsCount - packed < WORD_BITS ? elementsCount - packed : WORD_BITS;
+            Word value = 0;
+
+            for (size_t i = 0; i < chunk; ++i) {
+                value |= static_cast<Word>(elements[packed + i]) << i;
+            }
+
+            depositBits(words, index + packed, value, chunk);
+        }
+    }
+
+    /**
+     * Ensures that the capacity of the array is at lest of the given number of bits
+     * @param min the minimal required capacity
+     * @param exact true if the capacity should be increased to exactly min instead of using the growth policy
+     */
+    void ensureCapacity(size_t min, bool exact = false) {
+        if (min <= capacity) {
+            return;
+        }
+
+        const size_t oldWordCount = capacity / WORD_BITS;
+        const size_t newWordCount = wordsFor(exact ? min : grownCapacity(capacity, min));
+        recordArrayGrowth();
+
+        if (usesInlineStorage()) {
+            Word* allocation = allocateWords(newWordCount);
+            std::copy(words, words + oldWordCount, allocation);
+            words = allocation;
+        } else {
+            words = allocateWords(newWordCount, words, oldWordCount);
+        }
+
+        // maintain the invariant that all bits after the length are zero
+        std::fill(words + oldWordCount, words + newWordCount, 0);
+        capacity = newWordCount * WORD_BITS;
+    }
+
+    /**
+     * (Re) Allocates the words array
+     * @param wordCount the number of words to allocate
+     * @param existing existing pointer to the words, in this case, a reallocate is performed
+     * @param oldWordCount the number of words of the existing allocation
+     * @returns the pointer to the allocated words
+     */
+    static inline Word* allocateWords(size_t wordCount, Word* existing = nullptr, size_t oldWordCount = 0)  __attribute__((returns_nonnull)) {
+        void* allocation = reallocateMemory(existing, oldWordCount * sizeof(Word), wordCount * sizeof(Word));
+        recordElementAllocation(wordCount * sizeof(Word));
+
+        if (allocation == nullptr) {
+            RAISE_RUNTIME_ERROR(RuntimeError::OUT_OF_MEMORY, std::bad_alloc {});
+        }
+
+        return static_cast<Word*>(allocation);
+    }
+};
+
+#endif //SPEEDYJS_RUNTIME_BOOL_ARRAY_H
@@ -1,33 +1,62 @@
 #include <cmath>
 #include <cstdint>
+#include <cstring>
 #include "macros.h"
 
-const long long TWO_TO_THE_POWER_OF_32 = 4294967296;
-const uint32_t TWO_TO_THE_POWER_OF_31 = 2147483648;
+const double TWO_TO_THE_POWER_OF_63 = 9223372036854775808.0;
+
+/**
+ * Computes value modulo 2^32 for the values that cannot be truncated to an int64_t (an absolute value of at least
+ * 2^63, NaN and +-Infinity). These values are integers and only the mantissa bits shifted into the lower 32 bits remain.
+ */
+static inline uint32_t wrapToUint32(double value) {
+    uint64_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+
+    const int32_t exponent = static_cast<int32_t>((bits >> 52) & 0x7ff) - 1075;
+
+    // The values >= 2^84 are multiples of 2^32. NaN and +-Infinity have the largest exponent and are converted to 0
+    if (exponent >= 32) {
+        return 0;
+    }
+
+    const uint64_t mantissa = (bits & ((1ULL << 52) - 1)) | (1ULL << 52);
+    const uint32_t magnitude = static_cast<uint32_t>(mantissa << exponent);
+    return bits >> 63 ? 0u - magnitude : magnitude;
+}
 
 extern "C" {
 
 /**
- * http://www.ecma-international.org/ecma-262/5.1/#sec-9.5
+ * http://www.ecma-international.org/ecma-262/5.1/#sec-9.6
+ * All doubles with an absolute value smaller than 2^63 are truncated by a single int64 conversion (that cannot trap)
+ * followed by a wrap to 32 bits. Only larger values, NaN and +-Infinity take the slow path.
  * @param the value to convert
- * @returns the double as int32_t
+ * @returns the double as uint32_t
  */
-DLL_PUBLIC ALWAYS_INLINE int32_t toInt32d(double value) {
+DLL_PUBLIC ALWAYS_INLINE uint32_t toUint32d(double value) {
 #ifdef SAFE
-    if (std::isnan(value) || std::isinf(value)) {
-        return 0;
+    if (std::fabs(value) < TWO_TO_THE_POWER_OF_63) {
+        return static_cast<uint32_t>(static_cast<int64_t>(value));
     }
 
-    int64_t posInt = static_cast<int64_t>(std::copysign(std::floor(std::abs(value)), value));
-    uint32_t int32bit = static_cast<uint32_t>(posInt - (TWO_TO_THE_POWER_OF_32 * (posInt/TWO_TO_THE_POWER_OF_32)));
+    return wrapToUint32(value);
+#else
+    return static_cast<uint32_t>(static_cast<int64_t>(value));
+#endif
+}
 
-    if (int32bit >= TWO_TO_THE_POWER_OF_31) {
-        return static_cast<int32_t>(int32bit - TWO_TO_THE_POWER_OF_32);
-    }
-    return int32bit;
+/**
+ * http://www.ecma-international.org/ecma-262/5.1/#sec-9.5
+ * @param the value to convert
+ * @returns the double as int32_t
+ */
+DLL_PUBLIC ALWAYS_INLINE int32_t toInt32d(double value) {
+#ifdef SAFE
+    return static_cast<int32_t>(toUint32d(value));
 #else
     return static_cast<int32_t>(value);
 #endif
 }
 
-}
\ No newline at end of file
+}
@@ -0,0 +1,21 @@
+//
+// Error code of the runtime, read by the loader after a trap.
+//
+
+#include "errors.h"
+
+RuntimeError runtimeError = RuntimeError::NONE;
+
+extern "C" {
+
+/**
+ * Returns the code of the error that caused the last trap and resets it
+ * @return the error code, 0 if no error has been raised
+ */
+DLL_PUBLIC int32_t speedyJsTakeError() {
+    const RuntimeError error = runtimeError;
+    runtimeError = RuntimeError::NONE;
+    return static_cast<int32_t>(error);
+}
+
+}
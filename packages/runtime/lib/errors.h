@@ -0,0 +1,49 @@
+//
+// Error channel of the runtime. The runtime is compiled without C++ exceptions, a failing operation records an error
+// code and traps. The loader reads the error code after the trap and throws the matching JavaScript error.
+//
+
+#ifndef SPEEDYJS_RUNTIME_ERRORS_H
+#define SPEEDYJS_RUNTIME_ERRORS_H
+
+#include <stdint.h>
+#include <new>
+#include <stdexcept>
+#include "macros.h"
+
+/**
+ * The error codes, need to match the codes in the loader (RUNTIME_ERRORS in get-wasm-module-function.ts)
+ */
+enum class RuntimeError : int32_t {
+    NONE = 0,
+    INVALID_ARRAY_INDEX = 1,
+    INVALID_ARRAY_LENGTH = 2,
+    OUT_OF_MEMORY = 3
+};
+
+/**
+ * The error raised by the last failing operation or NONE
+ */
+extern RuntimeError runtimeError;
+
+/**
+ * Records the error and aborts the execution of the current call.
+ */
+[[noreturn]] inline void raiseRuntimeError(RuntimeError error) {
+    runtimeError = error;
+    __builtin_trap();
+}
+
+/**
+ * Raises the error. Native builds with exceptions enabled (e.g. the unit tests) throw the corresponding C++ exception
+ * instead of trapping.
+ * @param error the runtime error code
+ * @param exception the exception thrown if exceptions are enabled
+ */
+#if defined(__cpp_exceptions) || defined(__EXCEPTIONS)
+#define RAISE_RUNTIME_ERROR(error, exception) throw exception
+#else
+#define RAISE_RUNTIME_ERROR(error, exception) raiseRuntimeError(error)
+#endif
+
+#endif //SPEEDYJS_RUNTIME_ERRORS_H
@@ -0,0 +1,108 @@
+#include <stdint.h>
+#include "macros.h"
+#include "hash-map.h"
+
+#ifndef SPEEDYJS_RUNTIME_HASH_MAP_API_H
+#define SPEEDYJS_RUNTIME_HASH_MAP_API_H
+
+// see RuntimeSystemNameMangler for the naming schema used, e.g. MapIid_seti for Map<int, number>.set(int, number)
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Defines the runtime entry points of the HashMap<K, V> class
+ * @param NAME the mangled class name, e.g. MapIid
+ * @param K the type of the keys
+ * @param KEY_CODE the type code of K, e.g. i
+ * @param V the type of the values
+ * @param VALUE_CODE the type code of V, e.g. d
+ */
+#define DEFINE_MAP_API(NAME, K, KEY_CODE, V, VALUE_CODE) \
+    DLL_PUBLIC ALWAYS_INLINE HashMap<K, V>* NAME##_constructor() { \
+        return new HashMap<K, V> {}; \
+    } \
+    \
+    DLL_PUBLIC ALWAYS_INLINE V NAME##_get##KEY_CODE(HashMap<K, V>& map, K key) { \
+        return map.get(key); \
+    } \
+    \
+    DLL_PUBLIC ALWAYS_INLINE HashMap<K, V>* NAME##_set##KEY_CODE##VALUE_CODE(HashMap<K, V>& map, K key, V value) { \
+        map.set(key, value); \
+        return &map; \
+    } \
+    \
+    DLL_PUBLIC ALWAYS_INLINE bool NAME##_has##KEY_CODE(HashMap<K, V>& map, K key) { \
+        return map.has(key); \
+    } \
+    \
+    DLL_PUBLIC ALWAYS_INLINE bool NAME##_delete##KEY_CODE(HashMap<K, V>& map, K key) { \
+        return map.remove(key); \
+    } \
+    \
+    DLL_PUBLIC ALWAYS_INLINE void NAME##_clear(HashMap<K, V>& map) { \
+        map.clear(); \
+    } \
+    \
+    DLL_PUBLIC ALWAYS_INLINE int32_t NAME##_size(const HashMap<K, V>& map) { \
+        return map.size(); \
+    }
+
+/**
+ * Defines the runtime entry points of the HashSet<K> class
+ * @param NAME the mangled class name, e.g. SetIi
+ * @param K the type of the values
+ * @param KEY_CODE the type code of K, e.g. i
+ */
+#define DEFINE_SET_API(NAME, K, KEY_CODE) \
+    DLL_PUBLIC ALWAYS_INLINE HashSet<K>* NAME##_constructor() { \
+        return new HashSet<K> {}; \
+    } \
+    \
+    DLL_PUBLIC ALWAYS_INLINE HashSet<K>* NAME##_add##KEY_CODE(HashSet<K>& set, K key) { \
+        set.add(key); \
+        return &set; \
+    } \
+    \
+    DLL_PUBLIC ALWAYS_INLINE bool NAME##_has##KEY_CODE(HashSet<K>& set, K key) { \
+        return set.has(key); \
+    } \
+    \
+    DLL_PUBLIC ALWAYS_INLINE bool NAME##_delete##KEY_CODE(HashSet<K>& set, K key) { \
+        return set.remove(key); \
+    } \
+    \
+    DLL_PUBLIC ALWAYS_INLINE void NAME##_clear(HashSet<K>& set) { \
+        set.clear(); \
+    } \
+    \
+    DLL_PUBLIC ALWAYS_INLINE int32_t NAME##_size(const HashSet<K>& set) { \
+        return set.size(); \
+    }
+
+//---------------------------------------------------------------------------------
+// Map<K, V>
+//---------------------------------------------------------------------------------
+
+DEFINE_MAP_API(MapIib, int32_t, i, bool, b)
+DEFINE_MAP_API(MapIii, int32_t, i, int32_t, i)
+DEFINE_MAP_API(MapIid, int32_t, i, double, d)
+DEFINE_MAP_API(MapIiPv, int32_t, i, void*, Pv)
+DEFINE_MAP_API(MapIdb, double, d, bool, b)
+DEFINE_MAP_API(MapIdi, double, d, int32_t, i)
+DEFINE_MAP_API(MapIdd, double, d, double, d)
+DEFINE_MAP_API(MapIdPv, double, d, void*, Pv)
+
+//---------------------------------------------------------------------------------
+// Set<K>
+//---------------------------------------------------------------------------------
+
+DEFINE_SET_API(SetIi, int32_t, i)
+DEFINE_SET_API(SetId, double, d)
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //SPEEDYJS_RUNTIME_HASH_MAP_API_H
@@ -0,0 +1,453 @@
+//
+// Open addressing hash map and set for int and number keys (the JS Map and Set).
+//
+
+#ifndef SPEEDYJS_RUNTIME_HASH_MAP_H
+#define SPEEDYJS_RUNTIME_HASH_MAP_H
+
+#include <stdexcept>
+#include <stdint.h>
+#include <cstring>
+#include <new>
+#include "macros.h"
+#include "errors.h"
+#include "allocator.h"
+#include "instrumentation.h"
+#include "pool.h"
+
+/**
+ * The hash of a removed entry. The hash of a key is never zero, see HashKey.
+ */
+const uint32_t REMOVED_ENTRY_HASH = 0;
+
+/**
+ * The values of an index slot that does not reference an entry
+ */
+const int32_t EMPTY_SLOT = -1;
+const int32_t REMOVED_SLOT = -2;
+
+/**
+ * The number of index slots of the smallest index
+ */
+const size_t MIN_HASH_SLOTS = 16;
+
+/**
+ * Hashing and comparison of the keys. Keys are compared using SameValueZero (NaN equals NaN, -0 equals +0).
+ * @tparam K the type of the keys
+ */
+template<typename K>
+struct HashKey;
+
+template<>
+struct HashKey<int32_t> {
+    static inline int32_t normalize(int32_t key) {
+        return key;
+    }
+
+    static inline uint32_t hash(int32_t key) {
+        return mix(static_cast<uint32_t>(key));
+    }
+
+    static inline bool equals(int32_t first, int32_t second) {
+        return first == second;
+    }
+
+    /**
+     * Fibonacci hashing followed by folding the high bits into the low bits that are used to compute the slot
+     */
+    static inline uint32_t mix(uint32_t value) {
+        uint32_t hash = value * 2654435769u;
+        hash ^= hash >> 16;
+        return hash == REMOVED_ENTRY_HASH ? 1 : hash;
+    }
+};
+
+template<>
+struct HashKey<double> {
+    static inline double normalize(double key) {
+        // -0 is stored as +0 (as in JS)
+        return key == 0.0 ? 0.0 : key;
+    }
+
+    static inline uint32_t hash(double key) {
+        if (key != key) {
+            return HashKey<int32_t>::mix(0x7ff80000u);
+        }
+
+        uint64_t bits;
+        const double normalized = normalize(key);
+        std::memcpy(&bits, &normalized, sizeof(double));
+        return HashKey<int32_t>::mix(static_cast<uint32_t>(bits ^ (bits >> 32)));
+    }
+
+    static inline bool equals(double first, double second) {
+        return first == second || (first != first && second != second);
+    }
+};
+
+template<typename K, typename V>
+struct HashMapEntry {
+    uint32_t hash;
+    K key;
+    V value;
+};
+
+template<typename K>
+struct HashSetEntry {
+    uint32_t hash;
+    K key;
+};
+
+/**
+ * Hash table shared by HashMap and HashSet. The entries are stored in insertion order in a dense array (the iteration
+ * order of JS Maps and Sets). The index is an open addressing table with linear probing whose slots store the position
+ * of the entry. A lookup therefore probes a few contiguous ints and compares the key of a single entry in the common case.
+ *
+ * Removing an entry marks the entry and the slot as removed, the removed entries are compacted when the entries grow.
+ *
+ * The loader creates the tables passed from JS without an index (slots is the nullptr): it stores the entries only and
+ * the index is built (and the hashes computed) by the first operation.
+ * @tparam K the type of the keys (int32_t or double)
+ * @tparam Entry the type of the entries
+ */
+template<typename K, typename Entry>
+class HashTable {
+protected:
+    /**
+     * The entries, entriesCapacity elements of which entriesCount are used (including the removed entries)
+     */
+    Entry* entries;
+
+    /**
+     * The index of slotMask + 1 slots or the nullptr if the index has not yet been built
+     */
+    int32_t* slots;
+
+    uint32_t entriesCount;
+    uint32_t entriesCapacity;
+
+    /**
+     * The number of entries that are not removed
+     */
+    uint32_t count;
+
+    uint32_t slotMask;
+
+public:
+    HashTable() : entries { nullptr }, slots { nullptr }, entriesCount { 0 }, entriesCapacity { 0 }, count { 0 }, slotMask { 0 } {
+    }
+
+    HashTable(const HashTable&) = delete;
+    HashTable& operator=(const HashTable&) = delete;
+
+    ~HashTable() {
+        if (entries != nullptr) {
+            freeMemory(entries, entriesCapacity * sizeof(Entry));
+        }
+
+        if (slots != nullptr) {
+            freeMemory(slots, slotCount() * sizeof(int32_t));
+        }
+    }
+
+    /**
+     * Allocates the objects from the pool as all objects have the same size
+     */
+    static inline void* operator new(size_t size) {
+        void* allocation = runtimePool.allocate(size);
+
+        if (allocation == nullptr) {
+            RAISE_RUNTIME_ERROR(RuntimeError::OUT_OF_MEMORY, std::bad_alloc {});
+        }
+
+        return allocation;
+    }
+
+    static inline void operator delete(void* allocation, size_t size) {
+        runtimePool.release(allocation, size);
+    }
+
+    /**
+     * Tests if the table contains an entry for the given key
+     */
+    inline bool has(K key) {
+        return find(key) != nullptr;
+    }
+
+    /**
+     * Removes the entry with the given key
+     * @return true if an entry has been removed, false if there is no entry with the given key
+     */
+    bool remove(K key) {
+        const int32_t slot = findSlot(key);
+
+        if (slot < 0) {
+            return false;
+        }
+
+        Entry& entry = entries[slots[slot]];
+        entry.hash = REMOVED_ENTRY_HASH;
+        slots[slot] = REMOVED_SLOT;
+        --count;
+        return true;
+    }
+
+    /**
+     * Removes all entries, retains the allocated capacity
+     */
+    void clear() {
+        entriesCount = 0;
+        count = 0;
+
+        if (slots != nullptr) {
+            std::memset(slots, 0xff, slotCount() * sizeof(int32_t));
+        }
+    }
+
+    /**
+     * Calls the callback for every entry in insertion order
+     */
+    template<typename Callback>
+    void forEach(Callback callback) const {
+        for (uint32_t i = 0; i < entriesCount; ++i) {
+            if (entries[i].hash != REMOVED_ENTRY_HASH) {
+                callback(entries[i]);
+            }
+        }
+    }
+
+    /**
+     * Returns the number of entries
+     */
+    inline int32_t size() const {
+        return static_cast<int32_t>(count);
+    }
+
+protected:
+    /**
+     * Returns the entry with the given key or the nullptr
+     */
+    inline Entry* find(K key) {
+        const int32_t slot = findSlot(key);
+        return slot < 0 ? nullptr : &entries[slots[slot]];
+    }
+
+    /**
+     * Returns the entry with the given key. Appends a new entry if the table has no entry for the key,
+     * only the hash and the key of the new entry are initialized.
+     * @param key the key
+     * @param added set to true if the entry has been added
+     */
+    Entry& findOrAdd(K key, bool& added) {
+        ensureIndex();
+        key = HashKey<K>::normalize(key);
+        const uint32_t hash = HashKey<K>::hash(key);
+
+        if (slots != nullptr) {
+            int32_t removedSlot = -1;
+            for (uint32_t slot = hash & slotMask;; slot = (slot + 1) & slotMask) {
+                const int32_t position = slots[slot];
+
+                if (position == EMPTY_SLOT) {
+                    break;
+                }
+
+                if (position == REMOVED_SLOT) {
+                    if (removedSlot < 0) {
+                        removedSlot = static_cast<int32_t>(slot);
+                    }
+                } else if (entries[position].hash == hash && HashKey<K>::equals(entries[position].key, key)) {
+                    added = false;
+                    return entries[position];
+                }
+            }
+
+            // reuse a removed slot if the entries do not need to grow (growing rebuilds the index)
+            if (removedSlot >= 0 && entriesCount < entriesCapacity) {
+                return append(static_cast<uint32_t>(removedSlot), hash, key, added);
+            }
+        }
+
+        if (entriesCount == entriesCapacity) {
+            // compact the entries if half or more of them are removed, otherwise double the capacity
+            rebuild(count * 2 < entriesCount ? entriesCapacity : entriesCapacity * 2);
+        }
+
+        return append(emptySlotFor(hash), hash, key, added);
+    }
+
+private:
+    inline size_t slotCount() const {
+        return slots == nullptr ? 0 : static_cast<size_t>(slotMask) + 1;
+    }
+
+    /**
+     * Returns the index of the slot referencing the entry with the given key or -1
+     */
+    inline int32_t findSlot(K key) {
+        ensureIndex();
+
+        if (count == 0) {
+            return -1;
+        }
+
+        const uint32_t hash = HashKey<K>::hash(key);
+        for (uint32_t slot = hash & slotMask;; slot = (slot + 1) & slotMask) {
+            const int32_t position = slots[slot];
+
+            if (position == EMPTY_SLOT) {
+                return -1;
+            }
+
+            if (position != REMOVED_SLOT && entries[position].hash == hash && HashKey<K>::equals(entries[position].key, key)) {
+                return static_cast<int32_t>(slot);
+            }
+        }
+    }
+
+    /**
+     * Builds the index of a table allocated by the loader
+     */
+    inline void ensureIndex() {
+        if (slots == nullptr && entriesCount > 0) {
+            for (uint32_t i = 0; i < entriesCount; ++i) {
+                entries[i].hash = HashKey<K>::hash(entries[i].key);
+            }
+
+            rebuild(entriesCapacity);
+        }
+    }
+
+    inline Entry& append(uint32_t slot, uint32_t hash, K key, bool& added) {
+        const uint32_t position = entriesCount++;
+        Entry& entry = entries[position];
+        entry.hash = hash;
+        entry.key = key;
+        slots[slot] = static_cast<int32_t>(position);
+        ++count;
+        added = true;
+        return entry;
+    }
+
+    /**
+     * Returns the first empty or removed slot for the hash. The index must not contain the key.
+     */
+    inline uint32_t emptySlotFor(uint32_t hash) const {
+        uint32_t slot = hash & slotMask;
+        while (slots[slot] >= 0) {
+            slot = (slot + 1) & slotMask;
+        }
+
+        return slot;
+    }
+
+    /**
+     * Compacts the entries and rebuilds the index for the given number of entries. The index has at least 4 / 3 times
+     * as many slots as entries so that the probe sequences remain short and always reach an empty slot.
+     * @param minCapacity the minimal capacity of the entries
+     */
+    void rebuild(uint32_t minCapacity) {
+        size_t newSlotCount = MIN_HASH_SLOTS;
+        while (newSlotCount / 4 * 3 < minCapacity) {
+            if (newSlotCount > static_cast<size_t>(INT32_MAX / 2)) {
+                RAISE_RUNTIME_ERROR(RuntimeError::OUT_OF_MEMORY, std::bad_alloc {});
+            }
+
+            newSlotCount *= 2;
+        }
+
+        const size_t newCapacity = newSlotCount / 4 * 3;
+
+        // compact the entries, retains the insertion order
+        uint32_t live = 0;
+        for (uint32_t i = 0; i < entriesCount; ++i) {
+            if (entries[i].hash != REMOVED_ENTRY_HASH) {
+                entries[live++] = entries[i];
+            }
+        }
+
+        if (newCapacity != entriesCapacity) {
+            if (entries != nullptr) {
+                recordArrayGrowth();
+            }
+
+            void* allocation = reallocateMemory(entries, entriesCapacity * sizeof(Entry), newCapacity * sizeof(Entry));
+            recordElementAllocation(newCapacity * sizeof(Entry));
+
+            if (allocation == nullptr) {
+                RAISE_RUNTIME_ERROR(RuntimeError::OUT_OF_MEMORY, std::bad_alloc {});
+            }
+
+            entries = static_cast<Entry*>(allocation);
+            entriesCapacity = static_cast<uint32_t>(newCapacity);
+        }
+
+        if (newSlotCount != slotCount()) {
+            if (slots != nullptr) {
+                freeMemory(slots, slotCount() * sizeof(int32_t));
+            }
+
+            slots = static_cast<int32_t*>(allocateMemory(newSlotCount * sizeof(int32_t)));
+
+            if (slots == nullptr) {
+                RAISE_RUNTIME_ERROR(RuntimeError::OUT_OF_MEMORY, std::bad_alloc {});
+            }
+
+            slotMask = static_cast<uint32_t>(newSlotCount - 1);
+        }
+
+        std::memset(slots, 0xff, newSlotCount * sizeof(int32_t));
+
+        entriesCount = live;
+        count = live;
+        for (uint32_t i = 0; i < live; ++i) {
+            slots[emptySlotFor(entries[i].hash)] = static_cast<int32_t>(i);
+        }
+    }
+};
+
+/**
+ * Implementation of the JS Map for int and number keys. Unlike Map.get, get returns the default value of V for
+ * absent keys (as Array.get does for out of bound indices), use has to distinguish absent keys.
+ * @tparam K the type of the keys
+ * @tparam V the type of the values
+ */
+template<typename K, typename V>
+class HashMap : public HashTable<K, HashMapEntry<K, V>> {
+public:
+    /**
+     * Returns the value of the entry with the given key or the default value of V if there is no such entry
+     */
+    inline V get(K key) {
+        auto entry = this->find(key);
+        return entry == nullptr ? V {} : entry->value;
+    }
+
+    /**
+     * Sets the value of the entry with the given key, adds an entry if the map has no entry for the key
+     */
+    inline void set(K key, V value) {
+        bool added;
+        this->findOrAdd(key, added).value = value;
+    }
+};
+
+/**
+ * Implementation of the JS Set for int and number values
+ * @tparam K the type of the values
+ */
+template<typename K>
+class HashSet : public HashTable<K, HashSetEntry<K>> {
+public:
+    /**
+     * Adds the value to the set if the set does not yet contain it
+     * @return true if the value has been added
+     */
+    inline bool add(K key) {
+        bool added;
+        this->findOrAdd(key, added);
+        return added;
+    }
+};
+
+#endif //SPEEDYJS_RUNTIME_HASH_MAP_H
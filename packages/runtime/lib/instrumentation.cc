@@ -0,0 +1,56 @@
+//
+// Counters and histograms of the instrumented runtime variants, read by the loader.
+//
+
+#include <cstring>
+#include "instrumentation.h"
+
+RuntimeStatistics runtimeStatistics {};
+
+#ifdef INSTRUMENTED
+
+/**
+ * The number of words of the statistics snapshot
+ */
+const size_t STATISTICS_WORDS = 9 + 2 * HISTOGRAM_BUCKETS;
+
+static inline void storeUint64(uint32_t* words, uint64_t value) {
+    words[0] = static_cast<uint32_t>(value);
+    words[1] = static_cast<uint32_t>(value >> 32);
+}
+
+extern "C" {
+
+/**
+ * Returns a pointer to a snapshot of the runtime statistics. The first word is the number of histogram buckets followed
+ * by the element allocations, the array growths, the allocated element bytes (low and high word), the gc calls, the
+ * released allocations, the released bytes (low and high word), the buckets of the element allocation sizes and the
+ * buckets of the released allocations per gc call. The snapshot is overridden by the next call to this function.
+ * @return pointer to the snapshot
+ */
+DLL_PUBLIC uint32_t* speedyJsRuntimeStatistics() {
+    static uint32_t snapshot[STATISTICS_WORDS];
+
+    snapshot[0] = HISTOGRAM_BUCKETS;
+    snapshot[1] = runtimeStatistics.elementAllocations;
+    snapshot[2] = runtimeStatistics.arrayGrowths;
+    storeUint64(snapshot + 3, runtimeStatistics.allocatedElementBytes);
+    snapshot[5] = runtimeStatistics.gcCalls;
+    snapshot[6] = runtimeStatistics.gcReleasedAllocations;
+    storeUint64(snapshot + 7, runtimeStatistics.gcReleasedBytes);
+    std::memcpy(snapshot + 9, runtimeStatistics.elementAllocationSizes.buckets, sizeof(Histogram::buckets));
+    std::memcpy(snapshot + 9 + HISTOGRAM_BUCKETS, runtimeStatistics.gcReleasedAllocationsPerCall.buckets, sizeof(Histogram::buckets));
+
+    return snapshot;
+}
+
+/**
+ * Resets all counters and histograms of the runtime statistics
+ */
+DLL_PUBLIC void speedyJsResetRuntimeStatistics() {
+    runtimeStatistics = RuntimeStatistics {};
+}
+
+}
+
+#endif
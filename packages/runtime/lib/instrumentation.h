@@ -0,0 +1,127 @@
+//
+// Counters and histograms of the instrumented runtime variants (built with INSTRUMENTED). The other variants compile
+// the record functions to nothing.
+//
+
+#ifndef SPEEDYJS_RUNTIME_INSTRUMENTATION_H
+#define SPEEDYJS_RUNTIME_INSTRUMENTATION_H
+
+#include <cstddef>
+#include <stdint.h>
+#include "macros.h"
+
+/**
+ * The number of buckets of a histogram
+ */
+const size_t HISTOGRAM_BUCKETS = 32;
+
+/**
+ * Histogram with power of two buckets. The bucket 0 counts the zero values and the bucket i the values in the range
+ * [2^(i-1), 2^i). The last bucket also counts all larger values.
+ */
+struct Histogram {
+    uint32_t buckets[HISTOGRAM_BUCKETS];
+
+    inline void record(size_t value) {
+        ++buckets[bucketOf(value)];
+    }
+
+    static inline size_t bucketOf(size_t value) {
+        if (value == 0) {
+            return 0;
+        }
+
+        const size_t bucket = 64 - static_cast<size_t>(__builtin_clzll(static_cast<unsigned long long>(value)));
+        return bucket < HISTOGRAM_BUCKETS ? bucket : HISTOGRAM_BUCKETS - 1;
+    }
+};
+
+/**
+ * The statistics collected by the instrumented runtime. Constant initialized and without destructor like the other
+ * globals of the runtime.
+ */
+struct RuntimeStatistics {
+    /**
+     * The number of allocations of array storage (including the bit words of boolean arrays)
+     */
+    uint32_t elementAllocations;
+
+    /**
+     * The number of times ensureCapacity grew the storage of an array
+     */
+    uint32_t arrayGrowths;
+
+    /**
+     * The total number of bytes requested for array storage
+     */
+    uint64_t allocatedElementBytes;
+
+    /**
+     * The number of calls to speedyJsGc
+     */
+    uint32_t gcCalls;
+
+    /**
+     * The total number of allocations freed by speedyJsGc (always zero for the arena variants that reset at once)
+     */
+    uint32_t gcReleasedAllocations;
+
+    /**
+     * The total number of bytes released by speedyJsGc (the reserved bytes of the arena for the arena variants)
+     */
+    uint64_t gcReleasedBytes;
+
+    /**
+     * The sizes in bytes of the array storage allocations
+     */
+    Histogram elementAllocationSizes;
+
+    /**
+     * The number of allocations freed by a single call to speedyJsGc
+     */
+    Histogram gcReleasedAllocationsPerCall;
+};
+
+extern RuntimeStatistics runtimeStatistics;
+
+/**
+ * Records the (re) allocation of the storage of an array
+ * @param bytes the size of the storage in bytes
+ */
+ALWAYS_INLINE inline void recordElementAllocation(size_t bytes) {
+#ifdef INSTRUMENTED
+    ++runtimeStatistics.elementAllocations;
+    runtimeStatistics.allocatedElementBytes += bytes;
+    runtimeStatistics.elementAllocationSizes.record(bytes);
+#else
+    (void) bytes;
+#endif
+}
+
+/**
+ * Records that ensureCapacity grew the storage of an array
+ */
+ALWAYS_INLINE inline void recordArrayGrowth() {
+#ifdef INSTRUMENTED
+    ++runtimeStatistics.arrayGrowths;
+#endif
+}
+
+/**
+ * Records a call to speedyJsGc
+ * @param releasedAllocations the number of allocations freed by the gc
+ * @param releasedBytes the number of bytes released by the gc
+ */
+ALWAYS_INLINE inline void recordGc(size_t releasedAllocations, size_t releasedBytes) {
+#ifdef INSTRUMENTED
+    ++runtimeStatistics.gcCalls;
+    runtimeStatistics.gcReleasedAllocations += static_cast<uint32_t>(releasedAllocations);
+    runtimeStatistics.gcReleasedBytes += releasedBytes;
+    runtimeStatistics.gcReleasedAllocationsPerCall.record(releasedAllocations);
+#else
+    (void) releasedAllocations;
+    (void) releasedBytes;
+#endif
+}
+
+#endif //SPEEDYJS_RUNTIME_INSTRUMENTATION_H
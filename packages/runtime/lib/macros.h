@@ -40,8 +40,16 @@
 #endif
 #endif
 
+/**
+ * Forces the inlining of the runtime functions into the compiled program. Only the wasm builds force the inlining, the
+ * native test and benchmark builds call the exported functions (that are not declared inline) and gcc warns about them.
+ */
 #ifndef ALWAYS_INLINE
+#ifdef __EMSCRIPTEN__
 #define ALWAYS_INLINE __attribute__((always_inline))
+#else
+#define ALWAYS_INLINE
+#endif
 #endif
 
 #endif //SPEEDYJS_RUNTIME_MACROS_H
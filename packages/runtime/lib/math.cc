@@ -2,6 +2,8 @@
 #include <cstdint>
 #include <algorithm>
 #include "macros.h"
+#include "native-math.h"
+#include "simd.h"
 
 extern "C" {
 
@@ -18,7 +20,11 @@ ALWAYS_INLINE DLL_PUBLIC double Math_PI(__attribute__((unused)) void* math) {
 }
 
 ALWAYS_INLINE DLL_PUBLIC double Math_powdd(__attribute__((unused)) void* math, double base, double power) {
-    return std::pow(base, power);
+    return nativePow(base, power);
+}
+
+ALWAYS_INLINE DLL_PUBLIC double Math_expd(__attribute__((unused)) void* math, double value) {
+    return std::exp(value);
 }
 
 ALWAYS_INLINE DLL_PUBLIC double Math_sqrtd(__attribute__((unused)) void* math, double value) {
@@ -38,22 +44,28 @@ ALWAYS_INLINE DLL_PUBLIC double_t Math_logd(__attribute__((unused)) void* math,
 }
 
 ALWAYS_INLINE DLL_PUBLIC double Math_maxPdu(__attribute__((unused)) void* math, double* values, size_t valueCount) {
-    double max = -INFINITY;
+    return maxElement(values, valueCount);
+}
 
-    for (size_t i = 0; i < valueCount; ++i) {
-        max = std::max(values[i], max);
-    }
+ALWAYS_INLINE DLL_PUBLIC int32_t Math_maxPiu(__attribute__((unused)) void* math, int32_t* values, size_t valueCount) {
+    return maxElement(values, valueCount);
+}
 
-    return max;
+ALWAYS_INLINE DLL_PUBLIC double Math_minPdu(__attribute__((unused)) void* math, double* values, size_t valueCount) {
+    return minElement(values, valueCount);
 }
 
-ALWAYS_INLINE DLL_PUBLIC int32_t Math_maxPiu(__attribute__((unused)) void* math, int32_t* values, size_t valueCount) {
-    int32_t max = -2147483648;
+ALWAYS_INLINE DLL_PUBLIC int32_t Math_minPiu(__attribute__((unused)) void* math, int32_t* values, size_t valueCount) {
+    return minElement(values, valueCount);
+}
 
-    for (size_t i = 0; i < valueCount; ++i) {
-        max = std::max(values[i], max);
-    }
+// The libc linked into the wasm module does not define pow and fmod, the calls emitted by the backend for llvm.pow
+// and frem (% on numbers) would otherwise be imported from JavaScript
+DLL_PUBLIC double pow(double base, double exponent) {
+    return nativePow(base, exponent);
+}
 
-    return max;
+DLL_PUBLIC double fmod(double x, double y) {
+    return nativeFmod(x, y);
 }
 }
@@ -6,25 +6,126 @@
 #include <array>
 #include <cassert>
 #include "macros.h"
+#include "allocator.h"
+#include "pool.h"
+#include "pinned.h"
+#include "instrumentation.h"
 
 struct CollectedPointers {
     std::array<void*, 10000> pointers;
     size_t count;
+    size_t bytes;
 
-    CollectedPointers() : pointers {}, count {}
+    CollectedPointers() : pointers {}, count {}, bytes {}
     {}
 };
 
 extern "C" {
 
+/**
+ * Allocates the memory for an object on the runtime heap. Used by the compiled code to allocate class instances and by
+ * the loader to allocate the marshalled objects and arrays.
+ * @param size the size in bytes
+ * @return pointer to the allocated memory
+ */
+DLL_PUBLIC ALWAYS_INLINE void* speedyJsMalloc(size_t size) {
+    return allocateMemory(size);
+}
+
+/**
+ * Allocates an object with a size that is known at compile time (e.g. a class instance or an array object) from the pool.
+ * @param size the size of the object in bytes
+ * @return pointer to the allocated memory
+ */
+DLL_PUBLIC ALWAYS_INLINE void* speedyJsAllocateObject(size_t size) {
+    return runtimePool.allocate(size);
+}
+
+/**
+ * Creates a scope for the allocations of a value retained by the loader across calls
+ * @return the identifier of the scope
+ */
+DLL_PUBLIC uint32_t speedyJsCreateRetainScope() {
+    return runtimePinnedAllocations.createScope();
+}
+
+/**
+ * Allocates memory that survives the gc for a value retained by the loader. Arrays allocated with this function need to
+ * be marked as pinned so that their storage is reallocated in the same scope when they grow.
+ * @param size the size in bytes
+ * @param scope the scope of the retained value
+ * @return pointer to the allocated memory or the nullptr if the allocation failed
+ */
+DLL_PUBLIC void* speedyJsAllocateRetained(size_t size, uint32_t scope) {
+    return runtimePinnedAllocations.allocate(size, scope);
+}
+
+/**
+ * Releases all allocations of a retained value
+ * @param scope the scope of the retained value
+ */
+DLL_PUBLIC void speedyJsReleaseRetainScope(uint32_t scope) {
+    runtimePinnedAllocations.releaseScope(scope);
+}
+
+/**
+ * Returns a pointer to the statistics of the pool allocator. The first value is the number of size classes followed by
+ * the size, the hits and the misses of each size class. The statistics are overridden by the next call to this function.
+ * @return pointer to the statistics
+ */
+DLL_PUBLIC uint32_t* speedyJsPoolStatistics() {
+    static uint32_t statistics[1 + 3 * POOL_SIZE_CLASSES];
+
+    statistics[0] = POOL_SIZE_CLASSES;
+    for (size_t i = 0; i < POOL_SIZE_CLASSES; ++i) {
+        statistics[1 + 3 * i] = static_cast<uint32_t>(Pool::sizeClassSize(i));
+        statistics[2 + 3 * i] = runtimePool.hits(i);
+        statistics[3 + 3 * i] = runtimePool.misses(i);
+    }
+
+    return statistics;
+}
+
+/**
+ * Resets the hit and miss counters of the pool allocator
+ */
+DLL_PUBLIC void speedyJsResetPoolStatistics() {
+    runtimePool.resetStatistics();
+}
+
+#ifdef ARENA
+
+/**
+ * Resets the arena and by this, releases all allocations at once (including the slabs of the pool).
+ */
+DLL_PUBLIC ALWAYS_INLINE void speedyJsGc() {
+    recordGc(0, runtimeArena.reservedBytes());
+    runtimePool.reset();
+    runtimeArena.reset();
+}
+
+/**
+ * Freezes the heap, the objects allocated so far survive all later gc calls. Used by the compiler to create the heap
+ * snapshot after the snapshot functions have been executed.
+ * @return true if the heap has been frozen
+ */
+DLL_PUBLIC bool speedyJsFreezeHeap() {
+    runtimeArena.freeze();
+    return true;
+}
+
+#else
+
 extern void malloc_inspect_all(void(*handler)(void*, void *, size_t, void*), void* arg);
 extern size_t bulk_free(void**, size_t n_elements);
 
 ALWAYS_INLINE void collectPointers(void* start, void*, size_t used_bytes, void* callback_arg) {
     auto collectedPointers = static_cast<CollectedPointers*>(callback_arg);
 
-    if (used_bytes > 0 && collectedPointers->count < collectedPointers->pointers.size()) {
+    // Pinned allocations (the arrays allocated and the values retained by the loader) survive the gc
+    if (used_bytes > 0 && collectedPointers->count < collectedPointers->pointers.size() && !runtimePinnedAllocations.survivesGc(start)) {
         collectedPointers->pointers[collectedPointers->count++] = start;
+        collectedPointers->bytes += used_bytes;
     }
 }
 
@@ -33,16 +134,49 @@ ALWAYS_INLINE void collectPointers(void* start, void*, size_t used_bytes, void*
  * The helper struct is used as we should not use any heap allocation in this method (otherwise we nuke our own data!)
  */
 DLL_PUBLIC ALWAYS_INLINE void speedyJsGc() {
+    // The slabs of the pool are released too
+    runtimePool.reset();
+
     CollectedPointers collectedPointers {};
+    size_t releasedAllocations = 0;
     do {
         collectedPointers.count = 0;
 
         malloc_inspect_all(collectPointers, &collectedPointers);
         auto released = bulk_free(collectedPointers.pointers.data(), collectedPointers.count);
         assert(released == 0 && "Not all pointers freed by bulk_free");
+        releasedAllocations += collectedPointers.count;
     } while (collectedPointers.count >= collectedPointers.pointers.size());
+
+    recordGc(releasedAllocations, collectedPointers.bytes);
+}
+
+/**
+ * Freezes the heap by pinning all live allocations, the objects allocated so far survive all later gc calls. Used by
+ * the compiler to create the heap snapshot after the snapshot functions have been executed.
+ * @return true if the heap has been frozen, false if the table of the pinned allocations could not be grown
+ */
+DLL_PUBLIC bool speedyJsFreezeHeap() {
+    const uint32_t scope = runtimePinnedAllocations.createScope();
+    CollectedPointers collectedPointers {};
+
+    // Pinning may grow the table and is therefore done after the inspection, the heap is inspected until all allocations are pinned
+    do {
+        collectedPointers.count = 0;
+        malloc_inspect_all(collectPointers, &collectedPointers);
+
+        for (size_t i = 0; i < collectedPointers.count; ++i) {
+            if (!runtimePinnedAllocations.adopt(collectedPointers.pointers[i], scope)) {
+                return false;
+            }
+        }
+    } while (collectedPointers.count > 0);
+
+    return true;
 }
 
+#endif
+
 // Probably malloc can be overriden and use emscripten_builtin_malloc to have a custom malloc version
 // extern __typeof(malloc) emscripten_builtin_malloc __attribute__((weak, alias("malloc")));
 // extern __typeof(free) emscripten_builtin_free __attribute__((weak, alias("free")));
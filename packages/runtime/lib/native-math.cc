@@ -0,0 +1,419 @@
+//
+// Native implementations of the math functions that the libc linked into the wasm modules does not provide (pow and
+// fmod). powReal is a port of __ieee754_pow of fdlibm (the algorithm is also used by V8 for Math.pow):
+//
+// Copyright (C) 2004 by Sun Microsystems, Inc. All rights reserved.
+//
+// Permission to use, copy, modify, and distribute this software is freely granted, provided that this notice
+// is preserved.
+//
+
+#include <cstring>
+#include <limits>
+#include "native-math.h"
+
+static inline uint64_t toBits(double value) {
+    uint64_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    return bits;
+}
+
+static inline double fromBits(uint64_t bits) {
+    double value;
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+static inline int32_t highWord(double value) {
+    return static_cast<int32_t>(toBits(value) >> 32);
+}
+
+static inline uint32_t lowWord(double value) {
+    return static_cast<uint32_t>(toBits(value));
+}
+
+static inline double withHighWord(double value, int32_t high) {
+    return fromBits((static_cast<uint64_t>(static_cast<uint32_t>(high)) << 32) | lowWord(value));
+}
+
+static inline double withoutLowWord(double value) {
+    return fromBits(toBits(value) & 0xffffffff00000000ULL);
+}
+
+/**
+ * Computes value * 2^exponent
+ */
+static double scaleByPowerOfTwo(double value, int32_t exponent) {
+    if (exponent > 1023) {
+        value *= fromBits(static_cast<uint64_t>(0x3ff + 1023) << 52);
+        exponent -= 1023;
+        if (exponent > 1023) {
+            exponent = 1023;
+        }
+    } else if (exponent < -1022) {
+        // scale by 2^-969 (2^-1022 * 2^53) to avoid double rounding in the subnormal range
+        value *= fromBits(static_cast<uint64_t>(0x3ff - 1022 + 53) << 52);
+        exponent += 1022 - 53;
+        if (exponent < -1022) {
+            value *= fromBits(static_cast<uint64_t>(0x3ff - 1022 + 53) << 52);
+            exponent += 1022 - 53;
+            if (exponent < -1022) {
+                exponent = -1022;
+            }
+        }
+    }
+
+    return value * fromBits(static_cast<uint64_t>(0x3ff + exponent) << 52);
+}
+
+static const double bp[] = { 1.0, 1.5 };
+static const double dp_h[] = { 0.0, 5.84962487220764160156e-01 };   /* 0x3FE2B803, 0x40000000 */
+static const double dp_l[] = { 0.0, 1.35003920212974897128e-08 };   /* 0x3E4CFDEB, 0x43CFD006 */
+static const double two53 = 9007199254740992.0;                     /* 0x43400000, 0x00000000 */
+static const double huge = 1.0e300;
+static const double tiny = 1.0e-300;
+
+// poly coefs for (3/2)*(log(x)-2s-2/3*s**3
+static const double L1 = 5.99999999999994648725e-01;                /* 0x3FE33333, 0x33333303 */
+static const double L2 = 4.28571428578550184252e-01;                /* 0x3FDB6DB6, 0xDB6FABFF */
+static const double L3 = 3.33333329818377432918e-01;                /* 0x3FD55555, 0x518F264D */
+static const double L4 = 2.72728123808534006489e-01;                /* 0x3FD17460, 0xA91D4101 */
+static const double L5 = 2.30660745775561754067e-01;                /* 0x3FCD864A, 0x93C9DB65 */
+static const double L6 = 2.06975017800338417784e-01;                /* 0x3FCA7E28, 0x4A454EEF */
+static const double P1 = 1.66666666666666019037e-01;                /* 0x3FC55555, 0x5555553E */
+static const double P2 = -2.77777777770155933842e-03;               /* 0xBF66C16C, 0x16BEBD93 */
+static const double P3 = 6.61375632143793436117e-05;                /* 0x3F11566A, 0xAF25DE2C */
+static const double P4 = -1.65339022054652515390e-06;               /* 0xBEBBBD41, 0xC5D26BF1 */
+static const double P5 = 4.13813679705723846039e-08;                /* 0x3E663769, 0x72BEA4D0 */
+static const double lg2 = 6.93147180559945286227e-01;               /* 0x3FE62E42, 0xFEFA39EF */
+static const double lg2_h = 6.93147182464599609375e-01;             /* 0x3FE62E43, 0x00000000 */
+static const double lg2_l = -1.90465429995776804525e-09;            /* 0xBE205C61, 0x0CA86C39 */
+static const double ovt = 8.0085662595372944372e-17;                /* -(1024-log2(ovfl+.5ulp)) */
+static const double cp = 9.61796693925975554329e-01;                /* 0x3FEEC709, 0xDC3A03FD =2/(3ln2) */
+static const double cp_h = 9.61796700954437255859e-01;              /* 0x3FEEC709, 0xE0000000 =(float)cp */
+static const double cp_l = -7.02846165095275826516e-09;             /* 0xBE3E2FE0, 0x145B01F5 =tail of cp_h*/
+static const double ivln2 = 1.44269504088896338700e+00;             /* 0x3FF71547, 0x652B82FE =1/ln2 */
+static const double ivln2_h = 1.44269502162933349609e+00;           /* 0x3FF71547, 0x60000000 =24b 1/ln2*/
+static const double ivln2_l = 1.92596299112661746887e-08;           /* 0x3E54AE0B, 0xF85DDF44 =1/ln2 tail*/
+
+double powReal(double x, double y) {
+    const int32_t hx = highWord(x);
+    const uint32_t lx = lowWord(x);
+    const int32_t hy = highWord(y);
+    const uint32_t ly = lowWord(y);
+    int32_t ix = hx & 0x7fffffff;
+    const int32_t iy = hy & 0x7fffffff;
+
+    // y==zero: x**0 = 1, even if x is NaN
+    if ((iy | ly) == 0) {
+        return 1.0;
+    }
+
+    // NaN if either argument is NaN. Unlike C, Math.pow returns NaN for 1**NaN
+    if (ix > 0x7ff00000 || (ix == 0x7ff00000 && lx != 0) || iy > 0x7ff00000 || (iy == 0x7ff00000 && ly != 0)) {
+        return std::numeric_limits<double>::quiet_NaN();
+    }
+
+    // determine if y is an odd int when x < 0: yisint = 0 ... y is not an integer, 1 ... y is an odd int, 2 ... y is an even int
+    int32_t yisint = 0;
+    if (hx < 0) {
+        if (iy >= 0x43400000) {
+            yisint = 2;
+        } else if (iy >= 0x3ff00000) {
+            const int32_t k = (iy >> 20) - 0x3ff;
+            if (k > 20) {
+                const uint32_t j = ly >> (52 - k);
+                if ((j << (52 - k)) == ly) {
+                    yisint = 2 - static_cast<int32_t>(j & 1);
+                }
+            } else if (ly == 0) {
+                const int32_t j = iy >> (20 - k);
+                if ((j << (20 - k)) == iy) {
+                    yisint = 2 - (j & 1);
+                }
+            }
+        }
+    }
+
+    // special value of y
+    if (ly == 0) {
+        if (iy == 0x7ff00000) {
+            // y is +-inf. Unlike C, Math.pow returns NaN for (+-1)**+-inf
+            if (((ix - 0x3ff00000) | lx) == 0) {
+                return std::numeric_limits<double>::quiet_NaN();
+            } else if (ix >= 0x3ff00000) {
+                // (|x|>1)**+-inf = inf,0
+                return hy >= 0 ? y : 0.0;
+            } else {
+                // (|x|<1)**+-inf = 0,inf
+                return hy >= 0 ? 0.0 : -y;
+            }
+        }
+
+        if (iy == 0x3ff00000) {
+            // y is +-1
+            return hy < 0 ? 1.0 / x : x;
+        }
+
+        if (hy == 0x40000000) {
+            // y is 2
+            return x * x;
+        }
+
+        if (hy == 0x3fe00000 && hx >= 0) {
+            // y is 0.5 and x >= +0
+            return std::sqrt(x);
+        }
+    }
+
+    double ax = std::fabs(x);
+
+    // special value of x
+    if (lx == 0 && (ix == 0x7ff00000 || ix == 0 || ix == 0x3ff00000)) {
+        // x is +-0,+-inf,+-1
+        double z = ax;
+        if (hy < 0) {
+            z = 1.0 / z;
+        }
+
+        if (hx < 0) {
+            if (((ix - 0x3ff00000) | yisint) == 0) {
+                // (-1)**non-int is NaN
+                z = std::numeric_limits<double>::quiet_NaN();
+            } else if (yisint == 1) {
+                // (x<0)**odd = -(|x|**odd)
+                z = -z;
+            }
+        }
+
+        return z;
+    }
+
+    // sign of the result
+    double s = 1.0;
+    if (hx < 0) {
+        if (yisint == 0) {
+            // (x<0)**(non-int) is NaN
+            return std::numeric_limits<double>::quiet_NaN();
+        }
+
+        if (yisint == 1) {
+            s = -1.0;
+        }
+    }
+
+    double t1, t2;
+
+    if (iy > 0x41e00000) {
+        // |y| is huge
+        if (iy > 0x43f00000) {
+            // |y| > 2**64, must o/uflow
+            if (ix <= 0x3fefffff) {
+                return hy < 0 ? huge * huge : tiny * tiny;
+            }
+            if (ix >= 0x3ff00000) {
+                return hy > 0 ? huge * huge : tiny * tiny;
+            }
+        }
+
+        // over/underflow if x is not close to one
+        if (ix < 0x3fefffff) {
+            return hy < 0 ? s * huge * huge : s * tiny * tiny;
+        }
+        if (ix > 0x3ff00000) {
+            return hy > 0 ? s * huge * huge : s * tiny * tiny;
+        }
+
+        // now |1-x| is tiny <= 2**-20, suffice to compute log(x) by x-x^2/2+x^3/3-x^4/4
+        const double t = ax - 1.0;
+        const double w = (t * t) * (0.5 - t * (0.3333333333333333333333 - t * 0.25));
+        const double u = ivln2_h * t;
+        const double v = t * ivln2_l - w * ivln2;
+        t1 = withoutLowWord(u + v);
+        t2 = v - (t1 - u);
+    } else {
+        int32_t n = 0;
+
+        // take care subnormal number
+        if (ix < 0x00100000) {
+            ax *= two53;
+            n -= 53;
+            ix = highWord(ax);
+        }
+
+        n += (ix >> 20) - 0x3ff;
+        const int32_t j = ix & 0x000fffff;
+
+        // determine interval
+        int32_t k;
+        ix = j | 0x3ff00000;
+        if (j <= 0x3988E) {
+            // |x|<sqrt(3/2)
+            k = 0;
+        } else if (j < 0xBB67A) {
+            // |x|<sqrt(3)
+            k = 1;
+        } else {
+            k = 0;
+            n += 1;
+            ix -= 0x00100000;
+        }
+        ax = withHighWord(ax, ix);
+
+        // compute ss = s_h+s_l = (x-1)/(x+1) or (x-1.5)/(x+1.5)
+        double u = ax - bp[k];
+        double v = 1.0 / (ax + bp[k]);
+        const double ss = u * v;
+        const double s_h = withoutLowWord(ss);
+
+        // t_h=ax+bp[k] High
+        double t_h = fromBits(static_cast<uint64_t>(static_cast<uint32_t>(((ix >> 1) | 0x20000000) + 0x00080000 + (k << 18))) << 32);
+        double t_l = ax - (t_h - bp[k]);
+        const double s_l = v * ((u - s_h * t_h) - s_h * t_l);
+
+        // compute log(ax)
+        double s2 = ss * ss;
+        double r = s2 * s2 * (L1 + s2 * (L2 + s2 * (L3 + s2 * (L4 + s2 * (L5 + s2 * L6)))));
+        r += s_l * (s_h + ss);
+        s2 = s_h * s_h;
+        t_h = withoutLowWord(3.0 + s2 + r);
+        t_l = r - ((t_h - 3.0) - s2);
+
+        // u+v = ss*(1+...)
+        u = s_h * t_h;
+        v = s_l * t_h + t_l * ss;
+
+        // 2/(3log2)*(ss+...)
+        const double p_h = withoutLowWord(u + v);
+        const double p_l = v - (p_h - u);
+        const double z_h = cp_h * p_h;
+        const double z_l = cp_l * p_h + p_l * cp + dp_l[k];
+
+        // log2(ax) = (ss+..)*2/(3*log2) = n + dp_h + z_h + z_l
+        const double t = static_cast<double>(n);
+        t1 = withoutLowWord(((z_h + z_l) + dp_h[k]) + t);
+        t2 = z_l - (((t1 - t) - dp_h[k]) - z_h);
+    }
+
+    // split up y into y1+y2 and compute (y1+y2)*(t1+t2)
+    const double y1 = withoutLowWord(y);
+    const double p_l = (y - y1) * t1 + y * t2;
+    double p_h = y1 * t1;
+    double z = p_l + p_h;
+    int32_t j = highWord(z);
+    const int32_t i = static_cast<int32_t>(lowWord(z));
+
+    if (j >= 0x40900000) {
+        // z >= 1024
+        if (((j - 0x40900000) | i) != 0 || p_l + ovt > z - p_h) {
+            return s * huge * huge;
+        }
+    } else if ((j & 0x7fffffff) >= 0x4090cc00) {
+        // z <= -1075
+        if (((static_cast<uint32_t>(j) - 0xc090cc00u) | static_cast<uint32_t>(i)) != 0 || p_l <= z - p_h) {
+            return s * tiny * tiny;
+        }
+    }
+
+    // compute 2**(p_h+p_l)
+    const int32_t absJ = j & 0x7fffffff;
+    int32_t k = (absJ >> 20) - 0x3ff;
+    int32_t n = 0;
+    if (absJ > 0x3fe00000) {
+        // if |z| > 0.5, set n = [z+0.5]
+        n = j + (0x00100000 >> (k + 1));
+        k = ((n & 0x7fffffff) >> 20) - 0x3ff;
+        const double t = fromBits(static_cast<uint64_t>(static_cast<uint32_t>(n & ~(0x000fffff >> k))) << 32);
+        n = ((n & 0x000fffff) | 0x00100000) >> (20 - k);
+        if (j < 0) {
+            n = -n;
+        }
+        p_h -= t;
+    }
+
+    const double t = withoutLowWord(p_l + p_h);
+    const double u = t * lg2_h;
+    const double v = (p_l - (t - p_h)) * lg2 + t * lg2_l;
+    z = u + v;
+    const double w = v - (z - u);
+    const double tt = z * z;
+    t1 = z - tt * (P1 + tt * (P2 + tt * (P3 + tt * (P4 + tt * P5))));
+    const double r = (z * t1) / (t1 - 2.0) - (w + z * w);
+    z = 1.0 - (r - z);
+
+    j = highWord(z) + static_cast<int32_t>(static_cast<uint32_t>(n) << 20);
+    if ((j >> 20) <= 0) {
+        // subnormal output
+        z = scaleByPowerOfTwo(z, n);
+    } else {
+        z = withHighWord(z, j);
+    }
+
+    return s * z;
+}
+
+double nativeFmod(double x, double y) {
+    uint64_t xBits = toBits(x);
+    uint64_t yBits = toBits(y);
+    int32_t xExponent = static_cast<int32_t>(xBits >> 52 & 0x7ff);
+    int32_t yExponent = static_cast<int32_t>(yBits >> 52 & 0x7ff);
+    const uint64_t sign = xBits & (1ULL << 63);
+
+    if (yBits << 1 == 0 || std::isnan(y) || xExponent == 0x7ff) {
+        return std::numeric_limits<double>::quiet_NaN();
+    }
+
+    if (xBits << 1 <= yBits << 1) {
+        // |x| <= |y|
+        return xBits << 1 == yBits << 1 ? 0.0 * x : x;
+    }
+
+    // normalize the mantissas, the implicit one is at bit 52
+    if (xExponent == 0) {
+        for (uint64_t i = xBits << 12; i >> 63 == 0; --xExponent, i <<= 1) {}
+        xBits <<= -xExponent + 1;
+    } else {
+        xBits &= ~0ULL >> 12;
+        xBits |= 1ULL << 52;
+    }
+
+    if (yExponent == 0) {
+        for (uint64_t i = yBits << 12; i >> 63 == 0; --yExponent, i <<= 1) {}
+        yBits <<= -yExponent + 1;
+    } else {
+        yBits &= ~0ULL >> 12;
+        yBits |= 1ULL << 52;
+    }
+
+    // shift and subtract, one bit of the quotient per iteration
+    for (; xExponent > yExponent; --xExponent) {
+        const uint64_t difference = xBits - yBits;
+        if (difference >> 63 == 0) {
+            if (difference == 0) {
+                return 0.0 * x;
+            }
+            xBits = difference;
+        }
+        xBits <<= 1;
+    }
+
+    const uint64_t difference = xBits - yBits;
+    if (difference >> 63 == 0) {
+        if (difference == 0) {
+            return 0.0 * x;
+        }
+        xBits = difference;
+    }
+
+    for (; xBits >> 52 == 0; xBits <<= 1, --xExponent) {}
+
+    // scale the result
+    if (xExponent > 0) {
+        xBits -= 1ULL << 52;
+        xBits |= static_cast<uint64_t>(xExponent) << 52;
+    } else {
+        xBits >>= -xExponent + 1;
+    }
+
+    return fromBits(xBits | sign);
+}
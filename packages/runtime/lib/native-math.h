@@ -0,0 +1,73 @@
+//
+// Native implementations of the math functions that the libc linked into the wasm modules does not provide (pow and
+// fmod). Without them, every Math.pow call and every % on numbers calls into JavaScript.
+//
+
+#ifndef SPEEDYJS_RUNTIME_NATIVE_MATH_H
+#define SPEEDYJS_RUNTIME_NATIVE_MATH_H
+
+#include <cmath>
+#include <stdint.h>
+#include "macros.h"
+
+/**
+ * The largest absolute integer exponent that is computed by repeated multiplication instead of computing the logarithm.
+ * The result of an exponent n is rounded at most |n| - 1 times, the error therefore stays within a few ulps.
+ */
+const int32_t MAX_FAST_POW_EXPONENT = 8;
+
+/**
+ * Computes base^exponent using the logarithm of base, the result is within one ulp of the exact result.
+ * Implements the semantics of Math.pow: the result is NaN if the exponent is NaN or if the exponent is infinite and the
+ * absolute value of the base is one.
+ */
+double powReal(double base, double exponent);
+
+/**
+ * Computes the remainder of the division x / y with the sign of x. The remainder is exact and equal to the result of
+ * the % operator on numbers in JavaScript.
+ */
+double nativeFmod(double x, double y);
+
+/**
+ * Computes base^exponent by repeated squaring
+ */
+inline double powInteger(double base, int32_t exponent) {
+    uint32_t remaining = exponent < 0 ? 0u - static_cast<uint32_t>(exponent) : static_cast<uint32_t>(exponent);
+    double result = 1.0;
+    double square = base;
+
+    while (remaining != 0) {
+        if (remaining & 1) {
+            result *= square;
+        }
+
+        remaining >>= 1;
+        if (remaining != 0) {
+            square *= square;
+        }
+    }
+
+    return exponent < 0 ? 1.0 / result : result;
+}
+
+/**
+ * Computes base^exponent with the semantics of Math.pow. Small integer exponents (and 0.5) are computed without the
+ * logarithm. The function is inlined so that the fast path is reduced to the multiplications if the exponent is a
+ * constant. Results that are not normal numbers (zero, subnormal, infinite or NaN) are recomputed by powReal as the
+ * repeated multiplications might over or underflow in between.
+ */
+ALWAYS_INLINE inline double nativePow(double base, double exponent) {
+    if (std::fabs(exponent) <= MAX_FAST_POW_EXPONENT && static_cast<double>(static_cast<int32_t>(exponent)) == exponent) {
+        const double result = powInteger(base, static_cast<int32_t>(exponent));
+        if (std::isnormal(result)) {
+            return result;
+        }
+    } else if (exponent == 0.5 && base > 0.0) {
+        return std::sqrt(base);
+    }
+
+    return powReal(base, exponent);
+}
+
+#endif //SPEEDYJS_RUNTIME_NATIVE_MATH_H
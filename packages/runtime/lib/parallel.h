@@ -0,0 +1,277 @@
+//
+// Parallel loop primitive and the parallel array kernels (fill, map, reduce and sort) built on top of it.
+// If the runtime is built with THREADS, the loops are executed by a set of workers that balance the work using work
+// stealing deques, otherwise the loops are executed on the calling thread.
+//
+
+#ifndef SPEEDYJS_RUNTIME_PARALLEL_H
+#define SPEEDYJS_RUNTIME_PARALLEL_H
+
+#include <stdint.h>
+#include <algorithm>
+#include <numeric>
+#include <vector>
+#include "macros.h"
+#include "simd.h"
+#include "sort.h"
+
+#ifdef THREADS
+#include <thread>
+#include "work-stealing.h"
+#endif
+
+/**
+ * The maximal number of workers used by a parallel loop
+ */
+const size_t MAX_PARALLEL_WORKERS = 64;
+
+/**
+ * The number of elements processed by one task of the parallel kernels
+ */
+const int32_t PARALLEL_GRAIN_SIZE = 4096;
+
+/**
+ * Half open index range [begin, end) processed by a task
+ */
+struct ParallelRange {
+    int32_t begin;
+    int32_t end;
+};
+
+/**
+ * Returns the number of workers used by the parallel loops
+ */
+inline size_t parallelWorkers() {
+#ifdef THREADS
+    const size_t concurrency = std::thread::hardware_concurrency();
+    return std::max<size_t>(1, std::min(concurrency, MAX_PARALLEL_WORKERS));
+#else
+    return 1;
+#endif
+}
+
+#ifdef THREADS
+
+/**
+ * Executes the body for the ranges of a parallel loop. Every worker starts with an equal share of the range in its
+ * deque. A worker splits the ranges larger than the grain size and pushes the upper halves so that idle workers can steal
+ * them. The loop ends when all indices have been processed.
+ */
+template<typename Body>
+class ParallelLoop {
+private:
+    typedef WorkStealingDeque<ParallelRange> Deque;
+
+    std::vector<Deque> deques;
+    std::atomic<int64_t> remaining;
+    const int32_t grain;
+    Body& body;
+
+    void run(size_t worker) {
+        Deque& own = deques[worker];
+        ParallelRange range;
+
+        while (remaining.load() > 0) {
+            if (!own.pop(range) && !steal(worker, range)) {
+                std::this_thread::yield();
+                continue;
+            }
+
+            // Split until the range is small enough, the upper halves can be stolen by other workers
+            while (range.end - range.begin > grain) {
+                const int32_t middle = range.begin + (range.end - range.begin) / 2;
+                if (!own.push(ParallelRange { middle, range.end })) {
+                    break;
+                }
+                range.end = middle;
+            }
+
+            body(range.begin, range.end);
+            remaining.fetch_sub(range.end - range.begin);
+        }
+    }
+
+    bool steal(size_t thief, ParallelRange& range) {
+        for (size_t i = 1; i < deques.size(); ++i) {
+            if (deques[(thief + i) % deques.size()].steal(range)) {
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+public:
+    ParallelLoop(size_t workers, int32_t grain, Body& body) : deques(workers), remaining { 0 }, grain { grain }, body(body) {
+    }
+
+    void execute(int32_t begin, int32_t end) {
+        const size_t workers = deques.size();
+        const int32_t share = (end - begin + static_cast<int32_t>(workers) - 1) / static_cast<int32_t>(workers);
+
+        remaining.store(end - begin);
+        for (size_t i = 0; i < workers; ++i) {
+            const int32_t shareBegin = std::min(end, begin + static_cast<int32_t>(i) * share);
+            const int32_t shareEnd = std::min(end, shareBegin + share);
+
+            if (shareBegin < shareEnd) {
+                deques[i].push(ParallelRange { shareBegin, shareEnd });
+            }
+        }
+
+        // The calling thread is the first worker
+        std::vector<std::thread> threads;
+        for (size_t i = 1; i < workers; ++i) {
+            threads.emplace_back(&ParallelLoop::run, this, i);
+        }
+
+        run(0);
+
+        for (auto& thread : threads) {
+            thread.join();
+        }
+    }
+};
+
+#endif
+
+/**
+ * Calls body(rangeBegin, rangeEnd) for disjoint ranges that cover [begin, end). The ranges are processed in parallel
+ * if the runtime is built with THREADS, therefore, the calls of the body may not depend on each other.
+ * @param begin the first index
+ * @param end the index passed the last index
+ * @param grain the minimal number of indices processed by a single call of the body (if the range is large enough)
+ * @param body the loop body, called with the start and end index of a range
+ */
+template<typename Body>
+void parallelFor(int32_t begin, int32_t end, int32_t grain, Body body) {
+    if (begin >= end) {
+        return;
+    }
+
+#ifdef THREADS
+    grain = std::max(grain, 1);
+    const size_t workers = std::min(parallelWorkers(), static_cast<size_t>((end - begin + grain - 1) / grain));
+
+    if (workers > 1) {
+        ParallelLoop<Body> loop { workers, grain, body };
+        loop.execute(begin, end);
+        return;
+    }
+#else
+    (void) grain;
+#endif
+
+    body(begin, end);
+}
+
+/**
+ * Sets the elements in between begin and end to the given value
+ */
+template<typename T>
+void parallelFill(T* begin, T* end, T value) {
+    parallelFor(0, static_cast<int32_t>(end - begin), PARALLEL_GRAIN_SIZE, [begin, value](int32_t from, int32_t to) {
+        fillElements(begin + from, begin + to, value);
+    });
+}
+
+/**
+ * Applies the mapper to every element in between begin and end and stores the result in target
+ * @param target the start of the target elements (may be equal to begin)
+ * @param mapper function that maps an element, may be called concurrently
+ */
+template<typename T, typename R, typename Mapper>
+void parallelMap(const T* begin, const T* end, R* target, Mapper mapper) {
+    parallelFor(0, static_cast<int32_t>(end - begin), PARALLEL_GRAIN_SIZE, [begin, target, &mapper](int32_t from, int32_t to) {
+        std::transform(begin + from, begin + to, target + from, mapper);
+    });
+}
+
+/**
+ * Reduces the elements in between begin and end. The elements are reduced in chunks of PARALLEL_GRAIN_SIZE elements and
+ * the chunk results are reduced in order afterwards. The result therefore does not depend on the number of workers, even
+ * for operations that are not associative for floating point numbers (e.g. +).
+ * @param initial the initial value
+ * @param reducer the reduce operation, may be called concurrently
+ */
+template<typename T, typename Reducer>
+T parallelReduce(const T* begin, const T* end, T initial, Reducer reducer) {
+    const int32_t count = static_cast<int32_t>(end - begin);
+    const int32_t chunks = (count + PARALLEL_GRAIN_SIZE - 1) / PARALLEL_GRAIN_SIZE;
+
+    if (chunks <= 1) {
+        return std::accumulate(begin, end, initial, reducer);
+    }
+
+    std::vector<T> partials(static_cast<size_t>(chunks));
+    parallelFor(0, chunks, 1, [begin, count, &partials, &reducer](int32_t from, int32_t to) {
+        for (int32_t chunk = from; chunk < to; ++chunk) {
+            const T* chunkBegin = begin + chunk * PARALLEL_GRAIN_SIZE;
+            const T* chunkEnd = begin + std::min(count, (chunk + 1) * PARALLEL_GRAIN_SIZE);
+            partials[chunk] = std::accumulate(chunkBegin + 1, chunkEnd, *chunkBegin, reducer);
+        }
+    });
+
+    return std::accumulate(partials.begin(), partials.end(), initial, reducer);
+}
+
+/**
+ * The order used to merge the sorted runs, needs to be the order of sortElements
+ */
+template<typename T>
+inline bool mergesBefore(T a, T b) {
+    return a < b;
+}
+
+inline bool mergesBefore(double a, double b) {
+    return radixKey(a) < radixKey(b);
+}
+
+/**
+ * Sorts the elements in between begin and end in ascending order using a parallel merge sort. The runs of
+ * PARALLEL_GRAIN_SIZE elements are sorted in parallel (using sortElements), the runs are then merged pairwise in parallel.
+ * Uses sortElements directly if there is only a single worker, merging the runs would only add work in this case.
+ */
+template<typename T>
+void parallelSort(T* begin, T* end) {
+    const int32_t count = static_cast<int32_t>(end - begin);
+
+    if (count <= PARALLEL_GRAIN_SIZE || parallelWorkers() == 1) {
+        sortElements(begin, end);
+        return;
+    }
+
+    const int32_t runs = (count + PARALLEL_GRAIN_SIZE - 1) / PARALLEL_GRAIN_SIZE;
+    parallelFor(0, runs, 1, [begin, count](int32_t from, int32_t to) {
+        for (int32_t run = from; run < to; ++run) {
+            sortElements(begin + run * PARALLEL_GRAIN_SIZE, begin + std::min(count, (run + 1) * PARALLEL_GRAIN_SIZE));
+        }
+    });
+
+    std::vector<T> buffer(static_cast<size_t>(count));
+    T* source = begin;
+    T* target = buffer.data();
+
+    for (int32_t width = PARALLEL_GRAIN_SIZE; width < count; width *= 2) {
+        const int32_t merges = (count + 2 * width - 1) / (2 * width);
+
+        parallelFor(0, merges, 1, [source, target, width, count](int32_t from, int32_t to) {
+            for (int32_t merge = from; merge < to; ++merge) {
+                const int32_t left = merge * 2 * width;
+                const int32_t middle = std::min(count, left + width);
+                const int32_t right = std::min(count, left + 2 * width);
+                std::merge(source + left, source + middle, source + middle, source + right, target + left, [](T a, T b) {
+                    return mergesBefore(a, b);
+                });
+            }
+        });
+
+        std::swap(source, target);
+    }
+
+    if (source != begin) {
+        std::copy(source, source + count, begin);
+    }
+}
+
+#endif //SPEEDYJS_RUNTIME_PARALLEL_H
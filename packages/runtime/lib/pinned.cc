@@ -0,0 +1,130 @@
+//
+// Allocations that survive speedyJsGc.
+//
+
+#include <cstdlib>
+#include <algorithm>
+#include "pinned.h"
+
+PinnedAllocations runtimePinnedAllocations {};
+
+size_t PinnedAllocations::lowerBound(const void* allocation) const {
+    auto position = std::lower_bound(entries, entries + count, allocation, [](const PinnedAllocation& entry, const void* value) {
+        return entry.allocation < value;
+    });
+
+    return static_cast<size_t>(position - entries);
+}
+
+bool PinnedAllocations::track(void* allocation, uint32_t scope) {
+    if (count == capacity) {
+        const size_t newCapacity = capacity == 0 ? INITIAL_PINNED_CAPACITY : capacity * 2;
+        auto* newEntries = static_cast<PinnedAllocation*>(std::realloc(entries, newCapacity * sizeof(PinnedAllocation)));
+
+        if (newEntries == nullptr) {
+            return false;
+        }
+
+        entries = newEntries;
+        capacity = newCapacity;
+    }
+
+    // Allocations are mostly served with increasing addresses, inserting at the end does not move any entries
+    const size_t index = lowerBound(allocation);
+    std::move_backward(&entries[index], &entries[count], &entries[count + 1]);
+    entries[index] = PinnedAllocation { allocation, scope };
+    ++count;
+    return true;
+}
+
+bool PinnedAllocations::untrack(void* allocation) {
+    const size_t index = lowerBound(allocation);
+
+    if (index == count || entries[index].allocation != allocation) {
+        return false;
+    }
+
+    std::move(&entries[index + 1], &entries[count], &entries[index]);
+    --count;
+    return true;
+}
+
+void* PinnedAllocations::allocate(size_t size, uint32_t scope) {
+    void* allocation = std::malloc(size);
+
+    if (allocation != nullptr && !track(allocation, scope)) {
+        std::free(allocation);
+        return nullptr;
+    }
+
+    return allocation;
+}
+
+void* PinnedAllocations::reallocate(void* allocation, size_t size, uint32_t scope) {
+    if (allocation == nullptr) {
+        return allocate(size, scope);
+    }
+
+    const size_t index = lowerBound(allocation);
+
+    if (index == count || entries[index].allocation != allocation) {
+        // not a malloc allocation (e.g. an arena allocation) or already released, realloc would corrupt the heap
+        return nullptr;
+    }
+
+    const uint32_t allocationScope = entries[index].scope;
+    void* resized = std::realloc(allocation, size);
+
+    if (resized == nullptr || resized == allocation) {
+        return resized;
+    }
+
+    // The entry of the moved allocation is removed first, tracking the resized allocation therefore never grows the table
+    std::move(&entries[index + 1], &entries[count], &entries[index]);
+    --count;
+
+    if (!track(resized, allocationScope)) {
+        std::free(resized);
+        return nullptr;
+    }
+
+    return resized;
+}
+
+bool PinnedAllocations::adopt(void* allocation, uint32_t scope) {
+    return contains(allocation) || track(allocation, scope);
+}
+
+void PinnedAllocations::release(void* allocation) {
+    if (untrack(allocation)) {
+        std::free(allocation);
+    }
+}
+
+uint32_t PinnedAllocations::createScope() {
+    return ++lastScope;
+}
+
+void PinnedAllocations::releaseScope(uint32_t scope) {
+    size_t kept = 0;
+
+    for (size_t i = 0; i < count; ++i) {
+        if (entries[i].scope == scope) {
+            std::free(entries[i].allocation);
+        } else {
+            entries[kept++] = entries[i];
+        }
+    }
+
+    count = kept;
+}
+
+uint32_t PinnedAllocations::scopeOf(const void* allocation) const {
+    const size_t index = lowerBound(allocation);
+    return index < count && entries[index].allocation == allocation ? entries[index].scope : UNSCOPED;
+}
+
+bool PinnedAllocations::contains(const void* allocation) const {
+    const size_t index = lowerBound(allocation);
+    return index < count && entries[index].allocation == allocation;
+}
@@ -0,0 +1,141 @@
+//
+// Allocations that survive speedyJsGc, used for the arrays that the loader allocates in the linear memory and the
+// values retained by the loader across calls.
+//
+
+#ifndef SPEEDYJS_RUNTIME_PINNED_H
+#define SPEEDYJS_RUNTIME_PINNED_H
+
+#include <cstddef>
+#include <stdint.h>
+#include "macros.h"
+
+/**
+ * The number of pinned allocations that can be tracked before the table is grown the first time
+ */
+const size_t INITIAL_PINNED_CAPACITY = 64;
+
+/**
+ * The scope of allocations that are released one by one (e.g. the pinned arrays)
+ */
+const uint32_t UNSCOPED = 0;
+
+struct PinnedAllocation {
+    void* allocation;
+
+    /**
+     * The scope the allocation belongs to, all allocations of a scope are released at once
+     */
+    uint32_t scope;
+};
+
+/**
+ * Tracks the pinned allocations. The allocations are served by malloc and not by the arena (that is reset by the gc).
+ * The gc of the malloc variants skips the tracked allocations (and the table itself) when freeing the heap.
+ * The allocations are kept sorted so that the gc can look them up without allocating.
+ *
+ * Allocations can be grouped into scopes. The loader allocates all objects of a retained value in the same scope and
+ * releases them together when the value is released.
+ *
+ * Like the arena, the registry is constant initialized, the table is allocated on the first allocation.
+ */
+class PinnedAllocations {
+private:
+    PinnedAllocation* entries;
+    size_t count;
+    size_t capacity;
+    uint32_t lastScope;
+
+    /**
+     * Returns the index of the first allocation that is not less than the given pointer
+     */
+    size_t lowerBound(const void* allocation) const;
+
+    /**
+     * Adds the allocation to the table
+     * @return false if the table is full and growing it failed
+     */
+    bool track(void* allocation, uint32_t scope);
+
+    /**
+     * Removes the allocation from the table
+     * @return true if the allocation was pinned
+     */
+    bool untrack(void* allocation);
+
+public:
+    constexpr PinnedAllocations() : entries { nullptr }, count { 0 }, capacity { 0 }, lastScope { UNSCOPED } {
+    }
+
+    /**
+     * Allocates a pinned memory block
+     * @param size the size in bytes
+     * @param scope the scope of the allocation
+     * @return the allocation or the nullptr if the allocation failed
+     */
+    void* allocate(size_t size, uint32_t scope = UNSCOPED);
+
+    /**
+     * Resizes a pinned allocation, the resized allocation is pinned too and stays in the scope of the allocation
+     * @param allocation the pinned allocation or the nullptr
+     * @param size the new size in bytes
+     * @param scope the scope of the new allocation if allocation is the nullptr
+     * @return the resized allocation or the nullptr if the allocation failed (the passed allocation is still valid) or
+     * if the passed allocation is not pinned
+     */
+    void* reallocate(void* allocation, size_t size, uint32_t scope = UNSCOPED);
+
+    /**
+     * Pins an existing malloc allocation, e.g. the objects of the heap snapshot that need to survive the gc
+     * @param allocation the allocation returned by malloc, pinned allocations are ignored
+     * @param scope the scope the allocation is added to
+     * @return false if the table is full and growing it failed
+     */
+    bool adopt(void* allocation, uint32_t scope);
+
+    /**
+     * Releases a pinned allocation
+     * @param allocation the pinned allocation, pointers that are not pinned are ignored
+     */
+    void release(void* allocation);
+
+    /**
+     * Creates a new scope for allocations that are released together
+     * @return the identifier of the scope
+     */
+    uint32_t createScope();
+
+    /**
+     * Releases all allocations of the given scope
+     * @param scope the scope to release
+     */
+    void releaseScope(uint32_t scope);
+
+    /**
+     * Returns the scope of a pinned allocation or UNSCOPED if the pointer is not pinned
+     */
+    uint32_t scopeOf(const void* allocation) const;
+
+    /**
+     * Returns true if the given pointer is the start of a pinned allocation
+     */
+    bool contains(const void* allocation) const;
+
+    /**
+     * Returns true if the given pointer is a pinned allocation or the table tracking the pinned allocations, used by the gc
+     */
+    inline bool survivesGc(const void* allocation) const {
+        return allocation == entries || contains(allocation);
+    }
+
+    /**
+     * Returns the number of pinned allocations
+     */
+    inline size_t size() const {
+        return count;
+    }
+};
+
+extern PinnedAllocations runtimePinnedAllocations;
+
+#endif //SPEEDYJS_RUNTIME_PINNED_H
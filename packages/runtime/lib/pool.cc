@@ -0,0 +1,35 @@
+//
+// Size-class pool allocator for small objects of a fixed size.
+//
+
+#include "pool.h"
+
+Pool runtimePool {};
+
+void Pool::reset() {
+    for (auto& sizeClass : sizeClasses) {
+        sizeClass.freeList = nullptr;
+        sizeClass.top = nullptr;
+        sizeClass.limit = nullptr;
+    }
+}
+
+void Pool::resetStatistics() {
+    for (auto& sizeClass : sizeClasses) {
+        sizeClass.hits = 0;
+        sizeClass.misses = 0;
+    }
+}
+
+bool Pool::allocateSlab(SizeClass& sizeClass) {
+    char* slab = static_cast<char*>(allocateMemory(POOL_SLAB_SIZE));
+
+    if (slab == nullptr) {
+        return false;
+    }
+
+    // The rest of the previous slab is wasted. It is smaller than a block anyway.
+    sizeClass.top = slab;
+    sizeClass.limit = slab + POOL_SLAB_SIZE;
+    return true;
+}
@@ -0,0 +1,188 @@
+//
+// Size-class pool allocator for small objects of a fixed size.
+//
+
+#ifndef SPEEDYJS_RUNTIME_POOL_H
+#define SPEEDYJS_RUNTIME_POOL_H
+
+#include <cstddef>
+#include <stdint.h>
+#include "macros.h"
+#include "allocator.h"
+
+/**
+ * The difference in bytes between two size classes. Allocations are rounded up to the next size class.
+ * As all sizes of a class are a multiple of the step, the natural alignment of structs is retained.
+ */
+const size_t POOL_SIZE_CLASS_STEP = 4;
+
+/**
+ * The number of size classes. Allocations larger than POOL_SIZE_CLASS_STEP * POOL_SIZE_CLASSES are not pooled.
+ */
+const size_t POOL_SIZE_CLASSES = 16;
+
+/**
+ * The largest allocation served by the pool
+ */
+const size_t POOL_MAX_SIZE = POOL_SIZE_CLASS_STEP * POOL_SIZE_CLASSES;
+
+/**
+ * The size of the slabs requested from the runtime heap
+ */
+const size_t POOL_SLAB_SIZE = 4096;
+
+/**
+ * Free list / slab allocator for the small fixed size objects allocated by the runtime (array headers) and the compiled code
+ * (class instances). Allocations are served from the free list of the size class or are bumped from the current slab of the
+ * size class. New slabs are allocated from the runtime heap when the current slab is exhausted.
+ *
+ * The slabs are owned by the runtime heap and are therefore released by the gc, the pool needs to be reset at the same time.
+ * Like the arena, the pool is constant initialized.
+ */
+class Pool {
+private:
+    struct FreeBlock {
+        FreeBlock* next;
+    };
+
+    struct SizeClass {
+        /**
+         * The released blocks of this size class
+         */
+        FreeBlock* freeList;
+
+        /**
+         * Pointer to the next free block in the current slab
+         */
+        char* top;
+
+        /**
+         * Pointer passed the end of the current slab
+         */
+        char* limit;
+
+        /**
+         * Number of allocations served without allocating a new slab
+         */
+        uint32_t hits;
+
+        /**
+         * Number of allocations that required a new slab
+         */
+        uint32_t misses;
+    };
+
+    SizeClass sizeClasses[POOL_SIZE_CLASSES];
+
+public:
+    constexpr Pool() : sizeClasses {} {
+    }
+
+    /**
+     * Allocates a block of the given size. Allocations larger than {@link POOL_MAX_SIZE} are directly allocated
+     * from the runtime heap.
+     * @param size the size in bytes
+     * @return the pointer to the allocated block or the nullptr if the allocation failed
+     */
+    inline void* allocate(size_t size) {
+        if (size > POOL_MAX_SIZE) {
+            return allocateMemory(size);
+        }
+
+        SizeClass& sizeClass = sizeClasses[sizeClassIndex(size)];
+
+        if (sizeClass.freeList != nullptr) {
+            FreeBlock* block = sizeClass.freeList;
+            sizeClass.freeList = block->next;
+            ++sizeClass.hits;
+            return block;
+        }
+
+        const size_t blockSize = sizeClassSize(sizeClassIndex(size));
+        if (sizeClass.top == nullptr || static_cast<size_t>(sizeClass.limit - sizeClass.top) < blockSize) {
+            if (!allocateSlab(sizeClass)) {
+                return nullptr;
+            }
+
+            ++sizeClass.misses;
+        } else {
+            ++sizeClass.hits;
+        }
+
+        void* block = sizeClass.top;
+        sizeClass.top += blockSize;
+        return block;
+    }
+
+    /**
+     * Returns the given block to the free list of its size class
+     * @param block the block to release
+     * @param size the size of the block, as passed to allocate
+     */
+    inline void release(void* block, size_t size) {
+        if (block == nullptr) {
+            return;
+        }
+
+        if (size > POOL_MAX_SIZE) {
+            freeMemory(block, size);
+            return;
+        }
+
+        SizeClass& sizeClass = sizeClasses[sizeClassIndex(size)];
+        FreeBlock* freeBlock = static_cast<FreeBlock*>(block);
+        freeBlock->next = sizeClass.freeList;
+        sizeClass.freeList = freeBlock;
+    }
+
+    /**
+     * Forgets all slabs and free lists. Needs to be called when the runtime heap is released (gc).
+     * The hit and miss counters are retained.
+     */
+    void reset();
+
+    /**
+     * Resets the hit and miss counters of all size classes
+     */
+    void resetStatistics();
+
+    /**
+     * Returns the number of allocations of the given size class that have been served by the free list or the current slab
+     */
+    inline uint32_t hits(size_t sizeClassIndex) const {
+        return sizeClasses[sizeClassIndex].hits;
+    }
+
+    /**
+     * Returns the number of allocations of the given size class that required a new slab
+     */
+    inline uint32_t misses(size_t sizeClassIndex) const {
+        return sizeClasses[sizeClassIndex].misses;
+    }
+
+    /**
+     * Returns the index of the size class used for allocations of the given size
+     */
+    static inline size_t sizeClassIndex(size_t size) {
+        // Each block needs to be large enough to store the free list pointer
+        size = size < sizeof(FreeBlock) ? sizeof(FreeBlock) : size;
+        return (size + POOL_SIZE_CLASS_STEP - 1) / POOL_SIZE_CLASS_STEP - 1;
+    }
+
+    /**
+     * Returns the size of the blocks of the size class with the given index
+     */
+    static inline size_t sizeClassSize(size_t sizeClassIndex) {
+        return (sizeClassIndex + 1) * POOL_SIZE_CLASS_STEP;
+    }
+
+private:
+    bool allocateSlab(SizeClass& sizeClass);
+};
+
+/**
+ * The pool used by the runtime for the array headers and the objects allocated by the compiled code
+ */
+extern Pool runtimePool;
+
+#endif //SPEEDYJS_RUNTIME_POOL_H
@@ -0,0 +1,307 @@
+//
+// Kernels for the bulk operations on elements. The SIMD variants of the runtime use 128 bit vectors (wasm simd128),
+// the other variants use the scalar implementations.
+//
+
+#ifndef SPEEDYJS_RUNTIME_SIMD_H
+#define SPEEDYJS_RUNTIME_SIMD_H
+
+#include <stdint.h>
+#include <cstring>
+#include <cmath>
+#include <algorithm>
+#include <limits>
+#include "macros.h"
+
+#ifdef SIMD
+
+/**
+ * The size of a vector register in bytes
+ */
+const size_t VECTOR_SIZE = 16;
+
+typedef uint8_t ByteVector __attribute__((vector_size(16)));
+typedef int32_t Int32Vector __attribute__((vector_size(16)));
+typedef int64_t Int64Vector __attribute__((vector_size(16)));
+typedef double DoubleVector __attribute__((vector_size(16)));
+
+#ifdef __clang__
+    #define SHUFFLE_BYTES(vector, ...) __builtin_shufflevector(vector, vector, __VA_ARGS__)
+#else
+    #define SHUFFLE_BYTES(vector, ...) __builtin_shuffle(vector, ByteVector { __VA_ARGS__ })
+#endif
+
+/**
+ * Loads a vector from a (possibly) unaligned address
+ */
+template<typename V>
+ALWAYS_INLINE inline V loadVector(const void* address) {
+    V vector;
+    std::memcpy(&vector, address, sizeof(V));
+    return vector;
+}
+
+/**
+ * Stores a vector at a (possibly) unaligned address
+ */
+template<typename V>
+ALWAYS_INLINE inline void storeVector(void* address, const V vector) {
+    std::memcpy(address, &vector, sizeof(V));
+}
+
+/**
+ * Reverses the order of the elements of the given size in the byte vector
+ */
+template<size_t ELEMENT_SIZE>
+inline ByteVector reverseLanes(ByteVector vector);
+
+template<>
+ALWAYS_INLINE inline ByteVector reverseLanes<1>(ByteVector vector) {
+    return SHUFFLE_BYTES(vector, 15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0);
+}
+
+template<>
+ALWAYS_INLINE inline ByteVector reverseLanes<2>(ByteVector vector) {
+    return SHUFFLE_BYTES(vector, 14, 15, 12, 13, 10, 11, 8, 9, 6, 7, 4, 5, 2, 3, 0, 1);
+}
+
+template<>
+ALWAYS_INLINE inline ByteVector reverseLanes<4>(ByteVector vector) {
+    return SHUFFLE_BYTES(vector, 12, 13, 14, 15, 8, 9, 10, 11, 4, 5, 6, 7, 0, 1, 2, 3);
+}
+
+template<>
+ALWAYS_INLINE inline ByteVector reverseLanes<8>(ByteVector vector) {
+    return SHUFFLE_BYTES(vector, 8, 9, 10, 11, 12, 13, 14, 15, 0, 1, 2, 3, 4, 5, 6, 7);
+}
+
+#endif
+
+/**
+ * Sets all elements in between begin and end to the given value
+ * @param begin pointer to the first element to set
+ * @param end pointer passed the last element to set
+ * @param value the value to set
+ */
+template<typename T>
+ALWAYS_INLINE inline void fillElements(T* begin, T* end, const T value) {
+#ifdef SIMD
+    static_assert(VECTOR_SIZE % sizeof(T) == 0, "The element size must divide the vector size");
+    const size_t lanes = VECTOR_SIZE / sizeof(T);
+
+    if (static_cast<size_t>(end - begin) >= lanes) {
+        T pattern[lanes];
+        std::fill_n(pattern, lanes, value);
+        const ByteVector vector = loadVector<ByteVector>(pattern);
+
+        for (; static_cast<size_t>(end - begin) >= lanes; begin += lanes) {
+            storeVector(begin, vector);
+        }
+    }
+#endif
+
+    std::fill(begin, end, value);
+}
+
+/**
+ * Copies the elements in between first and last to destination. The ranges are allowed to overlap (memmove semantics).
+ * @param first pointer to the first element to copy
+ * @param last pointer passed the last element to copy
+ * @param destination pointer to the target of the first element
+ * @return pointer passed the last copied element in the destination
+ */
+template<typename T>
+ALWAYS_INLINE inline T* moveElements(const T* first, const T* last, T* destination) {
+    const size_t count = static_cast<size_t>(last - first);
+
+#ifdef SIMD
+    const size_t lanes = VECTOR_SIZE / sizeof(T);
+    const size_t distance = destination < first ? first - destination : destination - first;
+
+    // Overlapping ranges closer than a vector would override elements not yet loaded
+    if (distance >= lanes || destination + count <= first || destination >= last) {
+        if (destination <= first) {
+            size_t i = 0;
+            for (; i + lanes <= count; i += lanes) {
+                storeVector(&destination[i], loadVector<ByteVector>(&first[i]));
+            }
+
+            for (; i < count; ++i) {
+                destination[i] = first[i];
+            }
+        } else {
+            size_t i = count;
+            for (; i >= lanes; i -= lanes) {
+                storeVector(&destination[i - lanes], loadVector<ByteVector>(&first[i - lanes]));
+            }
+
+            for (; i > 0; --i) {
+                destination[i - 1] = first[i - 1];
+            }
+        }
+
+        return destination + count;
+    }
+#endif
+
+    std::memmove(destination, first, count * sizeof(T));
+    return destination + count;
+}
+
+/**
+ * Reverses the elements in between begin and end in place
+ * @param begin pointer to the first element
+ * @param end pointer passed the last element
+ */
+template<typename T>
+ALWAYS_INLINE inline void reverseElements(T* begin, T* end) {
+#ifdef SIMD
+    const size_t lanes = VECTOR_SIZE / sizeof(T);
+
+    for (; static_cast<size_t>(end - begin) >= 2 * lanes; begin += lanes, end -= lanes) {
+        const ByteVector front = loadVector<ByteVector>(begin);
+        const ByteVector back = loadVector<ByteVector>(end - lanes);
+
+        storeVector(begin, reverseLanes<sizeof(T)>(back));
+        storeVector(end - lanes, reverseLanes<sizeof(T)>(front));
+    }
+#endif
+
+    std::reverse(begin, end);
+}
+
+/**
+ * Returns the largest of the given values or NaN if any value is NaN (as Math.max)
+ * @param values the values
+ * @param count the number of values
+ * @return the maximum, -Infinity if count is zero
+ */
+ALWAYS_INLINE inline double maxElement(const double* values, size_t count) {
+    double max = -INFINITY;
+    bool isNaN = false;
+    size_t i = 0;
+
+#ifdef SIMD
+    const size_t lanes = VECTOR_SIZE / sizeof(double);
+    DoubleVector maxVector = { -INFINITY, -INFINITY };
+    Int64Vector nanVector = { 0, 0 };
+
+    for (; i + lanes <= count; i += lanes) {
+        const DoubleVector vector = loadVector<DoubleVector>(&values[i]);
+        const Int64Vector greater = vector > maxVector;
+        nanVector |= vector != vector;
+        maxVector = (DoubleVector) (((Int64Vector) vector & greater) | ((Int64Vector) maxVector & ~greater));
+    }
+
+    isNaN = nanVector[0] != 0 || nanVector[1] != 0;
+    max = std::max(maxVector[0], maxVector[1]);
+#endif
+
+    for (; i < count; ++i) {
+        isNaN |= std::isnan(values[i]);
+        max = values[i] > max ? values[i] : max;
+    }
+
+    return isNaN ? NAN : max;
+}
+
+/**
+ * Returns the smallest of the given values or NaN if any value is NaN (as Math.min)
+ * @param values the values
+ * @param count the number of values
+ * @return the minimum, Infinity if count is zero
+ */
+ALWAYS_INLINE inline double minElement(const double* values, size_t count) {
+    double min = INFINITY;
+    bool isNaN = false;
+    size_t i = 0;
+
+#ifdef SIMD
+    const size_t lanes = VECTOR_SIZE / sizeof(double);
+    DoubleVector minVector = { INFINITY, INFINITY };
+    Int64Vector nanVector = { 0, 0 };
+
+    for (; i + lanes <= count; i += lanes) {
+        const DoubleVector vector = loadVector<DoubleVector>(&values[i]);
+        const Int64Vector less = vector < minVector;
+        nanVector |= vector != vector;
+        minVector = (DoubleVector) (((Int64Vector) vector & less) | ((Int64Vector) minVector & ~less));
+    }
+
+    isNaN = nanVector[0] != 0 || nanVector[1] != 0;
+    min = std::min(minVector[0], minVector[1]);
+#endif
+
+    for (; i < count; ++i) {
+        isNaN |= std::isnan(values[i]);
+        min = values[i] < min ? values[i] : min;
+    }
+
+    return isNaN ? NAN : min;
+}
+
+/**
+ * Returns the largest of the given values
+ * @param values the values
+ * @param count the number of values
+ * @return the maximum, INT32_MIN if count is zero
+ */
+ALWAYS_INLINE inline int32_t maxElement(const int32_t* values, size_t count) {
+    int32_t max = std::numeric_limits<int32_t>::min();
+    size_t i = 0;
+
+#ifdef SIMD
+    const size_t lanes = VECTOR_SIZE / sizeof(int32_t);
+    Int32Vector maxVector = { max, max, max, max };
+
+    for (; i + lanes <= count; i += lanes) {
+        const Int32Vector vector = loadVector<Int32Vector>(&values[i]);
+        const Int32Vector greater = vector > maxVector;
+        maxVector = (vector & greater) | (maxVector & ~greater);
+    }
+
+    for (size_t lane = 0; lane < lanes; ++lane) {
+        max = std::max(max, static_cast<int32_t>(maxVector[lane]));
+    }
+#endif
+
+    for (; i < count; ++i) {
+        max = std::max(values[i], max);
+    }
+
+    return max;
+}
+
+/**
+ * Returns the smallest of the given values
+ * @param values the values
+ * @param count the number of values
+ * @return the minimum, INT32_MAX if count is zero
+ */
+ALWAYS_INLINE inline int32_t minElement(const int32_t* values, size_t count) {
+    int32_t min = std::numeric_limits<int32_t>::max();
+    size_t i = 0;
+
+#ifdef SIMD
+    const size_t lanes = VECTOR_SIZE / sizeof(int32_t);
+    Int32Vector minVector = { min, min, min, min };
+
+    for (; i + lanes <= count; i += lanes) {
+        const Int32Vector vector = loadVector<Int32Vector>(&values[i]);
+        const Int32Vector less = vector < minVector;
+        minVector = (vector & less) | (minVector & ~less);
+    }
+
+    for (size_t lane = 0; lane < lanes; ++lane) {
+        min = std::min(min, static_cast<int32_t>(minVector[lane]));
+    }
+#endif
+
+    for (; i < count; ++i) {
+        min = std::min(values[i], min);
+    }
+
+    return min;
+}
+
+#endif //SPEEDYJS_RUNTIME_SIMD_H
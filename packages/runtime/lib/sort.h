@@ -0,0 +1,162 @@
+//
+// Sort kernels for the array elements. Int and number arrays are sorted with a least significant digit radix sort,
+// all other element types use std::sort.
+//
+
+#ifndef SPEEDYJS_RUNTIME_SORT_H
+#define SPEEDYJS_RUNTIME_SORT_H
+
+#include <stdint.h>
+#include <cstring>
+#include <algorithm>
+#include "macros.h"
+#include "allocator.h"
+
+/**
+ * Arrays with fewer elements are sorted using std::sort. The radix sort needs to pass over the elements and its
+ * histograms multiple times what does not pay off for small arrays.
+ */
+const size_t RADIX_SORT_THRESHOLD = 64;
+
+/**
+ * Maps an int to an unsigned key with the same order (flips the sign bit)
+ */
+ALWAYS_INLINE inline uint32_t radixKey(int32_t value) {
+    return static_cast<uint32_t>(value) ^ 0x80000000u;
+}
+
+/**
+ * Maps a double to an unsigned key that orders the values as defined by IEEE 754 (totalOrder). Negative values have
+ * all bits flipped, positive values the sign bit only. Negative zero is mapped to the key of positive zero as both
+ * compare equal. All NaNs are mapped to the key of the positive quiet NaN and are therefore ordered after positive
+ * infinity, independent of their sign and payload.
+ */
+ALWAYS_INLINE inline uint64_t radixKey(double value) {
+    uint64_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+
+    if (value != value) {
+        bits = 0x7ff8000000000000ull;
+    } else if (bits == 0x8000000000000000ull) {
+        bits = 0;
+    }
+
+    return (bits & 0x8000000000000000ull) ? ~bits : bits | 0x8000000000000000ull;
+}
+
+/**
+ * Sorts the elements in between begin and end by their radix keys. The sort is stable.
+ * @tparam DESCENDING true if the largest key should come first
+ * @param begin pointer to the first element
+ * @param end pointer passed the last element
+ * @param buffer buffer with space for end - begin elements
+ */
+template<bool DESCENDING, typename T>
+void radixSortElements(T* begin, T* end, T* buffer) {
+    typedef decltype(radixKey(T {})) Key;
+    const size_t DIGITS = sizeof(Key);
+    const size_t count = static_cast<size_t>(end - begin);
+    const Key flip = DESCENDING ? static_cast<Key>(~Key {}) : Key {};
+
+    // Computing the histograms of all digits in a single pass saves a pass over the elements per digit
+    size_t histograms[DIGITS][256] = { { 0 } };
+    for (T* element = begin; element != end; ++element) {
+        Key key = radixKey(*element) ^ flip;
+
+        for (size_t digit = 0; digit < DIGITS; ++digit) {
+            ++histograms[digit][key & 0xff];
+            key >>= 8;
+        }
+    }
+
+    T* source = begin;
+    T* target = buffer;
+
+    for (size_t digit = 0; digit < DIGITS; ++digit) {
+        size_t* histogram = histograms[digit];
+        const size_t shift = digit * 8;
+
+        // All elements have the same digit, this pass would not change the order
+        if (histogram[(radixKey(*source) ^ flip) >> shift & 0xff] == count) {
+            continue;
+        }
+
+        size_t offset = 0;
+        for (size_t bucket = 0; bucket < 256; ++bucket) {
+            const size_t bucketSize = histogram[bucket];
+            histogram[bucket] = offset;
+            offset += bucketSize;
+        }
+
+        for (T* element = source; element != source + count; ++element) {
+            const size_t bucket = (radixKey(*element) ^ flip) >> shift & 0xff;
+            target[histogram[bucket]++] = *element;
+        }
+
+        std::swap(source, target);
+    }
+
+    if (source != begin) {
+        std::copy(source, source + count, begin);
+    }
+}
+
+/**
+ * Sorts the elements using radix sort and falls back to std::sort for small arrays or if the buffer cannot be allocated
+ */
+template<bool DESCENDING, typename T>
+void radixSort(T* begin, T* end) {
+    const size_t count = static_cast<size_t>(end - begin);
+
+    if (count >= RADIX_SORT_THRESHOLD) {
+        T* buffer = static_cast<T*>(allocateMemory(count * sizeof(T)));
+
+        if (buffer != nullptr) {
+            radixSortElements<DESCENDING>(begin, end, buffer);
+            freeMemory(buffer, count * sizeof(T));
+            return;
+        }
+    }
+
+    std::stable_sort(begin, end, [](T a, T b) {
+        return DESCENDING ? radixKey(b) < radixKey(a) : radixKey(a) < radixKey(b);
+    });
+}
+
+/**
+ * Sorts the elements in between begin and end in ascending order
+ * @param begin pointer to the first element
+ * @param end pointer passed the last element
+ */
+template<typename T>
+inline void sortElements(T* begin, T* end) {
+    std::sort(begin, end);
+}
+
+inline void sortElements(int32_t* begin, int32_t* end) {
+    radixSort<false>(begin, end);
+}
+
+inline void sortElements(double* begin, double* end) {
+    radixSort<false>(begin, end);
+}
+
+/**
+ * Sorts the elements in between begin and end in descending order
+ * @param begin pointer to the first element
+ * @param end pointer passed the last element
+ */
+template<typename T>
+inline void sortElementsDescending(T* begin, T* end) {
+    std::sort(begin, end, [](T a, T b) { return b < a; });
+}
+
+inline void sortElementsDescending(int32_t* begin, int32_t* end) {
+    radixSort<true>(begin, end);
+}
+
+inline void sortElementsDescending(double* begin, double* end) {
+    radixSort<true>(begin, end);
+}
+
+#endif //SPEEDYJS_RUNTIME_SORT_H
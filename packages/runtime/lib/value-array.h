@@ -0,0 +1,222 @@
+//
+// Array of value objects that are stored inline in the elements of the array.
+//
+
+#ifndef SPEEDYJS_RUNTIME_VALUE_ARRAY_H
+#define SPEEDYJS_RUNTIME_VALUE_ARRAY_H
+
+#include <stdexcept>
+#include <stdint.h>
+#include <cstring>
+#include <new>
+#include "macros.h"
+#include "errors.h"
+#include "allocator.h"
+#include "array.h"
+#include "instrumentation.h"
+#include "pool.h"
+
+/**
+ * Array whose elements are the fields of objects of a single class stored one after another (array of structs) instead
+ * of pointers to separately allocated objects. An access to a field of an element (points[i].x) therefore needs a
+ * single load from begin instead of a load of the object pointer followed by the load of the field, and iterating the
+ * elements touches contiguous memory.
+ *
+ * The size of the elements is defined when the array is created as the runtime cannot be instantiated for every class.
+ * The compiler only uses value arrays for classes whose objects are never compared or shared by identity, an element
+ * is always copied into and out of the array. The element size needs to be a multiple of the alignment of the fields.
+ */
+class ValueArray {
+private:
+    /**
+     * The elements of the array, capacity * elementSize bytes (or the nullptr if the capacity is zero).
+     * The bytes up to back are initialized with zero if not written otherwise.
+     */
+    uint8_t* begin;
+
+    /**
+     * Pointer passed the last element
+     */
+    uint8_t* back;
+
+    /**
+     * The number of elements that can be stored without growing the array
+     */
+    size_t capacity;
+
+    /**
+     * The size of a single element in bytes. The layout up to here (begin, back, capacity and elementSize) is shared
+     * with the compiler that computes the address of an element from begin and elementSize.
+     */
+    size_t elementSize;
+
+public:
+    /**
+     * Creates a new array with the given length whose elements are zero initialized
+     * @param size the length of the array
+     * @param elementSize the size of an element in bytes, greater than zero
+     */
+    ValueArray(int32_t size, int32_t elementSize) : begin { nullptr }, back { nullptr }, capacity { 0 }, elementSize { static_cast<size_t>(elementSize) } {
+#ifdef SAFE
+        if (size < 0 || elementSize <= 0) {
+            RAISE_RUNTIME_ERROR(RuntimeError::INVALID_ARRAY_LENGTH, std::out_of_range("Invalid array length"));
+        }
+#endif
+
+        resize(static_cast<size_t>(size));
+    }
+
+    /**
+     * Creates a new array containing copies of the given elements
+     * @param elements pointer to the elementsCount contiguous elements to copy
+     * @param elementsCount the number of elements
+     * @param elementSize the size of an element in bytes, greater than zero
+     */
+    ValueArray(const void* elements, size_t elementsCount, int32_t elementSize) : ValueArray(0, elementSize) {
+        push(elements, elementsCount);
+    }
+
+    ValueArray(const ValueArray&) = delete;
+    ValueArray& operator=(const ValueArray&) = delete;
+
+    ~ValueArray() {
+        if (begin != nullptr) {
+            freeMemory(begin, capacity * elementSize);
+        }
+    }
+
+    /**
+     * Allocates the array objects from the pool as all value array objects have the same size
+     */
+    static inline void* operator new(size_t size) {
+        void* allocation = runtimePool.allocate(size);
+
+        if (allocation == nullptr) {
+            RAISE_RUNTIME_ERROR(RuntimeError::OUT_OF_MEMORY, std::bad_alloc {});
+        }
+
+        return allocation;
+    }
+
+    static inline void operator delete(void* allocation, size_t size) {
+        runtimePool.release(allocation, size);
+    }
+
+    /**
+     * Returns a pointer to the element at the given index. The pointer is invalidated when the array grows or shrinks.
+     * Unlike Array.get, an out of bound index raises an error as there is no element that could be returned instead.
+     * @param index the index of the element
+     * @return pointer to the first byte of the element
+     */
+    inline void* elementAt(int32_t index) const __attribute__((returns_nonnull)) {
+#ifdef SAFE
+        if (index < 0 || index >= length()) {
+            RAISE_RUNTIME_ERROR(RuntimeError::INVALID_ARRAY_INDEX, std::out_of_range("Invalid array index"));
+        }
+#endif
+
+        return elementAtUnchecked(index);
+    }
+
+    /**
+     * Returns a pointer to the element without checking the bounds, even in safe mode
+     * @param index the index of the element, needs to be in between 0 and length - 1
+     */
+    inline void* elementAtUnchecked(int32_t index) const {
+        return begin + static_cast<size_t>(index) * elementSize;
+    }
+
+    /**
+     * Copies the value into the element at the given index
+     * @param index the index of the element
+     * @param value pointer to the value of elementSize bytes
+     */
+    inline void set(int32_t index, const void* value) __attribute__((nonnull(3))) {
+        std::memcpy(elementAt(index), value, elementSize);
+    }
+
+    /**
+     * Appends copies of the given elements
+     * @param elements pointer to numElements contiguous elements
+     * @param numElements the number of elements to add
+     * @return the new length of the array
+     */
+    inline int32_t push(const void* elements, size_t numElements) {
+        const size_t length = size();
+        ensureCapacity(length + numElements);
+
+        if (numElements > 0) {
+            std::memmove(back, elements, numElements * elementSize);
+        }
+
+        back += numElements * elementSize;
+        return this->length();
+    }
+
+    /**
+     * Resizes the array to the new length, added elements are zero initialized
+     * @param newSize the new length
+     */
+    void resize(size_t newSize) {
+        const size_t length = size();
+        ensureCapacity(newSize);
+
+        if (newSize > length) {
+            std::memset(back, 0, (newSize - length) * elementSize);
+        }
+
+        back = begin + newSize * elementSize;
+    }
+
+    /**
+     * Returns the number of elements
+     */
+    inline size_t size() const {
+        return static_cast<size_t>(back - begin) / elementSize;
+    }
+
+    /**
+     * Returns the number of elements as int
+     */
+    inline int32_t length() const {
+        return static_cast<int32_t>(size());
+    }
+
+    /**
+     * Returns the size of a single element in bytes
+     */
+    inline size_t getElementSize() const {
+        return elementSize;
+    }
+
+private:
+    /**
+     * Ensures that the capacity is at least min elements, grows the capacity using the growth policy of Array
+     */
+    void ensureCapacity(size_t min) {
+        if (min <= capacity) {
+            return;
+        }
+
+        const size_t length = size();
+        const size_t newCapacity = grownCapacity(capacity, min);
+        const size_t bytes = newCapacity * elementSize;
+
+        if (begin != nullptr) {
+            recordArrayGrowth();
+        }
+
+        void* allocation = reallocateMemory(begin, capacity * elementSize, bytes);
+        recordElementAllocation(bytes);
+
+        if (allocation == nullptr) {
+            RAISE_RUNTIME_ERROR(RuntimeError::OUT_OF_MEMORY, std::bad_alloc {});
+        }
+
+        begin = static_cast<uint8_t*>(allocation);
+        back = begin + length * elementSize;
+        capacity = newCapacity;
+    }
+};
+
+#endif //SPEEDYJS_RUNTIME_VALUE_ARRAY_H
@@ -0,0 +1,104 @@
+//
+// Work stealing deque (Chase-Lev) used by the parallel kernels to balance the work between the workers.
+//
+
+#ifndef SPEEDYJS_RUNTIME_WORK_STEALING_H
+#define SPEEDYJS_RUNTIME_WORK_STEALING_H
+
+#include <atomic>
+#include <cstddef>
+#include <stdint.h>
+
+/**
+ * Bounded work stealing deque as described by Chase and Lev ("Dynamic Circular Work-Stealing Deque"), using the
+ * sequentially consistent variant of Lê et al. ("Correct and Efficient Work-Stealing for Weak Memory Models").
+ * The owner pushes and pops at the bottom, other workers steal from the top. The deque does not grow, push fails if it is full
+ * (the owner then executes the task itself).
+ * @tparam T the task type, needs to be trivially copyable as the tasks are stored in atomics
+ * @tparam CAPACITY the maximal number of tasks, needs to be a power of two
+ */
+template<typename T, size_t CAPACITY = 256>
+class WorkStealingDeque {
+    static_assert(CAPACITY > 0 && (CAPACITY & (CAPACITY - 1)) == 0, "The capacity needs to be a power of two");
+
+private:
+    std::atomic<int64_t> top;
+    std::atomic<int64_t> bottom;
+    std::atomic<T> tasks[CAPACITY];
+
+public:
+    WorkStealingDeque() : top { 0 }, bottom { 0 } {
+    }
+
+    WorkStealingDeque(const WorkStealingDeque&) = delete;
+    WorkStealingDeque& operator=(const WorkStealingDeque&) = delete;
+
+    /**
+     * Adds a task at the bottom, may only be called by the owner
+     * @return false if the deque is full
+     */
+    bool push(T task) {
+        const int64_t b = bottom.load();
+        const int64_t t = top.load();
+
+        if (b - t >= static_cast<int64_t>(CAPACITY)) {
+            return false;
+        }
+
+        tasks[b & (CAPACITY - 1)].store(task);
+        bottom.store(b + 1);
+        return true;
+    }
+
+    /**
+     * Removes the task at the bottom, may only be called by the owner
+     * @param task the removed task
+     * @return false if the deque is empty (or the last task has been stolen)
+     */
+    bool pop(T& task) {
+        const int64_t b = bottom.load() - 1;
+        bottom.store(b);
+        int64_t t = top.load();
+
+        if (t > b) {
+            bottom.store(b + 1);
+            return false;
+        }
+
+        task = tasks[b & (CAPACITY - 1)].load();
+        if (t < b) {
+            return true;
+        }
+
+        // Last task, race against the thieves
+        const bool won = top.compare_exchange_strong(t, t + 1);
+        bottom.store(b + 1);
+        return won;
+    }
+
+    /**
+     * Removes the task at the top, may be called by any worker
+     * @param task the stolen task
+     * @return false if the deque is empty or another worker won the race for the task
+     */
+    bool steal(T& task) {
+        int64_t t = top.load();
+        const int64_t b = bottom.load();
+
+        if (t >= b) {
+            return false;
+        }
+
+        task = tasks[t & (CAPACITY - 1)].load();
+        return top.compare_exchange_strong(t, t + 1);
+    }
+
+    /**
+     * Returns true if the deque has no tasks (the result might be outdated if other workers access the deque)
+     */
+    bool empty() const {
+        return bottom.load() <= top.load();
+    }
+};
+
+#endif //SPEEDYJS_RUNTIME_WORK_STEALING_H
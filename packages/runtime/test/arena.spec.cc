@@ -0,0 +1,174 @@
+//
+// Tests for the bump allocator used by the arena runtime variants.
+//
+
+#include <cstring>
+#include "gtest/gtest.h"
+#include "../lib/arena.h"
+
+class ArenaTests: public ::testing::Test {
+public:
+    Arena* arena;
+
+    void SetUp() {
+        arena = new Arena();
+    }
+
+    void TearDown() {
+        // Leaks the retained chunks, the arena has no destructor by design
+        delete arena;
+    }
+};
+
+// -----------------------------------------
+// allocate
+// -----------------------------------------
+
+TEST_F(ArenaTests, allocate_returns_aligned_memory) {
+    auto first = arena->allocate(3);
+    auto second = arena->allocate(5);
+
+    ASSERT_NE(first, nullptr);
+    ASSERT_NE(second, nullptr);
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(first) % ARENA_ALIGNMENT, 0u);
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(second) % ARENA_ALIGNMENT, 0u);
+    EXPECT_NE(first, second);
+}
+
+TEST_F(ArenaTests, allocate_returns_non_null_for_empty_allocations) {
+    EXPECT_NE(arena->allocate(0), nullptr);
+}
+
+TEST_F(ArenaTests, allocate_bumps_the_pointer) {
+    auto first = static_cast<char*>(arena->allocate(16));
+    auto second = static_cast<char*>(arena->allocate(16));
+
+    EXPECT_EQ(second, first + 16);
+}
+
+TEST_F(ArenaTests, allocate_uses_a_new_chunk_if_the_current_chunk_is_full) {
+    arena->allocate(ARENA_CHUNK_SIZE - 8);
+    arena->allocate(16);
+
+    EXPECT_EQ(arena->reservedBytes() > 2 * ARENA_CHUNK_SIZE, true);
+}
+
+TEST_F(ArenaTests, allocate_serves_allocations_larger_than_a_chunk) {
+    auto allocation = static_cast<char*>(arena->allocate(3 * ARENA_CHUNK_SIZE));
+
+    ASSERT_NE(allocation, nullptr);
+    std::memset(allocation, 1, 3 * ARENA_CHUNK_SIZE);
+    EXPECT_EQ(allocation[3 * ARENA_CHUNK_SIZE - 1], 1);
+}
+
+// -----------------------------------------
+// reallocate
+// -----------------------------------------
+
+TEST_F(ArenaTests, reallocate_allocates_if_the_allocation_is_the_nullptr) {
+    EXPECT_NE(arena->reallocate(nullptr, 0, 16), nullptr);
+}
+
+TEST_F(ArenaTests, reallocate_grows_the_last_allocation_in_place) {
+    auto allocation = arena->allocate(16);
+
+    auto reallocated = arena->reallocate(allocation, 16, 64);
+    auto next = static_cast<char*>(arena->allocate(8));
+
+    EXPECT_EQ(reallocated, allocation);
+    EXPECT_EQ(next, static_cast<char*>(allocation) + 64);
+}
+
+TEST_F(ArenaTests, reallocate_copies_the_content_if_the_allocation_is_not_the_last) {
+    auto allocation = static_cast<int32_t*>(arena->allocate(2 * sizeof(int32_t)));
+    allocation[0] = 1;
+    allocation[1] = 2;
+    arena->allocate(8);
+
+    auto reallocated = static_cast<int32_t*>(arena->reallocate(allocation, 2 * sizeof(int32_t), 4 * sizeof(int32_t)));
+
+    EXPECT_NE(reallocated, allocation);
+    EXPECT_EQ(reallocated[0], 1);
+    EXPECT_EQ(reallocated[1], 2);
+}
+
+TEST_F(ArenaTests, reallocate_keeps_the_allocation_when_shrinking) {
+    auto allocation = arena->allocate(64);
+    arena->allocate(8);
+
+    EXPECT_EQ(arena->reallocate(allocation, 64, 16), allocation);
+}
+
+// -----------------------------------------
+// release
+// -----------------------------------------
+
+TEST_F(ArenaTests, release_reclaims_the_last_allocation) {
+    auto allocation = arena->allocate(32);
+
+    arena->release(allocation, 32);
+
+    EXPECT_EQ(arena->allocate(8), allocation);
+}
+
+TEST_F(ArenaTests, release_does_not_reclaim_other_allocations) {
+    auto first = arena->allocate(32);
+    auto second = static_cast<char*>(arena->allocate(32));
+
+    arena->release(first, 32);
+
+    EXPECT_EQ(arena->allocate(8), second + 32);
+}
+
+// -----------------------------------------
+// reset
+// -----------------------------------------
+
+TEST_F(ArenaTests, reset_reuses_the_retained_chunks) {
+    auto allocation = arena->allocate(32);
+    arena->allocate(ARENA_CHUNK_SIZE);
+    const auto reserved = arena->reservedBytes();
+
+    arena->reset();
+
+    EXPECT_EQ(arena->allocate(32), allocation);
+    EXPECT_EQ(arena->reservedBytes(), reserved);
+}
+
+TEST_F(ArenaTests, reset_frees_oversized_chunks) {
+    arena->allocate(16);
+    const auto reserved = arena->reservedBytes();
+    arena->allocate(2 * ARENA_CHUNK_SIZE);
+
+    arena->reset();
+
+    EXPECT_EQ(arena->reservedBytes(), reserved);
+}
+
+// -----------------------------------------
+// freeze
+// -----------------------------------------
+
+TEST_F(ArenaTests, reset_keeps_the_frozen_allocations) {
+    auto frozen = static_cast<char*>(arena->allocate(16));
+    std::memset(frozen, 7, 16);
+    arena->freeze();
+    auto released = arena->allocate(32);
+
+    arena->reset();
+
+    EXPECT_EQ(arena->allocate(32), released);
+    EXPECT_EQ(frozen[15], 7);
+}
+
+TEST_F(ArenaTests, reset_keeps_the_frozen_oversized_chunks) {
+    arena->allocate(16);
+    arena->allocate(2 * ARENA_CHUNK_SIZE);
+    arena->freeze();
+    const auto reserved = arena->reservedBytes();
+    arena->allocate(2 * ARENA_CHUNK_SIZE);
+
+    arena->reset();
+
+    EXPECT_EQ(arena->reservedBytes(), reserved);
+}
@@ -132,6 +132,38 @@ TEST_F(ArrayTests, set_throws_if_the_index_is_negative) {
     EXPECT_THROW(array->set(-3, 34), std::out_of_range);
 }
 
+// -----------------------------------------
+// getUnchecked / setUnchecked
+// -----------------------------------------
+
+TEST_F(ArrayTests, setUnchecked_changes_the_value_at_the_given_index) {
+    array = new Array<double>(100);
+
+    // act
+    array->setUnchecked(0, 10);
+    array->setUnchecked(99, 100);
+
+    // assert
+    EXPECT_EQ(array->getUnchecked(0), 10);
+    EXPECT_EQ(array->getUnchecked(99), 100);
+    EXPECT_EQ(array->get(99), 100);
+}
+
+TEST_F(ArrayTests, setUnchecked_copies_shared_storage_before_writing) {
+    double elements[100] = { 0 };
+    array = new Array<double>(elements, 100);
+    Array<double>* view = array->slice(10, 90);
+
+    // act
+    view->setUnchecked(0, 42);
+
+    // assert
+    EXPECT_EQ(view->getUnchecked(0), 42);
+    EXPECT_EQ(array->getUnchecked(10), 0);
+
+    delete view;
+}
+
 // -----------------------------------------
 // resize
 // -----------------------------------------
@@ -174,6 +206,21 @@ TEST_F(ArrayTests, fill_sets_all_values_to_the_given_constant) {
     EXPECT_EQ(array->get(9), 5.0);
 }
 
+TEST_F(ArrayTests, fill_sets_the_values_of_arrays_that_are_filled_in_parallel) {
+    const int32_t count = 5 * PARALLEL_GRAIN_SIZE + 17;
+    array = new Array<double>(count);
+
+    // act
+    array->fill(5.0, 3, count - 3);
+
+    // assert
+    EXPECT_EQ(array->get(2), 0.0);
+    for (int32_t i = 3; i < count - 3; ++i) {
+        ASSERT_EQ(array->get(i), 5.0);
+    }
+    EXPECT_EQ(array->get(count - 3), 0.0);
+}
+
 TEST_F(ArrayTests, fill_sets_the_values_from_the_defined_start_position) {
     array = new Array<double>(10);
 
@@ -273,6 +320,35 @@ TEST_F(ArrayTests, fill_does_not_change_the_array_if_end_is_less_than_start) {
     EXPECT_EQ(array->get(3), 0);
 }
 
+// -----------------------------------------
+// REVERSE
+// -----------------------------------------
+
+TEST_F(ArrayTests, reverse_reverses_the_elements_in_place) {
+    double elements[5] = { 1, 2, 3, 4, 5 };
+    array = new Array<double>(elements, 5);
+
+    // act
+    array->reverse();
+
+    // assert
+    EXPECT_EQ(array->get(0), 5);
+    EXPECT_EQ(array->get(1), 4);
+    EXPECT_EQ(array->get(2), 3);
+    EXPECT_EQ(array->get(3), 2);
+    EXPECT_EQ(array->get(4), 1);
+}
+
+TEST_F(ArrayTests, reverse_is_a_noop_for_an_empty_array) {
+    array = new Array<double>();
+
+    // act
+    array->reverse();
+
+    // assert
+    EXPECT_EQ(array->length(), 0);
+}
+
 // -----------------------------------------
 // PUSH
 // -----------------------------------------
@@ -323,6 +399,21 @@ TEST_F(ArrayTests, push_returns_the_new_array_length) {
     EXPECT_EQ(array->push(elements, 2), 7);
 }
 
+TEST_F(ArrayTests, push_single_element_appends_it_and_grows_the_array) {
+    array = new Array<double>();
+
+    // act
+    for (int i = 0; i < 100; ++i) {
+        EXPECT_EQ(array->push(static_cast<double>(i)), i + 1);
+    }
+
+    // assert
+    EXPECT_EQ(array->length(), 100);
+    for (int i = 0; i < 100; ++i) {
+        EXPECT_EQ(array->get(i), i);
+    }
+}
+
 // -----------------------------------------
 // UNSHIFT
 // -----------------------------------------
@@ -347,6 +438,23 @@ TEST_F(ArrayTests, unshift_returns_the_new_size_of_the_array) {
     EXPECT_EQ(array->unshift(toAdd, 2), 7);
 }
 
+TEST_F(ArrayTests, unshift_single_element_adds_it_to_the_beginning) {
+    double elements[2] = { 1, 2 };
+    array = new Array<double>(elements, 2);
+
+    // act
+    for (int i = 0; i < 50; ++i) {
+        EXPECT_EQ(array->unshift(static_cast<double>(-i)), i + 3);
+    }
+
+    // assert
+    EXPECT_EQ(array->length(), 52);
+    EXPECT_EQ(array->get(0), -49);
+    EXPECT_EQ(array->get(49), 0);
+    EXPECT_EQ(array->get(50), 1);
+    EXPECT_EQ(array->get(51), 2);
+}
+
 TEST_F(ArrayTests, unshift_moves_the_existing_elements_to_the_back) {
     array = new Array<double>(5);
     array->set(0, 1);
@@ -380,6 +488,57 @@ TEST_F(ArrayTests, unshift_resizes_the_container_if_necessary) {
     EXPECT_EQ(array->get(0), 1);
 }
 
+TEST_F(ArrayTests, unshift_many_elements_keeps_the_order) {
+    array = new Array<double>();
+
+    // act
+    for (int32_t i = 0; i < 1000; ++i) {
+        double toAdd[1] = { static_cast<double>(i) };
+        array->unshift(toAdd, 1);
+    }
+
+    // assert
+    EXPECT_EQ(array->length(), 1000);
+    for (int32_t i = 0; i < 1000; ++i) {
+        EXPECT_EQ(array->get(i), 999 - i);
+    }
+}
+
+TEST_F(ArrayTests, unshift_uses_the_gap_left_by_shift) {
+    double elements[4] = { 1, 2, 3, 4 };
+    double toAdd[1] = { 5 };
+    array = new Array<double>(elements, 4);
+
+    // act
+    array->shift();
+    array->unshift(toAdd, 1);
+
+    // assert
+    EXPECT_TRUE(array->usesInlineStorage());
+    EXPECT_EQ(array->get(0), 5);
+    EXPECT_EQ(array->get(1), 2);
+    EXPECT_EQ(array->get(3), 4);
+}
+
+TEST_F(ArrayTests, unshift_and_pop_used_as_queue_keep_the_elements) {
+    array = new Array<double>();
+
+    // act
+    for (int32_t i = 0; i < 1000; ++i) {
+        double toAdd[1] = { static_cast<double>(i) };
+        array->unshift(toAdd, 1);
+
+        if (i >= 10) {
+            EXPECT_EQ(array->pop(), i - 10);
+        }
+    }
+
+    // assert
+    EXPECT_EQ(array->length(), 10);
+    EXPECT_EQ(array->get(0), 999);
+    EXPECT_EQ(array->get(9), 990);
+}
+
 // -----------------------------------------
 // POP
 // -----------------------------------------
@@ -444,6 +603,65 @@ TEST_F(ArrayTests, shift_returns_the_default_value_if_the_array_is_empty) {
     EXPECT_EQ(array->shift(), 0.0);
 }
 
+TEST_F(ArrayTests, shift_and_push_used_as_queue_keep_the_elements) {
+    array = new Array<double>();
+
+    // act
+    for (int32_t i = 0; i < 1000; ++i) {
+        double toAdd[1] = { static_cast<double>(i) };
+        array->push(toAdd, 1);
+
+        if (i >= 10) {
+            EXPECT_EQ(array->shift(), i - 10);
+        }
+    }
+
+    // assert
+    EXPECT_EQ(array->length(), 10);
+    EXPECT_EQ(array->get(0), 990);
+    EXPECT_EQ(array->get(9), 999);
+}
+
+TEST_F(ArrayTests, shift_of_the_last_element_allows_to_reuse_the_inline_storage) {
+    double elements[4] = { 1, 2, 3, 4 };
+    array = new Array<double>(elements, 4);
+
+    // act
+    for (int32_t i = 0; i < 4; ++i) {
+        array->shift();
+    }
+    array->push(elements, 4);
+
+    // assert
+    EXPECT_TRUE(array->usesInlineStorage());
+    EXPECT_EQ(array->get(0), 1);
+    EXPECT_EQ(array->get(3), 4);
+}
+
+TEST_F(ArrayTests, shift_followed_by_splice_and_resize_keeps_the_elements) {
+    double elements[20] = { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16, 17, 18, 19 };
+    double toAdd[2] = { 100, 101 };
+    array = new Array<double>(elements, 20);
+
+    // act
+    array->shift();
+    array->shift();
+    auto* deleted = array->splice(1, 1, toAdd, 2);
+    array->resize(40);
+
+    // assert
+    EXPECT_EQ(array->length(), 40);
+    EXPECT_EQ(array->get(0), 2);
+    EXPECT_EQ(array->get(1), 100);
+    EXPECT_EQ(array->get(2), 101);
+    EXPECT_EQ(array->get(3), 4);
+    EXPECT_EQ(array->get(18), 19);
+    EXPECT_EQ(array->get(19), 0);
+    EXPECT_EQ(deleted->get(0), 3);
+
+    delete deleted;
+}
+
 // -----------------------------------------
 // slice
 // -----------------------------------------
@@ -552,6 +770,114 @@ TEST_F(ArrayTests, slice_returns_an_empty_array_if_start_is_larger_than_the_end)
     delete copy;
 }
 
+TEST_F(ArrayTests, slice_copies_small_slices_into_the_inline_storage) {
+    double elements[10] = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10};
+    array = new Array<double>(elements, 10);
+
+    // act
+    Array<double>* copy = array->slice(2, 4);
+
+    // assert
+    EXPECT_FALSE(copy->isShared());
+    EXPECT_TRUE(copy->usesInlineStorage());
+    EXPECT_FALSE(array->isShared());
+
+    delete copy;
+}
+
+TEST_F(ArrayTests, slice_returns_a_view_sharing_the_elements_for_large_slices) {
+    double elements[10] = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10};
+    array = new Array<double>(elements, 10);
+
+    // act
+    Array<double>* view = array->slice(2, 9);
+
+    // assert
+    EXPECT_TRUE(view->isShared());
+    EXPECT_TRUE(array->isShared());
+    EXPECT_EQ(view->length(), 7);
+    EXPECT_EQ(view->get(0), 3);
+    EXPECT_EQ(view->get(6), 9);
+
+    delete view;
+}
+
+TEST_F(ArrayTests, slice_view_copies_the_elements_on_the_first_write) {
+    double elements[10] = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10};
+    array = new Array<double>(elements, 10);
+    Array<double>* view = array->slice(2, 9);
+
+    // act
+    view->set(0, 100);
+
+    // assert
+    EXPECT_FALSE(view->isShared());
+    EXPECT_EQ(view->get(0), 100);
+    EXPECT_EQ(view->get(1), 4);
+    EXPECT_EQ(array->get(2), 3);
+
+    delete view;
+}
+
+TEST_F(ArrayTests, slice_view_is_not_affected_if_the_parent_is_modified) {
+    double elements[10] = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10};
+    double toAdd[1] = { 11 };
+    array = new Array<double>(elements, 10);
+    Array<double>* view = array->slice(0, 9);
+
+    // act
+    array->set(0, 100);
+    array->fill(0, 4);
+    array->sort();
+
+    // assert
+    EXPECT_FALSE(array->isShared());
+    EXPECT_EQ(view->get(0), 1);
+    EXPECT_EQ(view->get(8), 9);
+
+    view->push(toAdd, 1);
+    EXPECT_EQ(view->get(9), 11);
+
+    delete view;
+}
+
+TEST_F(ArrayTests, slice_view_does_not_override_the_parent_elements_when_pushing) {
+    double elements[10] = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10};
+    double toAdd[1] = { 100 };
+    array = new Array<double>(elements, 10);
+    Array<double>* view = array->slice(0, 6);
+
+    // act
+    view->push(toAdd, 1);
+
+    // assert
+    EXPECT_EQ(view->get(6), 100);
+    EXPECT_EQ(array->get(6), 7);
+
+    delete view;
+}
+
+TEST_F(ArrayTests, slice_of_a_view_shares_the_elements) {
+    double elements[20] = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16, 17, 18, 19};
+    array = new Array<double>(elements, 20);
+    Array<double>* view = array->slice(2);
+
+    // act
+    Array<double>* nested = view->slice(5);
+    view->pop();
+    view->shift();
+
+    // assert
+    EXPECT_TRUE(nested->isShared());
+    EXPECT_EQ(nested->length(), 13);
+    EXPECT_EQ(nested->get(0), 7);
+    EXPECT_EQ(nested->get(12), 19);
+    EXPECT_EQ(view->get(0), 3);
+
+    delete nested;
+    delete view;
+}
+
 // -----------------------------------------
 // splice
 // -----------------------------------------
@@ -674,6 +1000,37 @@ TEST_F(ArrayTests, splice_returns_an_empty_array_if_the_index_is_out_of_range) {
     delete deleted;
 }
 
+TEST_F(ArrayTests, spliceDiscard_removes_the_elements_and_inserts_the_new_ones) {
+    double elements[5] = {1, 2, 3, 4, 5};
+    double toAdd[3] = {10, 11, 12};
+    array = new Array<double>(elements, 5);
+
+    // act
+    array->spliceDiscard(-4, 2, toAdd, 3);
+
+    // assert
+    EXPECT_EQ(array->length(), 6);
+    EXPECT_EQ(array->get(0), 1);
+    EXPECT_EQ(array->get(1), 10);
+    EXPECT_EQ(array->get(2), 11);
+    EXPECT_EQ(array->get(3), 12);
+    EXPECT_EQ(array->get(4), 4);
+    EXPECT_EQ(array->get(5), 5);
+}
+
+TEST_F(ArrayTests, spliceDiscard_clamps_the_range) {
+    double elements[5] = {1, 2, 3, 4, 5};
+    array = new Array<double>(elements, 5);
+
+    // act
+    array->spliceDiscard(3, 10);
+    array->spliceDiscard(10, 1);
+
+    // assert
+    EXPECT_EQ(array->length(), 3);
+    EXPECT_EQ(array->get(2), 3);
+}
+
 
 // -----------------------------------------
 // size
@@ -684,6 +1041,66 @@ TEST_F(ArrayTests, size_returns_the_size_of_the_array) {
     EXPECT_EQ(array->length(), 5);
 }
 
+// -----------------------------------------
+// inline storage
+// -----------------------------------------
+TEST_F(ArrayTests, new_stores_the_elements_of_small_arrays_inline) {
+    double elements[2] = { 1, 2 };
+    array = new Array<double>(elements, 2);
+
+    // assert
+    EXPECT_TRUE(array->usesInlineStorage());
+    EXPECT_EQ(array->get(1), 2);
+}
+
+TEST_F(ArrayTests, new_allocates_the_elements_of_large_arrays) {
+    array = new Array<double>(1024);
+
+    // assert
+    EXPECT_FALSE(array->usesInlineStorage());
+}
+
+TEST_F(ArrayTests, push_keeps_the_elements_inline_as_long_as_they_fit) {
+    array = new Array<double>();
+    double elements[4] = { 1, 2, 3, 4 };
+
+    // act
+    array->push(elements, 4);
+
+    // assert
+    EXPECT_TRUE(array->usesInlineStorage());
+    EXPECT_EQ(array->length(), 4);
+}
+
+TEST_F(ArrayTests, push_moves_the_elements_out_of_the_inline_storage_if_it_is_full) {
+    double elements[4] = { 1, 2, 3, 4 };
+    array = new Array<double>(elements, 4);
+
+    // act
+    array->push(elements, 4);
+
+    // assert
+    EXPECT_FALSE(array->usesInlineStorage());
+    EXPECT_EQ(array->length(), 8);
+    EXPECT_EQ(array->get(0), 1);
+    EXPECT_EQ(array->get(3), 4);
+    EXPECT_EQ(array->get(7), 4);
+}
+
+TEST_F(ArrayTests, unshift_moves_the_elements_out_of_the_inline_storage_if_it_is_full) {
+    double elements[4] = { 1, 2, 3, 4 };
+    double elementsToAdd[1] = { 0 };
+    array = new Array<double>(elements, 4);
+
+    // act
+    array->unshift(elementsToAdd, 1);
+
+    // assert
+    EXPECT_FALSE(array->usesInlineStorage());
+    EXPECT_EQ(array->get(0), 0);
+    EXPECT_EQ(array->get(4), 4);
+}
+
 // -----------------------------------------
 // resize
 // -----------------------------------------
@@ -718,6 +1135,113 @@ TEST_F(ArrayTests, resize_decreases_the_size_of_the_array_if_the_new_size_is_sma
     EXPECT_EQ(array->length(), 10);
 }
 
+// -----------------------------------------
+// capacity
+// -----------------------------------------
+
+TEST_F(ArrayTests, pop_shrinks_the_capacity_if_the_array_gets_sparse) {
+    array = new Array<double>(1000);
+    array->fill(3.0, 0, 1000);
+
+    // act
+    for (int32_t i = 0; i < 900; ++i) {
+        array->pop();
+    }
+
+    // assert
+    EXPECT_EQ(array->length(), 100);
+#if ARRAY_SHRINK_PERCENT > 0
+    EXPECT_LT(array->totalCapacity(), 1000u);
+#endif
+    EXPECT_GE(array->totalCapacity(), 100u);
+    EXPECT_EQ(array->get(0), 3.0);
+    EXPECT_EQ(array->get(99), 3.0);
+}
+
+TEST_F(ArrayTests, resize_moves_the_elements_back_into_the_inline_storage_if_the_array_gets_small) {
+    array = new Array<double>(100);
+    array->set(1, 5.0);
+
+    // act
+    array->resize(2);
+
+    // assert
+    EXPECT_EQ(array->length(), 2);
+#if ARRAY_SHRINK_PERCENT > 0
+    EXPECT_TRUE(array->usesInlineStorage());
+#endif
+    EXPECT_EQ(array->get(1), 5.0);
+}
+
+TEST_F(ArrayTests, shift_shrinks_the_capacity_and_keeps_the_order) {
+    array = new Array<double>();
+    for (int32_t i = 0; i < 200; ++i) {
+        double value = i;
+        array->push(&value, 1);
+    }
+
+    // act
+    for (int32_t i = 0; i < 180; ++i) {
+        EXPECT_EQ(array->shift(), i);
+    }
+
+    // assert
+    EXPECT_EQ(array->length(), 20);
+    for (int32_t i = 0; i < 20; ++i) {
+        EXPECT_EQ(array->get(i), 180 + i);
+    }
+}
+
+TEST_F(ArrayTests, reservePush_allocates_exactly_the_required_capacity) {
+    array = new Array<double>(10);
+
+    // act
+    array->reservePush(90);
+
+    // assert
+    EXPECT_EQ(array->totalCapacity(), 100u);
+    EXPECT_EQ(array->length(), 10);
+
+    for (int32_t i = 0; i < 90; ++i) {
+        double value = i;
+        array->push(&value, 1);
+    }
+
+    EXPECT_EQ(array->totalCapacity(), 100u);
+    EXPECT_EQ(array->get(99), 89);
+}
+
+TEST_F(ArrayTests, reservePush_ignores_non_positive_counts) {
+    array = new Array<double>(10);
+
+    // act
+    array->reservePush(0);
+    array->reservePush(-5);
+
+    // assert
+    EXPECT_TRUE(array->usesInlineStorage() || array->totalCapacity() == 10u);
+    EXPECT_EQ(array->length(), 10);
+}
+
+TEST_F(ArrayTests, reservePush_on_a_view_does_not_change_the_parent) {
+    array = new Array<double>(100);
+    array->fill(1.0, 0, 100);
+    auto* view = array->slice(10, 60);
+
+    // act
+    view->reservePush(50);
+    double value = 7.0;
+    view->push(&value, 1);
+
+    // assert
+    EXPECT_FALSE(view->isShared());
+    EXPECT_EQ(view->length(), 51);
+    EXPECT_EQ(view->get(50), 7.0);
+    EXPECT_EQ(array->get(60), 1.0);
+
+    delete view;
+}
+
 // -----------------------------------------
 // sort
 // -----------------------------------------
@@ -736,6 +1260,55 @@ TEST_F(ArrayTests, sort_sorts_the_array_in_ascending_order) {
     EXPECT_EQ(array->get(4), 48.53);
 }
 
+TEST_F(ArrayTests, sortDescending_sorts_the_array_in_descending_order) {
+    double elements[5] = { 8.3, 2.3, 48.53, 28.4, 21.2 };
+    array = new Array<double>(elements, 5);
+
+    // act
+    array->sortDescending();
+
+    // expect
+    EXPECT_EQ(array->get(0), 48.53);
+    EXPECT_EQ(array->get(1), 28.4);
+    EXPECT_EQ(array->get(2), 21.2);
+    EXPECT_EQ(array->get(3), 8.3);
+    EXPECT_EQ(array->get(4), 2.3);
+}
+
+TEST_F(ArrayTests, sort_does_not_change_the_elements_of_the_parent_of_a_view) {
+    array = new Array<double>(200);
+    for (int32_t i = 0; i < 200; ++i) {
+        array->set(i, 200 - i);
+    }
+    auto* view = array->slice(0, 100);
+
+    // act
+    view->sort();
+
+    // expect
+    EXPECT_EQ(view->get(0), 101);
+    EXPECT_EQ(view->get(99), 200);
+    EXPECT_EQ(array->get(0), 200);
+
+    delete view;
+}
+
+TEST_F(ArrayTests, sort_sorts_arrays_that_are_sorted_in_parallel) {
+    const int32_t count = 5 * PARALLEL_GRAIN_SIZE + 17;
+    array = new Array<double>(count);
+    for (int32_t i = 0; i < count; ++i) {
+        array->set(i, (i * 7919) % count);
+    }
+
+    // act
+    array->sort();
+
+    // expect
+    for (int32_t i = 0; i < count; ++i) {
+        ASSERT_EQ(array->get(i), i);
+    }
+}
+
 TEST_F(ArrayTests, sort_uses_the_given_comparator) {
     double elements[5] = { 8.3, 2.3, 48.53, 28.4, 21.2 };
     array = new Array<double>(elements, 5);
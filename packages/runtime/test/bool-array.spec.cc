@@ -0,0 +1,369 @@
+//
+// Tests for the bit packed Array<bool> specialization.
+//
+
+#include "gtest/gtest.h"
+#include "../lib/array.h"
+
+class BoolArrayTests: public ::testing::Test {
+public:
+    Array<bool>* array;
+
+    void SetUp() {
+        array = nullptr;
+    }
+
+    void TearDown() {
+        if (array != nullptr) {
+            delete array;
+        }
+    }
+
+    /**
+     * Creates an array where every third element is true
+     */
+    static Array<bool>* createPattern(size_t length) {
+        bool elements[1024];
+        for (size_t i = 0; i < length; ++i) {
+            elements[i] = i % 3 == 0;
+        }
+
+        return new Array<bool>(elements, length);
+    }
+};
+
+// -----------------------------------------
+// new
+// -----------------------------------------
+
+TEST_F(BoolArrayTests, new_initializes_all_elements_with_false) {
+    array = new Array<bool>(1000);
+
+    EXPECT_EQ(array->length(), 1000);
+    EXPECT_EQ(array->countTrue(), 0u);
+    EXPECT_FALSE(array->usesInlineStorage());
+}
+
+TEST_F(BoolArrayTests, new_stores_up_to_256_elements_inline) {
+    array = new Array<bool>(256);
+
+    EXPECT_TRUE(array->usesInlineStorage());
+}
+
+TEST_F(BoolArrayTests, new_packs_the_passed_elements) {
+    array = createPattern(100);
+
+    // assert
+    EXPECT_EQ(array->length(), 100);
+    for (int32_t i = 0; i < 100; ++i) {
+        EXPECT_EQ(array->get(i), i % 3 == 0);
+    }
+}
+
+// -----------------------------------------
+// GET / SET
+// -----------------------------------------
+
+TEST_F(BoolArrayTests, get_returns_false_for_out_of_bound_indices) {
+    array = createPattern(10);
+
+    EXPECT_FALSE(array->get(-3));
+    EXPECT_FALSE(array->get(12));
+}
+
+TEST_F(BoolArrayTests, set_only_changes_the_element_at_the_index) {
+    array = new Array<bool>(100);
+
+    // act
+    array->set(33, true);
+
+    // assert
+    EXPECT_TRUE(array->get(33));
+    EXPECT_FALSE(array->get(32));
+    EXPECT_FALSE(array->get(34));
+    EXPECT_EQ(array->countTrue(), 1u);
+
+    array->set(33, false);
+    EXPECT_EQ(array->countTrue(), 0u);
+}
+
+TEST_F(BoolArrayTests, setUnchecked_only_changes_the_element_at_the_index) {
+    array = new Array<bool>(100);
+
+    // act
+    array->setUnchecked(64, true);
+
+    // assert
+    EXPECT_TRUE(array->getUnchecked(64));
+    EXPECT_FALSE(array->getUnchecked(63));
+    EXPECT_FALSE(array->getUnchecked(65));
+    EXPECT_EQ(array->countTrue(), 1u);
+}
+
+TEST_F(BoolArrayTests, set_throws_for_out_of_bound_indices) {
+    array = new Array<bool>(10);
+
+    EXPECT_THROW(array->set(10, true), std::out_of_range);
+    EXPECT_THROW(array->set(-1, true), std::out_of_range);
+}
+
+// -----------------------------------------
+// FILL
+// -----------------------------------------
+
+TEST_F(BoolArrayTests, fill_sets_the_values_in_between_start_and_end) {
+    array = new Array<bool>(200);
+
+    // act
+    array->fill(true, 3, 170);
+
+    // assert
+    EXPECT_EQ(array->countTrue(), 167u);
+    EXPECT_FALSE(array->get(2));
+    EXPECT_TRUE(array->get(3));
+    EXPECT_TRUE(array->get(169));
+    EXPECT_FALSE(array->get(170));
+}
+
+TEST_F(BoolArrayTests, fill_sets_the_values_within_a_single_word) {
+    array = new Array<bool>(32);
+
+    // act
+    array->fill(true, 5, 9);
+
+    // assert
+    EXPECT_EQ(array->countTrue(), 4u);
+    EXPECT_TRUE(array->get(5));
+    EXPECT_TRUE(array->get(8));
+}
+
+TEST_F(BoolArrayTests, fill_clamps_to_the_array_length) {
+    array = new Array<bool>(40);
+
+    // act
+    array->fill(true, -8, 100);
+
+    // assert
+    EXPECT_EQ(array->countTrue(), 8u);
+    EXPECT_TRUE(array->get(32));
+    EXPECT_TRUE(array->get(39));
+}
+
+// -----------------------------------------
+// sort / reverse
+// -----------------------------------------
+
+TEST_F(BoolArrayTests, sort_orders_false_before_true) {
+    array = createPattern(100);
+
+    // act
+    array->sort();
+
+    // assert
+    EXPECT_FALSE(array->get(65));
+    EXPECT_TRUE(array->get(66));
+    EXPECT_TRUE(array->get(99));
+    EXPECT_EQ(array->countTrue(), 34u);
+}
+
+TEST_F(BoolArrayTests, sort_uses_the_order_of_the_comparator) {
+    array = createPattern(100);
+
+    // act
+    array->sort([](bool a, bool b) { return static_cast<double>(b) - static_cast<double>(a); });
+
+    // assert
+    EXPECT_TRUE(array->get(33));
+    EXPECT_FALSE(array->get(34));
+    EXPECT_EQ(array->countTrue(), 34u);
+}
+
+TEST_F(BoolArrayTests, reverse_reverses_the_elements) {
+    for (size_t length = 0; length < 100; ++length) {
+        auto* reversed = createPattern(length);
+
+        // act
+        reversed->reverse();
+
+        // assert
+        for (size_t i = 0; i < length; ++i) {
+            EXPECT_EQ(reversed->get(static_cast<int32_t>(i)), (length - i - 1) % 3 == 0);
+        }
+        EXPECT_EQ(reversed->countTrue(), (length + 2) / 3);
+
+        delete reversed;
+    }
+}
+
+// -----------------------------------------
+// push / unshift / pop / shift
+// -----------------------------------------
+
+TEST_F(BoolArrayTests, push_grows_beyond_the_inline_storage) {
+    array = createPattern(250);
+    bool elements[10] = { true, true, false, true, false, false, false, false, false, true };
+
+    // act
+    EXPECT_EQ(array->push(elements, 10), 260);
+
+    // assert
+    EXPECT_FALSE(array->usesInlineStorage());
+    EXPECT_TRUE(array->get(249));
+    EXPECT_TRUE(array->get(250));
+    EXPECT_FALSE(array->get(252));
+    EXPECT_TRUE(array->get(259));
+
+    for (int32_t i = 0; i < 250; ++i) {
+        EXPECT_EQ(array->get(i), i % 3 == 0);
+    }
+}
+
+TEST_F(BoolArrayTests, push_single_element_sets_the_bit_after_the_last_element) {
+    array = createPattern(31);
+
+    // act
+    EXPECT_EQ(array->push(true), 32);
+    EXPECT_EQ(array->push(false), 33);
+    EXPECT_EQ(array->push(true), 34);
+
+    // assert
+    EXPECT_TRUE(array->get(31));
+    EXPECT_FALSE(array->get(32));
+    EXPECT_TRUE(array->get(33));
+    EXPECT_FALSE(array->get(34));
+}
+
+TEST_F(BoolArrayTests, unshift_moves_the_existing_elements_back) {
+    array = createPattern(70);
+    bool elements[3] = { false, true, true };
+
+    // act
+    EXPECT_EQ(array->unshift(elements, 3), 73);
+
+    // assert
+    EXPECT_FALSE(array->get(0));
+    EXPECT_TRUE(array->get(1));
+    EXPECT_TRUE(array->get(2));
+    for (int32_t i = 0; i < 70; ++i) {
+        EXPECT_EQ(array->get(i + 3), i % 3 == 0);
+    }
+}
+
+TEST_F(BoolArrayTests, pop_removes_the_last_element) {
+    array = createPattern(34);
+
+    EXPECT_TRUE(array->pop());
+    EXPECT_EQ(array->length(), 33);
+    EXPECT_FALSE(array->pop());
+    EXPECT_EQ(array->countTrue(), 11u);
+}
+
+TEST_F(BoolArrayTests, pop_returns_false_for_an_empty_array) {
+    array = new Array<bool>();
+
+    EXPECT_FALSE(array->pop());
+    EXPECT_EQ(array->length(), 0);
+}
+
+TEST_F(BoolArrayTests, shift_removes_the_first_element) {
+    array = createPattern(70);
+
+    // act
+    EXPECT_TRUE(array->shift());
+
+    // assert
+    EXPECT_EQ(array->length(), 69);
+    for (int32_t i = 0; i < 69; ++i) {
+        EXPECT_EQ(array->get(i), (i + 1) % 3 == 0);
+    }
+    EXPECT_FALSE(array->get(69));
+}
+
+// -----------------------------------------
+// slice / splice
+// -----------------------------------------
+
+TEST_F(BoolArrayTests, slice_copies_the_elements_in_between_start_and_end) {
+    array = createPattern(100);
+
+    // act
+    auto* sliced = array->slice(31, 80);
+
+    // assert
+    EXPECT_EQ(sliced->length(), 49);
+    for (int32_t i = 0; i < 49; ++i) {
+        EXPECT_EQ(sliced->get(i), (i + 31) % 3 == 0);
+    }
+
+    delete sliced;
+}
+
+TEST_F(BoolArrayTests, splice_removes_and_inserts_the_elements) {
+    array = createPattern(100);
+    bool elements[2] = { true, true };
+
+    // act
+    auto* deleted = array->splice(10, 5, elements, 2);
+
+    // assert
+    EXPECT_EQ(deleted->length(), 5);
+    EXPECT_FALSE(deleted->get(0));
+    EXPECT_FALSE(deleted->get(1));
+    EXPECT_TRUE(deleted->get(2));
+
+    EXPECT_EQ(array->length(), 97);
+    EXPECT_TRUE(array->get(9));
+    EXPECT_TRUE(array->get(10));
+    EXPECT_TRUE(array->get(11));
+    for (int32_t i = 15; i < 100; ++i) {
+        EXPECT_EQ(array->get(i - 3), i % 3 == 0);
+    }
+    EXPECT_FALSE(array->get(97));
+
+    delete deleted;
+}
+
+TEST_F(BoolArrayTests, spliceDiscard_removes_and_inserts_the_elements) {
+    array = createPattern(100);
+    bool elements[2] = { true, true };
+
+    // act
+    array->spliceDiscard(10, 5, elements, 2);
+
+    // assert
+    EXPECT_EQ(array->length(), 97);
+    EXPECT_TRUE(array->get(9));
+    EXPECT_TRUE(array->get(10));
+    EXPECT_TRUE(array->get(11));
+    for (int32_t i = 15; i < 100; ++i) {
+        EXPECT_EQ(array->get(i - 3), i % 3 == 0);
+    }
+}
+
+// -----------------------------------------
+// resize
+// -----------------------------------------
+
+TEST_F(BoolArrayTests, resize_clears_the_removed_elements) {
+    array = createPattern(100);
+
+    // act
+    array->resize(10);
+    array->resize(100);
+
+    // assert
+    EXPECT_EQ(array->countTrue(), 4u);
+    EXPECT_FALSE(array->get(12));
+}
+
+TEST_F(BoolArrayTests, reservePush_keeps_the_elements) {
+    array = createPattern(100);
+
+    // act
+    array->reservePush(1000);
+
+    // assert
+    EXPECT_FALSE(array->usesInlineStorage());
+    EXPECT_EQ(array->length(), 100);
+    EXPECT_EQ(array->countTrue(), 34u);
+}
@@ -0,0 +1,100 @@
+//
+// Tests for the number conversions.
+//
+
+#include <cmath>
+#include <limits>
+#include <random>
+#include "gtest/gtest.h"
+
+extern "C" int32_t toInt32d(double value);
+extern "C" uint32_t toUint32d(double value);
+
+static const double NaN = std::numeric_limits<double>::quiet_NaN();
+static const double Infinity = std::numeric_limits<double>::infinity();
+
+/**
+ * ToUint32 as defined in the spec: truncate and compute the modulo 2^32
+ */
+static uint32_t referenceToUint32(double value) {
+    if (std::isnan(value) || std::isinf(value)) {
+        return 0;
+    }
+
+    double modulo = std::fmod(std::trunc(value), 4294967296.0);
+    if (modulo < 0) {
+        modulo += 4294967296.0;
+    }
+
+    return static_cast<uint32_t>(modulo);
+}
+
+// -----------------------------------------
+// toUint32d
+// -----------------------------------------
+
+TEST(ConversionTests, toUint32d_truncates_the_value) {
+    EXPECT_EQ(toUint32d(0.0), 0u);
+    EXPECT_EQ(toUint32d(-0.0), 0u);
+    EXPECT_EQ(toUint32d(3.7), 3u);
+    EXPECT_EQ(toUint32d(-0.5), 0u);
+    EXPECT_EQ(toUint32d(4294967295.0), 4294967295u);
+}
+
+TEST(ConversionTests, toUint32d_wraps_values_outside_of_the_uint32_range) {
+    EXPECT_EQ(toUint32d(-1.0), 4294967295u);
+    EXPECT_EQ(toUint32d(-3.7), 4294967293u);
+    EXPECT_EQ(toUint32d(4294967296.0), 0u);
+    EXPECT_EQ(toUint32d(4294967301.5), 5u);
+}
+
+TEST(ConversionTests, toUint32d_wraps_values_outside_of_the_int64_range) {
+    EXPECT_EQ(toUint32d(9223372036854775808.0), 0u);
+    EXPECT_EQ(toUint32d(std::ldexp(3.0, 62) + std::ldexp(1.0, 31)), referenceToUint32(std::ldexp(3.0, 62) + std::ldexp(1.0, 31)));
+    EXPECT_EQ(toUint32d(std::ldexp(-5.0, 63) - std::ldexp(7.0, 32)), referenceToUint32(std::ldexp(-5.0, 63) - std::ldexp(7.0, 32)));
+    EXPECT_EQ(toUint32d(std::ldexp(1.0, 83) + std::ldexp(1.0, 31)), 2147483648u);
+    EXPECT_EQ(toUint32d(std::numeric_limits<double>::max()), 0u);
+    EXPECT_EQ(toUint32d(-std::numeric_limits<double>::max()), 0u);
+}
+
+TEST(ConversionTests, toUint32d_returns_0_for_NaN_and_Infinity) {
+    EXPECT_EQ(toUint32d(NaN), 0u);
+    EXPECT_EQ(toUint32d(Infinity), 0u);
+    EXPECT_EQ(toUint32d(-Infinity), 0u);
+}
+
+TEST(ConversionTests, toUint32d_equals_the_spec_for_random_values) {
+    std::mt19937 random(42);
+    std::uniform_real_distribution<double> mantissas(-1.0, 1.0);
+    std::uniform_int_distribution<int> exponents(-2, 100);
+
+    for (int i = 0; i < 100000; ++i) {
+        const double value = std::ldexp(mantissas(random), exponents(random));
+        ASSERT_EQ(toUint32d(value), referenceToUint32(value)) << value;
+    }
+}
+
+// -----------------------------------------
+// toInt32d
+// -----------------------------------------
+
+TEST(ConversionTests, toInt32d_truncates_the_value) {
+    EXPECT_EQ(toInt32d(3.7), 3);
+    EXPECT_EQ(toInt32d(-3.7), -3);
+    EXPECT_EQ(toInt32d(2147483647.0), INT32_MAX);
+    EXPECT_EQ(toInt32d(-2147483648.0), INT32_MIN);
+}
+
+TEST(ConversionTests, toInt32d_wraps_values_outside_of_the_int32_range) {
+    EXPECT_EQ(toInt32d(2147483648.0), INT32_MIN);
+    EXPECT_EQ(toInt32d(-2147483649.0), INT32_MAX);
+    EXPECT_EQ(toInt32d(4294967297.0), 1);
+    EXPECT_EQ(toInt32d(1e10), 1410065408);
+    EXPECT_EQ(toInt32d(-1e20), -1661992960);
+}
+
+TEST(ConversionTests, toInt32d_returns_0_for_NaN_and_Infinity) {
+    EXPECT_EQ(toInt32d(NaN), 0);
+    EXPECT_EQ(toInt32d(Infinity), 0);
+    EXPECT_EQ(toInt32d(-Infinity), 0);
+}
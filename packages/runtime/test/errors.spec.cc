@@ -0,0 +1,27 @@
+//
+// Tests for the error channel of the runtime.
+//
+
+#include "gtest/gtest.h"
+#include "../lib/errors.h"
+
+extern "C" int32_t speedyJsTakeError();
+
+TEST(ErrorsTests, take_error_returns_none_if_no_error_has_been_raised) {
+    EXPECT_EQ(speedyJsTakeError(), static_cast<int32_t>(RuntimeError::NONE));
+}
+
+TEST(ErrorsTests, take_error_returns_and_resets_the_raised_error) {
+    runtimeError = RuntimeError::INVALID_ARRAY_INDEX;
+
+    EXPECT_EQ(speedyJsTakeError(), static_cast<int32_t>(RuntimeError::INVALID_ARRAY_INDEX));
+    EXPECT_EQ(speedyJsTakeError(), static_cast<int32_t>(RuntimeError::NONE));
+}
+
+TEST(ErrorsTests, raise_runtime_error_traps) {
+    EXPECT_DEATH(raiseRuntimeError(RuntimeError::OUT_OF_MEMORY), "");
+}
+
+TEST(ErrorsTests, raise_runtime_error_macro_throws_the_exception_if_exceptions_are_enabled) {
+    EXPECT_THROW(RAISE_RUNTIME_ERROR(RuntimeError::INVALID_ARRAY_LENGTH, std::out_of_range("Invalid array length")), std::out_of_range);
+}
@@ -0,0 +1,286 @@
+//
+// Tests for the HashMap and HashSet that implement Map and Set for int and number keys.
+//
+
+#include <cmath>
+#include <cstddef>
+#include <vector>
+#include "gtest/gtest.h"
+#include "../lib/hash-map.h"
+
+class HashMapTests: public ::testing::Test {
+public:
+    HashMap<int32_t, int32_t>* map;
+
+    void SetUp() {
+        map = new HashMap<int32_t, int32_t> {};
+    }
+
+    void TearDown() {
+        delete map;
+    }
+
+    std::vector<int32_t> keys() {
+        std::vector<int32_t> result;
+        map->forEach([&result](const HashMapEntry<int32_t, int32_t>& entry) { result.push_back(entry.key); });
+        return result;
+    }
+};
+
+// -----------------------------------------
+// get / set
+// -----------------------------------------
+
+TEST_F(HashMapTests, get_returns_the_value_of_the_key) {
+    map->set(1, 10);
+    map->set(2, 20);
+
+    EXPECT_EQ(map->get(1), 10);
+    EXPECT_EQ(map->get(2), 20);
+    EXPECT_EQ(map->size(), 2);
+}
+
+TEST_F(HashMapTests, get_returns_the_default_value_for_absent_keys) {
+    EXPECT_EQ(map->get(1), 0);
+
+    map->set(1, 10);
+
+    EXPECT_EQ(map->get(2), 0);
+}
+
+TEST_F(HashMapTests, set_overrides_the_value_of_an_existing_key) {
+    map->set(1, 10);
+    map->set(1, 11);
+
+    EXPECT_EQ(map->get(1), 11);
+    EXPECT_EQ(map->size(), 1);
+}
+
+TEST_F(HashMapTests, set_grows_the_table) {
+    for (int32_t i = 0; i < 10000; ++i) {
+        map->set(i * 7, i);
+    }
+
+    EXPECT_EQ(map->size(), 10000);
+    for (int32_t i = 0; i < 10000; ++i) {
+        EXPECT_EQ(map->get(i * 7), i);
+    }
+
+    EXPECT_FALSE(map->has(1));
+}
+
+TEST_F(HashMapTests, set_supports_colliding_and_negative_keys) {
+    // keys that only differ in the high bits
+    map->set(1 << 16, 1);
+    map->set(2 << 16, 2);
+    map->set(-1, 3);
+    map->set(INT32_MIN, 4);
+
+    EXPECT_EQ(map->get(1 << 16), 1);
+    EXPECT_EQ(map->get(2 << 16), 2);
+    EXPECT_EQ(map->get(-1), 3);
+    EXPECT_EQ(map->get(INT32_MIN), 4);
+}
+
+// -----------------------------------------
+// remove
+// -----------------------------------------
+
+TEST_F(HashMapTests, remove_removes_the_entry) {
+    map->set(1, 10);
+    map->set(2, 20);
+
+    EXPECT_TRUE(map->remove(1));
+
+    EXPECT_FALSE(map->has(1));
+    EXPECT_TRUE(map->has(2));
+    EXPECT_EQ(map->size(), 1);
+}
+
+TEST_F(HashMapTests, remove_returns_false_for_absent_keys) {
+    EXPECT_FALSE(map->remove(1));
+
+    map->set(1, 10);
+    map->remove(1);
+
+    EXPECT_FALSE(map->remove(1));
+}
+
+TEST_F(HashMapTests, remove_and_set_reuse_the_capacity) {
+    for (int32_t round = 0; round < 100; ++round) {
+        for (int32_t i = 0; i < 10; ++i) {
+            map->set(round * 10 + i, i);
+        }
+
+        for (int32_t i = 0; i < 10; ++i) {
+            EXPECT_TRUE(map->remove(round * 10 + i));
+        }
+    }
+
+    EXPECT_EQ(map->size(), 0);
+    EXPECT_FALSE(map->has(990));
+}
+
+// -----------------------------------------
+// clear
+// -----------------------------------------
+
+TEST_F(HashMapTests, clear_removes_all_entries) {
+    map->set(1, 10);
+    map->set(2, 20);
+
+    map->clear();
+
+    EXPECT_EQ(map->size(), 0);
+    EXPECT_FALSE(map->has(1));
+
+    map->set(2, 21);
+    EXPECT_EQ(map->get(2), 21);
+}
+
+// -----------------------------------------
+// forEach
+// -----------------------------------------
+
+TEST_F(HashMapTests, forEach_visits_the_entries_in_insertion_order) {
+    map->set(30, 0);
+    map->set(10, 0);
+    map->set(20, 0);
+    map->remove(10);
+    map->set(10, 0);
+    map->set(30, 1);
+
+    EXPECT_EQ(keys(), (std::vector<int32_t> { 30, 20, 10 }));
+}
+
+TEST_F(HashMapTests, forEach_retains_the_order_when_the_removed_entries_are_compacted) {
+    for (int32_t i = 0; i < 100; ++i) {
+        map->set(i, i);
+    }
+
+    for (int32_t i = 0; i < 100; i += 2) {
+        map->remove(i);
+    }
+
+    for (int32_t i = 100; i < 200; ++i) {
+        map->set(i, i);
+    }
+
+    auto visited = keys();
+    ASSERT_EQ(visited.size(), 150u);
+    EXPECT_EQ(visited[0], 1);
+    EXPECT_EQ(visited[49], 99);
+    EXPECT_EQ(visited[50], 100);
+    EXPECT_EQ(visited[149], 199);
+}
+
+// -----------------------------------------
+// tables allocated by the loader
+// -----------------------------------------
+
+/**
+ * Stores the entries without an index as the loader does for the maps passed from JS
+ */
+class LoaderAllocatedMap: public HashMap<int32_t, int32_t> {
+public:
+    LoaderAllocatedMap(const std::vector<int32_t>& keys) {
+        entries = static_cast<HashMapEntry<int32_t, int32_t>*>(allocateMemory(keys.size() * sizeof(HashMapEntry<int32_t, int32_t>)));
+        for (size_t i = 0; i < keys.size(); ++i) {
+            entries[i] = { 1, keys[i], static_cast<int32_t>(i) };
+        }
+
+        entriesCount = entriesCapacity = count = static_cast<uint32_t>(keys.size());
+    }
+};
+
+TEST(HashMapLoaderTests, builds_the_index_on_the_first_lookup) {
+    LoaderAllocatedMap map { { 5, 3, 9 } };
+
+    EXPECT_EQ(map.get(3), 1);
+    EXPECT_EQ(map.get(9), 2);
+    EXPECT_FALSE(map.has(4));
+
+    map.set(4, 3);
+    EXPECT_EQ(map.size(), 4);
+    EXPECT_EQ(map.get(5), 0);
+    EXPECT_EQ(map.get(4), 3);
+}
+
+// the loader writes and reads the entries of the maps and sets passed between JS and WASM (see RuntimeMap)
+TEST(HashMapLoaderTests, entries_have_the_layout_expected_by_the_loader) {
+    using IntNumberEntry = HashMapEntry<int32_t, double>;
+    using IntIntEntry = HashMapEntry<int32_t, int32_t>;
+
+    EXPECT_EQ(offsetof(IntNumberEntry, key), 4u);
+    EXPECT_EQ(offsetof(IntNumberEntry, value), 8u);
+    EXPECT_EQ(sizeof(IntNumberEntry), 16u);
+
+    EXPECT_EQ(offsetof(IntIntEntry, value), 8u);
+    EXPECT_EQ(sizeof(IntIntEntry), 12u);
+
+    EXPECT_EQ(offsetof(HashSetEntry<double>, key), 8u);
+    EXPECT_EQ(sizeof(HashSetEntry<double>), 16u);
+
+    EXPECT_EQ(offsetof(HashSetEntry<int32_t>, key), 4u);
+    EXPECT_EQ(sizeof(HashSetEntry<int32_t>), 8u);
+}
+
+// -----------------------------------------
+// number keys
+// -----------------------------------------
+
+TEST(HashMapNumberKeyTests, compares_the_keys_using_same_value_zero) {
+    HashMap<double, int32_t> map {};
+
+    map.set(NAN, 1);
+    map.set(-0.0, 2);
+
+    EXPECT_EQ(map.get(NAN), 1);
+    EXPECT_EQ(map.get(0.0), 2);
+    EXPECT_EQ(map.size(), 2);
+
+    map.forEach([](const HashMapEntry<double, int32_t>& entry) {
+        if (entry.value == 2) {
+            EXPECT_FALSE(std::signbit(entry.key));
+        }
+    });
+}
+
+TEST(HashMapNumberKeyTests, distinguishes_fractional_keys) {
+    HashMap<double, double> map {};
+
+    for (int32_t i = 0; i < 1000; ++i) {
+        map.set(i / 4.0, i);
+    }
+
+    EXPECT_EQ(map.size(), 1000);
+    EXPECT_EQ(map.get(0.25), 1.0);
+    EXPECT_EQ(map.get(249.75), 999.0);
+    EXPECT_FALSE(map.has(0.125));
+}
+
+// -----------------------------------------
+// HashSet
+// -----------------------------------------
+
+TEST(HashSetTests, add_returns_false_if_the_value_is_already_contained) {
+    HashSet<int32_t> set {};
+
+    EXPECT_TRUE(set.add(5));
+    EXPECT_FALSE(set.add(5));
+    EXPECT_TRUE(set.add(6));
+
+    EXPECT_EQ(set.size(), 2);
+    EXPECT_TRUE(set.has(5));
+    EXPECT_FALSE(set.has(7));
+}
+
+TEST(HashSetTests, remove_removes_the_value) {
+    HashSet<double> set {};
+    set.add(1.5);
+
+    EXPECT_TRUE(set.remove(1.5));
+
+    EXPECT_FALSE(set.has(1.5));
+    EXPECT_EQ(set.size(), 0);
+}
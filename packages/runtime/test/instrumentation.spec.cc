@@ -0,0 +1,127 @@
+//
+// Tests for the counters of the instrumented runtime (compiled with INSTRUMENTED).
+//
+
+#include "gtest/gtest.h"
+#include "../lib/array.h"
+#include "../lib/instrumentation.h"
+
+extern "C" uint32_t* speedyJsRuntimeStatistics();
+extern "C" void speedyJsResetRuntimeStatistics();
+
+class InstrumentationTests : public ::testing::Test {
+protected:
+    void SetUp() override {
+        speedyJsResetRuntimeStatistics();
+    }
+};
+
+// -----------------------------------------
+// Histogram
+// -----------------------------------------
+
+TEST(HistogramTests, bucketOf_returns_the_power_of_two_bucket) {
+    EXPECT_EQ(Histogram::bucketOf(0), 0u);
+    EXPECT_EQ(Histogram::bucketOf(1), 1u);
+    EXPECT_EQ(Histogram::bucketOf(2), 2u);
+    EXPECT_EQ(Histogram::bucketOf(3), 2u);
+    EXPECT_EQ(Histogram::bucketOf(4), 3u);
+    EXPECT_EQ(Histogram::bucketOf(1023), 10u);
+    EXPECT_EQ(Histogram::bucketOf(1024), 11u);
+}
+
+TEST(HistogramTests, bucketOf_counts_large_values_in_the_last_bucket) {
+    EXPECT_EQ(Histogram::bucketOf(static_cast<size_t>(1) << 30), HISTOGRAM_BUCKETS - 1);
+    EXPECT_EQ(Histogram::bucketOf(SIZE_MAX), HISTOGRAM_BUCKETS - 1);
+}
+
+// -----------------------------------------
+// Array counters
+// -----------------------------------------
+
+TEST_F(InstrumentationTests, counts_the_element_allocations_and_growths_of_arrays) {
+    Array<int32_t> array { 100 };
+    EXPECT_EQ(runtimeStatistics.elementAllocations, 1u);
+    EXPECT_EQ(runtimeStatistics.allocatedElementBytes, 400u);
+    EXPECT_EQ(runtimeStatistics.arrayGrowths, 0u);
+
+    int32_t value = 1;
+    array.push(&value, 1);
+
+    EXPECT_EQ(runtimeStatistics.arrayGrowths, 1u);
+    EXPECT_EQ(runtimeStatistics.elementAllocations, 2u);
+    EXPECT_GT(runtimeStatistics.allocatedElementBytes, 404u);
+    EXPECT_EQ(runtimeStatistics.elementAllocationSizes.buckets[Histogram::bucketOf(400)], 1u);
+}
+
+TEST_F(InstrumentationTests, does_not_count_inline_arrays) {
+    Array<int32_t> array { 2 };
+
+    EXPECT_EQ(runtimeStatistics.elementAllocations, 0u);
+    EXPECT_EQ(runtimeStatistics.arrayGrowths, 0u);
+}
+
+TEST_F(InstrumentationTests, counts_the_growths_of_bool_arrays) {
+    Array<bool> array {};
+
+    for (int i = 0; i < 1000; ++i) {
+        bool value = i % 2 == 0;
+        array.push(&value, 1);
+    }
+
+    EXPECT_GT(runtimeStatistics.arrayGrowths, 0u);
+    EXPECT_EQ(runtimeStatistics.elementAllocations, runtimeStatistics.arrayGrowths);
+}
+
+// -----------------------------------------
+// recordGc
+// -----------------------------------------
+
+TEST_F(InstrumentationTests, recordGc_counts_the_calls_and_released_allocations) {
+    recordGc(3, 300);
+    recordGc(0, 0);
+
+    EXPECT_EQ(runtimeStatistics.gcCalls, 2u);
+    EXPECT_EQ(runtimeStatistics.gcReleasedAllocations, 3u);
+    EXPECT_EQ(runtimeStatistics.gcReleasedBytes, 300u);
+    EXPECT_EQ(runtimeStatistics.gcReleasedAllocationsPerCall.buckets[0], 1u);
+    EXPECT_EQ(runtimeStatistics.gcReleasedAllocationsPerCall.buckets[2], 1u);
+}
+
+// -----------------------------------------
+// speedyJsRuntimeStatistics
+// -----------------------------------------
+
+TEST_F(InstrumentationTests, speedyJsRuntimeStatistics_returns_the_snapshot) {
+    recordElementAllocation(0x100000010ULL);
+    recordArrayGrowth();
+    recordGc(5, 50);
+
+    const uint32_t* snapshot = speedyJsRuntimeStatistics();
+
+    EXPECT_EQ(snapshot[0], HISTOGRAM_BUCKETS);
+    EXPECT_EQ(snapshot[1], 1u);
+    EXPECT_EQ(snapshot[2], 1u);
+    EXPECT_EQ(snapshot[3], 0x10u);
+    EXPECT_EQ(snapshot[4], 1u);
+    EXPECT_EQ(snapshot[5], 1u);
+    EXPECT_EQ(snapshot[6], 5u);
+    EXPECT_EQ(snapshot[7], 50u);
+    EXPECT_EQ(snapshot[8], 0u);
+    EXPECT_EQ(snapshot[9 + HISTOGRAM_BUCKETS - 1], 1u);
+    EXPECT_EQ(snapshot[9 + HISTOGRAM_BUCKETS + Histogram::bucketOf(5)], 1u);
+}
+
+TEST_F(InstrumentationTests, speedyJsResetRuntimeStatistics_resets_all_counters) {
+    recordElementAllocation(8);
+    recordArrayGrowth();
+    recordGc(1, 8);
+
+    speedyJsResetRuntimeStatistics();
+
+    EXPECT_EQ(runtimeStatistics.elementAllocations, 0u);
+    EXPECT_EQ(runtimeStatistics.arrayGrowths, 0u);
+    EXPECT_EQ(runtimeStatistics.gcCalls, 0u);
+    EXPECT_EQ(runtimeStatistics.elementAllocationSizes.buckets[Histogram::bucketOf(8)], 0u);
+    EXPECT_EQ(runtimeStatistics.gcReleasedAllocationsPerCall.buckets[1], 0u);
+}
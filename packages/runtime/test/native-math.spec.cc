@@ -0,0 +1,167 @@
+//
+// Tests for the native pow and fmod implementations.
+//
+
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <random>
+#include "gtest/gtest.h"
+#include "../lib/native-math.h"
+
+static const double NaN = std::numeric_limits<double>::quiet_NaN();
+static const double Infinity = std::numeric_limits<double>::infinity();
+
+/**
+ * Returns the distance of the two numbers in units in the last place
+ */
+static uint64_t ulpDistance(double a, double b) {
+    int64_t aBits;
+    int64_t bBits;
+    std::memcpy(&aBits, &a, sizeof(a));
+    std::memcpy(&bBits, &b, sizeof(b));
+
+    // map the sign magnitude representation onto a monotonic integer line
+    aBits = aBits < 0 ? INT64_MIN - aBits : aBits;
+    bBits = bBits < 0 ? INT64_MIN - bBits : bBits;
+    return aBits > bBits ? static_cast<uint64_t>(aBits) - static_cast<uint64_t>(bBits) : static_cast<uint64_t>(bBits) - static_cast<uint64_t>(aBits);
+}
+
+static bool isNegativeZero(double value) {
+    return value == 0.0 && std::signbit(value);
+}
+
+// -----------------------------------------
+// powReal
+// -----------------------------------------
+
+TEST(NativeMathTests, powReal_is_within_one_ulp_for_random_values) {
+    std::mt19937 random(42);
+    std::uniform_real_distribution<double> bases(0.0, 100.0);
+    std::uniform_real_distribution<double> exponents(-50.0, 50.0);
+
+    for (int i = 0; i < 100000; ++i) {
+        const double base = bases(random);
+        const double exponent = exponents(random);
+        const double expected = std::pow(base, exponent);
+
+        ASSERT_LE(ulpDistance(powReal(base, exponent), expected), 1u) << base << " ** " << exponent;
+    }
+}
+
+TEST(NativeMathTests, powReal_is_within_one_ulp_for_values_close_to_the_limits) {
+    EXPECT_LE(ulpDistance(powReal(2.34, 34.2), std::pow(2.34, 34.2)), 1u);
+    EXPECT_LE(ulpDistance(powReal(1.0000001, 1e10), std::pow(1.0000001, 1e10)), 1u);
+    EXPECT_LE(ulpDistance(powReal(10.0, 308.0), std::pow(10.0, 308.0)), 1u);
+    EXPECT_LE(ulpDistance(powReal(10.0, -310.0), std::pow(10.0, -310.0)), 1u);
+    EXPECT_LE(ulpDistance(powReal(4.9e-324, 0.5), std::pow(4.9e-324, 0.5)), 1u);
+    EXPECT_LE(ulpDistance(powReal(-3.0, 5.0), -243.0), 1u);
+}
+
+TEST(NativeMathTests, powReal_overflows_and_underflows) {
+    EXPECT_EQ(powReal(10.0, 309.0), Infinity);
+    EXPECT_EQ(powReal(-10.0, 309.0), -Infinity);
+    EXPECT_EQ(powReal(10.0, -400.0), 0.0);
+    EXPECT_EQ(powReal(2.0, 1e20), Infinity);
+    EXPECT_EQ(powReal(0.5, 1e20), 0.0);
+}
+
+TEST(NativeMathTests, powReal_implements_the_special_cases_of_Math_pow) {
+    EXPECT_EQ(powReal(NaN, 0.0), 1.0);
+    EXPECT_EQ(powReal(NaN, -0.0), 1.0);
+    EXPECT_TRUE(std::isnan(powReal(NaN, 1.0)));
+    EXPECT_TRUE(std::isnan(powReal(1.0, NaN)));
+    EXPECT_TRUE(std::isnan(powReal(1.0, Infinity)));
+    EXPECT_TRUE(std::isnan(powReal(-1.0, -Infinity)));
+    EXPECT_EQ(powReal(2.0, Infinity), Infinity);
+    EXPECT_EQ(powReal(2.0, -Infinity), 0.0);
+    EXPECT_EQ(powReal(0.5, Infinity), 0.0);
+    EXPECT_EQ(powReal(0.5, -Infinity), Infinity);
+    EXPECT_EQ(powReal(Infinity, 2.5), Infinity);
+    EXPECT_EQ(powReal(Infinity, -2.5), 0.0);
+    EXPECT_EQ(powReal(-Infinity, 3.0), -Infinity);
+    EXPECT_EQ(powReal(-Infinity, 2.0), Infinity);
+    EXPECT_TRUE(isNegativeZero(powReal(-Infinity, -3.0)));
+    EXPECT_EQ(powReal(0.0, 2.5), 0.0);
+    EXPECT_EQ(powReal(0.0, -2.5), Infinity);
+    EXPECT_TRUE(isNegativeZero(powReal(-0.0, 3.0)));
+    EXPECT_EQ(powReal(-0.0, 0.5), 0.0);
+    EXPECT_FALSE(std::signbit(powReal(-0.0, 0.5)));
+    EXPECT_EQ(powReal(-0.0, -3.0), -Infinity);
+    EXPECT_EQ(powReal(-0.0, -2.0), Infinity);
+    EXPECT_TRUE(std::isnan(powReal(-2.0, 0.5)));
+}
+
+// -----------------------------------------
+// nativePow
+// -----------------------------------------
+
+TEST(NativeMathTests, nativePow_computes_small_integer_exponents_by_multiplication) {
+    EXPECT_EQ(nativePow(3.0, 2.0), 9.0);
+    EXPECT_EQ(nativePow(-3.0, 3.0), -27.0);
+    EXPECT_EQ(nativePow(2.0, -2.0), 0.25);
+    EXPECT_EQ(nativePow(1.5, 1.0), 1.5);
+    EXPECT_EQ(nativePow(NaN, 0.0), 1.0);
+    EXPECT_EQ(nativePow(16.0, 0.5), 4.0);
+}
+
+TEST(NativeMathTests, nativePow_is_close_to_pow_for_all_fast_exponents) {
+    std::mt19937 random(42);
+    std::uniform_real_distribution<double> bases(-100.0, 100.0);
+
+    for (int32_t exponent = -MAX_FAST_POW_EXPONENT; exponent <= MAX_FAST_POW_EXPONENT; ++exponent) {
+        for (int i = 0; i < 1000; ++i) {
+            const double base = bases(random);
+            const double expected = std::pow(base, exponent);
+
+            ASSERT_LE(ulpDistance(nativePow(base, exponent), expected), static_cast<uint64_t>(std::abs(exponent))) << base << " ** " << exponent;
+        }
+    }
+}
+
+TEST(NativeMathTests, nativePow_falls_back_to_powReal_if_the_multiplications_over_or_underflow) {
+    EXPECT_LE(ulpDistance(nativePow(1e160, -2.0), std::pow(1e160, -2.0)), 1u);
+    EXPECT_GT(nativePow(1e160, -2.0), 0.0);
+    EXPECT_EQ(nativePow(1e200, 2.0), Infinity);
+    EXPECT_EQ(nativePow(0.0, -1.0), Infinity);
+    EXPECT_EQ(nativePow(-0.0, -1.0), -Infinity);
+    EXPECT_TRUE(std::isnan(nativePow(NaN, 2.0)));
+    EXPECT_TRUE(std::isnan(nativePow(1.0, NaN)));
+}
+
+// -----------------------------------------
+// nativeFmod
+// -----------------------------------------
+
+TEST(NativeMathTests, nativeFmod_equals_fmod_for_random_values) {
+    std::mt19937 random(42);
+    std::uniform_real_distribution<double> values(-1e6, 1e6);
+    std::uniform_real_distribution<double> exponents(-300, 300);
+
+    for (int i = 0; i < 100000; ++i) {
+        const double x = values(random) * std::pow(10.0, exponents(random));
+        const double y = values(random);
+
+        ASSERT_EQ(nativeFmod(x, y), std::fmod(x, y)) << x << " % " << y;
+        ASSERT_EQ(nativeFmod(y, x), std::fmod(y, x)) << y << " % " << x;
+    }
+}
+
+TEST(NativeMathTests, nativeFmod_handles_subnormal_numbers) {
+    EXPECT_EQ(nativeFmod(1.0, 4.9e-324), std::fmod(1.0, 4.9e-324));
+    EXPECT_EQ(nativeFmod(3e-310, 7e-311), std::fmod(3e-310, 7e-311));
+    EXPECT_EQ(nativeFmod(3e-310, 1.0), 3e-310);
+}
+
+TEST(NativeMathTests, nativeFmod_implements_the_special_cases_of_the_remainder_operator) {
+    EXPECT_EQ(nativeFmod(5.5, 2.0), 1.5);
+    EXPECT_EQ(nativeFmod(-5.5, 2.0), -1.5);
+    EXPECT_EQ(nativeFmod(5.5, -2.0), 1.5);
+    EXPECT_TRUE(isNegativeZero(nativeFmod(-4.0, 2.0)));
+    EXPECT_TRUE(isNegativeZero(nativeFmod(-0.0, 2.0)));
+    EXPECT_EQ(nativeFmod(3.0, Infinity), 3.0);
+    EXPECT_TRUE(std::isnan(nativeFmod(3.0, 0.0)));
+    EXPECT_TRUE(std::isnan(nativeFmod(Infinity, 3.0)));
+    EXPECT_TRUE(std::isnan(nativeFmod(NaN, 3.0)));
+    EXPECT_TRUE(std::isnan(nativeFmod(3.0, NaN)));
+}
@@ -0,0 +1,206 @@
+//
+// Tests for the parallel loop and the parallel kernels. The tests are compiled with and without THREADS.
+//
+
+#include <atomic>
+#include <cmath>
+#include <numeric>
+#include <random>
+#include <vector>
+#include "gtest/gtest.h"
+#include "../lib/parallel.h"
+
+// -----------------------------------------
+// parallelFor
+// -----------------------------------------
+
+TEST(ParallelTests, parallelFor_calls_the_body_for_every_index_exactly_once) {
+    std::vector<std::atomic<int32_t>> calls(100000);
+    for (auto& count : calls) {
+        count.store(0);
+    }
+
+    // act
+    parallelFor(0, 100000, 64, [&calls](int32_t from, int32_t to) {
+        for (int32_t i = from; i < to; ++i) {
+            calls[i].fetch_add(1);
+        }
+    });
+
+    // assert
+    for (auto& count : calls) {
+        ASSERT_EQ(count.load(), 1);
+    }
+}
+
+TEST(ParallelTests, parallelFor_does_not_call_the_body_for_an_empty_range) {
+    bool called = false;
+
+    // act
+    parallelFor(10, 10, 1, [&called](int32_t, int32_t) { called = true; });
+
+    // assert
+    EXPECT_FALSE(called);
+}
+
+TEST(ParallelTests, parallelFor_respects_the_start_index) {
+    std::atomic<int64_t> sum { 0 };
+
+    // act
+    parallelFor(100, 200, 1, [&sum](int32_t from, int32_t to) {
+        for (int32_t i = from; i < to; ++i) {
+            sum.fetch_add(i);
+        }
+    });
+
+    // assert
+    EXPECT_EQ(sum.load(), 14950);
+}
+
+#ifdef THREADS
+
+TEST(ParallelTests, ParallelLoop_distributes_the_range_over_the_workers) {
+    std::vector<std::atomic<int32_t>> calls(100000);
+    for (auto& count : calls) {
+        count.store(0);
+    }
+
+    auto body = [&calls](int32_t from, int32_t to) {
+        for (int32_t i = from; i < to; ++i) {
+            calls[i].fetch_add(1);
+        }
+    };
+
+    // act, independent of the number of cores of the machine
+    ParallelLoop<decltype(body)> loop { 4, 16, body };
+    loop.execute(0, 100000);
+
+    // assert
+    for (auto& count : calls) {
+        ASSERT_EQ(count.load(), 1);
+    }
+}
+
+#endif
+
+// -----------------------------------------
+// parallelFill, parallelMap
+// -----------------------------------------
+
+TEST(ParallelTests, parallelFill_sets_all_elements) {
+    std::vector<double> elements(50001, 0.0);
+
+    // act
+    parallelFill(elements.data() + 1, elements.data() + elements.size(), 3.5);
+
+    // assert
+    EXPECT_EQ(elements[0], 0.0);
+    for (size_t i = 1; i < elements.size(); ++i) {
+        ASSERT_EQ(elements[i], 3.5);
+    }
+}
+
+TEST(ParallelTests, parallelMap_maps_every_element) {
+    std::vector<int32_t> elements(30000);
+    std::iota(elements.begin(), elements.end(), 0);
+    std::vector<double> mapped(elements.size());
+
+    // act
+    parallelMap(elements.data(), elements.data() + elements.size(), mapped.data(), [](int32_t value) { return value * 0.5; });
+
+    // assert
+    for (size_t i = 0; i < mapped.size(); ++i) {
+        ASSERT_EQ(mapped[i], i * 0.5);
+    }
+}
+
+// -----------------------------------------
+// parallelReduce
+// -----------------------------------------
+
+TEST(ParallelTests, parallelReduce_reduces_all_elements) {
+    std::vector<int32_t> elements(100000);
+    std::iota(elements.begin(), elements.end(), 1);
+
+    // act
+    const int64_t sum = parallelReduce<int64_t>(nullptr, nullptr, 0, [](int64_t a, int64_t b) { return a + b; });
+    const int32_t max = parallelReduce(elements.data(), elements.data() + elements.size(), 0, [](int32_t a, int32_t b) { return std::max(a, b); });
+
+    // assert
+    EXPECT_EQ(sum, 0);
+    EXPECT_EQ(max, 100000);
+}
+
+TEST(ParallelTests, parallelReduce_sums_doubles_in_a_fixed_order) {
+    std::vector<double> elements(20000);
+    for (size_t i = 0; i < elements.size(); ++i) {
+        elements[i] = 1.0 / (i + 1);
+    }
+
+    double expected = 0.0;
+    for (size_t chunk = 0; chunk < elements.size(); chunk += PARALLEL_GRAIN_SIZE) {
+        const auto chunkEnd = elements.begin() + std::min(elements.size(), chunk + PARALLEL_GRAIN_SIZE);
+        expected += std::accumulate(elements.begin() + chunk + 1, chunkEnd, elements[chunk]);
+    }
+
+    // act
+    const double sum = parallelReduce(elements.data(), elements.data() + elements.size(), 0.0, [](double a, double b) { return a + b; });
+
+    // assert
+    EXPECT_EQ(sum, expected);
+}
+
+// -----------------------------------------
+// parallelSort
+// -----------------------------------------
+
+TEST(ParallelTests, parallelSort_sorts_ints) {
+    std::vector<int32_t> elements(100003);
+    std::mt19937 random { 42 };
+    std::uniform_int_distribution<int32_t> distribution { INT32_MIN, INT32_MAX };
+    for (auto& element : elements) {
+        element = distribution(random);
+    }
+    std::vector<int32_t> expected { elements };
+    std::sort(expected.begin(), expected.end());
+
+    // act
+    parallelSort(elements.data(), elements.data() + elements.size());
+
+    // assert
+    EXPECT_EQ(elements, expected);
+}
+
+TEST(ParallelTests, parallelSort_sorts_doubles_like_sortElements) {
+    std::vector<double> elements(20000);
+    std::mt19937 random { 7 };
+    std::uniform_real_distribution<double> distribution { -1000.0, 1000.0 };
+    for (auto& element : elements) {
+        element = distribution(random);
+    }
+    elements[5] = -0.0;
+    elements[6000] = INFINITY;
+    elements[12000] = -INFINITY;
+
+    std::vector<double> expected { elements };
+    sortElements(expected.data(), expected.data() + expected.size());
+
+    // act
+    parallelSort(elements.data(), elements.data() + elements.size());
+
+    // assert
+    EXPECT_EQ(elements, expected);
+}
+
+TEST(ParallelTests, parallelSort_sorts_small_arrays) {
+    int32_t elements[] = { 5, 3, -1, 8 };
+
+    // act
+    parallelSort(&elements[0], &elements[4]);
+
+    // assert
+    EXPECT_EQ(elements[0], -1);
+    EXPECT_EQ(elements[1], 3);
+    EXPECT_EQ(elements[2], 5);
+    EXPECT_EQ(elements[3], 8);
+}
@@ -0,0 +1,303 @@
+//
+// Tests for the pinned allocations and the pinned arrays.
+//
+
+#include <cstdlib>
+#include <vector>
+#include "gtest/gtest.h"
+#include "../lib/array.h"
+#include "../lib/pinned.h"
+
+class PinnedAllocationsTests: public ::testing::Test {
+public:
+    PinnedAllocations* pinned;
+
+    void SetUp() {
+        pinned = new PinnedAllocations();
+    }
+
+    void TearDown() {
+        delete pinned;
+    }
+};
+
+// -----------------------------------------
+// allocate / release
+// -----------------------------------------
+
+TEST_F(PinnedAllocationsTests, allocate_tracks_the_allocation) {
+    void* allocation = pinned->allocate(64);
+
+    // assert
+    ASSERT_NE(allocation, nullptr);
+    EXPECT_TRUE(pinned->contains(allocation));
+    EXPECT_EQ(pinned->size(), 1u);
+
+    pinned->release(allocation);
+}
+
+TEST_F(PinnedAllocationsTests, release_untracks_the_allocation) {
+    void* first = pinned->allocate(16);
+    void* second = pinned->allocate(16);
+    void* third = pinned->allocate(16);
+
+    // act
+    pinned->release(second);
+
+    // assert
+    EXPECT_TRUE(pinned->contains(first));
+    EXPECT_FALSE(pinned->contains(second));
+    EXPECT_TRUE(pinned->contains(third));
+    EXPECT_EQ(pinned->size(), 2u);
+
+    pinned->release(first);
+    pinned->release(third);
+}
+
+TEST_F(PinnedAllocationsTests, release_ignores_pointers_that_are_not_pinned) {
+    int value = 0;
+
+    // act
+    pinned->release(&value);
+
+    // assert
+    EXPECT_EQ(pinned->size(), 0u);
+}
+
+TEST_F(PinnedAllocationsTests, reallocate_tracks_the_resized_allocation) {
+    auto* allocation = static_cast<int32_t*>(pinned->allocate(sizeof(int32_t)));
+    *allocation = 42;
+
+    // act
+    auto* resized = static_cast<int32_t*>(pinned->reallocate(allocation, 100000 * sizeof(int32_t)));
+
+    // assert
+    ASSERT_NE(resized, nullptr);
+    EXPECT_EQ(*resized, 42);
+    EXPECT_TRUE(pinned->contains(resized));
+    EXPECT_EQ(pinned->size(), 1u);
+
+    pinned->release(resized);
+}
+
+TEST_F(PinnedAllocationsTests, allocate_grows_the_table) {
+    std::vector<void*> allocations;
+    for (size_t i = 0; i < 10 * INITIAL_PINNED_CAPACITY; ++i) {
+        allocations.push_back(pinned->allocate(8));
+    }
+
+    // assert
+    EXPECT_EQ(pinned->size(), 10 * INITIAL_PINNED_CAPACITY);
+    for (void* allocation : allocations) {
+        EXPECT_TRUE(pinned->contains(allocation));
+    }
+
+    for (void* allocation : allocations) {
+        pinned->release(allocation);
+    }
+    EXPECT_EQ(pinned->size(), 0u);
+}
+
+// -----------------------------------------
+// scopes
+// -----------------------------------------
+
+TEST_F(PinnedAllocationsTests, createScope_returns_distinct_scopes) {
+    const uint32_t first = pinned->createScope();
+    const uint32_t second = pinned->createScope();
+
+    // assert
+    EXPECT_NE(first, UNSCOPED);
+    EXPECT_NE(second, UNSCOPED);
+    EXPECT_NE(first, second);
+}
+
+TEST_F(PinnedAllocationsTests, releaseScope_releases_the_allocations_of_the_scope_only) {
+    const uint32_t retained = pinned->createScope();
+    const uint32_t other = pinned->createScope();
+
+    void* unscoped = pinned->allocate(16);
+    void* first = pinned->allocate(16, retained);
+    void* second = pinned->allocate(16, other);
+    void* third = pinned->allocate(16, retained);
+
+    // act
+    pinned->releaseScope(retained);
+
+    // assert
+    EXPECT_TRUE(pinned->contains(unscoped));
+    EXPECT_FALSE(pinned->contains(first));
+    EXPECT_TRUE(pinned->contains(second));
+    EXPECT_FALSE(pinned->contains(third));
+    EXPECT_EQ(pinned->size(), 2u);
+
+    pinned->release(unscoped);
+    pinned->releaseScope(other);
+    EXPECT_EQ(pinned->size(), 0u);
+}
+
+TEST_F(PinnedAllocationsTests, reallocate_keeps_the_scope_of_the_allocation) {
+    const uint32_t scope = pinned->createScope();
+    void* allocation = pinned->allocate(4, scope);
+
+    // act
+    void* resized = pinned->reallocate(allocation, 100000);
+
+    // assert
+    EXPECT_EQ(pinned->scopeOf(resized), scope);
+
+    pinned->releaseScope(scope);
+    EXPECT_EQ(pinned->size(), 0u);
+}
+
+TEST_F(PinnedAllocationsTests, reallocate_returns_nullptr_for_not_pinned_pointers) {
+    int32_t value = 42;
+
+    // act
+    void* resized = pinned->reallocate(&value, 100000);
+
+    // assert
+    EXPECT_EQ(resized, nullptr);
+    EXPECT_EQ(value, 42);
+    EXPECT_EQ(pinned->size(), 0u);
+}
+
+TEST_F(PinnedAllocationsTests, reallocate_returns_nullptr_for_moved_pointers) {
+    void* before = pinned->allocate(4);
+    void* allocation = pinned->allocate(4);
+    void* after = pinned->allocate(4);
+    void* resized = pinned->reallocate(allocation, 100000);
+    ASSERT_NE(resized, nullptr);
+    ASSERT_NE(resized, allocation);
+
+    // act
+    void* result = pinned->reallocate(allocation, 200000);
+
+    // assert
+    EXPECT_EQ(result, nullptr);
+    EXPECT_TRUE(pinned->contains(before));
+    EXPECT_TRUE(pinned->contains(after));
+    EXPECT_TRUE(pinned->contains(resized));
+    EXPECT_FALSE(pinned->contains(allocation));
+    EXPECT_EQ(pinned->size(), 3u);
+
+    pinned->release(before);
+    pinned->release(after);
+    pinned->release(resized);
+}
+
+TEST_F(PinnedAllocationsTests, scopeOf_returns_unscoped_for_not_pinned_pointers) {
+    int value = 0;
+
+    EXPECT_EQ(pinned->scopeOf(&value), UNSCOPED);
+}
+
+// -----------------------------------------
+// adopt
+// -----------------------------------------
+
+TEST_F(PinnedAllocationsTests, adopt_pins_the_allocation_in_the_scope) {
+    void* allocation = std::malloc(32);
+    const uint32_t scope = pinned->createScope();
+
+    EXPECT_TRUE(pinned->adopt(allocation, scope));
+
+    EXPECT_TRUE(pinned->contains(allocation));
+    EXPECT_EQ(pinned->scopeOf(allocation), scope);
+
+    pinned->releaseScope(scope);
+    EXPECT_FALSE(pinned->contains(allocation));
+}
+
+TEST_F(PinnedAllocationsTests, adopt_keeps_the_scope_of_pinned_allocations) {
+    void* allocation = pinned->allocate(16);
+
+    EXPECT_TRUE(pinned->adopt(allocation, pinned->createScope()));
+
+    EXPECT_EQ(pinned->scopeOf(allocation), UNSCOPED);
+    EXPECT_EQ(pinned->size(), 1u);
+
+    pinned->release(allocation);
+}
+
+// -----------------------------------------
+// Array::createPinned
+// -----------------------------------------
+
+TEST(PinnedArrayTests, createPinned_allocates_the_array_and_the_elements_pinned) {
+    auto* array = Array<double>::createPinned(1000);
+
+    // assert
+    EXPECT_TRUE(array->isPinned());
+    EXPECT_EQ(array->length(), 1000);
+    EXPECT_EQ(array->get(999), 0.0);
+    EXPECT_TRUE(runtimePinnedAllocations.contains(array));
+    EXPECT_EQ(runtimePinnedAllocations.size(), 2u);
+
+    Array<double>::releasePinned(array);
+    EXPECT_EQ(runtimePinnedAllocations.size(), 0u);
+}
+
+TEST(PinnedArrayTests, createPinned_stores_small_arrays_inline) {
+    auto* array = Array<int32_t>::createPinned(3);
+
+    // assert
+    EXPECT_TRUE(array->usesInlineStorage());
+    EXPECT_EQ(runtimePinnedAllocations.size(), 1u);
+
+    Array<int32_t>::releasePinned(array);
+    EXPECT_EQ(runtimePinnedAllocations.size(), 0u);
+}
+
+TEST(PinnedArrayTests, push_grows_the_pinned_storage) {
+    auto* array = Array<int32_t>::createPinned(2);
+
+    // act
+    for (int32_t i = 0; i < 1000; ++i) {
+        array->push(&i, 1);
+    }
+
+    // assert
+    EXPECT_TRUE(array->isPinned());
+    EXPECT_EQ(array->length(), 1002);
+    EXPECT_EQ(array->get(1001), 999);
+    EXPECT_EQ(runtimePinnedAllocations.size(), 2u);
+
+    Array<int32_t>::releasePinned(array);
+    EXPECT_EQ(runtimePinnedAllocations.size(), 0u);
+}
+
+TEST(PinnedArrayTests, unshift_keeps_the_storage_pinned) {
+    auto* array = Array<int32_t>::createPinned(100);
+
+    // act
+    for (int32_t i = 0; i < 100; ++i) {
+        array->unshift(&i, 1);
+    }
+
+    // assert
+    EXPECT_EQ(array->length(), 200);
+    EXPECT_EQ(array->get(0), 99);
+    EXPECT_EQ(runtimePinnedAllocations.size(), 2u);
+
+    Array<int32_t>::releasePinned(array);
+    EXPECT_EQ(runtimePinnedAllocations.size(), 0u);
+}
+
+TEST(PinnedArrayTests, slice_copies_the_elements_of_pinned_arrays) {
+    auto* array = Array<double>::createPinned(100);
+    array->fill(4.0);
+
+    // act
+    auto* sliced = array->slice(10, 90);
+
+    // assert
+    EXPECT_FALSE(sliced->isShared());
+    EXPECT_FALSE(sliced->isPinned());
+    EXPECT_TRUE(array->isPinned());
+    EXPECT_EQ(sliced->length(), 80);
+    EXPECT_EQ(sliced->get(0), 4.0);
+
+    delete sliced;
+    Array<double>::releasePinned(array);
+}
@@ -0,0 +1,126 @@
+//
+// Tests for the size-class pool allocator.
+//
+
+#include "gtest/gtest.h"
+#include "../lib/pool.h"
+
+class PoolTests: public ::testing::Test {
+public:
+    Pool* pool;
+
+    void SetUp() {
+        pool = new Pool();
+    }
+
+    void TearDown() {
+        // The slabs are owned by the heap (and freed by the gc in the runtime)
+        delete pool;
+    }
+};
+
+// -----------------------------------------
+// sizeClassIndex
+// -----------------------------------------
+
+TEST_F(PoolTests, sizeClassIndex_rounds_up_to_the_next_size_class) {
+    EXPECT_EQ(Pool::sizeClassSize(Pool::sizeClassIndex(12)), 12u);
+    EXPECT_EQ(Pool::sizeClassSize(Pool::sizeClassIndex(13)), 16u);
+    EXPECT_EQ(Pool::sizeClassSize(Pool::sizeClassIndex(POOL_MAX_SIZE)), POOL_MAX_SIZE);
+}
+
+TEST_F(PoolTests, sizeClassIndex_reserves_space_for_the_free_list_pointer) {
+    EXPECT_GE(Pool::sizeClassSize(Pool::sizeClassIndex(1)), sizeof(void*));
+}
+
+// -----------------------------------------
+// allocate
+// -----------------------------------------
+
+TEST_F(PoolTests, allocate_places_blocks_of_a_size_class_next_to_each_other) {
+    auto first = static_cast<char*>(pool->allocate(24));
+    auto second = static_cast<char*>(pool->allocate(24));
+
+    EXPECT_EQ(second, first + 24);
+}
+
+TEST_F(PoolTests, allocate_retains_the_alignment_of_the_size) {
+    pool->allocate(24);
+    auto allocation = pool->allocate(24);
+
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(allocation) % 8, 0u);
+}
+
+TEST_F(PoolTests, allocate_counts_a_miss_for_a_new_slab_and_hits_afterwards) {
+    const auto sizeClass = Pool::sizeClassIndex(16);
+
+    pool->allocate(16);
+    pool->allocate(16);
+    pool->allocate(16);
+
+    EXPECT_EQ(pool->misses(sizeClass), 1u);
+    EXPECT_EQ(pool->hits(sizeClass), 2u);
+}
+
+TEST_F(PoolTests, allocate_allocates_a_new_slab_if_the_current_slab_is_exhausted) {
+    const auto sizeClass = Pool::sizeClassIndex(POOL_MAX_SIZE);
+
+    for (size_t i = 0; i < POOL_SLAB_SIZE / POOL_MAX_SIZE + 1; ++i) {
+        pool->allocate(POOL_MAX_SIZE);
+    }
+
+    EXPECT_EQ(pool->misses(sizeClass), 2u);
+}
+
+TEST_F(PoolTests, allocate_serves_oversized_allocations_from_the_heap) {
+    auto allocation = pool->allocate(POOL_MAX_SIZE + 1);
+
+    EXPECT_NE(allocation, nullptr);
+    pool->release(allocation, POOL_MAX_SIZE + 1);
+}
+
+// -----------------------------------------
+// release
+// -----------------------------------------
+
+TEST_F(PoolTests, release_returns_the_block_to_the_free_list) {
+    const auto sizeClass = Pool::sizeClassIndex(12);
+    auto allocation = pool->allocate(12);
+
+    pool->release(allocation, 12);
+
+    EXPECT_EQ(pool->allocate(12), allocation);
+    EXPECT_EQ(pool->hits(sizeClass), 1u);
+}
+
+TEST_F(PoolTests, release_ignores_the_nullptr) {
+    pool->release(nullptr, 12);
+
+    EXPECT_NE(pool->allocate(12), nullptr);
+}
+
+// -----------------------------------------
+// reset
+// -----------------------------------------
+
+TEST_F(PoolTests, reset_forgets_the_free_list) {
+    const auto sizeClass = Pool::sizeClassIndex(12);
+    auto allocation = pool->allocate(12);
+    pool->release(allocation, 12);
+
+    pool->reset();
+    pool->allocate(12);
+
+    EXPECT_EQ(pool->misses(sizeClass), 2u);
+}
+
+TEST_F(PoolTests, resetStatistics_resets_the_counters) {
+    const auto sizeClass = Pool::sizeClassIndex(12);
+    pool->allocate(12);
+    pool->allocate(12);
+
+    pool->resetStatistics();
+
+    EXPECT_EQ(pool->hits(sizeClass), 0u);
+    EXPECT_EQ(pool->misses(sizeClass), 0u);
+}
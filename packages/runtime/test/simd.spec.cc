@@ -0,0 +1,165 @@
+//
+// Tests for the bulk element kernels. The tests are compiled with and without SIMD.
+//
+
+#include <cmath>
+#include <numeric>
+#include "gtest/gtest.h"
+#include "../lib/simd.h"
+
+// -----------------------------------------
+// fillElements
+// -----------------------------------------
+
+TEST(SimdTests, fillElements_sets_all_elements) {
+    int32_t elements[11] = { 0 };
+
+    // act
+    fillElements(&elements[1], &elements[10], 7);
+
+    // assert
+    EXPECT_EQ(elements[0], 0);
+    for (size_t i = 1; i < 10; ++i) {
+        EXPECT_EQ(elements[i], 7);
+    }
+    EXPECT_EQ(elements[10], 0);
+}
+
+TEST(SimdTests, fillElements_fills_bytes) {
+    bool elements[37] = { false };
+
+    // act
+    fillElements(&elements[0], &elements[37], true);
+
+    // assert
+    EXPECT_EQ(std::count(&elements[0], &elements[37], true), 37);
+}
+
+// -----------------------------------------
+// moveElements
+// -----------------------------------------
+
+TEST(SimdTests, moveElements_copies_the_elements) {
+    double source[9];
+    double destination[9] = { 0 };
+    std::iota(&source[0], &source[9], 1.0);
+
+    // act
+    auto end = moveElements(&source[0], &source[9], &destination[0]);
+
+    // assert
+    EXPECT_EQ(end, &destination[9]);
+    EXPECT_TRUE(std::equal(&source[0], &source[9], &destination[0]));
+}
+
+TEST(SimdTests, moveElements_handles_overlapping_ranges_moving_to_the_back) {
+    int32_t elements[20];
+    std::iota(&elements[0], &elements[20], 0);
+
+    // act
+    moveElements(&elements[0], &elements[15], &elements[5]);
+
+    // assert
+    for (int32_t i = 5; i < 20; ++i) {
+        EXPECT_EQ(elements[i], i - 5);
+    }
+}
+
+TEST(SimdTests, moveElements_handles_overlapping_ranges_moving_to_the_front) {
+    int32_t elements[20];
+    std::iota(&elements[0], &elements[20], 0);
+
+    // act
+    moveElements(&elements[1], &elements[20], &elements[0]);
+
+    // assert
+    for (int32_t i = 0; i < 19; ++i) {
+        EXPECT_EQ(elements[i], i + 1);
+    }
+}
+
+// -----------------------------------------
+// reverseElements
+// -----------------------------------------
+
+TEST(SimdTests, reverseElements_reverses_the_elements) {
+    for (int32_t length = 0; length < 20; ++length) {
+        int32_t elements[20];
+        std::iota(&elements[0], &elements[length], 0);
+
+        // act
+        reverseElements(&elements[0], &elements[length]);
+
+        // assert
+        for (int32_t i = 0; i < length; ++i) {
+            EXPECT_EQ(elements[i], length - i - 1);
+        }
+    }
+}
+
+TEST(SimdTests, reverseElements_reverses_doubles_and_bytes) {
+    double doubles[7] = { 1, 2, 3, 4, 5, 6, 7 };
+    uint8_t bytes[35];
+    std::iota(&bytes[0], &bytes[35], 0);
+
+    // act
+    reverseElements(&doubles[0], &doubles[7]);
+    reverseElements(&bytes[0], &bytes[35]);
+
+    // assert
+    EXPECT_EQ(doubles[0], 7);
+    EXPECT_EQ(doubles[6], 1);
+    for (uint8_t i = 0; i < 35; ++i) {
+        EXPECT_EQ(bytes[i], 34 - i);
+    }
+}
+
+TEST(SimdTests, reverseElements_reverses_shorts_and_floats) {
+    int16_t shorts[19];
+    float floats[11];
+    std::iota(&shorts[0], &shorts[19], 0);
+    std::iota(&floats[0], &floats[11], 0.0f);
+
+    // act
+    reverseElements(&shorts[0], &shorts[19]);
+    reverseElements(&floats[0], &floats[11]);
+
+    // assert
+    for (int16_t i = 0; i < 19; ++i) {
+        EXPECT_EQ(shorts[i], 18 - i);
+    }
+
+    for (int32_t i = 0; i < 11; ++i) {
+        EXPECT_EQ(floats[i], static_cast<float>(10 - i));
+    }
+}
+
+// -----------------------------------------
+// maxElement / minElement
+// -----------------------------------------
+
+TEST(SimdTests, maxElement_returns_the_largest_double) {
+    double values[7] = { 1.5, -3, 8.25, 2, 8, -10, 4 };
+
+    EXPECT_EQ(maxElement(values, 7), 8.25);
+    EXPECT_EQ(minElement(values, 7), -10);
+}
+
+TEST(SimdTests, maxElement_returns_nan_if_any_double_is_nan) {
+    double values[5] = { 1, 2, NAN, 4, 5 };
+
+    EXPECT_TRUE(std::isnan(maxElement(values, 5)));
+    EXPECT_TRUE(std::isnan(minElement(values, 5)));
+}
+
+TEST(SimdTests, maxElement_returns_infinity_for_no_doubles) {
+    EXPECT_EQ(maxElement(static_cast<const double*>(nullptr), 0), -INFINITY);
+    EXPECT_EQ(minElement(static_cast<const double*>(nullptr), 0), INFINITY);
+}
+
+TEST(SimdTests, maxElement_returns_the_largest_int) {
+    int32_t values[9] = { 1, -3, 8, 2, 27, -10, 4, 26, -2147483647 };
+
+    EXPECT_EQ(maxElement(values, 9), 27);
+    EXPECT_EQ(minElement(values, 9), -2147483647);
+}
@@ -0,0 +1,172 @@
+//
+// Tests for the sort kernels.
+//
+
+#include <cmath>
+#include <cstring>
+#include <numeric>
+#include <random>
+#include "gtest/gtest.h"
+#include "../lib/sort.h"
+
+template<typename T>
+static std::vector<T> randomElements(size_t count, T min, T max) {
+    std::mt19937 random(42);
+    std::vector<T> elements(count);
+
+    for (size_t i = 0; i < count; ++i) {
+        elements[i] = static_cast<T>(min + (static_cast<double>(max) - min) * (random() / static_cast<double>(random.max())));
+    }
+
+    return elements;
+}
+
+// -----------------------------------------
+// radixKey
+// -----------------------------------------
+
+TEST(SortTests, radixKey_preserves_the_order_of_ints) {
+    EXPECT_LT(radixKey(INT32_MIN), radixKey(-1));
+    EXPECT_LT(radixKey(-1), radixKey(0));
+    EXPECT_LT(radixKey(0), radixKey(INT32_MAX));
+}
+
+TEST(SortTests, radixKey_preserves_the_order_of_doubles) {
+    EXPECT_LT(radixKey(-INFINITY), radixKey(-1.5));
+    EXPECT_LT(radixKey(-1.5), radixKey(-1.25));
+    EXPECT_LT(radixKey(-1.25), radixKey(0.0));
+    EXPECT_LT(radixKey(0.0), radixKey(1e-300));
+    EXPECT_LT(radixKey(1e-300), radixKey(INFINITY));
+    EXPECT_LT(radixKey(INFINITY), radixKey(NAN));
+}
+
+TEST(SortTests, radixKey_maps_negative_zero_to_zero) {
+    EXPECT_EQ(radixKey(-0.0), radixKey(0.0));
+}
+
+// -----------------------------------------
+// sortElements
+// -----------------------------------------
+
+TEST(SortTests, sortElements_sorts_ints_in_ascending_order) {
+    for (size_t count : { 0, 1, 10, 63, 64, 1000, 10000 }) {
+        auto elements = randomElements<int32_t>(count, INT32_MIN, INT32_MAX);
+        auto expected = elements;
+        std::sort(expected.begin(), expected.end());
+
+        // act
+        sortElements(elements.data(), elements.data() + count);
+
+        // assert
+        EXPECT_EQ(elements, expected);
+    }
+}
+
+TEST(SortTests, sortElements_sorts_ints_with_a_small_range) {
+    auto elements = randomElements<int32_t>(1000, -5, 5);
+    auto expected = elements;
+    std::sort(expected.begin(), expected.end());
+
+    // act
+    sortElements(elements.data(), elements.data() + elements.size());
+
+    // assert
+    EXPECT_EQ(elements, expected);
+}
+
+TEST(SortTests, sortElements_sorts_doubles_in_ascending_order) {
+    for (size_t count : { 0, 1, 10, 63, 64, 1000, 10000 }) {
+        auto elements = randomElements<double>(count, -1e10, 1e10);
+        auto expected = elements;
+        std::sort(expected.begin(), expected.end());
+
+        // act
+        sortElements(elements.data(), elements.data() + count);
+
+        // assert
+        EXPECT_EQ(elements, expected);
+    }
+}
+
+TEST(SortTests, sortElements_orders_nan_after_infinity) {
+    auto elements = randomElements<double>(100, -10, 10);
+    elements[3] = NAN;
+    elements[40] = INFINITY;
+    elements[70] = -INFINITY;
+
+    // act
+    sortElements(elements.data(), elements.data() + elements.size());
+
+    // assert
+    EXPECT_EQ(elements[0], -INFINITY);
+    EXPECT_EQ(elements[98], INFINITY);
+    EXPECT_TRUE(std::isnan(elements[99]));
+    EXPECT_TRUE(std::is_sorted(elements.begin(), elements.end() - 1));
+}
+
+TEST(SortTests, sortElements_orders_negative_nan_after_infinity) {
+    const uint64_t negativeNanBits = 0xfff8000000000001ull;
+    double negativeNan;
+    std::memcpy(&negativeNan, &negativeNanBits, sizeof(negativeNan));
+
+    auto elements = randomElements<double>(100, -10, 10);
+    elements[3] = negativeNan;
+    elements[40] = INFINITY;
+    elements[70] = -INFINITY;
+    elements[80] = NAN;
+
+    // act
+    sortElements(elements.data(), elements.data() + elements.size());
+
+    // assert
+    EXPECT_EQ(elements[0], -INFINITY);
+    EXPECT_EQ(elements[97], INFINITY);
+    EXPECT_TRUE(std::isnan(elements[98]));
+    EXPECT_TRUE(std::isnan(elements[99]));
+    EXPECT_TRUE(std::is_sorted(elements.begin(), elements.end() - 2));
+}
+
+TEST(SortTests, sortElements_keeps_the_order_of_negative_and_positive_zero) {
+    std::vector<double> elements(100, 1.0);
+    elements[10] = 0.0;
+    elements[20] = -0.0;
+
+    // act
+    sortElements(elements.data(), elements.data() + elements.size());
+
+    // assert
+    EXPECT_FALSE(std::signbit(elements[0]));
+    EXPECT_TRUE(std::signbit(elements[1]));
+}
+
+// -----------------------------------------
+// sortElementsDescending
+// -----------------------------------------
+
+TEST(SortTests, sortElementsDescending_sorts_ints_in_descending_order) {
+    for (size_t count : { 0, 10, 1000 }) {
+        auto elements = randomElements<int32_t>(count, -100000, 100000);
+        auto expected = elements;
+        std::sort(expected.begin(), expected.end(), [](int32_t a, int32_t b) { return b < a; });
+
+        // act
+        sortElementsDescending(elements.data(), elements.data() + count);
+
+        // assert
+        EXPECT_EQ(elements, expected);
+    }
+}
+
+TEST(SortTests, sortElementsDescending_sorts_doubles_in_descending_order) {
+    for (size_t count : { 0, 10, 1000 }) {
+        auto elements = randomElements<double>(count, -1000, 1000);
+        auto expected = elements;
+        std::sort(expected.begin(), expected.end(), [](double a, double b) { return b < a; });
+
+        // act
+        sortElementsDescending(elements.data(), elements.data() + count);
+
+        // assert
+        EXPECT_EQ(elements, expected);
+    }
+}
@@ -0,0 +1,137 @@
+//
+// Tests for the runtime entry points of the typed arrays (Float32Array, Int8Array, Int16Array and Uint8Array).
+//
+
+#include <cmath>
+#include <stdint.h>
+#include "gtest/gtest.h"
+#include "../lib/array.h"
+
+// The entry points are defined in array-api.cc, see DEFINE_TYPED_ARRAY_API
+extern "C" {
+    Array<float>* Float32Array_constructori(int32_t size);
+    Array<float>* Float32Array_constructord(double size);
+    Array<float>* Float32Array_constructorPdu(double* const elements, size_t elementsCount);
+    double Float32Array_geti(const Array<float>& array, int32_t index);
+    void Float32Array_setid(Array<float>& array, int32_t index, double value);
+    Array<float>* Float32Array_slicedd(const Array<float>& array, double start, double end);
+    int32_t Float32Array_length(const Array<float>& array);
+
+    Array<int8_t>* Int8Array_constructori(int32_t size);
+    Array<int8_t>* Int8Array_constructord(double size);
+    double Int8Array_geti(const Array<int8_t>& array, int32_t index);
+    void Int8Array_setid(Array<int8_t>& array, int32_t index, double value);
+    Array<int8_t>* Int8Array_fillddd(Array<int8_t>& array, double value, double start, double end);
+
+    Array<int16_t>* Int16Array_constructori(int32_t size);
+    double Int16Array_geti(const Array<int16_t>& array, int32_t index);
+    void Int16Array_setid(Array<int16_t>& array, int32_t index, double value);
+    int32_t Int16Array_length(const Array<int16_t>& array);
+
+    Array<uint8_t>* Uint8Array_constructorPdu(double* const elements, size_t elementsCount);
+    double Uint8Array_geti(const Array<uint8_t>& array, int32_t index);
+    int32_t Uint8Array_length(const Array<uint8_t>& array);
+}
+
+// -----------------------------------------
+// new
+// -----------------------------------------
+
+TEST(TypedArrayTests, constructord_initializes_the_elements_with_zero) {
+    Array<float>* array = Float32Array_constructord(10.0);
+
+    EXPECT_EQ(Float32Array_length(*array), 10);
+    EXPECT_EQ(Float32Array_geti(*array, 9), 0.0);
+
+    delete array;
+}
+
+TEST(TypedArrayTests, constructord_throws_for_an_invalid_length) {
+    EXPECT_THROW(Int8Array_constructord(-1.0), std::out_of_range);
+    EXPECT_THROW(Int8Array_constructord(1.5), std::out_of_range);
+    EXPECT_THROW(Int8Array_constructord(NAN), std::out_of_range);
+}
+
+TEST(TypedArrayTests, constructorPdu_converts_the_elements) {
+    double elements[] = { 1.5, 300.0, -1.0 };
+    Array<uint8_t>* array = Uint8Array_constructorPdu(elements, 3);
+
+    EXPECT_EQ(Uint8Array_length(*array), 3);
+    EXPECT_EQ(Uint8Array_geti(*array, 0), 1.0);
+    EXPECT_EQ(Uint8Array_geti(*array, 1), 44.0);
+    EXPECT_EQ(Uint8Array_geti(*array, 2), 255.0);
+
+    delete array;
+}
+
+// -----------------------------------------
+// get / set
+// -----------------------------------------
+
+TEST(TypedArrayTests, setid_rounds_to_float) {
+    Array<float>* array = Float32Array_constructori(1);
+
+    Float32Array_setid(*array, 0, 0.1);
+
+    EXPECT_EQ(Float32Array_geti(*array, 0), static_cast<double>(0.1f));
+
+    delete array;
+}
+
+TEST(TypedArrayTests, setid_wraps_the_integer_types_around) {
+    Array<int8_t>* int8Array = Int8Array_constructori(1);
+    Array<int16_t>* int16Array = Int16Array_constructori(1);
+
+    Int8Array_setid(*int8Array, 0, 128.0);
+    Int16Array_setid(*int16Array, 0, -32769.0);
+
+    EXPECT_EQ(Int8Array_geti(*int8Array, 0), -128.0);
+    EXPECT_EQ(Int16Array_geti(*int16Array, 0), 32767.0);
+
+    delete int8Array;
+    delete int16Array;
+}
+
+TEST(TypedArrayTests, setid_ignores_out_of_bound_writes) {
+    Array<int16_t>* array = Int16Array_constructori(2);
+
+    Int16Array_setid(*array, 2, 1.0);
+    Int16Array_setid(*array, -1, 1.0);
+
+    EXPECT_EQ(Int16Array_length(*array), 2);
+    EXPECT_EQ(Int16Array_geti(*array, 0), 0.0);
+    EXPECT_EQ(Int16Array_geti(*array, 1), 0.0);
+
+    delete array;
+}
+
+// -----------------------------------------
+// fill / slice
+// -----------------------------------------
+
+TEST(TypedArrayTests, fillddd_fills_the_range) {
+    Array<int8_t>* array = Int8Array_constructori(4);
+
+    Int8Array_fillddd(*array, 3.0, 1.0, -1.0);
+
+    EXPECT_EQ(Int8Array_geti(*array, 0), 0.0);
+    EXPECT_EQ(Int8Array_geti(*array, 1), 3.0);
+    EXPECT_EQ(Int8Array_geti(*array, 2), 3.0);
+    EXPECT_EQ(Int8Array_geti(*array, 3), 0.0);
+
+    delete array;
+}
+
+TEST(TypedArrayTests, slicedd_clamps_the_positions) {
+    double elements[] = { 1.0, 2.0, 3.0 };
+    Array<float>* array = Float32Array_constructorPdu(elements, 3);
+
+    Array<float>* slice = Float32Array_slicedd(*array, 1.0, INFINITY);
+
+    EXPECT_EQ(Float32Array_length(*slice), 2);
+    EXPECT_EQ(Float32Array_geti(*slice, 0), 2.0);
+    EXPECT_EQ(Float32Array_geti(*slice, 1), 3.0);
+
+    delete slice;
+    delete array;
+}
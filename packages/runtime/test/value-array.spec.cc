@@ -0,0 +1,136 @@
+//
+// Tests for the ValueArray that stores the fields of the elements inline.
+//
+
+#include "gtest/gtest.h"
+#include "../lib/value-array.h"
+
+struct Point {
+    double x;
+    double y;
+};
+
+const int32_t POINT_SIZE = static_cast<int32_t>(sizeof(Point));
+
+class ValueArrayTests: public ::testing::Test {
+public:
+    ValueArray* array;
+
+    void SetUp() {
+        array = nullptr;
+    }
+
+    void TearDown() {
+        if (array != nullptr) {
+            delete array;
+        }
+    }
+
+    Point& pointAt(int32_t index) {
+        return *static_cast<Point*>(array->elementAt(index));
+    }
+};
+
+// -----------------------------------------
+// new
+// -----------------------------------------
+
+TEST_F(ValueArrayTests, new_initializes_the_elements_with_zero) {
+    array = new ValueArray(100, POINT_SIZE);
+
+    EXPECT_EQ(array->length(), 100);
+    EXPECT_EQ(array->getElementSize(), sizeof(Point));
+    for (int32_t i = 0; i < 100; ++i) {
+        EXPECT_EQ(pointAt(i).x, 0.0);
+        EXPECT_EQ(pointAt(i).y, 0.0);
+    }
+}
+
+TEST_F(ValueArrayTests, new_copies_the_passed_elements) {
+    Point points[] = { { 1.0, 2.0 }, { 3.0, 4.0 } };
+    array = new ValueArray(points, 2, POINT_SIZE);
+    points[0].x = 10.0;
+
+    EXPECT_EQ(array->length(), 2);
+    EXPECT_EQ(pointAt(0).x, 1.0);
+    EXPECT_EQ(pointAt(1).y, 4.0);
+}
+
+TEST_F(ValueArrayTests, new_throws_for_a_negative_length) {
+    EXPECT_THROW(new ValueArray(-1, POINT_SIZE), std::out_of_range);
+}
+
+// -----------------------------------------
+// elementAt
+// -----------------------------------------
+
+TEST_F(ValueArrayTests, elementAt_returns_contiguous_elements) {
+    array = new ValueArray(3, POINT_SIZE);
+
+    EXPECT_EQ(static_cast<uint8_t*>(array->elementAt(2)) - static_cast<uint8_t*>(array->elementAt(0)), 2 * POINT_SIZE);
+}
+
+TEST_F(ValueArrayTests, elementAt_writes_the_fields_in_place) {
+    array = new ValueArray(2, POINT_SIZE);
+
+    pointAt(1).x = 5.0;
+
+    EXPECT_EQ(pointAt(1).x, 5.0);
+    EXPECT_EQ(pointAt(0).x, 0.0);
+}
+
+TEST_F(ValueArrayTests, elementAt_throws_if_the_index_is_out_of_bound) {
+    array = new ValueArray(2, POINT_SIZE);
+
+    EXPECT_THROW(array->elementAt(2), std::out_of_range);
+    EXPECT_THROW(array->elementAt(-1), std::out_of_range);
+}
+
+// -----------------------------------------
+// set
+// -----------------------------------------
+
+TEST_F(ValueArrayTests, set_copies_the_value) {
+    array = new ValueArray(2, POINT_SIZE);
+    Point point { 7.0, 8.0 };
+
+    array->set(0, &point);
+    point.x = 0.0;
+
+    EXPECT_EQ(pointAt(0).x, 7.0);
+    EXPECT_EQ(pointAt(0).y, 8.0);
+}
+
+// -----------------------------------------
+// push
+// -----------------------------------------
+
+TEST_F(ValueArrayTests, push_appends_the_elements_and_grows_the_array) {
+    array = new ValueArray(0, POINT_SIZE);
+
+    for (int32_t i = 0; i < 100; ++i) {
+        Point point { static_cast<double>(i), static_cast<double>(-i) };
+        EXPECT_EQ(array->push(&point, 1), i + 1);
+    }
+
+    for (int32_t i = 0; i < 100; ++i) {
+        EXPECT_EQ(pointAt(i).x, static_cast<double>(i));
+        EXPECT_EQ(pointAt(i).y, static_cast<double>(-i));
+    }
+}
+
+// -----------------------------------------
+// resize
+// -----------------------------------------
+
+TEST_F(ValueArrayTests, resize_zero_initializes_the_added_elements) {
+    array = new ValueArray(1, POINT_SIZE);
+    pointAt(0).x = 1.0;
+    array->resize(0);
+
+    array->resize(2);
+
+    EXPECT_EQ(array->length(), 2);
+    EXPECT_EQ(pointAt(0).x, 0.0);
+    EXPECT_EQ(pointAt(1).y, 0.0);
+}
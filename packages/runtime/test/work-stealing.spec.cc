@@ -0,0 +1,101 @@
+//
+// Tests for the work stealing deque
+//
+
+#include <atomic>
+#include <thread>
+#include <vector>
+#include "gtest/gtest.h"
+#include "../lib/work-stealing.h"
+
+TEST(WorkStealingDequeTests, pop_returns_the_tasks_in_lifo_order) {
+    WorkStealingDeque<int32_t, 4> deque;
+    deque.push(1);
+    deque.push(2);
+
+    int32_t task = 0;
+
+    // act, assert
+    EXPECT_TRUE(deque.pop(task));
+    EXPECT_EQ(task, 2);
+    EXPECT_TRUE(deque.pop(task));
+    EXPECT_EQ(task, 1);
+    EXPECT_FALSE(deque.pop(task));
+    EXPECT_TRUE(deque.empty());
+}
+
+TEST(WorkStealingDequeTests, steal_returns_the_tasks_in_fifo_order) {
+    WorkStealingDeque<int32_t, 4> deque;
+    deque.push(1);
+    deque.push(2);
+
+    int32_t task = 0;
+
+    // act, assert
+    EXPECT_TRUE(deque.steal(task));
+    EXPECT_EQ(task, 1);
+    EXPECT_TRUE(deque.steal(task));
+    EXPECT_EQ(task, 2);
+    EXPECT_FALSE(deque.steal(task));
+}
+
+TEST(WorkStealingDequeTests, push_fails_if_the_deque_is_full) {
+    WorkStealingDeque<int32_t, 2> deque;
+
+    // act, assert
+    EXPECT_TRUE(deque.push(1));
+    EXPECT_TRUE(deque.push(2));
+    EXPECT_FALSE(deque.push(3));
+
+    int32_t task = 0;
+    deque.steal(task);
+    EXPECT_TRUE(deque.push(3));
+}
+
+TEST(WorkStealingDequeTests, every_task_is_taken_exactly_once_by_the_owner_and_the_thieves) {
+    const int32_t TASKS = 100000;
+    WorkStealingDeque<int32_t, 1024> deque;
+    std::vector<std::atomic<int32_t>> taken(TASKS);
+    for (auto& count : taken) {
+        count.store(0);
+    }
+    std::atomic<bool> done { false };
+
+    std::vector<std::thread> thieves;
+    for (int i = 0; i < 3; ++i) {
+        thieves.emplace_back([&]() {
+            int32_t task;
+            while (!done.load()) {
+                if (deque.steal(task)) {
+                    taken[task].fetch_add(1);
+                }
+            }
+        });
+    }
+
+    // act
+    int32_t task;
+    for (int32_t next = 0; next < TASKS;) {
+        if (deque.push(next)) {
+            ++next;
+        }
+
+        if (next % 3 == 0 && deque.pop(task)) {
+            taken[task].fetch_add(1);
+        }
+    }
+
+    while (deque.pop(task)) {
+        taken[task].fetch_add(1);
+    }
+
+    done.store(true);
+    for (auto& thief : thieves) {
+        thief.join();
+    }
+
+    // assert
+    for (auto& count : taken) {
+        ASSERT_EQ(count.load(), 1);
+    }
+}